@@ -43,6 +43,7 @@ LOCAL_SRC_FILES := \
 	src/gl/gl4es.c \
 	src/gl/glstate.c \
 	src/gl/hint.c \
+	src/gl/hotarrays.c \
 	src/gl/init.c \
 	src/gl/light.c \
 	src/gl/line.c \
@@ -72,13 +73,16 @@ LOCAL_SRC_FILES := \
 	src/gl/stubs.c \
 	src/gl/texenv.c \
 	src/gl/texgen.c \
+	src/gl/texmirror.c \
 	src/gl/texture.c \
 	src/gl/texture_compressed.c \
 	src/gl/texture_params.c \
 	src/gl/texture_read.c \
+	src/gl/trace.c \
 	src/gl/texture_3d.c \
 	src/gl/uniform.c \
 	src/gl/vertexattrib.c \
+	src/gl/wireframe.c \
 	src/gl/wrap/gl4eswraps.c \
 	src/gl/wrap/gles.c \
 	src/gl/wrap/glstub.c \
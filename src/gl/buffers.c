@@ -4,11 +4,17 @@
 #include "../glx/hardext.h"
 #include "attributes.h"
 #include "debug.h"
+#include "enum_info.h"
 #include "gl4es.h"
 #include "glstate.h"
 #include "logs.h"
 #include "init.h"
 #include "loader.h"
+#include "pixel.h"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
 
 //#define DEBUG
 #ifdef DEBUG
@@ -94,6 +100,283 @@ void rebind_real_buff_arrays(int old_buffer, int new_buffer) {
     }
 }
 
+// Async glReadPixels: the read goes in a real PBO with a fence, and is only copied
+// (and converted if needed) to the buffer data when the application looks at it
+static void readback_drop(readback_t *rb) {
+    if(rb->fence) {
+        LOAD_GLES2(glDeleteSync);
+        gles_glDeleteSync(rb->fence);
+        rb->fence = NULL;
+    }
+    rb->pending = 0;
+}
+
+static void readback_free(glbuffer_t *buff) {
+    readback_drop(buff->readback);
+    if(buff->readback->pbo) {
+        LOAD_GLES(glDeleteBuffers);
+        gles_glDeleteBuffers(1, &buff->readback->pbo);
+    }
+    free(buff->readback);
+    buff->readback = NULL;
+}
+
+int buffer_readpixels(glbuffer_t *buff, GLint x, GLint y, GLsizei width, GLsizei height, GLenum readf, GLenum readt, GLenum format, GLenum type, GLintptr offset) {
+    if(hardext.esversion<3)
+        return 0;
+    LOAD_GLES2(glFenceSync);
+    LOAD_GLES2(glMapBufferRange);
+    if(!gles_glFenceSync || !gles_glMapBufferRange)
+        return 0;
+    LOAD_GLES(glGenBuffers);
+    LOAD_GLES(glBindBuffer);
+    LOAD_GLES(glBufferData);
+    LOAD_GLES(glReadPixels);
+    buffer_sync(buff);  // previous read may not cover the same area
+    if(!buff->readback)
+        buff->readback = (readback_t*)calloc(1, sizeof(readback_t));
+    readback_t *rb = buff->readback;
+    const GLint align = glstate->texture.pack_align;
+    const GLsizeiptr line = widthalign(width*pixel_sizeof(readf, readt), align);
+    if(!rb->pbo)
+        gles_glGenBuffers(1, &rb->pbo);
+    gles_glBindBuffer(GL_PIXEL_PACK_BUFFER, rb->pbo);
+    if(rb->pbo_size < line*height) {
+        rb->pbo_size = line*height;
+        gles_glBufferData(GL_PIXEL_PACK_BUFFER, rb->pbo_size, NULL, GL_STREAM_READ);
+    }
+    gles_glReadPixels(x, y, width, height, readf, readt, NULL);
+    gles_glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    rb->fence = gles_glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    rb->pending = 1;
+    rb->offset = offset;
+    rb->size = line*(height-1) + width*pixel_sizeof(readf, readt);
+    rb->width = width;
+    rb->height = height;
+    rb->readf = readf;
+    rb->readt = readt;
+    rb->format = format;
+    rb->type = type;
+    rb->align = align;
+    return 1;
+}
+
+void buffer_readback(glbuffer_t *buff) {
+    readback_t *rb = buff->readback;
+    LOAD_GLES2(glClientWaitSync);
+    LOAD_GLES2(glMapBufferRange);
+    LOAD_GLES2(glUnmapBuffer);
+    LOAD_GLES(glBindBuffer);
+    if(rb->fence) {
+        while(gles_glClientWaitSync(rb->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull)==GL_TIMEOUT_EXPIRED)
+            ;
+    }
+    readback_drop(rb);
+    gles_glBindBuffer(GL_PIXEL_PACK_BUFFER, rb->pbo);
+    void* pixels = gles_glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, rb->size, GL_MAP_READ_BIT);
+    if(pixels) {
+        GLvoid *dst = (char*)buff->data + rb->offset;
+        if(rb->readf==rb->format && rb->readt==rb->type)
+            memcpy(dst, pixels, rb->size);
+        else if (! pixel_convert(pixels, &dst, rb->width, rb->height, rb->readf, rb->readt, rb->format, rb->type, 0, rb->align)) {
+            LOGE("ReadPixels error: (%s, %s -> %s, %s )\n",
+                PrintEnum(rb->readf), PrintEnum(rb->readt), PrintEnum(rb->format), PrintEnum(rb->type));
+        }
+        gles_glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    } else
+        LOGE("Could not map the pixel pack buffer for glReadPixels\n");
+    gles_glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+// Mirror-less buffers (LIBGL_NOVBOMIRROR): the real VBO holds the content, and the CPU copy is
+// reserved but left untouched until something needs it, so it doesn't use physical memory until then.
+// Its address never changes, as it's baked in the arrays pointers
+static void* mirror_alloc(GLsizeiptr size) {
+#ifdef __linux__
+    void* p = mmap(NULL, size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+    return (p==MAP_FAILED)?NULL:p;
+#else
+    return malloc(size);
+#endif
+}
+
+static void mirror_release(glbuffer_t *buff) {
+    buff->stale = 1;
+#ifdef __linux__
+    if(buff->data && buff->size)
+        madvise(buff->data, buff->size, MADV_DONTNEED);
+#endif
+}
+
+static void free_data(glbuffer_t *buff) {
+    if(!buff->data)
+        return;
+#ifdef __linux__
+    if(buff->nomirror)
+        munmap(buff->data, buff->size);
+    else
+#endif
+    free(buff->data);
+    buff->data = NULL;
+}
+
+// (re)create the CPU side of a buffer for glBufferData
+static void buffer_storage(glbuffer_t *buff, GLenum target, GLsizeiptr size, const GLvoid *data) {
+    int nomirror = globals4es.novbomirror && buff->real_buffer && target==GL_ARRAY_BUFFER;
+    if (buff->data && (buff->size<size || nomirror || buff->nomirror))
+        free_data(buff);
+    buff->nomirror = nomirror;
+    if(!buff->data)
+        buff->data = (nomirror)?mirror_alloc(size):malloc(size);
+    buff->size = size;
+    buff->stale = nomirror;
+    if (data && !nomirror)
+        memcpy(buff->data, data, size);
+}
+
+void buffer_fetch(glbuffer_t *buff) {
+    LOAD_GLES2(glMapBufferRange);
+    LOAD_GLES2(glUnmapBuffer);
+    if(buff->native_map)
+        return; // mapped by the application, data will be fetched after the unmap
+    buff->stale = 0;
+    if(!buff->real_buffer || !buff->size || !buff->data || !gles_glMapBufferRange)
+        return;
+    DBG(printf("Fetching content of VBO %u (%zd bytes)\n", buff->buffer, buff->size);)
+    bindBuffer(GL_ARRAY_BUFFER, buff->real_buffer);
+    void* p = gles_glMapBufferRange(GL_ARRAY_BUFFER, 0, buff->size, GL_MAP_READ_BIT);
+    if(p) {
+        memcpy(buff->data, p, buff->size);
+        gles_glUnmapBuffer(GL_ARRAY_BUFFER);
+    } else
+        LOGE("Could not read back VBO %u\n", buff->buffer);
+}
+
+// map the real VBO directly, for mirror-less buffers
+static void* buffer_map_native(glbuffer_t *buff, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+    LOAD_GLES2(glMapBufferRange);
+    if(!gles_glMapBufferRange)
+        return NULL;
+    bindBuffer(GL_ARRAY_BUFFER, buff->real_buffer);
+    // GLES3 doesn't have persistent / coherent mapping
+    buff->native_map = gles_glMapBufferRange(GL_ARRAY_BUFFER, offset, length, access&~(GL_MAP_PERSISTENT_BIT|GL_MAP_COHERENT_BIT));
+    return buff->native_map;
+}
+
+static void buffer_unmap_native(glbuffer_t *buff) {
+    LOAD_GLES2(glUnmapBuffer);
+    bindBuffer(GL_ARRAY_BUFFER, buff->real_buffer);
+    gles_glUnmapBuffer(GL_ARRAY_BUFFER);
+    buff->native_map = NULL;
+    if((buff->ranged)?(buff->access&GL_MAP_WRITE_BIT):(buff->access!=GL_READ_ONLY))
+        mirror_release(buff);
+}
+
+// Write tracking of mapped buffers: instead of sending the whole buffer back on unmap, only
+// the ranges that changed are uploaded. Explicit flushes are collected as ranges, and for plain
+// glMapBuffer the CPU copy is hashed per block when mapped and compared on unmap.
+#define TRACK_BLOCK     4096
+#define TRACK_MIN_SIZE  (16*TRACK_BLOCK)    // smaller buffers are just sent back whole
+
+static void dirty_add(glbuffer_t *buff, GLintptr start, GLintptr end) {
+    if(end>buff->size) end = buff->size;
+    if(start>=end)
+        return;
+    // find the first range that ends at or after start
+    int i = 0;
+    while(i<buff->ndirty && buff->dirty[i*2+1]<start)
+        ++i;
+    // and merge all the ranges that touch [start, end[
+    int j = i;
+    while(j<buff->ndirty && buff->dirty[j*2]<=end) {
+        if(buff->dirty[j*2]<start) start = buff->dirty[j*2];
+        if(buff->dirty[j*2+1]>end) end = buff->dirty[j*2+1];
+        ++j;
+    }
+    if(i==j) {
+        // insert a new range
+        if(buff->ndirty==buff->capdirty) {
+            buff->capdirty += 8;
+            buff->dirty = (GLintptr*)realloc(buff->dirty, buff->capdirty*2*sizeof(GLintptr));
+        }
+        memmove(buff->dirty+(i+1)*2, buff->dirty+i*2, (buff->ndirty-i)*2*sizeof(GLintptr));
+        ++buff->ndirty;
+    } else if(j>i+1) {
+        memmove(buff->dirty+(i+1)*2, buff->dirty+j*2, (buff->ndirty-j)*2*sizeof(GLintptr));
+        buff->ndirty -= j-i-1;
+    }
+    buff->dirty[i*2] = start;
+    buff->dirty[i*2+1] = end;
+}
+
+static void dirty_upload(glbuffer_t *buff) {
+    LOAD_GLES(glBufferSubData);
+    if(buff->ndirty)
+        bindBuffer(buff->type, buff->real_buffer);
+    for(int i=0; i<buff->ndirty; ++i) {
+        DBG(printf("\t upload dirty range [%zd, %zd[ of buffer %u\n", buff->dirty[i*2], buff->dirty[i*2+1], buff->buffer);)
+        gles_glBufferSubData(buff->type, buff->dirty[i*2], buff->dirty[i*2+1]-buff->dirty[i*2], (char*)buff->data+buff->dirty[i*2]);
+    }
+    buff->ndirty = 0;
+}
+
+static uint64_t hash_block(const char* p, int size) {
+    const uint64_t* w = (const uint64_t*)p;
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ size;
+    int n = size/8;
+    for(int i=0; i<n; ++i) {
+        h ^= w[i] * 0x87c37b91114253d5ULL;
+        h = ((h<<31) | (h>>33)) * 0x4cf5ad432745937fULL;
+    }
+    for(int i=n*8; i<size; ++i)
+        h = (h ^ (unsigned char)p[i]) * 0x100000001b3ULL;
+    return h ^ (h>>29);
+}
+
+static void buffer_track_map(glbuffer_t *buff) {
+    if(!buff->real_buffer || buff->size<TRACK_MIN_SIZE || buff->access==GL_READ_ONLY)
+        return;
+    int n = (buff->size+TRACK_BLOCK-1)/TRACK_BLOCK;
+    if(buff->nblockhash!=n) {
+        free(buff->blockhash);
+        buff->blockhash = (uint64_t*)malloc(n*sizeof(uint64_t));
+        buff->nblockhash = n;
+    }
+    for(int i=0; i<n; ++i) {
+        GLsizeiptr sz = buff->size-i*TRACK_BLOCK;
+        buff->blockhash[i] = hash_block((char*)buff->data+i*TRACK_BLOCK, (sz>TRACK_BLOCK)?TRACK_BLOCK:sz);
+    }
+}
+
+static void buffer_track_unmap(glbuffer_t *buff) {
+    for(int i=0; i<buff->nblockhash; ++i) {
+        GLsizeiptr sz = buff->size-i*TRACK_BLOCK;
+        if(sz>TRACK_BLOCK) sz = TRACK_BLOCK;
+        if(hash_block((char*)buff->data+i*TRACK_BLOCK, sz)!=buff->blockhash[i])
+            dirty_add(buff, i*TRACK_BLOCK, i*TRACK_BLOCK+sz);
+    }
+}
+
+// send back to GLES what has been written in a mapped buffer
+static void buffer_unmap_upload(glbuffer_t *buff) {
+    if(!buff->mapped || !buff->real_buffer || (buff->type!=GL_ARRAY_BUFFER && buff->type!=GL_ELEMENT_ARRAY_BUFFER))
+        return;
+    if(!buff->ranged) {
+        if(buff->access!=GL_WRITE_ONLY && buff->access!=GL_READ_WRITE)
+            return;
+        if(buff->blockhash && buff->nblockhash==(buff->size+TRACK_BLOCK-1)/TRACK_BLOCK)
+            buffer_track_unmap(buff);
+        else
+            dirty_add(buff, 0, buff->size);
+    } else {
+        if(!(buff->access&GL_MAP_WRITE_BIT_EXT))
+            return;
+        if(!(buff->access&GL_MAP_FLUSH_EXPLICIT_BIT_EXT))
+            dirty_add(buff, buff->offset, buff->offset+buff->length);
+    }
+    dirty_upload(buff);
+}
+
 void APIENTRY_GL4ES gl4es_glGenBuffers(GLsizei n, GLuint * buffers) {
     DBG(printf("glGenBuffers(%i, %p)\n", n, buffers);)
 	noerrorShim();
@@ -119,6 +402,14 @@ void APIENTRY_GL4ES gl4es_glGenBuffers(GLsizei n, GLuint * buffers) {
         buff->access = GL_READ_WRITE;
         buff->mapped = 0;
         buff->real_buffer = 0;
+        buff->nomirror = 0;
+        buff->stale = 0;
+        buff->native_map = NULL;
+        buff->blockhash = NULL;
+        buff->nblockhash = 0;
+        buff->dirty = NULL;
+        buff->ndirty = buff->capdirty = 0;
+        buff->readback = NULL;
     }
 }
 
@@ -154,8 +445,18 @@ void APIENTRY_GL4ES gl4es_glBindBuffer(GLenum target, GLuint buffer) {
             buff->access = GL_READ_WRITE;
             buff->mapped = 0;
             buff->real_buffer = 0;
+            buff->nomirror = 0;
+            buff->stale = 0;
+            buff->native_map = NULL;
+            buff->blockhash = NULL;
+            buff->nblockhash = 0;
+            buff->dirty = NULL;
+            buff->ndirty = buff->capdirty = 0;
+            buff->readback = NULL;
         } else {
             buff = kh_value(list, k);
+            if(target!=GL_PIXEL_PACK_BUFFER)
+                buffer_sync(buff);
             buff->type = target;    //TODO: check if old binding?
         }
         bind_buffer(target, buff);
@@ -177,6 +478,8 @@ void APIENTRY_GL4ES gl4es_glBufferData(GLenum target, GLsizeiptr size, const GLv
     }
     if(target==GL_ARRAY_BUFFER)
         VaoSharedClear(glstate->vao);
+    if(buff->readback)
+        readback_drop(buff->readback);  // content is replaced anyway
     
     int go_real = 0;
     if(     (target==GL_ARRAY_BUFFER || target==GL_ELEMENT_ARRAY_BUFFER) 
@@ -202,18 +505,10 @@ void APIENTRY_GL4ES gl4es_glBufferData(GLenum target, GLsizeiptr size, const GLv
         DBG(printf(" => real VBO %d\n", buff->real_buffer);)
     }
         
-    if (buff->data && buff->size<size) {
-        free(buff->data);
-        buff->data = NULL;
-    }
-    if(!buff->data)
-        buff->data = malloc(size);
-    buff->size = size;
+    buffer_storage(buff, target, size, data);
     buff->usage = usage;
-    DBG(printf("\t buff->data = %p (size=%zd)\n", buff->data, size);)
+    DBG(printf("\t buff->data = %p (size=%zd, nomirror=%d)\n", buff->data, size, buff->nomirror);)
     buff->access = GL_READ_WRITE;
-    if (data)
-        memcpy(buff->data, data, size);
     // update binded VA
     for (int i=0; i<hardext.maxvattrib; ++i) {
         vertexattrib_t *v = &glstate->vao->vertexattrib[i];
@@ -233,10 +528,8 @@ void APIENTRY_GL4ES gl4es_glNamedBufferData(GLuint buffer, GLsizeiptr size, cons
 		errorShim(GL_INVALID_OPERATION);
         return;
     }
-    if (buff->data) {
-        free(buff->data);
-
-    }
+    if(buff->readback)
+        readback_drop(buff->readback);
     int go_real = 0;
     if(     (buff->type==GL_ARRAY_BUFFER || buff->type==GL_ELEMENT_ARRAY_BUFFER) 
          && (usage==GL_STREAM_DRAW || usage==GL_STATIC_DRAW || usage==GL_DYNAMIC_DRAW) && globals4es.usevbo)
@@ -258,12 +551,9 @@ void APIENTRY_GL4ES gl4es_glNamedBufferData(GLuint buffer, GLsizeiptr size, cons
         gles_glBufferData(buff->type, size, data, usage);
     }
 
-    buff->size = size;
+    buffer_storage(buff, buff->type, size, data);
     buff->usage = usage;
-    buff->data = malloc(size);
     buff->access = GL_READ_WRITE;
-    if (data)
-        memcpy(buff->data, data, size);
     // update binded VA
     for (int i=0; i<hardext.maxvattrib; ++i) {
         vertexattrib_t *v = &glstate->vao->vertexattrib[i];
@@ -295,6 +585,7 @@ void APIENTRY_GL4ES gl4es_glBufferSubData(GLenum target, GLintptr offset, GLsize
         errorShim(GL_INVALID_VALUE);
         return;
     }
+    buffer_sync(buff);
 
     if((target==GL_ARRAY_BUFFER || target==GL_ELEMENT_ARRAY_BUFFER) && buff->real_buffer) {
         LOAD_GLES(glBufferSubData);
@@ -302,8 +593,8 @@ void APIENTRY_GL4ES gl4es_glBufferSubData(GLenum target, GLintptr offset, GLsize
         bindBuffer(target, buff->real_buffer);
         gles_glBufferSubData(target, offset, size, data);
     }
-        
-    memcpy((char*)buff->data + offset, data, size);
+    if(!buff->stale)
+        memcpy((char*)buff->data + offset, data, size);
     noerrorShim();
 }
 void APIENTRY_GL4ES gl4es_glNamedBufferSubData(GLuint buffer, GLintptr offset, GLsizeiptr size, const GLvoid * data) {
@@ -318,6 +609,7 @@ void APIENTRY_GL4ES gl4es_glNamedBufferSubData(GLuint buffer, GLintptr offset, G
         errorShim(GL_INVALID_VALUE);
         return;
     }
+    buffer_sync(buff);
         
     if((buff->type==GL_ARRAY_BUFFER || buff->type==GL_ELEMENT_ARRAY_BUFFER) && buff->real_buffer) {
         LOAD_GLES(glBufferSubData);
@@ -325,7 +617,8 @@ void APIENTRY_GL4ES gl4es_glNamedBufferSubData(GLuint buffer, GLintptr offset, G
         bindBuffer(buff->type, buff->real_buffer);
         gles_glBufferSubData(buff->type, offset, size, data);
     }
-    memcpy((char*)buff->data + offset, data, size);
+    if(!buff->stale)
+        memcpy((char*)buff->data + offset, data, size);
     noerrorShim();
 }
 
@@ -346,6 +639,8 @@ void APIENTRY_GL4ES gl4es_glDeleteBuffers(GLsizei n, const GLuint * buffers) {
                 k = kh_get(buff, list, t);
                 if (k != kh_end(list)) {
                     buff = kh_value(list, k);
+                    if(buff->readback)
+                        readback_free(buff);
                     if(buff->real_buffer) {
                         rebind_real_buff_arrays(buff->real_buffer, 0);  // unbind
                         LOAD_GLES(glDeleteBuffers);
@@ -366,7 +661,11 @@ void APIENTRY_GL4ES gl4es_glDeleteBuffers(GLsizei n, const GLuint * buffers) {
                             glstate->vao->vertexattrib[j].real_pointer = 0;
                         }
                     DBG(printf("\t buff->data = %p\n", buff->data);)
-                    if (buff->data) free(buff->data);
+                    if(buff->native_map)
+                        buffer_unmap_native(buff);
+                    free_data(buff);
+                    free(buff->blockhash);
+                    free(buff->dirty);
                     kh_del(buff, list, k);
                     free(buff);
                 }
@@ -464,10 +763,19 @@ void* APIENTRY_GL4ES gl4es_glMapBuffer(GLenum target, GLenum access) {
         errorShim(GL_INVALID_OPERATION);
         return NULL;
     }
+    buffer_sync(buff);
 	buff->access = access;	// not used
 	buff->mapped = 1;
     buff->ranged = 0;
 	noerrorShim();
+    if(buff->nomirror) {
+        GLbitfield bits = (access==GL_READ_ONLY)?GL_MAP_READ_BIT:((access==GL_WRITE_ONLY)?GL_MAP_WRITE_BIT:(GL_MAP_READ_BIT|GL_MAP_WRITE_BIT));
+        void* ret = buffer_map_native(buff, 0, buff->size, bits);
+        if(ret)
+            return ret;
+        buffer_mirror(buff);    // fallback to the CPU copy
+    }
+    buffer_track_map(buff);
 	return buff->data;		// Not nice, should do some copy or something probably
 }
 void* APIENTRY_GL4ES gl4es_glMapNamedBuffer(GLuint buffer, GLenum access) {
@@ -482,10 +790,19 @@ void* APIENTRY_GL4ES gl4es_glMapNamedBuffer(GLuint buffer, GLenum access) {
         errorShim(GL_INVALID_OPERATION);
         return NULL;
     }
+    buffer_sync(buff);
 	buff->access = access;	// not used
 	buff->mapped = 1;
     buff->ranged = 0;
 	noerrorShim();
+    if(buff->nomirror) {
+        GLbitfield bits = (access==GL_READ_ONLY)?GL_MAP_READ_BIT:((access==GL_WRITE_ONLY)?GL_MAP_WRITE_BIT:(GL_MAP_READ_BIT|GL_MAP_WRITE_BIT));
+        void* ret = buffer_map_native(buff, 0, buff->size, bits);
+        if(ret)
+            return ret;
+        buffer_mirror(buff);    // fallback to the CPU copy
+    }
+    buffer_track_map(buff);
 	return buff->data;		// Not nice, should do some copy or something probably
 }
 
@@ -508,17 +825,10 @@ GLboolean APIENTRY_GL4ES gl4es_glUnmapBuffer(GLenum target) {
 		return GL_FALSE;
     }
 	noerrorShim();
-    if(buff->real_buffer && (buff->type==GL_ARRAY_BUFFER || buff->type==GL_ELEMENT_ARRAY_BUFFER) && buff->mapped && !buff->ranged && (buff->access==GL_WRITE_ONLY || buff->access==GL_READ_WRITE)) {
-        LOAD_GLES(glBufferSubData);
-        LOAD_GLES(glBindBuffer);
-        bindBuffer(buff->type, buff->real_buffer);
-        gles_glBufferSubData(buff->type, 0, buff->size, buff->data);
-    }
-    if(buff->real_buffer && (buff->type==GL_ARRAY_BUFFER || buff->type==GL_ELEMENT_ARRAY_BUFFER) && buff->mapped && buff->ranged && (buff->access&GL_MAP_WRITE_BIT_EXT) && !(buff->access&GL_MAP_FLUSH_EXPLICIT_BIT_EXT)) {
-        LOAD_GLES(glBufferSubData);
-        bindBuffer(buff->type, buff->real_buffer);
-        gles_glBufferSubData(buff->type, buff->offset, buff->length, (void*)((uintptr_t)buff->data+buff->offset));
-    }
+    if(buff->native_map)
+        buffer_unmap_native(buff);
+    else
+        buffer_unmap_upload(buff);
     if (buff->mapped) {
 		buff->mapped = 0;
         buff->ranged = 0;
@@ -535,18 +845,10 @@ GLboolean APIENTRY_GL4ES gl4es_glUnmapNamedBuffer(GLuint buffer) {
 	if (buff==NULL)
 		return GL_FALSE;		// Should generate an error!
 	noerrorShim();
-    if(buff->real_buffer && (buff->type==GL_ARRAY_BUFFER || buff->type==GL_ELEMENT_ARRAY_BUFFER) && buff->mapped && (buff->access==GL_WRITE_ONLY || buff->access==GL_READ_WRITE)) {
-        LOAD_GLES(glBufferSubData);
-        LOAD_GLES(glBindBuffer);
-        bindBuffer(buff->type, buff->real_buffer);
-        gles_glBufferSubData(buff->type, 0, buff->size, buff->data);
-    }
-    if(buff->real_buffer && (buff->type==GL_ARRAY_BUFFER || buff->type==GL_ELEMENT_ARRAY_BUFFER) && buff->mapped && buff->ranged && (buff->access&GL_MAP_WRITE_BIT_EXT) && !(buff->access&GL_MAP_FLUSH_EXPLICIT_BIT_EXT)) {
-        LOAD_GLES(glBufferSubData);
-        LOAD_GLES(glBindBuffer);
-        bindBuffer(buff->type, buff->real_buffer);
-        gles_glBufferSubData(buff->type, buff->offset, buff->length, (void*)((uintptr_t)buff->data+buff->offset));
-    }
+    if(buff->native_map)
+        buffer_unmap_native(buff);
+    else
+        buffer_unmap_upload(buff);
 	if (buff->mapped) {
 		buff->mapped = 0;
         buff->ranged = 0;
@@ -566,6 +868,8 @@ void APIENTRY_GL4ES gl4es_glGetBufferSubData(GLenum target, GLintptr offset, GLs
 	if (buff==NULL)
 		return;		// Should generate an error!
 	// TODO, check parameter consistancie
+    buffer_sync(buff);
+    buffer_mirror(buff);
     memcpy(data, (char*)buff->data+offset, size);
 	noerrorShim();
 }
@@ -576,6 +880,8 @@ void APIENTRY_GL4ES gl4es_glGetNamedBufferSubData(GLuint buffer, GLintptr offset
 	if (buff==NULL)
 		return;		// Should generate an error!
 	// TODO, check parameter consistancie
+    buffer_sync(buff);
+    buffer_mirror(buff);
     memcpy(data, (char*)buff->data+offset, size);
 	noerrorShim();
 }
@@ -596,7 +902,7 @@ void APIENTRY_GL4ES gl4es_glGetBufferPointerv(GLenum target, GLenum pname, GLvoi
 	if (!buff->mapped) {
 		params[0] = NULL;
 	} else {
-		params[0] = buff->data;
+		params[0] = (buff->native_map)?buff->native_map:buff->data;
 	}
 }
 void APIENTRY_GL4ES gl4es_glGetNamedBufferPointerv(GLuint buffer, GLenum pname, GLvoid ** params) {
@@ -611,7 +917,7 @@ void APIENTRY_GL4ES gl4es_glGetNamedBufferPointerv(GLuint buffer, GLenum pname,
 	if (!buff->mapped) {
 		params[0] = NULL;
 	} else {
-		params[0] = buff->data;
+		params[0] = (buff->native_map)?buff->native_map:buff->data;
 	}
 }
 
@@ -632,12 +938,19 @@ void* APIENTRY_GL4ES gl4es_glMapBufferRange(GLenum target, GLintptr offset, GLsi
         errorShim(GL_INVALID_OPERATION);
         return NULL;
     }
+    buffer_sync(buff);
 	buff->access = access;
 	buff->mapped = 1;
     buff->ranged = 1;
     buff->offset = offset;
     buff->length = length;
 	noerrorShim();
+    if(buff->nomirror) {
+        void* ret = buffer_map_native(buff, offset, length, access);
+        if(ret)
+            return ret;
+        buffer_mirror(buff);    // fallback to the CPU copy
+    }
     uintptr_t ret = (uintptr_t)buff->data;
     ret += offset;
 	return (void*)ret;
@@ -663,10 +976,16 @@ void APIENTRY_GL4ES gl4es_glFlushMappedBufferRange(GLenum target, GLintptr offse
         return;
     }
 
+    if(buff->native_map) {
+        LOAD_GLES2(glFlushMappedBufferRange);
+        bindBuffer(GL_ARRAY_BUFFER, buff->real_buffer);
+        gles_glFlushMappedBufferRange(GL_ARRAY_BUFFER, offset, length);
+    } else
     if(buff->real_buffer && (buff->type==GL_ARRAY_BUFFER || buff->type==GL_ELEMENT_ARRAY_BUFFER) && (buff->access&GL_MAP_WRITE_BIT_EXT)) {
-        LOAD_GLES(glBufferSubData);
-        bindBuffer(buff->type, buff->real_buffer);
-        gles_glBufferSubData(buff->type, buff->offset+offset, length, (void*)((uintptr_t)buff->data+buff->offset+offset));
+        // flushed ranges are collected and sent on unmap, unless the mapping stays alive while drawing
+        dirty_add(buff, buff->offset+offset, buff->offset+offset+length);
+        if(buff->access&GL_MAP_PERSISTENT_BIT)
+            dirty_upload(buff);
     }
 }
 
@@ -684,9 +1003,13 @@ void APIENTRY_GL4ES gl4es_glCopyBufferSubData(GLenum readTarget, GLenum writeTar
         errorShim(GL_INVALID_OPERATION);
         return;
     }
+    buffer_sync(readbuff);
+    buffer_sync(writebuff);
+    buffer_mirror(readbuff);
+    buffer_mirror(writebuff);
     // TODO: check memory overlap and overread/overwrite
     memcpy((char*)writebuff->data+writeOffset, (char*)readbuff->data+readOffset, size);
-    if(writebuff->real_buffer && (writebuff->type==GL_ARRAY_BUFFER || writebuff->type==GL_ELEMENT_ARRAY_BUFFER) && writebuff->mapped && (writebuff->access==GL_WRITE_ONLY || writebuff->access==GL_READ_WRITE)) {
+    if(writebuff->real_buffer && (writebuff->type==GL_ARRAY_BUFFER || writebuff->type==GL_ELEMENT_ARRAY_BUFFER) && ((writebuff->mapped && (writebuff->access==GL_WRITE_ONLY || writebuff->access==GL_READ_WRITE)) || writebuff->nomirror)) {
         LOAD_GLES(glBufferSubData);
         bindBuffer(writebuff->type, writebuff->real_buffer);
         gles_glBufferSubData(writebuff->type, writeOffset, size, (char*)writebuff->data+writeOffset);
@@ -725,6 +1048,22 @@ GLuint wantBufferIndex(GLuint buffer)
     return ret;
 }
 
+void bindVertexArray(glvao_t *vao)
+{
+    if(!vao->real_vao)
+        vao = glstate->defaultvao;
+    glvao_t *old = (glstate->native_vao)?glstate->native_vao:glstate->defaultvao;
+    if(old == vao)
+        return;
+    LOAD_GLES2(glBindVertexArray);
+    // the element buffer binding is part of the VAO
+    old->hard_index = glstate->bind_buffer.index;
+    gles_glBindVertexArray(vao->real_vao);
+    DBG(printf("Bind native VAO %u\n", vao->real_vao);)
+    glstate->native_vao = (vao->real_vao)?vao:NULL;
+    glstate->bind_buffer.index = vao->hard_index;
+    glstate->bind_buffer.used = (glstate->bind_buffer.index && glstate->bind_buffer.array)?1:0;
+}
 void realize_bufferIndex()
 {
     LOAD_GLES(glBindBuffer);
@@ -741,6 +1080,17 @@ void deleteSingleBuffer(GLuint buffer) {
    if(glstate->bind_buffer.index == buffer) glstate->bind_buffer.index = 0;
    else if(glstate->bind_buffer.want_index == buffer) glstate->bind_buffer.want_index = 0;
    else if(glstate->bind_buffer.array == buffer) glstate->bind_buffer.array = 0;
+   // native VAO not binded keep the deleted buffer, and the name can be reused: force a new setup
+   glvao_t *vao;
+   kh_foreach_value(glstate->vaos, vao,
+       if(vao->real_vao) {
+           for(int i=0; i<hardext.maxvattrib; ++i)
+               if(vao->hard[i].real_buffer == buffer)
+                   memset(&vao->hard[i], 0, sizeof(vertexattrib_t));
+           if(vao->hard_index == buffer && vao != glstate->native_vao)
+               vao->hard_index = (GLuint)-1;
+       }
+   );
    gles_glDeleteBuffers(1, &buffer);
 }
 
@@ -881,6 +1231,12 @@ void APIENTRY_GL4ES gl4es_glDeleteVertexArrays(GLsizei n, const GLuint *arrays)
                 if (k != kh_end(list)) {
                     glvao = kh_value(list, k);
                     VaoSharedClear(glvao);
+                    if(glvao->real_vao) {
+                        LOAD_GLES2(glDeleteVertexArrays);
+                        if(glstate->native_vao == glvao)
+                            bindVertexArray(glstate->defaultvao);
+                        gles_glDeleteVertexArrays(1, &glvao->real_vao);
+                    }
                     kh_del(glvao, list, k);
                     //free(glvao);  //let the use delete those
                 }
@@ -926,6 +1282,14 @@ void VaoSharedClear(glvao_t *vao) {
     vao->shared_arrays = NULL;
 }
 
+void VaoMirror(glvao_t *vao) {
+    if(!globals4es.novbomirror)
+        return;
+    for (int i=0; i<hardext.maxvattrib; i++)
+        if(vao->vertexattrib[i].enabled)
+            buffer_mirror(vao->vertexattrib[i].buffer);
+}
+
 void VaoInit(glvao_t *vao) {
     memset(vao, 0, sizeof(glvao_t));
     for (int i=0; i<hardext.maxvattrib; i++) {
@@ -6,6 +6,20 @@
 #include "gles.h"
 
 // VBO *****************
+// glReadPixels to a pixel pack buffer, done in a real GLES3 PBO and copied back on demand
+typedef struct {
+    GLuint      pbo;
+    GLsizeiptr  pbo_size;
+    GLsync      fence;
+    int         pending;        // data is not up to date
+    GLintptr    offset;         // where the pixels go in data
+    GLsizeiptr  size;           // size of the read in the pbo
+    GLsizei     width, height;
+    GLenum      readf, readt;   // what has been read
+    GLenum      format, type;   // what the application wants
+    GLint       align;
+} readback_t;
+
 typedef struct {
     GLuint      buffer;
     GLuint      real_buffer;
@@ -18,6 +32,15 @@ typedef struct {
     GLintptr    offset;
     GLsizeiptr  length;
     GLvoid     *data;
+    int         nomirror;   // real VBO is the reference, data is only filled when the CPU needs it
+    int         stale;      // data doesn't hold the content of the real VBO
+    GLvoid     *native_map; // pointer from the GLES glMapBufferRange, when mapped directly
+    uint64_t   *blockhash;  // hash of each block of data, taken when mapped (to find what has been written)
+    int         nblockhash;
+    GLintptr   *dirty;      // sorted and coalesced [start, end[ ranges waiting to be uploaded
+    int         ndirty;
+    int         capdirty;
+    readback_t *readback;
 } glbuffer_t;
 
 KHASH_MAP_DECLARE_INT(buff, glbuffer_t *);
@@ -77,6 +100,20 @@ void unboundBuffers();
 GLuint wantBufferIndex(GLuint buffer);
 // Bind the wanted index buffer if needed
 void realize_bufferIndex();
+// start an async glReadPixels to a pack buffer, return 0 if not possible
+int buffer_readpixels(glbuffer_t *buff, GLint x, GLint y, GLsizei width, GLsizei height, GLenum readf, GLenum readt, GLenum format, GLenum type, GLintptr offset);
+// wait for the pending glReadPixels and put the result in data
+void buffer_readback(glbuffer_t *buff);
+static inline void buffer_sync(glbuffer_t *buff) {
+    if(buff && buff->readback && buff->readback->pending)
+        buffer_readback(buff);
+}
+// fill data with the content of the real VBO
+void buffer_fetch(glbuffer_t *buff);
+static inline void buffer_mirror(glbuffer_t *buff) {
+    if(buff && buff->stale)
+        buffer_fetch(buff);
+}
 
 
 // Pointer..... ****** => map them in vertexattrib (even with GLES1.1). So no more pointer_state_t, use vertexattrib_t
@@ -214,11 +251,18 @@ typedef struct {
     int cache_count;
     // Vertex Attrib
     vertexattrib_t  vertexattrib[MAX_VATTRIB];
-    // TODO: Cache VA also?
+    // native GLES3 VAO, used when all arrays are in real VBO
+    GLuint          real_vao;
+    vertexattrib_t  hard[MAX_VATTRIB];  // attributes as set in the native VAO
+    GLuint          hard_index;         // element buffer binded in the native VAO (or in the GLES default VAO for defaultvao)
 } glvao_t;
 
 void VaoSharedClear(glvao_t *vao);
 void VaoInit(glvao_t *vao);
+// make sure the CPU copy of all enabled arrays is up to date
+void VaoMirror(glvao_t *vao);
+// bind the native VAO of vao on the GLES side, or the GLES default one if it has none
+void bindVertexArray(glvao_t *vao);
 
 KHASH_MAP_DECLARE_INT(glvao, glvao_t*);
 
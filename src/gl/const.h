@@ -565,6 +565,7 @@
 #define GL_PIXEL_PACK_BUFFER_BINDING      0x88ED
 #define GL_CURRENT_VERTEX_ATTRIB          0x8626
 #define GL_MAP_PERSISTENT_BIT             0x00000040
+#define GL_MAP_COHERENT_BIT               0x00000080
 #define GL_QUERY_BUFFER_BINDING_AMD       0x9193
 #define GL_COPY_READ_BUFFER_BINDING       0x8F36
 #define GL_COPY_READ_BUFFER               GL_COPY_READ_BUFFER_BINDING
@@ -933,4 +934,13 @@
 #define GL_MIN                                          0x8007
 #define GL_MAX                                          0x8008
 
+// Sync
+#define GL_SYNC_GPU_COMMANDS_COMPLETE                   0x9117
+#define GL_SYNC_FLUSH_COMMANDS_BIT                      0x00000001
+#define GL_ALREADY_SIGNALED                             0x911A
+#define GL_TIMEOUT_EXPIRED                              0x911B
+#define GL_CONDITION_SATISFIED                          0x911C
+#define GL_WAIT_FAILED                                  0x911D
+#define GL_TIMEOUT_IGNORED                              0xFFFFFFFFFFFFFFFFull
+
 #endif // _GL4ES_CONST_H_
@@ -5,10 +5,12 @@
 #include "gl4es.h"
 #include "gles.h"
 #include "glstate.h"
+#include "hotarrays.h"
 #include "init.h"
 #include "list.h"
 #include "loader.h"
 #include "render.h"
+#include "wireframe.h"
 
 //#define DEBUG
 #ifdef DEBUG
@@ -72,6 +74,7 @@ renderlist_t *arrays_to_renderlist(renderlist_t *list, GLenum mode,
     list->mode_dimension = rendermode_dimensions(mode);
     list->len = count-skip;
     list->cap = count-skip;
+    list->pooled_arrays = 0;
 
     // check cache if any
     if(glstate->vao->shared_arrays)  {
@@ -93,6 +96,7 @@ renderlist_t *arrays_to_renderlist(renderlist_t *list, GLenum mode,
         list->shared_arrays = glstate->vao->shared_arrays;
         (*glstate->vao->shared_arrays)++;
     } else {
+        VaoMirror(glstate->vao);
         if(!globals4es.novaocache && glstate->vao != glstate->defaultvao) {
             // prepare a vao cache object
             list->shared_arrays = glstate->vao->shared_arrays = (int*)malloc(sizeof(int));
@@ -181,6 +185,7 @@ renderlist_t *arrays_to_renderlist(renderlist_t *list, GLenum mode,
 static renderlist_t *arrays_add_renderlist(renderlist_t *a, GLenum mode,
                                         GLsizei skip, GLsizei count, GLushort* indices, int ilen_b) {
     DBG(LOGD("arrays_add_renderlist(%p, %s, %d, %d, %p, %d)\n", a, PrintEnum(mode), skip, count, indices, ilen_b);)
+    VaoMirror(glstate->vao);
     // check cache if any
     if(glstate->vao->shared_arrays)  {
         if (!is_cache_compatible(count))
@@ -257,8 +262,6 @@ static inline bool should_intercept_render(GLenum mode) {
                 return true;
         }
     }
-    if(glstate->polygon_mode == GL_LINE && mode>=GL_TRIANGLES)
-        return true;
     if ((hardext.esversion==1) && ((glstate->vao->vertexattrib[ATT_SECONDARY].enabled) && (glstate->vao->vertexattrib[ATT_COLOR].enabled)))
         return true;
     if ((hardext.esversion==1) && (glstate->vao->vertexattrib[ATT_COLOR].enabled && (glstate->vao->vertexattrib[ATT_COLOR].size != 4)))
@@ -312,8 +315,12 @@ static void glDrawElementsCommon(GLenum mode, GLint first, GLsizei count, GLuint
 if(count>500000) return;
 #endif
     GLenum mode_init = mode;
-    /*if (glstate->polygon_mode == GL_LINE && mode>=GL_TRIANGLES)
-        mode = GL_LINE_LOOP;*/
+    // POLYGON mode as LINE draws the cached edges of the primitives
+    wireframe_t *wire = NULL;
+    if (glstate->polygon_mode == GL_LINE && mode>=GL_TRIANGLES && glstate->render_mode != GL_SELECT)
+        wire = wireframe_get(mode, first, count, sindices, iindices);
+    if (wire)
+        mode = GL_LINES;
     if (glstate->polygon_mode == GL_POINT && mode>=GL_TRIANGLES)
         mode = GL_POINTS;
 
@@ -337,7 +344,7 @@ if(count>500000) return;
                 tmp[j+5] = iindices[i+3];
             }
             iindices = tmp;
-        } else {
+        } else if (sindices) {
             gl4es_scratch(ilen*sizeof(GLushort));
             GLushort *tmp = (GLushort*)glstate->scratch;
             for (int i=0, j=0; i+3<count; i+=4, j+=6) {
@@ -350,12 +357,35 @@ if(count>500000) return;
                 tmp[j+5] = sindices[i+3];
             }
             sindices = tmp;
+        } else {
+            // glDrawArrays of quads left without wireframe edges (GL_SELECT or too many vertices)
+            GLuint last = first+count;
+            if(last>0x10000) {
+                gl4es_scratch(ilen*sizeof(GLuint));
+                GLuint *tmp = (GLuint*)glstate->scratch;
+                for (int i=0, j=0; i+3<count; i+=4, j+=6) {
+                    tmp[j+0] = first+i+0; tmp[j+1] = first+i+1; tmp[j+2] = first+i+2;
+                    tmp[j+3] = first+i+0; tmp[j+4] = first+i+2; tmp[j+5] = first+i+3;
+                }
+                iindices = tmp;
+            } else {
+                gl4es_scratch(ilen*sizeof(GLushort));
+                GLushort *tmp = (GLushort*)glstate->scratch;
+                for (int i=0, j=0; i+3<count; i+=4, j+=6) {
+                    tmp[j+0] = first+i+0; tmp[j+1] = first+i+1; tmp[j+2] = first+i+2;
+                    tmp[j+3] = first+i+0; tmp[j+4] = first+i+2; tmp[j+5] = first+i+3;
+                }
+                sindices = tmp;
+            }
+            first = 0;
+            len = last;
         }
         count = ilen;
     }
     // of course, GL_SELECT with shader will just not work if not using standard transformation method... Instance count is ignored also
     if (glstate->render_mode == GL_SELECT) {
-        // TODO handling uint indices
+        // vertices are read on the CPU, so unmirrored VBO need their data back
+        buffer_mirror(glstate->vao->vertexattrib[ATT_VERTEX].buffer);
         if(!sindices && !iindices)
             select_glDrawArrays(&glstate->vao->vertexattrib[ATT_VERTEX], mode, first, count);
         else
@@ -421,9 +451,23 @@ if(count>500000) return;
             else
                 ToBuffer(glstate->vao->first, glstate->vao->count);
         }
+        // unchanged client arrays drawn again and again can go in a VBO
+        unsigned hot = 0;
+        if(hardext.esversion>1 && globals4es.hotarrays && !glstate->vao->locked) {
+            if((sindices || iindices) && !len) len = len_indices(sindices, iindices, count);
+            hot = hotarrays_remap(first, count, len);
+        }
 
-        // POLYGON mode as LINE is "intercepted" and drawn using list
-        if(instancecount==1 || hardext.esversion==1) {
+        if(wire) {
+            // the edges are seen as the bound element buffer, so ES2 uses their real buffer
+            glbuffer_t *old_elements = glstate->vao->elements;
+            glstate->vao->elements = &wire->edges;
+            if(instancecount==1 || hardext.esversion==1)
+                gles_glDrawElements(GL_LINES, wire->ilen, wire->itype, wire->edges.data);
+            else
+                fpe_glDrawElementsInstanced(GL_LINES, wire->ilen, wire->itype, wire->edges.data, instancecount);
+            glstate->vao->elements = old_elements;
+        } else if(instancecount==1 || hardext.esversion==1) {
             if(!iindices && !sindices)
                 gles_glDrawArrays(mode, first, count);
             else
@@ -437,6 +481,8 @@ if(count>500000) return;
                 fpe_glDrawElementsInstanced(mode, count, t, tmp, instancecount);
             }
         }
+        if(hot)
+            hotarrays_restore(hot);
 
         for (int aa=0; aa<hardext.maxtex; aa++) {
             if (!IS_TEX2D(glstate->enable.texture[aa]) && (IS_ANYTEX(glstate->enable.texture[aa]))) {
@@ -732,7 +778,7 @@ void APIENTRY_GL4ES gl4es_glDrawArrays(GLenum mode, GLint first, GLsizei count)
         draw_renderlist(list);
         free_renderlist(list);
     } else {
-        if (mode==GL_QUADS) {
+        if (mode==GL_QUADS && glstate->polygon_mode!=GL_LINE) {
             // TODO: move those static in glstate
             static GLushort *indices = NULL;
             static int indcnt = 0;
@@ -842,7 +888,7 @@ void APIENTRY_GL4ES gl4es_glMultiDrawArrays(GLenum mode, const GLint *firsts, co
             else
                 list = arrays_to_renderlist(NULL, mode, first, count+first);
         } else {
-            if (mode==GL_QUADS) {
+            if (mode==GL_QUADS && glstate->polygon_mode!=GL_LINE) {
                 // TODO: move those static in glstate
                 static GLushort *indices = NULL;
                 static int indcnt = 0;
@@ -1381,7 +1427,7 @@ void APIENTRY_GL4ES gl4es_glDrawArraysInstanced(GLenum mode, GLint first, GLsize
         draw_renderlist(list);
         free_renderlist(list);
     } else {
-        if (mode==GL_QUADS) {
+        if (mode==GL_QUADS && glstate->polygon_mode!=GL_LINE) {
             // TODO: move those static in glstate
             static GLushort *indices = NULL;
             static int indcnt = 0;
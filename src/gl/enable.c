@@ -154,6 +154,7 @@ static void proxy_glEnable(GLenum cap, bool enable, void (APIENTRY_GLES *next)(G
         proxy_GOFPE(GL_LINE_SMOOTH, line_smooth, );
 
         proxy_GO(GL_POLYGON_OFFSET_FILL, polyfill_offset);
+        proxy_GO(GL_SCISSOR_TEST, scissor_test);
 
         // color logic op
         proxy_GOFPE(GL_COLOR_LOGIC_OP, color_logic_op, );
@@ -394,6 +395,7 @@ GLboolean APIENTRY_GL4ES gl4es_glIsEnabled(GLenum cap) {
         clientisenabled(GL_COLOR_ARRAY, vertexattrib[ATT_COLOR].enabled);
         clientisenabled(GL_TEXTURE_COORD_ARRAY, vertexattrib[ATT_MULTITEXCOORD0+glstate->texture.client].enabled);
         isenabled(GL_NORMALIZE, normalize);
+        isenabled(GL_SCISSOR_TEST, scissor_test);
         isenabled(GL_RESCALE_NORMAL, normal_rescale);
         isenabled(GL_MAP1_COLOR_4, map1_color4);
         isenabled(GL_MAP1_INDEX, map1_index);
@@ -3,6 +3,7 @@
 
 #include "eval.h"
 
+#include "../glx/hardext.h"
 #include "math/eval.h"
 #include "wrap/gl4es.h"
 #include "array.h"
@@ -198,6 +199,7 @@ void APIENTRY_GL4ES gl4es_glMapGrid1f(GLint un, GLfloat u1, GLfloat u2) {
    glstate->map_grid[0].n = un;
    glstate->map_grid[0]._1 = u1;
    glstate->map_grid[0]._2 = u2;
+   glstate->map_grid[0].d = (u2 - u1)/un;
 }
 
 void APIENTRY_GL4ES gl4es_glMapGrid2f(GLint un, GLfloat u1, GLfloat u2,
@@ -224,49 +226,349 @@ void APIENTRY_GL4ES gl4es_glMapGrid2f(GLint un, GLfloat u1, GLfloat u2,
     glstate->map_grid[1].d = (glstate->map_grid[1]._2 - glstate->map_grid[1]._1)/glstate->map_grid[1].n;
 }
 
-static inline GLenum eval_mesh_prep(GLenum mode) {
-    if ((!glstate->map2.vertex4) && (!glstate->map2.vertex3)) {
-        return 0;
+// glEvalMesh evaluates the whole grid at once, with the Bernstein basis of each row and column of
+// the grid computed only once, and draws it with a single glDrawElements. The meshes are kept, keyed
+// by the grid and the content of the maps, so a patch drawn again unchanged costs only the draw.
+
+#define EVAL_MAP(d, name) ((glstate->map##d.name && glstate->enable.map##d##_##name)?(map_statef_t *)glstate->map##d.name:NULL)
+
+enum { EVAL_VERT = 0, EVAL_NORMAL, EVAL_COLOR, EVAL_TEX, EVAL_LAST };
+
+typedef struct {
+    GLint   dims, mode, i1, i2, j1, j2, autonormal;
+    GLfloat u1, du, v1, dv;
+} eval_key_t;
+
+typedef struct {
+    GLint   attrib, width, uorder, vorder;
+    GLfloat u1, ud, v1, vd;
+} eval_key_map_t;
+
+static void eval_maps(int dims, map_statef_t **maps) {
+    #define GET(d)                                                          \
+        maps[EVAL_VERT] = EVAL_MAP(d, vertex4);                             \
+        if(!maps[EVAL_VERT]) maps[EVAL_VERT] = EVAL_MAP(d, vertex3);        \
+        maps[EVAL_NORMAL] = (glstate->enable.auto_normal)?NULL:EVAL_MAP(d, normal); \
+        maps[EVAL_COLOR] = EVAL_MAP(d, color4);                             \
+        maps[EVAL_TEX] = EVAL_MAP(d, texture4);                             \
+        if(!maps[EVAL_TEX]) maps[EVAL_TEX] = EVAL_MAP(d, texture3);         \
+        if(!maps[EVAL_TEX]) maps[EVAL_TEX] = EVAL_MAP(d, texture2);         \
+        if(!maps[EVAL_TEX]) maps[EVAL_TEX] = EVAL_MAP(d, texture1);
+    if(dims==1) {
+        GET(1)
+    } else {
+        GET(2)
     }
+    #undef GET
+}
 
-    switch (mode) {
-        case GL_POINT: return GL_POINTS;
-        case GL_LINE: return GL_LINE_STRIP;
-        case GL_FILL: return GL_TRIANGLE_STRIP;
-        case 0: return 1;
-        default:
-            LOGE("unknown glEvalMesh mode: %x\n", mode);
-            return 0;
+// size of the key, and write it if key is not NULL
+static int eval_key(int dims, GLenum mode, GLint i1, GLint i2, GLint j1, GLint j2, map_statef_t **maps, int autonormal, char *key) {
+    int size = sizeof(eval_key_t);
+    if(key) {
+        eval_key_t k;
+        memset(&k, 0, sizeof(k));
+        k.dims = dims; k.mode = mode; k.autonormal = autonormal;
+        k.i1 = i1; k.i2 = i2; k.j1 = j1; k.j2 = j2;
+        k.u1 = glstate->map_grid[0]._1; k.du = glstate->map_grid[0].d;
+        if(dims==2) {
+            k.v1 = glstate->map_grid[1]._1; k.dv = glstate->map_grid[1].d;
+        }
+        memcpy(key, &k, sizeof(k));
     }
+    for (int a=0; a<EVAL_LAST; ++a) {
+        map_statef_t *map = maps[a];
+        if(!map)
+            continue;
+        int vorder = (dims==2)?map->v.order:1;
+        int n = map->u.order*vorder*map->width;
+        if(key) {
+            eval_key_map_t k;
+            memset(&k, 0, sizeof(k));
+            k.attrib = a; k.width = map->width;
+            k.uorder = map->u.order; k.vorder = vorder;
+            k.u1 = map->u._1; k.ud = map->u.d;
+            if(dims==2) {
+                k.v1 = map->v._1; k.vd = map->v.d;
+            }
+            memcpy(key+size, &k, sizeof(k));
+            memcpy(key+size+sizeof(k), map->points, n*sizeof(GLfloat));
+        }
+        size += sizeof(eval_key_map_t) + n*sizeof(GLfloat);
+    }
+    return size;
 }
 
-void APIENTRY_GL4ES gl4es_glEvalMesh1(GLenum mode, GLint i1, GLint i2) {
-    GLenum renderMode = eval_mesh_prep(mode);
-    if (! renderMode) {
-        errorShim(GL_INVALID_ENUM);
+// Bernstein polynomials of degree order-1 at t, and their derivative if db is not NULL
+static void eval_basis(GLfloat *b, GLfloat *db, GLfloat t, int order) {
+    GLfloat tp[MAX_EVAL_ORDER], sp[MAX_EVAL_ORDER];
+    int n = order-1;
+    GLfloat s = 1.0f - t;
+    tp[0] = sp[0] = 1.0f;
+    for (int k=1; k<order; ++k) {
+        tp[k] = tp[k-1]*t;
+        sp[k] = sp[k-1]*s;
+    }
+    GLfloat c = 1.0f;
+    for (int k=0; k<order; ++k) {
+        b[k] = c*tp[k]*sp[n-k];
+        c = c*(n-k)/(k+1);
+    }
+    if(!db)
         return;
+    // B'(n,k) = n*(B(n-1,k-1) - B(n-1,k))
+    GLfloat l[MAX_EVAL_ORDER];
+    c = 1.0f;
+    for (int k=0; k<n; ++k) {
+        l[k] = c*tp[k]*sp[n-1-k];
+        c = c*(n-1-k)/(k+1);
     }
-    
-    noerrorShim();
-    GLfloat u, du, u1;
-    du = glstate->map_grid[0].d;
-    u1 = glstate->map_grid[0]._1 + du*i1;
-    GLint i;
-    gl4es_glBegin(renderMode);
-    for (u = u1, i = i1; i <= i2; i++, u += du) {
-        gl4es_glEvalCoord1f(u);
+    for (int k=0; k<order; ++k)
+        db[k] = n*(((k>0)?l[k-1]:0.0f) - ((k<n)?l[k]:0.0f));
+}
+
+static void eval_tables(const mapcoordf_t *c, const map_grid_t *grid, GLint first, int n, GLfloat *b, GLfloat *db) {
+    for (int i=0; i<n; ++i) {
+        GLfloat t = (grid->_1 + grid->d*(first+i) - c->_1) * c->d;
+        eval_basis(b+i*c->order, (db)?(db+i*c->order):NULL, t, c->order);
     }
-    gl4es_glEnd();
 }
 
-void APIENTRY_GL4ES gl4es_glEvalMesh2(GLenum mode, GLint i1, GLint i2, GLint j1, GLint j2) {
-    GLenum renderMode = eval_mesh_prep(mode);
-    if (! renderMode) {
+// missing components get the default (0,0,0,1)
+static void eval_store(GLfloat *out, const GLfloat *v, int width, int size) {
+    for (int c=0; c<size; ++c)
+        out[c] = (c<width)?v[c]:((c==3)?1.0f:0.0f);
+}
+
+static void eval_curve(const map_statef_t *map, GLint i1, int ni, GLfloat *out, int size) {
+    const int U = map->u.order, w = map->width;
+    const GLfloat *P = map->points;
+    GLfloat *bu = (GLfloat*)malloc(ni*U*sizeof(GLfloat));
+    eval_tables(&map->u, &glstate->map_grid[0], i1, ni, bu, NULL);
+    for (int i=0; i<ni; ++i) {
+        const GLfloat *bi = bu+i*U;
+        GLfloat p[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        for (int k=0; k<U; ++k)
+            for (int c=0; c<w; ++c)
+                p[c] += bi[k]*P[k*w+c];
+        eval_store(out+i*size, p, w, size);
+    }
+    free(bu);
+}
+
+// normal is not NULL for the vertex map with GL_AUTO_NORMAL
+static void eval_surface(const map_statef_t *map, GLint i1, int ni, GLint j1, int nj, GLfloat *out, int size, GLfloat *normal) {
+    const int U = map->u.order, V = map->v.order, w = map->width;
+    const GLfloat *P = map->points;
+    GLfloat *bu = (GLfloat*)malloc(((ni*U + nj*V)*(normal?2:1) + U*w*2)*sizeof(GLfloat));
+    GLfloat *bv = bu + ni*U;
+    GLfloat *q = bv + nj*V;     // control polygon of the iso-curve at v
+    GLfloat *dq = q + U*w;
+    GLfloat *dbu = (normal)?(dq + U*w):NULL;
+    GLfloat *dbv = (normal)?(dbu + ni*U):NULL;
+    eval_tables(&map->u, &glstate->map_grid[0], i1, ni, bu, dbu);
+    eval_tables(&map->v, &glstate->map_grid[1], j1, nj, bv, dbv);
+    for (int j=0; j<nj; ++j) {
+        const GLfloat *bj = bv+j*V;
+        const GLfloat *dbj = (normal)?(dbv+j*V):NULL;
+        for (int k=0; k<U; ++k)
+            for (int c=0; c<w; ++c) {
+                GLfloat a = 0.0f, da = 0.0f;
+                for (int l=0; l<V; ++l) {
+                    a += bj[l]*P[(k*V+l)*w+c];
+                    if(dbj) da += dbj[l]*P[(k*V+l)*w+c];
+                }
+                q[k*w+c] = a;
+                dq[k*w+c] = da;
+            }
+        for (int i=0; i<ni; ++i) {
+            const GLfloat *bi = bu+i*U;
+            GLfloat p[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            for (int k=0; k<U; ++k)
+                for (int c=0; c<w; ++c)
+                    p[c] += bi[k]*q[k*w+c];
+            eval_store(out+(j*ni+i)*size, p, w, size);
+            if(normal) {
+                const GLfloat *dbi = dbu+i*U;
+                GLfloat du[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+                GLfloat dv[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+                for (int k=0; k<U; ++k)
+                    for (int c=0; c<w; ++c) {
+                        du[c] += dbi[k]*q[k*w+c];
+                        dv[c] += bi[k]*dq[k*w+c];
+                    }
+                if(w==4) {
+                    for (int c=0; c<3; ++c) {
+                        du[c] = du[c]*p[3] - du[3]*p[c];
+                        dv[c] = dv[c]*p[3] - dv[3]*p[c];
+                    }
+                }
+                GLfloat *n = normal+(j*ni+i)*3;
+                cross3(du, dv, n);
+                vector_normalize(n);
+            }
+        }
+    }
+    free(bu);
+}
+
+static void eval_mesh_clear(eval_mesh_t *m) {
+    free(m->key);
+    free(m->vert);
+    free(m->normal);
+    free(m->color);
+    free(m->tex);
+    free(m->indices);
+    memset(m, 0, sizeof(eval_mesh_t));
+}
+
+void eval_cache_free(eval_cache_t *cache) {
+    if(!cache)
+        return;
+    for (int i=0; i<EVAL_CACHE; ++i)
+        eval_mesh_clear(&cache->meshes[i]);
+    free(cache);
+}
+
+static eval_mesh_t *eval_mesh(int dims, GLenum mode, GLint i1, GLint i2, GLint j1, GLint j2) {
+    map_statef_t *maps[EVAL_LAST];
+    eval_maps(dims, maps);
+    if(!maps[EVAL_VERT])
+        return NULL;
+    const int autonormal = (dims==2 && glstate->enable.auto_normal);
+    if(!glstate->eval_cache)
+        glstate->eval_cache = (eval_cache_t*)calloc(1, sizeof(eval_cache_t));
+    eval_cache_t *cache = glstate->eval_cache;
+    ++cache->tick;
+    int keysize = eval_key(dims, mode, i1, i2, j1, j2, maps, autonormal, NULL);
+    char *key = (char*)malloc(keysize);
+    eval_key(dims, mode, i1, i2, j1, j2, maps, autonormal, key);
+    // same mesh as before, or a free slot, or the least recently used one
+    eval_mesh_t *m = &cache->meshes[0];
+    for (int i=0; i<EVAL_CACHE; ++i) {
+        eval_mesh_t *e = &cache->meshes[i];
+        if(e->key && e->keysize==keysize && !memcmp(e->key, key, keysize)) {
+            free(key);
+            e->last = cache->tick;
+            return e;
+        }
+        if(m->key && (!e->key || e->last<m->last))
+            m = e;
+    }
+    eval_mesh_clear(m);
+    m->key = key;
+    m->keysize = keysize;
+    m->last = cache->tick;
+
+    const int ni = i2-i1+1;
+    const int nj = (dims==2)?(j2-j1+1):1;
+    m->count = ni*nj;
+    m->vert = (GLfloat*)malloc(m->count*4*sizeof(GLfloat));
+    if(autonormal || maps[EVAL_NORMAL])
+        m->normal = (GLfloat*)malloc(m->count*3*sizeof(GLfloat));
+    if(maps[EVAL_COLOR])
+        m->color = (GLfloat*)malloc(m->count*4*sizeof(GLfloat));
+    if(maps[EVAL_TEX])
+        m->tex = (GLfloat*)malloc(m->count*4*sizeof(GLfloat));
+    if(dims==1) {
+        eval_curve(maps[EVAL_VERT], i1, ni, m->vert, 4);
+        if(maps[EVAL_NORMAL]) eval_curve(maps[EVAL_NORMAL], i1, ni, m->normal, 3);
+        if(maps[EVAL_COLOR]) eval_curve(maps[EVAL_COLOR], i1, ni, m->color, 4);
+        if(maps[EVAL_TEX]) eval_curve(maps[EVAL_TEX], i1, ni, m->tex, 4);
+        m->mode = (mode==GL_POINT)?GL_POINTS:GL_LINE_STRIP;
+        return m;
+    }
+    eval_surface(maps[EVAL_VERT], i1, ni, j1, nj, m->vert, 4, (autonormal)?m->normal:NULL);
+    if(maps[EVAL_NORMAL]) eval_surface(maps[EVAL_NORMAL], i1, ni, j1, nj, m->normal, 3, NULL);
+    if(maps[EVAL_COLOR]) eval_surface(maps[EVAL_COLOR], i1, ni, j1, nj, m->color, 4, NULL);
+    if(maps[EVAL_TEX]) eval_surface(maps[EVAL_TEX], i1, ni, j1, nj, m->tex, 4, NULL);
+    if(mode==GL_POINT) {
+        m->mode = GL_POINTS;
+    } else if(mode==GL_LINE) {
+        m->mode = GL_LINES;
+        m->ilen = (nj*(ni-1) + ni*(nj-1))*2;
+        GLushort *ind = m->indices = (GLushort*)malloc(m->ilen*sizeof(GLushort));
+        for (int j=0; j<nj; ++j)
+            for (int i=0; i<ni-1; ++i) {
+                *ind++ = j*ni+i;
+                *ind++ = j*ni+i+1;
+            }
+        for (int i=0; i<ni; ++i)
+            for (int j=0; j<nj-1; ++j) {
+                *ind++ = j*ni+i;
+                *ind++ = (j+1)*ni+i;
+            }
+    } else {
+        // same winding as the triangle strips of the (u,v), (u,v+dv) pairs
+        m->mode = GL_TRIANGLES;
+        m->ilen = (ni-1)*(nj-1)*6;
+        GLushort *ind = m->indices = (GLushort*)malloc(m->ilen*sizeof(GLushort));
+        for (int j=0; j<nj-1; ++j)
+            for (int i=0; i<ni-1; ++i) {
+                GLushort a = j*ni+i;
+                GLushort b = a+ni;
+                *ind++ = a;   *ind++ = b; *ind++ = a+1;
+                *ind++ = a+1; *ind++ = b; *ind++ = b+1;
+            }
+    }
+    return m;
+}
+
+static void eval_pointer(int att, int size, const GLfloat *pointer) {
+    vertexattrib_t *v = &glstate->vao->vertexattrib[att];
+    memset(v, 0, sizeof(vertexattrib_t));
+    if(!pointer)
+        return;
+    v->size = size;
+    v->type = GL_FLOAT;
+    v->pointer = pointer;
+    v->enabled = 1;
+}
+
+// draw the mesh with its own client arrays, leaving the ones of the application untouched
+static void eval_draw(eval_mesh_t *m) {
+    vertexattrib_t saved[MAX_VATTRIB];
+    memcpy(saved, glstate->vao->vertexattrib, sizeof(saved));
+    glbuffer_t *vertex = glstate->vao->vertex;
+    glbuffer_t *elements = glstate->vao->elements;
+    int maxtex = glstate->vao->maxtex;
+    int locked = glstate->vao->locked;
+    glstate->vao->vertex = NULL;
+    glstate->vao->elements = NULL;
+    glstate->vao->locked = 0;
+    for (int i=0; i<MAX_VATTRIB; ++i)
+        glstate->vao->vertexattrib[i].enabled = 0;
+    eval_pointer(ATT_VERTEX, 4, m->vert);
+    eval_pointer(ATT_NORMAL, 3, m->normal);
+    eval_pointer(ATT_COLOR, 4, m->color);
+    eval_pointer(ATT_MULTITEXCOORD0, 4, m->tex);
+    glstate->vao->maxtex = (m->tex)?1:0;
+    if(m->indices)
+        gl4es_glDrawElements(m->mode, m->ilen, GL_UNSIGNED_SHORT, m->indices);
+    else
+        gl4es_glDrawArrays(m->mode, 0, m->count);
+    memcpy(glstate->vao->vertexattrib, saved, sizeof(saved));
+    glstate->vao->vertex = vertex;
+    glstate->vao->elements = elements;
+    glstate->vao->maxtex = maxtex;
+    glstate->vao->locked = locked;
+}
+
+void APIENTRY_GL4ES gl4es_glEvalMesh1(GLenum mode, GLint i1, GLint i2) {
+    if (mode!=GL_POINT && mode!=GL_LINE) {
         errorShim(GL_INVALID_ENUM);
         return;
     }
-    
     noerrorShim();
+    if (i2<i1)
+        return;
+    eval_mesh_t *m = eval_mesh(1, mode, i1, i2, 0, 0);
+    if (m)
+        eval_draw(m);
+}
+
+// row by row, for grids too big for 16bits indices
+static void eval_mesh2_immediate(GLenum mode, GLint i1, GLint i2, GLint j1, GLint j2) {
     GLfloat u, du, u1, v, dv, v1;
     du = glstate->map_grid[0].d;
     dv = glstate->map_grid[1].d;
@@ -275,7 +577,7 @@ void APIENTRY_GL4ES gl4es_glEvalMesh2(GLenum mode, GLint i1, GLint i2, GLint j1,
     GLint i, j;
     if(mode==GL_FILL) {
         for (v = v1, j = j1; j <= j2-1; j++, v += dv) {
-            gl4es_glBegin(renderMode);
+            gl4es_glBegin(GL_TRIANGLE_STRIP);
             for (u = u1, i = i1; i <= i2; i++, u += du) {
                 gl4es_glEvalCoord2f(u, v);
                 gl4es_glEvalCoord2f(u, v + dv);
@@ -284,24 +586,39 @@ void APIENTRY_GL4ES gl4es_glEvalMesh2(GLenum mode, GLint i1, GLint i2, GLint j1,
         }
     } else {
         for (v = v1, j = j1; j <= j2; j++, v += dv) {
-            gl4es_glBegin(renderMode);
+            gl4es_glBegin(GL_LINE_STRIP);
             for (u = u1, i = i1; i <= i2; i++, u += du) {
                 gl4es_glEvalCoord2f(u, v);
             }
             gl4es_glEnd();
         }
-        if (mode == GL_LINE) {
-            gl4es_glBegin(renderMode);
-            for (u = u1, i = i1; i <= i2; i++, u += du) {
-                for (v = v1, j = j1; j <= j2; j++, v += dv) {
-                    gl4es_glEvalCoord2f(u, v);
-                }
+        for (u = u1, i = i1; i <= i2; i++, u += du) {
+            gl4es_glBegin(GL_LINE_STRIP);
+            for (v = v1, j = j1; j <= j2; j++, v += dv) {
+                gl4es_glEvalCoord2f(u, v);
             }
             gl4es_glEnd();
         }
     }
 }
 
+void APIENTRY_GL4ES gl4es_glEvalMesh2(GLenum mode, GLint i1, GLint i2, GLint j1, GLint j2) {
+    if (mode!=GL_POINT && mode!=GL_LINE && mode!=GL_FILL) {
+        errorShim(GL_INVALID_ENUM);
+        return;
+    }
+    noerrorShim();
+    if (i2<i1 || j2<j1)
+        return;
+    if (mode!=GL_POINT && (i2-i1+1)*(j2-j1+1)>65536) {
+        eval_mesh2_immediate(mode, i1, i2, j1, j2);
+        return;
+    }
+    eval_mesh_t *m = eval_mesh(2, mode, i1, i2, j1, j2);
+    if (m)
+        eval_draw(m);
+}
+
 void APIENTRY_GL4ES gl4es_glEvalPoint1(GLint i) {
     gl4es_glEvalCoord1f(glstate->map_grid[0]._1 + glstate->map_grid[0].d*i);
 }
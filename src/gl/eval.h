@@ -60,6 +60,29 @@ typedef struct {
     GLint n;
 } map_grid_t;
 
+#define EVAL_CACHE  8       // meshes kept by glEvalMesh
+
+typedef struct {
+    void        *key;       // grid, mode and content of the maps used (NULL if slot is free)
+    int         keysize;
+    unsigned    last;       // tick of the last use
+    GLenum      mode;       // primitive to draw
+    GLsizei     count;      // vertices
+    GLfloat     *vert;      // 4 components
+    GLfloat     *normal;    // 3 components, NULL if not evaluated, same for color and tex
+    GLfloat     *color;
+    GLfloat     *tex;
+    GLushort    *indices;   // NULL to draw the vertices in order
+    GLsizei     ilen;
+} eval_mesh_t;
+
+typedef struct {
+    eval_mesh_t meshes[EVAL_CACHE];
+    unsigned    tick;
+} eval_cache_t;
+
+void eval_cache_free(eval_cache_t *cache);
+
 static const GLsizei get_map_width(GLenum target) {
     switch (target) {
         case GL_MAP1_COLOR_4:         return 4;
@@ -3,6 +3,7 @@
 #include "debug.h"
 #include "enum_info.h"
 #include "fpe_shader.h"
+#include "framebuffers.h"
 #include "glcase.h"
 #include "init.h"
 #include "loader.h"
@@ -10,6 +11,7 @@
 #include "matvec.h"
 #include "program.h"
 #include "shaderconv.h"
+#include "trace.h"
 
 #include "fpe.h"
 
@@ -139,6 +141,8 @@ void APIENTRY_GL4ES fpe_ReleventState_DefaultVertex(fpe_state_t *dest, fpe_state
         dest->pointsprite_upper = 0;
         dest->pointsprite_coord = 0;
     }
+    dest->linestipple = 0;
+    dest->linestipple_tmu = 0;
     if(!dest->blend_enable) {
         dest->blendsrcrgb = 0;
         dest->blenddstrgb = 0;
@@ -244,6 +248,10 @@ void APIENTRY_GL4ES fpe_ReleventState(fpe_state_t *dest, fpe_state_t *src, int f
         dest->pointsprite_upper = 0;
         dest->pointsprite_coord = 0;
     }
+    if(!fixed)
+        dest->linestipple = 0;
+    if(!dest->linestipple)
+        dest->linestipple_tmu = 0;
     // ARB_vertex_program and ARB_fragment_program
     if(!fixed || !dest->vertex_prg_enable)
         dest->vertex_prg_id = 0;
@@ -384,6 +392,7 @@ void APIENTRY_GL4ES fpe_program(int ispoint) {
         glstate->fpe = fpe_GetCache(glstate->fpe_cache, &state, 1);
     }   
     if(glstate->fpe->glprogram==NULL) {
+        TRACE_BEGIN(fpe_program);
         glstate->fpe->prog = gl4es_glCreateProgram();
         DBG(int from_psa = 1;)
         if(fpe_GetProgramPSA(glstate->fpe->prog, &state)==0) {
@@ -446,6 +455,7 @@ void APIENTRY_GL4ES fpe_program(int ispoint) {
         }
         // all done
         DBG(printf("%s FPE shader : %d(%p)\n", from_psa?"Using Precomp":"Creating", glstate->fpe->prog, glstate->fpe->glprogram);)
+        TRACE_END(fpe_program);
     }
 }
 
@@ -848,6 +858,7 @@ void APIENTRY_GL4ES fpe_glDrawArraysInstanced(GLenum mode, GLint first, GLsizei
         {
             vertexattrib_t *w = &glstate->vao->vertexattrib[i];
             if(w->divisor && w->enabled) {
+                buffer_mirror(w->buffer);
                 char* current = (char*)((uintptr_t)w->pointer + ((w->buffer)?(uintptr_t)w->buffer->data:0));
                 int stride=w->stride;
                 if(!stride) stride=gl_sizeof(w->type)*w->size;
@@ -909,6 +920,7 @@ void APIENTRY_GL4ES fpe_glDrawElementsInstanced(GLenum mode, GLsizei count, GLen
         {
             vertexattrib_t *w = &glstate->vao->vertexattrib[i];
             if(w->divisor && w->enabled) {
+                buffer_mirror(w->buffer);
                 char* current = (char*)((uintptr_t)w->pointer + ((w->buffer)?(uintptr_t)w->buffer->data:0));
                 int stride=w->stride;
                 if(!stride) stride=gl_sizeof(w->type)*w->size;
@@ -1043,10 +1055,25 @@ int fpe_gettexture(int TMU) {
     return target;
 }
 
+// client side arrays or indices cannot be used with a non-default VAO on GLES3
+static int vao_can_be_native(glvao_t *vao, program_t *glprogram, GLenum type, const void* indices) {
+    if(type && !(vao->elements && vao->elements->real_buffer && indices>=vao->elements->data && indices<=((void*)((char*)vao->elements->data+vao->elements->size))))
+        return 0;
+    for(int i=0; i<hardext.maxvattrib; i++)
+        if(glprogram->va_size[i]) {
+            vertexattrib_t *w = &vao->vertexattrib[i];
+            if(w->enabled && !w->divisor && (!w->real_buffer || w->size==GL_BGRA || w->type==GL_DOUBLE))
+                return 0;
+        }
+    return 1;
+}
+
 void realize_glenv(int ispoint, int first, int count, GLenum type, const void* indices, scratch_t* scratch) {
     // the handling of GL_BGRA size of GL_DOUBLE using 1 scratch in not ideal, and a waste when dealing with Buffers
     // TODO: have the scratch buffer part of the VBO, and tag it dirty when buffer is changed (or always dirty for VBO 0)
     if(hardext.esversion==1) return;
+    TRACE_BEGIN(realize_glenv);
+    damageMainFBO(1);
     LOAD_GLES2(glEnableVertexAttribArray)
     LOAD_GLES2(glDisableVertexAttribArray);
     LOAD_GLES2(glVertexAttribPointer);
@@ -1386,6 +1413,16 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
         float alpharef = floorf(glstate->alpharef*255.f);
         GoUniformfv(glprogram, glprogram->fpe_alpharef, 1, 1, &alpharef);
     }
+    if(glprogram->fpe_linestipple!=-1)
+    {
+        // pixels to stipple counter scale, and the pattern as 2 bytes
+        GLfloat stipple[4];
+        stipple[0] = glstate->raster.viewport.width*0.5f/glstate->linestipple.factor;
+        stipple[1] = glstate->raster.viewport.height*0.5f/glstate->linestipple.factor;
+        stipple[2] = glstate->linestipple.pattern&0xff;
+        stipple[3] = glstate->linestipple.pattern>>8;
+        GoUniformfv(glprogram, glprogram->fpe_linestipple, 4, 1, stipple);
+    }
     if(glprogram->has_builtin_texsampler)
     {
         for (int i=0; i<hardext.maxtex; i++)
@@ -1431,11 +1468,23 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
         GO(Cube)
         #undef GO
     }
+    // use a native VAO if possible, so the attributes setup stays there
+    glvao_t *hardvao = glstate->defaultvao;
+    if(globals4es.nativevao && glstate->vao!=glstate->defaultvao && vao_can_be_native(glstate->vao, glprogram, type, indices)) {
+        if(!glstate->vao->real_vao) {
+            LOAD_GLES2(glGenVertexArrays);
+            gles_glGenVertexArrays(1, &glstate->vao->real_vao);
+            DBG(printf("Created native VAO %u for VAO %u\n", glstate->vao->real_vao, glstate->vao->array);)
+        }
+        hardvao = glstate->vao;
+    }
+    bindVertexArray(hardvao);
+    vertexattrib_t *hardva = (hardvao->real_vao)?hardvao->hard:glstate->gleshard->vertexattrib;
     // set VertexAttrib if needed
     for(int i=0; i<hardext.maxvattrib; i++) 
     if(glprogram->va_size[i])   // only check used VA...
     {
-        vertexattrib_t *v = &glstate->gleshard->vertexattrib[i];
+        vertexattrib_t *v = &hardva[i];
         vertexattrib_t *w = &glstate->vao->vertexattrib[i];
         int enabled = w->enabled;
         int dirty = 0;
@@ -1460,8 +1509,9 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
             if(dirty || v->size!=w->size || v->type!=w->type || v->normalized!=w->normalized 
                 || v->stride!=w->stride || v->buffer!=w->buffer || (w->real_buffer==0 && v->pointer!=ptr)
                 || v->real_buffer!=w->real_buffer || (w->real_buffer!=0 && v->real_pointer != w->real_pointer) 
-                || w->real_buffer!=glstate->bind_buffer.array) {
+                || (!hardvao->real_vao && w->real_buffer!=glstate->bind_buffer.array)) {
                 if((w->size==GL_BGRA || w->type==GL_DOUBLE) && scratch->size<8) { 
+                    buffer_mirror(w->buffer);
                     // need to adjust, so first need the min/max (a shame as I already must have that somewhere)
                     int imin, imax;
                     if(type==0) {
@@ -1522,6 +1572,7 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
             char* current = (char*)glstate->vavalue[i];
             GLfloat tmp[4] = {0.0f, 0.0f, 0.0f, 1.0f};
             if(w->divisor && w->enabled) {
+                buffer_mirror(w->buffer);
                 current = (char*)((uintptr_t)w->pointer + ((w->buffer)?(uintptr_t)w->buffer->data:0));
                 int stride=w->stride;
                 if(!stride) stride=gl_sizeof(w->type)*w->size;
@@ -1556,23 +1607,26 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
         }
     } else {
         // disable VAArray, to be on the safe side
-        vertexattrib_t *v = &glstate->gleshard->vertexattrib[i];
+        vertexattrib_t *v = &hardva[i];
         if(v->enabled) {
             v->enabled = 0;
             DBG(printf("VertexAttribArray[%d]:%s\n", i, "Disable");)
             gles_glDisableVertexAttribArray(i);
         }
     }
+    TRACE_END(realize_glenv);
 }
 
 void realize_blitenv(int alpha) {
     DBG(printf("realize_blitenv(%d)\n", alpha);)
+    damageMainFBO(1);
     LOAD_GLES2(glUseProgram);
     if(glstate->gleshard->program != ((alpha)?glstate->blit->program_alpha:glstate->blit->program)) {
         glstate->gleshard->program = ((alpha)?glstate->blit->program_alpha:glstate->blit->program);
         gles_glUseProgram(glstate->gleshard->program);
     }
     // set VertexAttrib if needed
+    bindVertexArray(glstate->defaultvao);
     unboundBuffers();
     for(int i=0; i<hardext.maxvattrib; i++) {
         vertexattrib_t *v = &glstate->gleshard->vertexattrib[i];
@@ -1673,6 +1727,7 @@ void builtin_Init(program_t *glprogram) {
     glprogram->builtin_blendcolor = -1;
     // fpe uniform
     glprogram->fpe_alpharef = -1;
+    glprogram->fpe_linestipple = -1;
     // initialise emulated builtin attrib to -1
     for (int i=0; i<ATT_MAX; i++)
         glprogram->builtin_attrib[i] = -1;
@@ -1721,6 +1776,7 @@ const char* texgenobj_fpe_code = "_gl4es_ObjectPlane%c_";
 const char* texgenobj_noa_code = "_gl4es_ObjectPlane%c";
 const char texgenCoords[4] = {'S', 'T', 'R', 'Q'};
 const char* alpharef_code = "_gl4es_AlphaRef";
+const char* linestipple_code = "_gl4es_LineStipple";
 const char* fpetexSampler_code = "_gl4es_TexSampler_";
 const char* fpetexenvRGBScale_code = "_gl4es_TexEnvRGBScale_";
 const char* fpetexenvAlphaScale_code = "_gl4es_TexEnvAlphaScale_";
@@ -1978,6 +2034,12 @@ int builtin_CheckUniform(program_t *glprogram, char* name, GLint id, int size) {
         glprogram->has_fpe = 1;
         return 1;
     }
+    // line stipple
+    if(strcmp(name, linestipple_code)==0) {
+        glprogram->fpe_linestipple = id;
+        glprogram->has_fpe = 1;
+        return 1;
+    }
     // texture sampler
     if(strncmp(name, fpetexSampler_code, strlen(fpetexSampler_code))==0) {
         // it a Texture Sampler! grab it's number
@@ -25,6 +25,9 @@
 #define FPE_FOG_DIST_PLANE      1
 #define FPE_FOG_DIST_RADIAL     2
 
+#define FPE_STIPPLE_ANCHOR  1   // texcoord is the first vertex of the segment, the counter is computed in the shader
+#define FPE_STIPPLE_DIST    2   // texcoord.x is the stipple counter
+
 #define FPE_TEX_OFF  0
 #define FPE_TEX_2D   1
 #define FPE_TEX_RECT 2
@@ -206,6 +209,8 @@ typedef struct fpe_state_s {
     unsigned int pointsprite:1;          // point sprite rendering
     unsigned int pointsprite_coord:1;    // point sprite coord replace
     unsigned int pointsprite_upper:1;    // if coord is upper left and not lower left
+    unsigned int linestipple:2;          // line stipple mode
+    unsigned int linestipple_tmu:4;      // TMU used for the line stipple texcoord
     unsigned int vertex_prg_enable:1;    // if vertex program is enabled
     unsigned int fragment_prg_enable:1;  // if fragment program is enabled
     unsigned int blend_enable:1;
@@ -174,6 +174,7 @@ const char* const* fpe_VertexShader(shaderconv_need_t* need, fpe_state_t *state)
     int color_material = state->color_material && lighting;
     int point = state->point;
     int pointsprite = state->pointsprite;
+    int linestipple = state->linestipple;
     int headers = 0;
     int planes = state->plane;
     char buff[1024];
@@ -187,6 +188,7 @@ const char* const* fpe_VertexShader(shaderconv_need_t* need, fpe_state_t *state)
     int texgens = 0;
     int texmats = 0;
     const char* fogp = hardext.highp?"highp":"mediump";
+    const char* stipplep = hardext.highp?"highp":"mediump";
 
     for (int i=0; i<hardext.maxtex; ++i) {
         if(state->texgen[i].texgen_s || state->texgen[i].texgen_t || state->texgen[i].texgen_r || state->texgen[i].texgen_q)
@@ -362,6 +364,16 @@ const char* const* fpe_VertexShader(shaderconv_need_t* need, fpe_state_t *state)
             }
         }
     }
+    if(linestipple) {
+        sprintf(buff, "varying %s vec2 _gl4es_LineStippleCoord;\n", stipplep);
+        ShadAppend(buff);
+        headers++;
+        if(linestipple==FPE_STIPPLE_ANCHOR) {
+            sprintf(buff, "uniform %s vec4 _gl4es_LineStipple;\n", stipplep);
+            ShadAppend(buff);
+            headers++;
+        }
+    }
     // let's start
     ShadAppend("\nvoid main() {\n");
     int need_normal = 0;
@@ -716,6 +728,16 @@ const char* const* fpe_VertexShader(shaderconv_need_t* need, fpe_state_t *state)
         sprintf(buff, "gl_PointSize = clamp(gl_Point.size*inversesqrt(gl_Point.distanceConstantAttenuation + ps_d*(gl_Point.distanceLinearAttenuation + ps_d*gl_Point.distanceQuadraticAttenuation)), gl_Point.sizeMin, gl_Point.sizeMax);\n");
         ShadAppend(buff);
     }
+    // line stipple, the counter must be linear in screen space, so it's multiplied by w here and by 1/w in the fragment shader
+    if(linestipple==FPE_STIPPLE_ANCHOR) {
+        sprintf(buff, "%s vec4 ls_a = gl_ModelViewProjectionMatrix * gl_MultiTexCoord%d;\n"
+                      "_gl4es_LineStippleCoord = (gl_Position.xy - ls_a.xy*(gl_Position.w/ls_a.w)) * _gl4es_LineStipple.xy;\n",
+                      stipplep, state->linestipple_tmu);
+        ShadAppend(buff);
+    } else if(linestipple==FPE_STIPPLE_DIST) {
+        sprintf(buff, "_gl4es_LineStippleCoord = vec2(gl_MultiTexCoord%d.x * gl_Position.w, 0.);\n", state->linestipple_tmu);
+        ShadAppend(buff);
+    }
     // insert normal, vertex and eye/obj planes if needed
     if(need_vertex) {
         buff[0] = '\0';
@@ -835,11 +857,13 @@ const char* const* fpe_FragmentShader(shaderconv_need_t* need, fpe_state_t *stat
     int pointsprite = state->pointsprite;
     int pointsprite_coord = state->pointsprite_coord;
     int pointsprite_upper = state->pointsprite_upper;
+    int linestipple = state->linestipple;
     int shaderblend = state->blend_enable;
     int texenv_combine = 0;
     int texturing = 0;
     char buff[1024];
     const char* fogp = hardext.highp?"highp":"mediump";
+    const char* stipplep = hardext.highp?"highp":"mediump";
 
 
     strcpy(shad, fpeshader_signature);
@@ -940,6 +964,11 @@ const char* const* fpe_FragmentShader(shaderconv_need_t* need, fpe_state_t *stat
         ShadAppend(gl4es_alphaRefSource);
         headers++;
     } 
+    if(linestipple) {
+        sprintf(buff, "varying %s vec2 _gl4es_LineStippleCoord;\nuniform %s vec4 _gl4es_LineStipple;\n", stipplep, stipplep);
+        ShadAppend(buff);
+        headers+=2;
+    }
 
     ShadAppend("void main() {\n");
 
@@ -958,6 +987,15 @@ const char* const* fpe_FragmentShader(shaderconv_need_t* need, fpe_state_t *stat
         ShadAppend(")<0.) discard;\n");
     }
 
+    //*** Line stipple: counter along the major axis, and test its bit in the pattern
+    if(linestipple) {
+        sprintf(buff, "%s vec2 ls_c = abs(_gl4es_LineStippleCoord*gl_FragCoord.w);\n"
+                      "%s float ls_b = mod(floor(max(ls_c.x, ls_c.y)), 16.);\n"
+                      "if(fract((((ls_b<8.)?_gl4es_LineStipple.z:_gl4es_LineStipple.w)+0.5)*exp2(-1.-mod(ls_b, 8.)))<0.5) discard;\n",
+                      stipplep, stipplep);
+        ShadAppend(buff);
+    }
+
     //*** initial color
     sprintf(buff, "vec4 fColor = %s;\n", twosided?"(gl_FrontFacing)?Color:BackColor":"Color");
     ShadAppend(buff);
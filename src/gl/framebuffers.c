@@ -8,6 +8,7 @@
 #include "glstate.h"
 #include "init.h"
 #include "loader.h"
+#include "trace.h"
 
 //#define DEBUG
 #ifdef DEBUG
@@ -562,6 +563,11 @@ void APIENTRY_GL4ES gl4es_glFramebufferTexture2D(GLenum target, GLenum attachmen
         DBG(printf("Attach Texture %d to FBO %d as Attachement %s\n", tex->glname, fb->id, PrintEnum(attachment));)
         tex->binded_fbo = fb->id;
         tex->binded_attachment = attachment;
+        // the GPU will render in it, so the CPU copy will not be up to date
+        if(tex->mirror && fb->id!=glstate->fbo.readback_fbo) {
+            texmirror_free(tex->mirror);
+            tex->mirror = NULL;
+        }
     }
 
     if ((old_attachment_type == textarget) && (old_attachment == (tex?tex->texture:texture)))
@@ -1102,6 +1108,11 @@ void APIENTRY_GL4ES gl4es_glGenerateMipmap(GLenum target) {
     if(globals4es.automipmap != 3) {
         gles_glGenerateMipmap(rtarget);
         bound->mipmap_auto = 1;
+        // the lazy mirror only has level 0, drop it so the new levels are read from the GPU
+        if(globals4es.texcopydata==2 && bound->mirror) {
+            texmirror_free(bound->mirror);
+            bound->mirror = NULL;
+        }
         /*if(bound->sampler.min_filer != bound->actual.min_filter)  // mainly for S3TC textures...
             gl4es_glTexParameteri(target, GL_TEXTURE_MIN_FILTER, bound->sampler.min_filer);*/
     }
@@ -1240,6 +1251,11 @@ void createMainFBO(int width, int height) {
         
     glstate->fbo.mainfbo_width = width;
     glstate->fbo.mainfbo_height = height;
+    // new content, forget about the previous frames
+    glstate->fbo.mainfbo_damage[0][0] = glstate->fbo.mainfbo_damage[0][1] = 0;
+    glstate->fbo.mainfbo_damage[0][2] = width;
+    glstate->fbo.mainfbo_damage[0][3] = height;
+    glstate->fbo.mainfbo_ndamage = 0;
     glstate->fbo.mainfbo_nwidth = width = hardext.npot>0?width:npot(width);
     glstate->fbo.mainfbo_nheight = height = hardext.npot>0?height:npot(height);
 
@@ -1307,6 +1323,10 @@ void createMainFBO(int width, int height) {
 void blitMainFBO(int x, int y, int width, int height) {
     if (glstate->fbo.mainfbo_fbo==0)
         return;
+    TRACE_BEGIN(blitMainFBO);
+    // the blit itself is not a damage of the main FBO
+    int damage[4];
+    memcpy(damage, glstate->fbo.mainfbo_damage[0], sizeof(damage));
 
     // blit the texture
     if(!width && !height) {
@@ -1334,6 +1354,125 @@ void blitMainFBO(int x, int y, int width, int height) {
         rx, ry,
         0, 0, x, y, BLIT_OPAQUE);
     gl4es_glViewport(vp[0], vp[1], vp[2], vp[3]);
+    memcpy(glstate->fbo.mainfbo_damage[0], damage, sizeof(damage));
+    TRACE_END(blitMainFBO);
+}
+
+static int rect_empty(const int *r) {
+    return (r[2]<=r[0] || r[3]<=r[1]);
+}
+
+static void rect_clip(int *r, int x0, int y0, int x1, int y1) {
+    if(r[0]<x0) r[0] = x0;
+    if(r[1]<y0) r[1] = y0;
+    if(r[2]>x1) r[2] = x1;
+    if(r[3]>y1) r[3] = y1;
+}
+
+static void rect_union(int *r, const int *a) {
+    if(rect_empty(a))
+        return;
+    if(rect_empty(r)) {
+        memcpy(r, a, 4*sizeof(int));
+        return;
+    }
+    if(a[0]<r[0]) r[0] = a[0];
+    if(a[1]<r[1]) r[1] = a[1];
+    if(a[2]>r[2]) r[2] = a[2];
+    if(a[3]>r[3]) r[3] = a[3];
+}
+
+// With LIBGL_FBODAMAGE, each draw or clear on the main FBO adds the viewport (for draws) and scissor box to the frame damage
+void damageMainFBO(int viewport) {
+    if(!globals4es.fbodamage || !glstate->fbo.mainfbo_fbo || glstate->fbo.current_fb->id!=0)
+        return;
+    int r[4] = {0, 0, glstate->fbo.mainfbo_width, glstate->fbo.mainfbo_height};
+    if(viewport) {
+        viewport_t *v = &glstate->raster.viewport;
+        rect_clip(r, v->x, v->y, v->x+v->width, v->y+v->height);
+    }
+    if(glstate->enable.scissor_test) {
+        viewport_t *s = &glstate->raster.scissor;
+        rect_clip(r, s->x, s->y, s->x+s->width, s->y+s->height);
+    }
+    rect_union(glstate->fbo.mainfbo_damage[0], r);
+}
+
+// x0, y0, x1, y1 rect to x, y, width, height on the window surface
+static void rect_region(const int *r, int ox, int oy, int *region) {
+    if(rect_empty(r)) {
+        memset(region, 0, 4*sizeof(int));
+        return;
+    }
+    region[0] = ox+r[0]; region[1] = oy+r[1];
+    region[2] = r[2]-r[0]; region[3] = r[3]-r[1];
+}
+
+// Get the part of the main FBO to present, the window back buffer being age frames old (0 if unknown).
+// buffer gets the part to blit and frame the part that changed since last frame (both can be empty).
+// Return 0 if nothing was drawn and the content of the back buffer is unknown: a full blit is needed then
+int damageMainFBORegion(int x, int y, int width, int height, int age, int *buffer, int *frame) {
+    fbo_t *fbo = &glstate->fbo;
+    int full[4] = {0, 0, fbo->mainfbo_width, fbo->mainfbo_height};
+    int pos[4] = {x, y, width, height};
+    if(memcmp(pos, fbo->mainfbo_present, sizeof(pos))) {
+        // the window moved or changed size, nothing from the previous frames can be kept
+        memcpy(fbo->mainfbo_present, pos, sizeof(pos));
+        memcpy(fbo->mainfbo_damage[0], full, sizeof(full));
+        fbo->mainfbo_ndamage = 0;
+    }
+    int *d = fbo->mainfbo_damage[0];
+    if(rect_empty(d) && age<1)
+        return 0;
+    if(width!=fbo->mainfbo_width || height!=fbo->mainfbo_height) {
+        // FBO is scaled to the window (or there is no window): everything is blitted
+        buffer[0] = frame[0] = x;
+        buffer[1] = frame[1] = height?(glstate->fboheight - (y+height)):0;
+        buffer[2] = frame[2] = width?width:fbo->mainfbo_width;
+        buffer[3] = frame[3] = height?height:fbo->mainfbo_height;
+    } else {
+        // the back buffer misses what was drawn since it was presented
+        int r[4];
+        memcpy(r, d, sizeof(r));
+        if(age<1 || age-1>fbo->mainfbo_ndamage)
+            memcpy(r, full, sizeof(r));
+        else
+            for (int i=1; i<age; ++i)
+                rect_union(r, fbo->mainfbo_damage[i]);
+        int oy = glstate->fboheight - (y+height);
+        rect_region(r, x, oy, buffer);
+        rect_region(d, x, oy, frame);
+    }
+    DBG(printf("damageMainFBO: age=%d, buffer=%d,%d %dx%d, frame=%d,%d %dx%d\n", age, buffer[0], buffer[1], buffer[2], buffer[3], frame[0], frame[1], frame[2], frame[3]);)
+    // current frame becomes the previous one
+    memmove(fbo->mainfbo_damage[1], fbo->mainfbo_damage[0], (MAX_DAMAGE_AGE-1)*sizeof(fbo->mainfbo_damage[0]));
+    memset(d, 0, sizeof(fbo->mainfbo_damage[0]));
+    if(fbo->mainfbo_ndamage<MAX_DAMAGE_AGE-1)
+        ++fbo->mainfbo_ndamage;
+    return 1;
+}
+
+// Blit only the region (x, y, width, height on the window surface) of the main FBO
+void blitMainFBORegion(int x, int y, int width, int height, const int *region) {
+    if (glstate->fbo.mainfbo_fbo==0 || !region[2] || !region[3])
+        return;
+    if(width!=glstate->fbo.mainfbo_width || height!=glstate->fbo.mainfbo_height) {
+        blitMainFBO(x, y, width, height);
+        return;
+    }
+    int damage[4];
+    memcpy(damage, glstate->fbo.mainfbo_damage[0], sizeof(damage));
+    GLint vp[4];
+    memcpy(vp, &glstate->raster.viewport, sizeof(vp));
+    gl4es_glViewport(0, 0, glstate->fbowidth, glstate->fboheight);
+    int oy = glstate->fboheight - (y+height);
+    gl4es_blitTexture(glstate->fbo.mainfbo_tex, region[0]-x, region[1]-oy,
+        region[2], region[3],
+        glstate->fbo.mainfbo_nwidth, glstate->fbo.mainfbo_nheight,
+        1.0f, 1.0f,
+        0, 0, region[0], region[1], BLIT_OPAQUE);
+    gl4es_glViewport(vp[0], vp[1], vp[2], vp[3]);
+    memcpy(glstate->fbo.mainfbo_damage[0], damage, sizeof(damage));
 }
 
 void bindMainFBO() {
@@ -1390,14 +1529,97 @@ void APIENTRY_GL4ES gl4es_glFramebufferTextureLayer(    GLenum target, GLenum at
 #ifndef NOX11
 void gl4es_SwapBuffers_currentContext();    // defined in glx/glx.c
 #endif
+
+// Use the driver blit when there is one. Return 0 if it cannot be used or failed, so the blit is emulated
+static int blit_native(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter) {
+    // reading and drawing the same buffers is an error on GLES3, even if the regions don't overlap
+    if(hardext.esversion<3 || glstate->fbo.fbo_read==glstate->fbo.fbo_draw)
+        return 0;
+    LOAD_GLES2(glBlitFramebuffer);
+    if(!gles_glBlitFramebuffer)
+        return 0;
+    LOAD_GLES2_OR_OES(glBindFramebuffer);
+    LOAD_GLES(glGetError);
+    // keep an error already pending for the application, so the one read after the blit is from the blit
+    GLenum pending = gles_glGetError();
+    if(pending!=GL_NO_ERROR)
+        errorShim(pending);
+    gles_glBindFramebuffer(GL_READ_FRAMEBUFFER, (glstate->fbo.fbo_read->id)?glstate->fbo.fbo_read->id:glstate->fbo.mainfbo_fbo);
+    gles_glBindFramebuffer(GL_DRAW_FRAMEBUFFER, (glstate->fbo.fbo_draw->id)?glstate->fbo.fbo_draw->id:glstate->fbo.mainfbo_fbo);
+    gles_glBlitFramebuffer(srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
+    GLenum err = gles_glGetError();
+    gles_glBindFramebuffer(GL_FRAMEBUFFER, (glstate->fbo.current_fb->id)?glstate->fbo.current_fb->id:glstate->fbo.mainfbo_fbo);
+    DBG(printf("   blit: native, err=%s\n", PrintEnum(err));)
+    if(err==GL_NO_ERROR && glstate->fbo.fbo_draw==glstate->fbo.current_fb)
+        damageMainFBO(0);
+    return (err==GL_NO_ERROR);
+}
+
+// Texture to copy the read FBO in, when it cannot be drawn from directly. Textures are kept by power of 2 size,
+// so post-processing chains don't create a new one each blit. Texture unit 0 must be active, the texture is left bound
+static GLuint blit_texture(int width, int height, GLenum filter) {
+    width = npot(width);
+    height = npot(height);
+    readbacktex_t *cache = glstate->fbo.blit_tex;
+    int idx = -1, lru = 0;
+    for (int i=0; i<MAX_BLIT_TEX && idx<0; ++i) {
+        if(cache[i].tex && cache[i].width==width && cache[i].height==height)
+            idx = i;
+        else if(cache[i].age < cache[lru].age)
+            lru = i;
+    }
+    if(idx<0) {
+        idx = lru;
+        if(!cache[idx].tex)
+            gl4es_glGenTextures(1, &cache[idx].tex);
+        gl4es_glBindTexture(GL_TEXTURE_2D, cache[idx].tex);
+        int oldshrink = globals4es.texshrink;   // the copy must be at full size
+        globals4es.texshrink = 0;
+        gl4es_glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        globals4es.texshrink = oldshrink;
+        gl4es_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        gl4es_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        cache[idx].width = width;
+        cache[idx].height = height;
+        DBG(printf("   blit: new temporary texture %u of %dx%d\n", cache[idx].tex, width, height);)
+    } else
+        gl4es_glBindTexture(GL_TEXTURE_2D, cache[idx].tex);
+    gl4es_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (filter==GL_LINEAR)?GL_LINEAR:GL_NEAREST);
+    gl4es_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, (filter==GL_LINEAR)?GL_LINEAR:GL_NEAREST);
+    cache[idx].age = ++glstate->fbo.blit_age;
+    return cache[idx].tex;
+}
+
+// is the blit covering the whole main framebuffer? Also get the size of the draw FBO
+static int blit_fullscreen(int width, int height, int *fbowidth, int *fboheight) {
+    *fbowidth = *fboheight = 0;
+    if(glstate->fbo.fbo_draw->id) {
+        *fbowidth  = glstate->fbo.fbo_draw->width;
+        *fboheight = glstate->fbo.fbo_draw->height;
+        return 0;
+    }
+    if(globals4es.blitfb0/* || (globals4es.usefb && !globals4es.usefbo)*/)
+        return 1;
+    *fbowidth = glstate->fbo.mainfbo_width;
+    *fboheight = glstate->fbo.mainfbo_height;
+    if((glstate->fbo.mainfbo_width==width) && (glstate->fbo.mainfbo_height==height))
+        return 1;
+    if (gl4es_getMainFBSize) {
+        gl4es_getMainFBSize(&glstate->fbo.mainfbo_width, &glstate->fbo.mainfbo_height);
+        if((glstate->fbo.mainfbo_width==width) && (glstate->fbo.mainfbo_height==height))
+            return 1;
+    }
+    return 0;
+}
+
 void APIENTRY_GL4ES gl4es_glBlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter) {
-    // mask will be ignored
+    // on GLES2, or if the driver refuses the blit, only the color is copied (with a textured quad)
     // filter will be taken only for ReadFBO has no Texture attached (so readpixel is used)
     DBG(printf("glBlitFramebuffer(%d, %d, %d, %d,  %d, %d, %d, %d,  0x%04X, %s) fbo_read=%d, fbo_draw=%d\n",
         srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, PrintEnum(filter), glstate->fbo.fbo_read->id, glstate->fbo.fbo_draw->id);)
 
-    if((mask&GL_COLOR_BUFFER_BIT)==0)
-        return; // cannot copy DEPTH or STENCIL data on GLES, only COLOR_BUFFER...
+    if((mask&(GL_COLOR_BUFFER_BIT|GL_DEPTH_BUFFER_BIT|GL_STENCIL_BUFFER_BIT))==0)
+        return;
 
     if(glstate->fbo.fbo_read == glstate->fbo.fbo_draw && srcX0==dstX0 && srcX1==dstX1 && srcY0==dstY0 && srcY1==dstY1)
         return; // no need to try copying on itself
@@ -1407,92 +1629,69 @@ void APIENTRY_GL4ES gl4es_glBlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX
     if(srcX1==srcX0 || srcY1==srcY0)
         return; // nothing to draw
 
-    GLuint texture = (glstate->fbo.fbo_read->id==0 && glstate->fbo.mainfbo_fbo)?glstate->fbo.mainfbo_tex:glstate->fbo.fbo_read->color[0];
-
-    int created = (texture==0 || (glstate->fbo.fbo_read==glstate->fbo.fbo_draw));
-    int oldtex = glstate->texture.active;
-    DBG(printf("   blit: created=%d, texture=%u, oldtex=%d\n", created, texture, oldtex);)
-    if (oldtex)
-        gl4es_glActiveTexture(GL_TEXTURE0);
-    float nwidth, nheight;
-    if (created) {
-        gltexture_t *old = glstate->texture.bound[ENABLED_TEX2D][0];
-        gl4es_glGenTextures(1, &texture);
-        gl4es_glBindTexture(GL_TEXTURE_2D, texture);
-        gl4es_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        gl4es_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        gl4es_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (filter==GL_LINEAR)?GL_LINEAR:GL_NEAREST);
-        gl4es_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, (filter==GL_LINEAR)?GL_LINEAR:GL_NEAREST);
-        gl4es_glCopyTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, srcX0, srcY0, srcX1-srcX0, srcY1-srcY0, 0);
-        srcX1-=srcX0; srcX0=0.f;
-        srcY1-=srcY0; srcY0=0.f;
-        gl4es_glBindTexture(GL_TEXTURE_2D, old->texture);
-    }
-    GLenum glname = texture;
-    if(texture==glstate->fbo.mainfbo_tex) {
-        nwidth = glstate->fbo.mainfbo_nwidth;
-        nheight = glstate->fbo.mainfbo_nheight;
-    } else {
-        gltexture_t *tex = gl4es_getTexture(GL_TEXTURE_2D, texture);
-        if(tex) {
-            nwidth = tex->nwidth;
-            nheight = tex->nheight;
-            glname = tex->glname;
-            if(!created) {
-                if((tex->actual.min_filter!=filter) || (tex->actual.mag_filter!=filter)) {
-                    gltexture_t *old = glstate->texture.bound[ENABLED_TEX2D][0];
-                    if(old->texture != glname)
-                        gl4es_glBindTexture(GL_TEXTURE_2D, glname);
-                    gl4es_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
-                    gl4es_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
-                    tex->actual.min_filter = tex->actual.mag_filter = filter;
-                    if(old->texture != glname)
-                        gl4es_glBindTexture(GL_TEXTURE_2D, old->texture);
-                }
-            }
-        } else {
-            // not good if here!
-            nwidth = srcX1;
-            nheight = srcY1;
+    int fbowidth, fboheight;
+    int blitfullscreen = blit_fullscreen(abs(dstX1-dstX0), abs(dstY1-dstY0), &fbowidth, &fboheight);
+
+    if(!blit_native(srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter)) {
+        if((mask&GL_COLOR_BUFFER_BIT)==0)
+            return; // cannot copy DEPTH or STENCIL data without the driver blit, only COLOR_BUFFER...
+
+        GLuint texture = (glstate->fbo.fbo_read->id==0 && glstate->fbo.mainfbo_fbo)?glstate->fbo.mainfbo_tex:glstate->fbo.fbo_read->color[0];
+
+        int created = (texture==0 || (glstate->fbo.fbo_read==glstate->fbo.fbo_draw));
+        int oldtex = glstate->texture.active;
+        DBG(printf("   blit: created=%d, texture=%u, oldtex=%d\n", created, texture, oldtex);)
+        if (oldtex)
+            gl4es_glActiveTexture(GL_TEXTURE0);
+        float nwidth, nheight;
+        if (created) {
+            gltexture_t *old = glstate->texture.bound[0][ENABLED_TEX2D];
+            texture = blit_texture(srcX1-srcX0, srcY1-srcY0, filter);
+            gl4es_glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, srcX0, srcY0, srcX1-srcX0, srcY1-srcY0);
+            srcX1-=srcX0; srcX0=0.f;
+            srcY1-=srcY0; srcY0=0.f;
+            gl4es_glBindTexture(GL_TEXTURE_2D, old->texture);
         }
-    }
-    float srcW = srcX1-srcX0;
-    float srcH = srcY1-srcY0;
-    float zoomx = ((float)(dstX1-dstX0))/srcW;
-    float zoomy = ((float)(dstY1-dstY0))/srcH;
-    // get the width / height of write FBO
-    int fbowidth = 0, fboheight = 0;
-    int blitfullscreen = 0;
-    if(glstate->fbo.fbo_draw->id==0/* && glstate->fbo.mainfbo_fbo*/) {
-        if(globals4es.blitfb0/* || (globals4es.usefb && !globals4es.usefbo)*/)
-            blitfullscreen = 1;
-        else {
-            fbowidth = glstate->fbo.mainfbo_width;
-            fboheight = glstate->fbo.mainfbo_height;
-            if((glstate->fbo.mainfbo_width==abs(dstX1-dstX0)) && (glstate->fbo.mainfbo_height==abs(dstY1-dstY0))) {
-                blitfullscreen = 1;
-            } else {
-                if (gl4es_getMainFBSize) {
-                    gl4es_getMainFBSize(&glstate->fbo.mainfbo_width, &glstate->fbo.mainfbo_height);
-                    if((glstate->fbo.mainfbo_width==abs(dstX1-dstX0)) && (glstate->fbo.mainfbo_height==abs(dstY1-dstY0)))
-                        blitfullscreen = 1;
+        GLenum glname = texture;
+        if(texture==glstate->fbo.mainfbo_tex) {
+            nwidth = glstate->fbo.mainfbo_nwidth;
+            nheight = glstate->fbo.mainfbo_nheight;
+        } else {
+            gltexture_t *tex = gl4es_getTexture(GL_TEXTURE_2D, texture);
+            if(tex) {
+                nwidth = tex->nwidth;
+                nheight = tex->nheight;
+                glname = tex->glname;
+                if(!created) {
+                    if((tex->actual.min_filter!=filter) || (tex->actual.mag_filter!=filter)) {
+                        gltexture_t *old = glstate->texture.bound[0][ENABLED_TEX2D];
+                        if(old->texture != glname)
+                            gl4es_glBindTexture(GL_TEXTURE_2D, glname);
+                        gl4es_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+                        gl4es_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+                        tex->actual.min_filter = tex->actual.mag_filter = filter;
+                        if(old->texture != glname)
+                            gl4es_glBindTexture(GL_TEXTURE_2D, old->texture);
+                    }
                 }
+            } else {
+                // not good if here!
+                nwidth = srcX1;
+                nheight = srcY1;
             }
         }
-    } else {
-        fbowidth  = glstate->fbo.fbo_draw->width;
-        fboheight = glstate->fbo.fbo_draw->height;
-    }
-    GLint vp[4];
-    memcpy(vp, &glstate->raster.viewport, sizeof(vp));
-    gl4es_glViewport(0, 0, fbowidth, fboheight);
-    gl4es_blitTexture(glname, srcX0, srcY0, srcW, srcH, nwidth, nheight, zoomx, zoomy, 0, 0, dstX0, dstY0, BLIT_OPAQUE);
-    gl4es_glViewport(vp[0], vp[1], vp[2], vp[3]);
-    if(created) {
-        gl4es_glDeleteTextures(1, &texture);
+        float srcW = srcX1-srcX0;
+        float srcH = srcY1-srcY0;
+        float zoomx = ((float)(dstX1-dstX0))/srcW;
+        float zoomy = ((float)(dstY1-dstY0))/srcH;
+        GLint vp[4];
+        memcpy(vp, &glstate->raster.viewport, sizeof(vp));
+        gl4es_glViewport(0, 0, fbowidth, fboheight);
+        gl4es_blitTexture(glname, srcX0, srcY0, srcW, srcH, nwidth, nheight, zoomx, zoomy, 0, 0, dstX0, dstY0, BLIT_OPAQUE);
+        gl4es_glViewport(vp[0], vp[1], vp[2], vp[3]);
+        if(oldtex)
+            gl4es_glActiveTexture(GL_TEXTURE0+oldtex);
     }
-    if(oldtex)
-        gl4es_glActiveTexture(GL_TEXTURE0+oldtex);
 
 #ifndef NOX11
     if(blitfullscreen)  // hack, force a swapbuffer (help wine d3d show stuff on certain games)
@@ -44,6 +44,10 @@ void APIENTRY_GL4ES gl4es_glColorMaskIndexed(GLuint framebuffer, GLboolean red,
 // In case of LIBGL_FB=2, let's create an FBO for everything, that is then blitted just before the SwapBuffer
 void createMainFBO(int width, int height);
 void blitMainFBO(int x, int y, int width, int height);
+// LIBGL_FBODAMAGE, only present what was drawn on the main FBO
+void damageMainFBO(int viewport);
+int damageMainFBORegion(int x, int y, int width, int height, int age, int *buffer, int *frame);
+void blitMainFBORegion(int x, int y, int width, int height, const int *region);
 void deleteMainFBO(void* state);
 void bindMainFBO();
 void unbindMainFBO();
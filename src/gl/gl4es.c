@@ -17,6 +17,7 @@
 #include "loader.h"
 #include "matrix.h"
 #include "buffers.h"
+#include "trace.h"
 #ifdef _WIN32
 #ifdef _WINBASE_
 #define GSM_CAST(c) ((LPFILETIME)c)
@@ -529,6 +530,7 @@ void APIENTRY_GL4ES gl4es_glArrayElement(GLint i) {
     vertexattrib_t *p;
     glvao_t* vao = glstate->vao;
     int stride, size;
+    VaoMirror(vao);
     p = &vao->vertexattrib[ATT_COLOR];
     if (p->enabled) {
         size = p->size; stride = p->stride;
@@ -881,11 +883,10 @@ void APIENTRY_GL4ES gl4es_glCallList(GLuint list) {
 }
 AliasExport(void,glCallList,,(GLuint list));
 
-void APIENTRY_GL4ES glPushCall(void *call) {
-    if (glstate->list.active) {
-		NewStage(glstate->list.active, STAGE_GLCALL);
-        rlPushCall(glstate->list.active, call);
-    }
+void* APIENTRY_GL4ES glAllocCall(int format, int size) {
+    // only called while compiling (see PUSH_IF_COMPILING)
+    NewStage(glstate->list.active, STAGE_GLCALL);
+    return rlAllocCall(glstate->list.active, format, size);
 }
 
 void APIENTRY_GL4ES gl4es_glCallLists(GLsizei n, GLenum type, const GLvoid *lists) {
@@ -1006,11 +1007,13 @@ void gl4es_flush() {
     // flush internal list
     renderlist_t *mylist = glstate->list.active?extend_renderlist(glstate->list.active):NULL;
     if (mylist) {
+        TRACE_BEGIN(gl4es_flush);
         glstate->list.active = NULL;
         glstate->list.pending = 0;
         mylist = end_renderlist(mylist);
         draw_renderlist(mylist);
         free_renderlist(mylist);
+        TRACE_END(gl4es_flush);
     }
     glstate->list.active = NULL;
 }
@@ -1144,6 +1147,8 @@ void APIENTRY_GL4ES gl4es_glClear(GLbitfield mask) {
     mask &= GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT;
     LOAD_GLES(glClear);
     gles_glClear(mask);
+    if(mask&GL_COLOR_BUFFER_BIT)
+        damageMainFBO(0);
 }
 AliasExport(void,glClear,,(GLbitfield mask));
 
@@ -159,6 +159,6 @@ void APIENTRY_GL4ES glVertex3f(GLfloat x, GLfloat y, GLfloat z);
 GLenum APIENTRY_GL4ES glGetError(void);
 
 // custom functions
-void APIENTRY_GL4ES glPushCall(void *call);
+void* APIENTRY_GL4ES glAllocCall(int format, int size);
 
 #endif // _GL4ES_GL4ES_H_
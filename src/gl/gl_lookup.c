@@ -1,4 +1,5 @@
 #include "attributes.h"
+#include "khash.h"
 #include "wrap/gl4es.h"
 #include "wrap/stub.h"
 #include "directstate.h"
@@ -34,8 +35,25 @@ void gl4es_Stub(void *x, ...) {
 void APIENTRY_GL4ES gl4es_Stub(void *x) {}
 #endif
 
-void* APIENTRY_GL4ES gl4es_GetProcAddress(const char *name) {
-    DBG(printf("glGetProcAddress(\"%s\")", name);)
+// All the names are put in a hash map the first time a function is looked up.
+// The list below is evaluated only once, so the hardext / globals4es conditions must be set by then.
+KHASH_MAP_INIT_STR(lookup, void*);
+static kh_lookup_t *lookup_map = NULL;
+
+static void lookup_add(const char *name, void *func) {
+    int ret;
+    khint_t k = kh_put(lookup, lookup_map, name, &ret);
+    if(ret) // first one wins, like the old strcmp chain
+        kh_value(lookup_map, k) = func;
+}
+
+#undef MAP
+#define MAP(func_name, func) lookup_add(func_name, (void *)func);
+#undef STUB
+#define STUB(func_name) lookup_add(#func_name, (void *)STUB_FCT);
+
+static void lookup_build() {
+    lookup_map = kh_init(lookup);
     // generated gles wrappers
     #include "glesfuncs.inc"
 
@@ -1054,6 +1072,19 @@ void* APIENTRY_GL4ES gl4es_GetProcAddress(const char *name) {
     // IPointer
     //_EX(glVertexAttribIPointer);
 
+}
+
+void* APIENTRY_GL4ES gl4es_GetProcAddress(const char *name) {
+    DBG(printf("glGetProcAddress(\"%s\")", name);)
+    if(!lookup_map)
+        lookup_build();
+    khint_t k = kh_get(lookup, lookup_map, name);
+    if(k != kh_end(lookup_map)) {
+        void *func = kh_value(lookup_map, k);
+        DBG(printf("%p\n", func);)
+        if(func == (void *)STUB_FCT && !globals4es.silentstub) LOGD("GL4ES stub: %s\n", name);
+        return func;
+    }
     DBG(printf("NULL\n");)
     if (!globals4es.silentstub) LOGD("GL4ES GetProcAddress: %s not found.\n", name);
     return NULL;
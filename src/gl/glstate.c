@@ -48,8 +48,7 @@ static void free_texture(gltexture_t *tex)
         return;
     if(tex->glname)
         gles_glDeleteTextures(1, &tex->glname);
-    if(tex->data)
-        free(tex->data);
+    texmirror_free(tex->mirror);
     // renderbuffer linked to this texture will be freed by the free_renderbuffer function.
     free(tex);
 }
@@ -544,6 +543,9 @@ void DeleteGLState(void* oldstate) {
     // scratch buffer
     if(state->scratch)
         free(state->scratch);
+    // select arena
+    if(state->selectbuf.arena)
+        free(state->selectbuf.arena);
     // merger buffers
     if(state->merger_master)
         free(state->merger_master);
@@ -577,6 +579,9 @@ void DeleteGLState(void* oldstate) {
         }
     }
     free(state->gleshard);  // Not shared!
+    free(state->hotarrays);
+    eval_cache_free(state->eval_cache);
+    wireframes_free(state->wireframes);
     // get extensions
     if(state->extensions)
         free(state->extensions);
@@ -4,11 +4,13 @@
 #include "oldprogram.h"
 #include "fog.h"
 #include "fpe.h"
+#include "hotarrays.h"
 #include "light.h"
 #include "pointsprite.h"
 #include "queries.h"
 #include "stack.h"
 #include "stencil.h"
+#include "wireframe.h"
 
 struct glstate_s {
     int                 dummy[16];  // dummy zone, test for memory overwriting...
@@ -42,6 +44,7 @@ struct glstate_s {
     glvao_t             *vao;
     glbuffer_t          *defaultvbo; 
     glvao_t             *defaultvao;
+    glvao_t             *native_vao;    // the glvao_t whose native VAO is binded (NULL for the GLES default VAO)
     GLfloat             vavalue[MAX_VATTRIB][4];    // the "static" value of a VA
     GLfloat             *vertex;                    // shortcut to actual vavalue...
     GLfloat             *color;
@@ -104,6 +107,9 @@ struct glstate_s {
     // scratch VBO
     GLuint              scratch_vertex;
     GLsizei             scratch_vertex_size;
+    hotarrays_t         *hotarrays;     // client arrays promoted to VBO
+    eval_cache_t        *eval_cache;    // meshes built by glEvalMesh
+    wireframes_t        *wireframes;    // edges of array draws with glPolygonMode(GL_LINE)
     GLuint              scratch_indices;
     GLsizei             scratch_indices_size;
     // Implementation read
@@ -0,0 +1,166 @@
+#include "hotarrays.h"
+
+#include "../glx/hardext.h"
+#include "buffers.h"
+#include "enum_info.h"
+#include "gl4es.h"
+#include "glstate.h"
+#include "init.h"
+#include "loader.h"
+
+//#define DEBUG
+#ifdef DEBUG
+#define DBG(a) a
+#else
+#define DBG(a)
+#endif
+
+// Some old engines send the same static geometry from client memory each frame. Those arrays
+// are recognized by their address, size and a checksum of the content, and after a few draws
+// without change, they are uploaded once in a VBO and drawn from there until they change again.
+
+#define HOT_SAMPLED_SIZE    4096    // with LIBGL_HOTARRAYS=2, bigger arrays are only sampled
+#define HOT_SAMPLES         256
+
+static uint64_t hot_mix(uint64_t h, uint64_t w) {
+    h ^= w * 0x87c37b91114253d5ULL;
+    return ((h<<31) | (h>>33)) * 0x4cf5ad432745937fULL;
+}
+
+static uint64_t hot_hash(const char* p, GLsizeiptr size) {
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ size;
+    uint64_t w;
+    if(globals4es.hotarrays==2 && size>HOT_SAMPLED_SIZE) {
+        // spread samples all over the array, plus the start and the end
+        GLsizeiptr step = (size-8)/HOT_SAMPLES;
+        for (int i=0; i<HOT_SAMPLES; ++i) {
+            memcpy(&w, p+i*step, 8);
+            h = hot_mix(h, w);
+        }
+        memcpy(&w, p+size-8, 8);
+        return hot_mix(h, w);
+    }
+    GLsizeiptr n = size/8;
+    for (GLsizeiptr i=0; i<n; ++i) {
+        memcpy(&w, p+i*8, 8);
+        h = hot_mix(h, w);
+    }
+    for (GLsizeiptr i=n*8; i<size; ++i)
+        h = hot_mix(h, (unsigned char)p[i]);
+    return h;
+}
+
+static void hot_drop(hotarray_t *e) {
+    if(e->real_buffer)
+        deleteSingleBuffer(e->real_buffer);
+    memset(e, 0, sizeof(hotarray_t));
+}
+
+// drop the VBO of arrays not drawn for a while
+static void hot_evict(hotarrays_t *hot) {
+    for (int i=0; i<HOT_MAX; ++i) {
+        hotarray_t *e = &hot->entries[i];
+        if(e->ptr && hot->tick-e->last>HOT_COLD) {
+            DBG(printf("Hot array %p (%zd bytes) is cold, dropping\n", (void*)e->ptr, e->size);)
+            hot_drop(e);
+        }
+    }
+}
+
+static hotarray_t* hot_lookup(hotarrays_t *hot, uintptr_t ptr, GLsizeiptr size) {
+    hotarray_t *e = NULL;
+    for (int i=0; i<HOT_MAX && !e; ++i)
+        if(hot->entries[i].ptr==ptr)
+            e = &hot->entries[i];
+    uint64_t hash = hot_hash((const char*)ptr, size);
+    if(!e) {
+        // take a free slot, or the least recently used one
+        e = &hot->entries[0];
+        for (int i=0; i<HOT_MAX && e->ptr; ++i)
+            if(!hot->entries[i].ptr || hot->entries[i].last<e->last)
+                e = &hot->entries[i];
+        if(e->ptr)
+            hot_drop(e);
+        e->ptr = ptr;
+        e->size = size;
+        e->hash = hash;
+    } else if(e->size!=size || e->hash!=hash) {
+        e->size = size;
+        e->hash = hash;
+        e->hits = 0;
+        e->uploaded = 0;
+    } else
+        ++e->hits;
+    e->last = hot->tick;
+    if(!e->uploaded && e->hits>=HOT_HITS) {
+        LOAD_GLES(glGenBuffers);
+        LOAD_GLES(glBufferData);
+        if(!e->real_buffer)
+            gles_glGenBuffers(1, &e->real_buffer);
+        bindBuffer(GL_ARRAY_BUFFER, e->real_buffer);
+        gles_glBufferData(GL_ARRAY_BUFFER, e->size, (void*)e->ptr, GL_STATIC_DRAW);
+        e->uploaded = 1;
+        DBG(printf("Hot array %p (%zd bytes) now in VBO %u\n", (void*)e->ptr, e->size, e->real_buffer);)
+    }
+    return (e->uploaded)?e:NULL;
+}
+
+static int is_client_array(vertexattrib_t *w) {
+    return w->enabled && w->pointer && !w->buffer && !w->real_buffer && !w->divisor
+        && w->size!=GL_BGRA && valid_vertex_type(w->type);
+}
+
+unsigned hotarrays_remap(GLint first, GLsizei count, GLuint len) {
+    if(!glstate->hotarrays)
+        glstate->hotarrays = (hotarrays_t*)calloc(1, sizeof(hotarrays_t));
+    hotarrays_t *hot = glstate->hotarrays;
+    if(!(++hot->tick & 255))
+        hot_evict(hot);
+    // vertex used are [0, end[, arrays always start at their pointer so they can be shared by draws on different range
+    GLuint end = (len)?len:(first+count);
+    if(!end)
+        return 0;
+    unsigned mask = 0;
+    unsigned done = 0;
+    for (int i=0; i<hardext.maxvattrib; ++i) {
+        vertexattrib_t *w = &glstate->vao->vertexattrib[i];
+        if((done&(1u<<i)) || !is_client_array(w))
+            continue;
+        // gather the interleaved arrays, so they go in the same VBO
+        int stride = (w->stride)?w->stride:(gl_sizeof(w->type)*w->size);
+        uintptr_t base = (uintptr_t)w->pointer;
+        uintptr_t last = base + (end-1)*stride + gl_sizeof(w->type)*w->size;
+        unsigned group = 1u<<i;
+        if(w->stride)
+        for (int j=i+1; j<hardext.maxvattrib; ++j) {
+            vertexattrib_t *v = &glstate->vao->vertexattrib[j];
+            uintptr_t p = (uintptr_t)v->pointer;
+            if(!(done&(1u<<j)) && is_client_array(v) && v->stride==stride && p+stride>(uintptr_t)w->pointer && p<(uintptr_t)w->pointer+stride) {
+                group |= 1u<<j;
+                if(p<base) base = p;
+                p += (end-1)*stride + gl_sizeof(v->type)*v->size;
+                if(p>last) last = p;
+            }
+        }
+        done |= group;
+        hotarray_t *e = hot_lookup(hot, base, last-base);
+        if(!e)
+            continue;
+        for (int j=i; j<hardext.maxvattrib; ++j)
+            if(group&(1u<<j)) {
+                vertexattrib_t *v = &glstate->vao->vertexattrib[j];
+                v->real_buffer = e->real_buffer;
+                v->real_pointer = (const GLvoid*)((uintptr_t)v->pointer - base);
+            }
+        mask |= group;
+    }
+    return mask;
+}
+
+void hotarrays_restore(unsigned mask) {
+    for (int i=0; mask; ++i, mask>>=1)
+        if(mask&1) {
+            glstate->vao->vertexattrib[i].real_buffer = 0;
+            glstate->vao->vertexattrib[i].real_pointer = NULL;
+        }
+}
@@ -0,0 +1,30 @@
+#ifndef _GL4ES_HOTARRAYS_H_
+#define _GL4ES_HOTARRAYS_H_
+
+#include "gles.h"
+
+#define HOT_MAX     64      // number of client arrays tracked
+#define HOT_HITS    3       // draws with unchanged content before going to a VBO
+#define HOT_COLD    4096    // draws without use before the VBO is dropped
+
+typedef struct {
+    uintptr_t   ptr;        // start of the client array (0 if slot is free)
+    GLsizeiptr  size;
+    uint64_t    hash;       // checksum of the content
+    int         hits;       // draws in a row with the same content
+    unsigned    last;       // tick of the last use
+    GLuint      real_buffer;
+    int         uploaded;   // real_buffer holds the current content
+} hotarray_t;
+
+typedef struct {
+    hotarray_t  entries[HOT_MAX];
+    unsigned    tick;
+} hotarrays_t;
+
+// Put enabled client arrays that are drawn unchanged over and over in VBO. Return the mask of
+// the vertex attributes that have been remapped, to give to hotarrays_restore after the draw
+unsigned hotarrays_remap(GLint first, GLsizei count, GLuint len);
+void hotarrays_restore(unsigned mask);
+
+#endif // _GL4ES_HOTARRAYS_H_
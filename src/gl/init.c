@@ -17,6 +17,7 @@
 #include "fpe_cache.h"
 #include "init.h"
 #include "envvars.h"
+#include "trace.h"
 #if defined(__EMSCRIPTEN__) || defined(__APPLE__)
 #define NO_INIT_CONSTRUCTOR
 #endif
@@ -158,7 +159,13 @@ void initialize_gl4es() {
           break;
     }
     env(LIBGL_BLITFB0, globals4es.blitfb0, "Blit to FB 0 force a SwapBuffer");
+    env(LIBGL_NOXSHM, globals4es.noxshm, "Don't use MIT-SHM for emulated pixmaps and windows");
     env(LIBGL_FPS, globals4es.showfps, "fps counter enabled");
+    const char* env_trace = GetEnvVar("LIBGL_TRACE");
+    if(env_trace && env_trace[0]) {
+        trace_init(env_trace);
+        SHUT_LOGD("Tracing gl4es internals to %s\n", env_trace);
+    }
 #if defined(USE_FBIO) || defined(PYRA)
     env(LIBGL_VSYNC, globals4es.vsync, "vsync enabled");
 #endif
@@ -171,6 +178,7 @@ void initialize_gl4es() {
     env(LIBGL_NOTEXRECT, globals4es.notexrect, "Don't export Text Rectangle extension");
     if(globals4es.usefbo) {
       env(LIBGL_FBONOALPHA, globals4es.fbo_noalpha, "Main FBO has no alpha channel");
+      env(LIBGL_FBODAMAGE, globals4es.fbodamage, "Only present the part of the main FBO drawn since last frame");
     }
 
         globals4es.es=ReturnEnvVarInt("LIBGL_ES");
@@ -250,6 +258,13 @@ void initialize_gl4es() {
         break;
     }
 
+    // read before the hardware probe, as it changes its outcome
+    if(IsEnvVarTrue("LIBGL_NOSHADERLOD")) {
+        globals4es.noshaderlod = 1;
+        SHUT_LOGD("No GL_EXT_shader_texture_lod used even if present\n");
+    }
+    env(LIBGL_NOHWCACHE, globals4es.nohwcache, "Don't use the hardware capabilities cache");
+
     GetHardwareExtensions(gl4es_notest);
 
 #if !defined(NO_LOADER) && !defined(NO_GBM)
@@ -300,9 +315,17 @@ void initialize_gl4es() {
         break;
     }
 
-    if(IsEnvVarTrue("LIBGL_TEXCOPY")) {
-      globals4es.texcopydata = 1;
-          SHUT_LOGD("Texture copy enabled\n");
+    globals4es.texcopydata = ReturnEnvVarInt("LIBGL_TEXCOPY");
+    switch(globals4es.texcopydata) {
+      case 1:
+        SHUT_LOGD("Texture copy enabled\n");
+        break;
+      case 2:
+        SHUT_LOGD("Texture copy enabled, built on first glGetTexImage\n");
+        break;
+      default:
+        globals4es.texcopydata = 0;
+        break;
     }
 
     globals4es.texshrink=ReturnEnvVarInt("LIBGL_SHRINK");
@@ -439,11 +462,6 @@ void initialize_gl4es() {
         globals4es.nointovlhack = 1;
         SHUT_LOGD("No hack in shader converter to define overloaded function with int\n");
     }
-    if(IsEnvVarTrue("LIBGL_NOSHADERLOD")) {
-        globals4es.noshaderlod = 1;
-        SHUT_LOGD("No GL_EXT_shader_texture_lod used even if present\n");
-        hardext.shaderlod=0;
-    }
 
     int env_begin_end;
     if(GetEnvVarInt("LIBGL_BEGINEND",&env_begin_end,0)) {
@@ -454,10 +472,13 @@ void initialize_gl4es() {
             SHUT_LOGD("Don't try to merge subsequent glBegin/glEnd blocks\n");
             break;
           case 1:
-          case 2:
             globals4es.beginend = 1;
             SHUT_LOGD("Try to merge subsequent glBegin/glEnd blocks, even if there is a glColor / glNormal in between\n");
             break;
+          case 2:
+            globals4es.beginend = 2;
+            SHUT_LOGD("Try to merge subsequent glBegin/glEnd blocks, even if there is a glColor / glNormal / modelview change in between\n");
+            break;
         }
       }
 
@@ -488,9 +509,9 @@ void initialize_gl4es() {
     env(LIBGL_POTFRAMEBUFFER, globals4es.potframebuffer, "Force framebuffers to be on POT size");
 
     int env_forcenpot=ReturnEnvVarIntDef("LIBGL_FORCENPOT",0);
-    if(env_forcenpot==0 && (hardext.esversion==2 && (hardext.npot==1 || hardext.npot==2))) {
+    if(env_forcenpot==0 && (hardext.esversion>1 && (hardext.npot==1 || hardext.npot==2))) {
       SHUT_LOGD("Not forcing NPOT support\n");
-    } else if(env_forcenpot!=0 || (hardext.esversion==2 && (hardext.npot==1 || hardext.npot==2))) {
+    } else if(env_forcenpot!=0 || (hardext.esversion>1 && (hardext.npot==1 || hardext.npot==2))) {
         if(hardext.npot==3) {
             SHUT_LOGD("NPOT texture handled in hardware\n");
         } else if(hardext.npot==1) {
@@ -548,7 +569,33 @@ void initialize_gl4es() {
               globals4es.usevbo=1;
               break;
         }
+        if(globals4es.usevbo) {
+            globals4es.hotarrays = ReturnEnvVarIntDef("LIBGL_HOTARRAYS",0);
+            if(globals4es.hotarrays==1)
+                SHUT_LOGD("Static client arrays will be put in VBO\n");
+            else if(globals4es.hotarrays==2)
+                SHUT_LOGD("Static client arrays will be put in VBO (sampled check of big arrays)\n");
+            else
+                globals4es.hotarrays = 0;
+        }
       }
+    if(hardext.esversion>=3) {
+        globals4es.novbomirror = ReturnEnvVarIntDef("LIBGL_NOVBOMIRROR",0);
+        if(globals4es.novbomirror)
+            SHUT_LOGD("Array VBO are not mirrored in CPU memory (fetched back only when needed)\n");
+        globals4es.nativevao = ReturnEnvVarIntDef("LIBGL_NATIVEVAO",1);
+        if(globals4es.nativevao) {
+            LOAD_GLES2(glGenVertexArrays);
+            LOAD_GLES2(glBindVertexArray);
+            LOAD_GLES2(glDeleteVertexArrays);
+            if(!gles_glGenVertexArrays || !gles_glBindVertexArray || !gles_glDeleteVertexArrays) {
+                globals4es.nativevao = 0;
+                SHUT_LOGD("Native VAO functions not found\n");
+            }
+        }
+        if(!globals4es.nativevao)
+            SHUT_LOGD("Native VAO disabled\n");
+    }
 
     globals4es.fbomakecurrent = 0;
     if((hardext.vendor & VEND_ARM) || (globals4es.usefb))
@@ -738,6 +785,7 @@ void close_gl4es() {
     FreeFBVisual();
     #endif
     gl_close();
+    trace_dump();
     fpe_writePSA();
     fpe_FreePSA();
         #if defined(GL4ES_COMPILE_FOR_USE_IN_SHARED_LIB) && defined(AMIGAOS4)
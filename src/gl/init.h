@@ -51,6 +51,9 @@ typedef struct _globals4es {
  int es;
  int gl;
  int usevbo;
+ int novbomirror;
+ int nativevao;
+ int hotarrays;
  int comments;
  int forcenpot;
  int fbomakecurrent;    // hack to bind/unbind FBO when doing glXMakeCurrent
@@ -66,10 +69,14 @@ typedef struct _globals4es {
  int noclean;
  int dbgshaderconv;
  int nopsa;
+ int nohwcache;
  int noes2;
  int nointovlhack;
  int noshaderlod;
  int fbo_noalpha;
+ int fbodamage;
+ int noxshm;
+ int trace;
  int noarbprogram;      // to disable ARB Program
  int glxnative;
  int normalize;         // force normal normalization (workaround a bug)
@@ -67,12 +67,14 @@ void APIENTRY_GL4ES gl4es_glLightModelfv(GLenum pname, const GLfloat* params) {
             NewStage(glstate->list.active, STAGE_LIGHTMODEL);
     /*		if (glstate->list.active->lightmodel)
                 glstate->list.active = extend_renderlist(glstate->list.active);*/
-            glstate->list.active->lightmodelparam = pname;
-            glstate->list.active->lightmodel = (GLfloat*)malloc(4*sizeof(GLfloat));
+            renderlist_ops_t *ops = get_renderlist_ops(glstate->list.active);
+            ops->lightmodelparam = pname;
+            if (!ops->lightmodel)
+                ops->lightmodel = (GLfloat*)malloc(4*sizeof(GLfloat));
             int sz = 4;
             if(pname==GL_LIGHT_MODEL_TWO_SIDE || pname==GL_LIGHT_MODEL_COLOR_CONTROL || pname==GL_LIGHT_MODEL_LOCAL_VIEWER)
                 sz=1;
-            memcpy(glstate->list.active->lightmodel, params, sz*sizeof(GLfloat));
+            memcpy(ops->lightmodel, params, sz*sizeof(GLfloat));
             noerrorShim();
             return;
         } else gl4es_flush();
@@ -1,6 +1,7 @@
 #include "line.h"
 #include <stdio.h>
 
+#include "../glx/hardext.h"
 #include "debug.h"
 #include "gl4es.h"
 #include "glstate.h"
@@ -20,9 +21,10 @@ void APIENTRY_GL4ES gl4es_glLineStipple(GLuint factor, GLushort pattern) {
     if(glstate->list.active) {
         if (glstate->list.compiling) {
             NewStage(glstate->list.active, STAGE_LINESTIPPLE);
-            glstate->list.active->linestipple_op = 1;
-            glstate->list.active->linestipple_factor = factor;
-            glstate->list.active->linestipple_pattern = pattern;
+            renderlist_ops_t *ops = get_renderlist_ops(glstate->list.active);
+            ops->linestipple_op = 1;
+            ops->linestipple_factor = factor;
+            ops->linestipple_pattern = pattern;
             return;
         } else gl4es_flush();
     }
@@ -34,6 +36,11 @@ void APIENTRY_GL4ES gl4es_glLineStipple(GLuint factor, GLushort pattern) {
         for (int i = 0; i < 16; i++) {
             glstate->linestipple.data[i] = ((pattern >> i) & 1) ? 255 : 0;
         }
+        // with shaders, the pattern is a uniform of the FPE program
+        if(hardext.esversion>1) {
+            noerrorShim();
+            return;
+        }
 
         // "Push" current Texture0 binding
         GLuint old_act = glstate->texture.active;
@@ -70,7 +77,7 @@ void bind_stipple_tex() {
     gl4es_glBindTexture(GL_TEXTURE_2D, glstate->linestipple.texture);
 }
 
-GLfloat *gen_stipple_tex_coords(GLfloat *vert, GLushort *sindices, modeinit_t *modes, int stride, int length, GLfloat* noalloctex) {
+GLfloat *gen_stipple_tex_coords(GLfloat *vert, GLushort *sindices, modeinit_t *modes, int stride, int length, GLfloat scale, GLfloat* noalloctex) {
     DBG(printf("Generate stripple tex (stride=%d, noalloctex=%p) length=%d:", stride, noalloctex, length);)
     // generate our texture coords
     GLfloat *tex = noalloctex?noalloctex:(GLfloat *)malloc(modes[length-1].ilen * 4 * sizeof(GLfloat));
@@ -118,7 +125,7 @@ GLfloat *gen_stipple_tex_coords(GLfloat *vert, GLushort *sindices, modeinit_t *m
                     x2=(v[0]/v[3])*w; y2=(v[1]/v[3])*h;
                 }
                 oldlen = len;
-                len += sqrtf((x2-x1)*(x2-x1) + (y2-y1)*(y2-y1)) / (glstate->linestipple.factor * 16.f);
+                len += sqrtf((x2-x1)*(x2-x1) + (y2-y1)*(y2-y1)) * scale;
                 DBG(printf("%f->%f (%f,%f -> %f,%f)\t", oldlen, len, x1, y1, x2, y2);)
                 if(sindices)
                     texPos = tex+texstride*sindices[i+0];   // it gets written 2*, but that should be ok, it's the same value
@@ -151,7 +158,7 @@ GLfloat *gen_stipple_tex_coords(GLfloat *vert, GLushort *sindices, modeinit_t *m
                 vector_matrix(vertPos, mvp, v);
                 vertPos+=stride;
                 x2=(v[0]/v[3])*w; y2=(v[1]/v[3])*h;
-                len += sqrtf((x2-x1)*(x2-x1) + (y2-y1)*(y2-y1)) / (glstate->linestipple.factor * 16.f);
+                len += sqrtf((x2-x1)*(x2-x1) + (y2-y1)*(y2-y1)) * scale;
                 DBG(printf("->%f\t", len);)
                 if(sindices)
                     texPos = tex+texstride*sindices[i];
@@ -164,3 +171,13 @@ GLfloat *gen_stipple_tex_coords(GLfloat *vert, GLushort *sindices, modeinit_t *m
     DBG(printf("\n");)
     return tex;
 }
+
+GLfloat *gen_stipple_anchors(GLfloat *vert, int len, int stride, GLfloat* noalloctex) {
+    // each vertex of a segment gets the 1st vertex, so the shader can measure from it
+    GLfloat *tex = noalloctex?noalloctex:(GLfloat *)malloc(len * 4 * sizeof(GLfloat));
+    if(stride==0) stride = 4; else stride/=sizeof(GLfloat);
+    int texstride = noalloctex?stride:4;
+    for (int i=0; i<len; i++)
+        memcpy(tex+i*texstride, vert+(i&~1)*stride, 4*sizeof(GLfloat));
+    return tex;
+}
@@ -5,7 +5,10 @@
 #include "list.h"
 
 void APIENTRY_GL4ES gl4es_glLineStipple(GLuint factor, GLushort pattern);
-GLfloat *gen_stipple_tex_coords(GLfloat *vert, GLushort *sindices, modeinit_t *modes, int stride, int length, GLfloat* noalloctex);
+// counter in texcoord.x, scale is the counter unit per pixel
+GLfloat *gen_stipple_tex_coords(GLfloat *vert, GLushort *sindices, modeinit_t *modes, int stride, int length, GLfloat scale, GLfloat* noalloctex);
+// for non indexed GL_LINES, first vertex of the segment in texcoord (FPE_STIPPLE_ANCHOR)
+GLfloat *gen_stipple_anchors(GLfloat *vert, int len, int stride, GLfloat* noalloctex);
 void bind_stipple_tex();
 
 #endif // _GL4ES_LINE_H
@@ -7,6 +7,7 @@
 #include "init.h"
 #include "loader.h"
 #include "buffers.h"
+#include "texgen.h"
 
 // KH Map implementation
 KHASH_MAP_IMPL_INT(material, rendermaterial_t *);
@@ -15,14 +16,36 @@ KHASH_MAP_IMPL_INT(texgen, rendertexgen_t *);
 KHASH_MAP_IMPL_INT(texenv, rendertexenv_t *);
 KHASH_MAP_IMPL_INT(gllisthead, renderlist_t*);
 
+// Pools of recycled renderlist nodes, ops and default capacity arrays
+// immediate mode alloc and free thousands of those each frame
+#define RLPOOL_MAX 256
+typedef struct {
+    int     count;
+    void    *items[RLPOOL_MAX];
+} rlpool_t;
+
+static rlpool_t pool_lists;
+static rlpool_t pool_ops;
+static rlpool_t pool_arrays[5];    // by number of floats per element (1, 3 or 4)
+
+static void* rlpool_get(rlpool_t *pool, size_t size) {
+    if(pool->count)
+        return pool->items[--pool->count];
+    return malloc(size);
+}
+
+static void rlpool_put(rlpool_t *pool, void *p) {
+    if(pool->count<RLPOOL_MAX)
+        pool->items[pool->count++] = p;
+    else
+        free(p);
+}
+
 renderlist_t *alloc_renderlist() {
 
-    renderlist_t *list = (renderlist_t *)malloc(sizeof(renderlist_t));
+    renderlist_t *list = (renderlist_t *)rlpool_get(&pool_lists, sizeof(renderlist_t));
     memset(list, 0, sizeof(renderlist_t));
     list->cap = DEFAULT_RENDER_LIST_CAPACITY;
-    list->matrix_val[0] = list->matrix_val[5] = list->matrix_val[10] = 
-                          list->matrix_val[15] = 1.0f;
-    list->lightmodelparam = GL_LIGHT_MODEL_AMBIENT;
     list->target_texture = GL_TEXTURE_2D;
     list->tmu = glstate->texture.active;
 
@@ -37,13 +60,58 @@ renderlist_t *alloc_renderlist() {
     return list;
 }
 
+renderlist_ops_t *get_renderlist_ops(renderlist_t *list) {
+    if(!list->ops) {
+        renderlist_ops_t *ops = list->ops = (renderlist_ops_t*)rlpool_get(&pool_ops, sizeof(renderlist_ops_t));
+        memset(ops, 0, sizeof(renderlist_ops_t));
+        ops->matrix_val[0] = ops->matrix_val[5] = ops->matrix_val[10] = 
+                             ops->matrix_val[15] = 1.0f;
+        ops->lightmodelparam = GL_LIGHT_MODEL_AMBIENT;
+    }
+    return list->ops;
+}
+
+static void free_renderlist_ops(renderlist_ops_t *ops) {
+    if (ops->material) {
+        rendermaterial_t *m;
+        kh_foreach_value(ops->material, m,
+            free(m);
+        )
+        kh_destroy(material, ops->material);
+    }
+    if (ops->light) {
+        renderlight_t *m;
+        kh_foreach_value(ops->light, m,
+            free(m);
+        )
+        kh_destroy(light, ops->light);
+    }
+    if (ops->lightmodel)
+        free(ops->lightmodel);
+    rlpool_put(&pool_ops, ops);
+}
+
+GLfloat *alloc_renderlist_array(renderlist_t *list, int n, int att) {
+    // arrays of the default capacity are recycled
+    if(list->cap == DEFAULT_RENDER_LIST_CAPACITY) {
+        list->pooled_arrays |= 1<<att;
+        return (GLfloat*)rlpool_get(&pool_arrays[n], n*sizeof(GLfloat)*DEFAULT_RENDER_LIST_CAPACITY);
+    }
+    return alloc_sublist(n, list->cap);
+}
+
+void free_renderlist_array(renderlist_t *list, GLfloat *p, int n, int att) {
+    if(list->pooled_arrays & (1<<att))
+        rlpool_put(&pool_arrays[n], p);
+    else
+        free(p);
+}
+
 bool ispurerender_renderlist(renderlist_t *list) {
     // return true if renderlist contains only rendering command, no state changes
     if (list->calls.len)
         return false;
-    if (list->matrix_op)
-        return false;
-    if (list->raster_op)
+    if (list->ops)
         return false;
     if (list->raster)
         return false;
@@ -53,14 +121,10 @@ bool ispurerender_renderlist(renderlist_t *list) {
         return false;
     if (list->popattribute)
         return false;
-    if (list->material || list->colormat_face || list->light || list->lightmodel || list->texgen || list->texenv)
-        return false;
-    if (list->fog_op)
+    if (list->colormat_face || list->texgen || list->texenv)
         return false;
     if (list->instanceCount!=1)
         return false;
-    if (list->pointparam_op)
-        return false;
     if (list->mode_init == 0)
         return false;
     if (list->ind_lines || list->final_colors)
@@ -124,6 +188,8 @@ bool islistscompatible_renderlist(renderlist_t *a, renderlist_t *b) {
         return false;*/
     if (a->polygon_mode != b->polygon_mode)
         return false;
+    if (a->pretransform != b->pretransform)
+        return false;
     if ((a->vert==NULL) != (b->vert==NULL))
         return false;
     if ((a->normal==NULL) != (b->normal==NULL))
@@ -334,6 +400,7 @@ void list_add_modeinit(renderlist_t* list, GLenum mode) {
 void unshared_renderlist(renderlist_t *a, int cap) {
     if(a->shared_arrays && ((*a->shared_arrays)--)>0) {
         a->cap = cap;
+        a->pooled_arrays = 0;   // the shared ones stay with the other owner
         GLfloat *tmp;
         tmp = a->vert;
         if (tmp) {
@@ -394,6 +461,7 @@ void unsharedindices_renderlist(renderlist_t* a, int cap)
 void redim_renderlist(renderlist_t *a, int cap) {
     if (a->cap < cap) {
         a->cap = cap;
+        a->pooled_arrays = 0;
         realloc_sublist(a->vert, 4, cap);
         realloc_sublist(a->normal, 3, cap);
         realloc_sublist(a->color, 4, cap);
@@ -574,6 +642,7 @@ renderlist_t *extend_renderlist(renderlist_t *list) {
         memcpy(new->lastSecondaryColors, list->lastSecondaryColors, 3*sizeof(GLfloat));
         memcpy(new->lastColors, list->lastColors, 4*sizeof(GLfloat));
         new->lastColorsSet = list->lastColorsSet;
+        new->pretransform = new->prev->pretransform;
         // detach
         list->prev = NULL;
         // free list now
@@ -589,6 +658,7 @@ renderlist_t *extend_renderlist(renderlist_t *list) {
         memcpy(new->lastSecondaryColors, list->lastSecondaryColors, 3*sizeof(GLfloat));
         memcpy(new->lastColors, (list->post_color)?list->post_colors:list->lastColors, 4*sizeof(GLfloat));
         new->lastColorsSet = (list->post_color || list->lastColorsSet)?1:0;
+        new->pretransform = list->pretransform;
         return new;
     }
 }
@@ -598,6 +668,7 @@ renderlist_t* append_calllist(renderlist_t *list, renderlist_t *a)
     // go to end of list
     while(list->next) list = list->next;
     while(a) {
+        expand_renderlist(a);   // the float arrays are needed to copy a
         if(ispurerender_renderlist(a) && islistscompatible_renderlist(list, a)) {
             // append list!
             append_renderlist(list, a);
@@ -623,14 +694,20 @@ renderlist_t* append_calllist(renderlist_t *list, renderlist_t *a)
             new->prev = list;
             // ok, now on new list
             list = new;
+            // the caches built when drawing a belong to a
+            list->stipple = NULL;
+            list->ind_lines = NULL;
+            list->ind_line = 0;
+            list->vbo_lines = 0;
+            memset(list->texgen_cache, 0, sizeof(list->texgen_cache));
+            list->compact = 0;
+            list->const_attribs = 0;
+            list->color_ub = NULL;
+            memset(list->tex_compact, 0, sizeof(list->tex_compact));
+            memset(list->tex_size, 0, sizeof(list->tex_size));
             // copy the many list arrays
             if (list->calls.len > 0) {
                 ++(*list->shared_calls);
-                /*
-                list->calls.calls = (packed_call_t**)malloc(sizeof(packed_call_t*)*a->calls.cap);
-                for (int i = 0; i < list->calls.len; i++) {
-                    list->calls.calls[i] = glCopyPackedCall(a->calls.calls[i]);
-                }*/
             }
             if(list->len) {
                 ++(*list->shared_arrays);
@@ -649,14 +726,31 @@ renderlist_t* append_calllist(renderlist_t *list, renderlist_t *a)
                         memcpy(m2, m, sizeof(T));           \
                     );       \
                 }
-            PROCESS(material, rendermaterial_t, m->pname);
-            PROCESS(light, renderlight_t, m->pname | ((m->which-GL_LIGHT0)<<16));
             PROCESS(texgen, rendertexgen_t, m->pname | ((m->coord-GL_S)<<16));
             PROCESS(texenv, rendertexenv_t, m->pname | ((m->target)<<16));
             #undef PROCESS
-            if (list->lightmodel) {
-                list->lightmodel = (GLfloat*)malloc(4*sizeof(GLfloat));
-                memcpy(list->lightmodel, a->lightmodel, 4*sizeof(GLfloat));
+            if (list->ops) {
+                list->ops = NULL;
+                renderlist_ops_t *ops = get_renderlist_ops(list);
+                memcpy(ops, a->ops, sizeof(renderlist_ops_t));
+                #define PROCESS(W, T, C) if(ops->W) { \
+                        ops->W = kh_init(W);   \
+                        T *m, *m2;      \
+                        khint_t k;      \
+                        int ret;        \
+                        kh_foreach_value(a->ops->W, m,   \
+                            k = kh_put(W, ops->W, C, &ret);    \
+                            m2= kh_value(ops->W, k) = malloc(sizeof(T));   \
+                            memcpy(m2, m, sizeof(T));           \
+                        );       \
+                    }
+                PROCESS(material, rendermaterial_t, m->pname);
+                PROCESS(light, renderlight_t, m->pname | ((m->which-GL_LIGHT0)<<16));
+                #undef PROCESS
+                if (ops->lightmodel) {
+                    ops->lightmodel = (GLfloat*)malloc(4*sizeof(GLfloat));
+                    memcpy(ops->lightmodel, a->ops->lightmodel, 4*sizeof(GLfloat));
+                }
             }
             if (list->raster) {
                 (*list->raster->shared)++;
@@ -684,22 +778,19 @@ void free_renderlist(renderlist_t *list) {
             free(list->mode_inits);
         if ((list->calls.len > 0) && (!list->shared_calls || ((*list->shared_calls)--)==0)) {
             if(list->shared_calls) free(list->shared_calls);
-            for (int i = 0; i < list->calls.len; i++) {
-                free(list->calls.calls[i]);
-            }
             free(list->calls.calls);
         }
         int a;
         if(!list->use_glstate) {
             if (!list->shared_arrays || ((*list->shared_arrays)--)==0) {
                 if (list->shared_arrays) free(list->shared_arrays);
-                if (list->vert) free(list->vert);
-                if (list->normal) free(list->normal);
-                if (list->color) free(list->color);
-                if (list->secondary) free(list->secondary);
-                if (list->fogcoord) free(list->fogcoord);
+                if (list->vert) free_renderlist_array(list, list->vert, 4, RLARRAY_VERT);
+                if (list->normal) free_renderlist_array(list, list->normal, 3, RLARRAY_NORMAL);
+                if (list->color) free_renderlist_array(list, list->color, 4, RLARRAY_COLOR);
+                if (list->secondary) free_renderlist_array(list, list->secondary, 4, RLARRAY_SECONDARY);
+                if (list->fogcoord) free_renderlist_array(list, list->fogcoord, 1, RLARRAY_FOGCOORD);
                 for (a=0; a<list->maxtex; a++)
-                    if (list->tex[a]) free(list->tex[a]);
+                    if (list->tex[a]) free_renderlist_array(list, list->tex[a], 4, RLARRAY_TEX0+a);
             }
             if (!list->shared_indices || ((*list->shared_indices)--)==0) {
                 if (list->shared_indices) free(list->shared_indices);
@@ -709,20 +800,8 @@ void free_renderlist(renderlist_t *list) {
         } else
             glstate->merger_used = 0;
 
-        if (list->material) {
-            rendermaterial_t *m;
-            kh_foreach_value(list->material, m,
-                free(m);
-            )
-            kh_destroy(material, list->material);
-        }
-        if (list->light) {
-            renderlight_t *m;
-            kh_foreach_value(list->light, m,
-                free(m);
-            )
-            kh_destroy(light, list->light);
-        }
+        if (list->ops)
+            free_renderlist_ops(list->ops);
         if (list->texgen) {
             rendertexgen_t *m;
             kh_foreach_value(list->texgen, m,
@@ -737,9 +816,6 @@ void free_renderlist(renderlist_t *list) {
             )
             kh_destroy(texenv, list->texenv);
         }
-        if (list->lightmodel)
-			free(list->lightmodel);
-			
         if (list->raster && !((*list->raster->shared)--)) {
 			if (list->raster->texture)
 				gl4es_glDeleteTextures(1, &list->raster->texture);
@@ -760,13 +836,24 @@ void free_renderlist(renderlist_t *list) {
             free(list->ind_lines);
         if(list->final_colors)
             free(list->final_colors);
+        if(list->stipple)
+            free(list->stipple);
+        for (a=0; a<MAX_TEX; a++)
+            texgen_cache_free(list->texgen_cache[a]);
+        if(list->color_ub)
+            free(list->color_ub);
+        for (a=0; a<MAX_TEX; a++)
+            if(list->tex_compact[a])
+                free(list->tex_compact[a]);
         if(list->vbo_array)
             deleteSingleBuffer(list->vbo_array);
         if(list->vbo_indices)
             deleteSingleBuffer(list->vbo_indices);
+        if(list->vbo_lines)
+            deleteSingleBuffer(list->vbo_lines);
 
         next = list->next;
-        free(list);
+        rlpool_put(&pool_lists, list);
     } while ((list = next));
 }
 
@@ -791,6 +878,7 @@ void resize_renderlist(renderlist_t *list) {
     } else {
         if (list->len >= list->cap) {
             list->cap += DEFAULT_RENDER_LIST_CAPACITY*8;
+            list->pooled_arrays = 0;
             realloc_sublist(list->vert, 4, list->cap);
             realloc_sublist(list->normal, 3, list->cap);
             realloc_sublist(list->color, 4, list->cap);
@@ -109,10 +109,20 @@ KHASH_MAP_DECLARE_INT(light, renderlight_t *);
 KHASH_MAP_DECLARE_INT(texgen, rendertexgen_t *);
 KHASH_MAP_DECLARE_INT(texenv, rendertexenv_t *);
 
+typedef struct {
+    packed_call_func_t exec;    // handler for the packed call that follows
+    unsigned int       size;    // size of the whole record, header included
+} call_header_t;
+
+// packed calls are stored inline after their header, 8 bytes aligned (for GLdouble args)
+#define CALL_ALIGN(s) (((s)+7)&~7)
+#define CALL_HEADER_SIZE CALL_ALIGN(sizeof(call_header_t))
+
 typedef struct _call_list_t {
-    unsigned long len;
-    unsigned long cap;
-    packed_call_t **calls;
+    unsigned long len;      // number of calls
+    unsigned long cap;      // allocated size of calls, in bytes
+    unsigned long size;     // used size of calls, in bytes
+    char *calls;            // call_header_t + packed call records
 } call_list_t;
 
 typedef struct {
@@ -137,6 +147,29 @@ typedef struct {
     int    ilen;
 } modeinit_t;
 
+// the ops payloads that are rarely used, allocated on first use (see get_renderlist_ops)
+typedef struct {
+    int     raster_op;
+    GLfloat raster_xyz[3];
+    
+    int     matrix_op;
+    GLfloat matrix_val[16];
+    
+    int     fog_op;
+    GLfloat fog_val[4];
+
+    int     pointparam_op;
+    GLfloat pointparam_val[4];
+
+    int     linestipple_op;
+    GLuint  linestipple_factor, linestipple_pattern;
+
+    khash_t(material) *material;
+    khash_t(light) *light;
+    GLfloat	*lightmodel;
+    GLenum	lightmodelparam;
+} renderlist_ops_t;
+
 typedef struct _renderlist_t {
     unsigned long len;
     unsigned long ilen;
@@ -166,6 +199,7 @@ typedef struct _renderlist_t {
     GLfloat *secondary;
     GLfloat *fogcoord;
     GLfloat *tex[MAX_TEX];
+    int      pooled_arrays;   // bitfield of the arrays above that come from the default capacity pool
     int      vert_stride;
     int      normal_stride;
     int      color_stride;
@@ -182,6 +216,11 @@ typedef struct _renderlist_t {
     GLfloat *vbo_secondary;
     GLfloat *vbo_fogcoord;
     GLfloat *vbo_tex[MAX_TEX];
+    int      compact;           // narrow formats evaluated (compiled lists on ES2+ only)
+    unsigned int const_attribs; // bitfield of ATT_xxx with the same value on every vertex
+    GLubyte *color_ub;          // colors, when they are all exact UNORM8 values (color is freed then)
+    GLfloat *tex_compact[MAX_TEX]; // texcoords without the trailing default r/q (tex is freed then)
+    int      tex_size[MAX_TEX];    // number of components in tex_compact
     int *shared_indices;
     GLushort *indices;
     unsigned int indice_cap;
@@ -201,20 +240,9 @@ typedef struct _renderlist_t {
     int     render_op;
     GLuint  render_arg;
 
-    int     raster_op;
-    GLfloat raster_xyz[3];
-    
-    int     matrix_op;
-    GLfloat matrix_val[16];
-    
-    int     fog_op;
-    GLfloat fog_val[4];
-
-    int     pointparam_op;
-    GLfloat pointparam_val[4];
+    renderlist_ops_t *ops;  // rarely used ops, NULL for most lists
 
-    int     linestipple_op;
-    GLuint  linestipple_factor, linestipple_pattern;
+    int     pretransform;   // vertices are already in eye space (LIBGL_BEGINEND=2)
 
     int     post_color;
     GLfloat post_colors[4];
@@ -223,18 +251,17 @@ typedef struct _renderlist_t {
 
     GLushort    *ind_lines;
     int         ind_line;
+    GLuint      vbo_lines;      // ind_lines in a VBO, for compiled lists on ES2
     GLfloat      *final_colors;
+    GLfloat      *stipple;       // line stipple anchors, kept for the next draws
+    struct _texgen_cache_t *texgen_cache[MAX_TEX];  // ES1 texgen results, for compiled lists
 
     int         instanceCount;
     
-    khash_t(material) *material;
     GLenum  colormat_face;
     GLenum  colormat_mode;
-    khash_t(light) *light;
     khash_t(texgen) *texgen;
     khash_t(texenv) *texenv;
-    GLfloat	*lightmodel;
-    GLenum	lightmodelparam;
     GLenum	polygon_mode;
     GLboolean set_tmu;      // TRUE is glActiveTexture called
     int tmu;             // the current TMU...
@@ -248,7 +275,7 @@ typedef struct _renderlist_t {
 
 KHASH_MAP_DECLARE_INT(gllisthead, renderlist_t*);
 
-#define DEFAULT_CALL_LIST_CAPACITY 20
+#define DEFAULT_CALL_LIST_CAPACITY 512
 #define DEFAULT_RENDER_LIST_CAPACITY 64
 
 int rendermode_dimensions(GLenum mode);
@@ -269,7 +296,19 @@ renderlist_t* GetFirst(renderlist_t* list);
 #define realloc_merger_sublist(ref, n, cap) \
         ref = (GLfloat *)realloc(ref, n * sizeof(GLfloat) * cap)
 
+// arrays that can come from the renderlist array pool (bits of renderlist_t.pooled_arrays)
+#define RLARRAY_VERT        0
+#define RLARRAY_NORMAL      1
+#define RLARRAY_COLOR       2
+#define RLARRAY_SECONDARY   3
+#define RLARRAY_FOGCOORD    4
+#define RLARRAY_TEX0        5
+
 renderlist_t *alloc_renderlist();
+renderlist_ops_t *get_renderlist_ops(renderlist_t *list);
+GLfloat *alloc_renderlist_array(renderlist_t *list, int n, int att);
+void free_renderlist_array(renderlist_t *list, GLfloat *p, int n, int att);
+void expand_renderlist(renderlist_t *list);
 renderlist_t *extend_renderlist(renderlist_t *list);
 void free_renderlist(renderlist_t *list);
 void draw_renderlist(renderlist_t *list);
@@ -306,7 +345,7 @@ void rlTexEnvfv(renderlist_t *list, GLenum target, GLenum pname, const GLfloat *
 void rlTexEnviv(renderlist_t *list, GLenum target, GLenum pname, const GLint * params);
 void rlNormal3f(renderlist_t *list, GLfloat x, GLfloat y, GLfloat z) FASTMATH;
 void rlNormal3fv(renderlist_t *list, GLfloat* v) FASTMATH;
-void rlPushCall(renderlist_t *list, packed_call_t *data);
+void* rlAllocCall(renderlist_t *list, int format, int size);
 void rlMultiTexCoord4f(renderlist_t *list, GLenum texture, GLfloat s, GLfloat t, GLfloat r, GLfloat q) FASTMATH;
 void rlMultiTexCoord2fv(renderlist_t *list, GLenum texture, GLfloat* v) FASTMATH;
 void rlMultiTexCoord4fv(renderlist_t *list, GLenum texture, GLfloat* v) FASTMATH;
@@ -9,6 +9,8 @@
 #include "matrix.h"
 #include "texgen.h"
 #include "render.h"
+#include "trace.h"
+#include "wireframe.h"
 #include "fpe.h"
 
 /* return 1 if failed, 2 if succeed */
@@ -18,8 +20,11 @@ typedef struct array2vbo_s {
     uint32_t    stride;
     uintptr_t   vbo_base;
     uintptr_t   vbo_basebase;
+    GLfloat**   dest;
 } array2vbo_t;
 
+#define ISCONST(list, att)  ((list)->const_attribs & (1u<<(att)))
+
 int list2VBO(renderlist_t* list)
 {
     LOAD_GLES2(glGenBuffers);
@@ -29,50 +34,42 @@ int list2VBO(renderlist_t* list)
     // list -> work
     int imax = 0;
     int len = list->len;
+    #define ADD(base, st, defst, vbo) \
+        work[imax].real_base = (uintptr_t)(base);    \
+        work[imax].stride = (st);                    \
+        if(!work[imax].stride) work[imax].stride = (defst); \
+        work[imax].real_size = work[imax].stride*len; \
+        work[imax].dest = &(vbo);                    \
+        imax++
     if(list->vert) {
-        work[imax].real_base = (uintptr_t)list->vert;
-        work[imax].stride = list->vert_stride;
-        if(!work[imax].stride) work[imax].stride = 4*4; // 4*GL_FLOAT
-        work[imax].real_size = work[imax].stride*len;
-        imax++;
+        ADD(list->vert, list->vert_stride, 4*4, list->vbo_vert);  // 4*GL_FLOAT
     }
-    if(list->color) {
-        work[imax].real_base = (uintptr_t)list->color;
-        work[imax].stride = list->color_stride;
-        if(!work[imax].stride) work[imax].stride = 4*4; // 4*GL_FLOAT
-        work[imax].real_size = work[imax].stride*len;
-        imax++;
+    if((list->color || list->color_ub) && !ISCONST(list, ATT_COLOR)) {
+        if(list->color_ub) {
+            ADD(list->color_ub, 4, 4, list->vbo_color);  // 4*GL_UNSIGNED_BYTE
+        } else {
+            ADD(list->color, list->color_stride, 4*4, list->vbo_color);  // 4*GL_FLOAT
+        }
     }
-    if(list->secondary) {
-        work[imax].real_base = (uintptr_t)list->secondary;
-        work[imax].stride = list->secondary_stride;
-        if(!work[imax].stride) work[imax].stride = 4*4; // 4*GL_FLOAT
-        work[imax].real_size = work[imax].stride*len;
-        imax++;
+    if(list->secondary && !ISCONST(list, ATT_SECONDARY)) {
+        ADD(list->secondary, list->secondary_stride, 4*4, list->vbo_secondary);  // 4*GL_FLOAT
     }
-    if(list->fogcoord) {
-        work[imax].real_base = (uintptr_t)list->fogcoord;
-        work[imax].stride = list->fogcoord_stride;
-        if(!work[imax].stride) work[imax].stride = 1*4; // 1*GL_FLOAT
-        work[imax].real_size = work[imax].stride*len;
-        imax++;
+    if(list->fogcoord && !ISCONST(list, ATT_FOGCOORD)) {
+        ADD(list->fogcoord, list->fogcoord_stride, 1*4, list->vbo_fogcoord);  // 1*GL_FLOAT
     }
-    if(list->normal) {
-        work[imax].real_base = (uintptr_t)list->normal;
-        work[imax].stride = list->normal_stride;
-        if(!work[imax].stride) work[imax].stride = 3*4; // 3*GL_FLOAT
-        work[imax].real_size = work[imax].stride*len;
-        imax++;
+    if(list->normal && !ISCONST(list, ATT_NORMAL)) {
+        ADD(list->normal, list->normal_stride, 3*4, list->vbo_normal);  // 3*GL_FLOAT
     }
     for (int a=0; a<list->maxtex; ++a) {
-        if(list->tex[a]) {
-            work[imax].real_base = (uintptr_t)list->tex[a];
-            work[imax].stride = list->tex_stride[a];
-            if(!work[imax].stride) work[imax].stride = 4*4; // 4*GL_FLOAT
-            work[imax].real_size = work[imax].stride*len;
-            imax++;
+        if((list->tex[a] || list->tex_compact[a]) && !ISCONST(list, ATT_MULTITEXCOORD0+a)) {
+            if(list->tex_compact[a]) {
+                ADD(list->tex_compact[a], list->tex_size[a]*4, 4*4, list->vbo_tex[a]);
+            } else {
+                ADD(list->tex[a], list->tex_stride[a], 4*4, list->vbo_tex[a]);  // 4*GL_FLOAT
+            }
         }
     }
+    #undef ADD
     // sort the real address...
     int sorted[ATT_MAX];
     for (int i=0; i<imax; ++i)
@@ -116,36 +113,114 @@ int list2VBO(renderlist_t* list)
             gles_glBufferSubData(GL_ARRAY_BUFFER, r->vbo_basebase, r->real_size, (void*)r->real_base);
     }
     // work -> list
-    imax = 0;
-    if(list->vert) {
-        list->vbo_vert = (GLfloat*)work[imax].vbo_base;
-        imax++;
-    }
-    if(list->color) {
-        list->vbo_color = (GLfloat*)work[imax].vbo_base;
-        imax++;
+    for (int i=0; i<imax; ++i)
+        *work[i].dest = (GLfloat*)work[i].vbo_base;
+
+    return 2;
+}
+
+static int isconst_array(const GLfloat *p, int n, int len) {
+    for (int i=1; i<len; ++i)
+        if(memcmp(p, p+i*n, n*sizeof(GLfloat)))
+            return 0;
+    return 1;
+}
+
+/* Choose the narrowest format that represents the arrays of a compiled list:
+ * attributes that never change are sent as a single generic value instead of an array,
+ * colors that all come from UNORM8 values are sent as GL_UNSIGNED_BYTE,
+ * and texcoords that keep the default r/q are sent with 2 or 3 components.
+ * Only tightly packed arrays (stride 0) are considered.
+ * The float arrays replaced by a narrow one are freed (see expand_renderlist). */
+static void compact_renderlist(renderlist_t *list) {
+    list->compact = 1;
+    const int len = list->len;
+    if(len<=0)
+        return;
+    #define CONST(arr, n, att) if(list->arr && !list->arr##_stride && isconst_array(list->arr, n, len)) list->const_attribs |= 1u<<(att)
+    CONST(normal, 3, ATT_NORMAL);
+    CONST(color, 4, ATT_COLOR);
+    CONST(secondary, 4, ATT_SECONDARY);
+    CONST(fogcoord, 1, ATT_FOGCOORD);
+    #undef CONST
+    for (int a=0; a<list->maxtex; ++a)
+        if(list->tex[a] && !list->tex_stride[a] && isconst_array(list->tex[a], 4, len))
+            list->const_attribs |= 1u<<(ATT_MULTITEXCOORD0+a);
+
+    if(list->color && !list->color_stride && !ISCONST(list, ATT_COLOR)) {
+        GLubyte *ub = (GLubyte*)malloc((size_t)len*4);
+        int i;
+        for (i=0; i<len*4; ++i) {
+            const GLfloat c = list->color[i];
+            if(!(c>=0.f && c<=1.f))
+                break;
+            const GLubyte v = (GLubyte)(c*255.f+0.5f);
+            if(v/255.0f != c)
+                break;
+            ub[i] = v;
+        }
+        if(i==len*4)
+            list->color_ub = ub;
+        else
+            free(ub);
     }
-    if(list->secondary) {
-        list->vbo_secondary = (GLfloat*)work[imax].vbo_base;
-        imax++;
+    for (int a=0; a<list->maxtex; ++a) {
+        if(!list->tex[a] || list->tex_stride[a] || ISCONST(list, ATT_MULTITEXCOORD0+a))
+            continue;
+        const GLfloat *t = list->tex[a];
+        int size = 2;
+        for (int i=0; i<len && size<4; ++i, t+=4) {
+            if(t[3]!=1.f)
+                size = 4;
+            else if(t[2]!=0.f)
+                size = 3;
+        }
+        if(size==4)
+            continue;
+        GLfloat *dst = list->tex_compact[a] = (GLfloat*)malloc((size_t)len*size*sizeof(GLfloat));
+        list->tex_size[a] = size;
+        t = list->tex[a];
+        for (int i=0; i<len; ++i, t+=4, dst+=size)
+            memcpy(dst, t, size*sizeof(GLfloat));
     }
-    if(list->fogcoord) {
-        list->vbo_fogcoord = (GLfloat*)work[imax].vbo_base;
-        imax++;
+    // the float arrays are not needed anymore, unless another list shares them
+    if(list->shared_arrays && *list->shared_arrays)
+        return;
+    if(list->color_ub) {
+        free_renderlist_array(list, list->color, 4, RLARRAY_COLOR);
+        list->pooled_arrays &= ~(1<<RLARRAY_COLOR);
+        list->color = NULL;
     }
-    if(list->normal) {
-        list->vbo_normal = (GLfloat*)work[imax].vbo_base;
-        imax++;
+    for (int a=0; a<list->maxtex; ++a)
+        if(list->tex_compact[a]) {
+            free_renderlist_array(list, list->tex[a], 4, RLARRAY_TEX0+a);
+            list->pooled_arrays &= ~(1<<(RLARRAY_TEX0+a));
+            list->tex[a] = NULL;
+        }
+}
+
+// rebuild the float arrays freed by compact_renderlist (the narrow formats are lossless)
+void expand_renderlist(renderlist_t *list) {
+    if(list->color_ub && !list->color) {
+        GLfloat *c = list->color = alloc_renderlist_array(list, 4, RLARRAY_COLOR);
+        for (int i=0; i<list->len*4; ++i)
+            c[i] = list->color_ub[i]/255.0f;
     }
     for (int a=0; a<list->maxtex; ++a) {
-        if(list->tex[a]) {
-            list->vbo_tex[a] = (GLfloat*)work[imax].vbo_base;
-            imax++;
+        if(!list->tex_compact[a] || list->tex[a])
+            continue;
+        const int size = list->tex_size[a];
+        const GLfloat *src = list->tex_compact[a];
+        GLfloat *t = list->tex[a] = alloc_renderlist_array(list, 4, RLARRAY_TEX0+a);
+        for (int i=0; i<list->len; ++i, t+=4, src+=size) {
+            t[0] = src[0];
+            t[1] = src[1];
+            t[2] = (size>2)?src[2]:0.f;
+            t[3] = 1.f;
         }
     }
-
-    return 2;
 }
+
 typedef struct save_vbo_s {
     GLuint          real_buffer;
     const GLvoid*   real_pointer;
@@ -161,7 +236,7 @@ void listActiveVBO(renderlist_t* list, save_vbo_t* saved) {
         glstate->vao->vertexattrib[ATT_VERTEX].real_pointer = list->vbo_vert;
         glstate->vao->vertexattrib[ATT_VERTEX].buffer = NULL;
     }
-    if(list->color) {
+    if(list->color || list->color_ub) {
         saved[ATT_COLOR].real_buffer = glstate->vao->vertexattrib[ATT_COLOR].real_buffer;
         saved[ATT_COLOR].real_pointer = glstate->vao->vertexattrib[ATT_COLOR].real_pointer;
         saved[ATT_COLOR].buffer = glstate->vao->vertexattrib[ATT_COLOR].buffer;
@@ -194,7 +269,7 @@ void listActiveVBO(renderlist_t* list, save_vbo_t* saved) {
         glstate->vao->vertexattrib[ATT_NORMAL].buffer = NULL;
     }
     for (int a=0; a<list->maxtex; ++a) {
-        if(list->tex[a]) {
+        if(list->tex[a] || list->tex_compact[a]) {
             saved[ATT_MULTITEXCOORD0+a].real_buffer = glstate->vao->vertexattrib[ATT_MULTITEXCOORD0+a].real_buffer;
             saved[ATT_MULTITEXCOORD0+a].real_pointer = glstate->vao->vertexattrib[ATT_MULTITEXCOORD0+a].real_pointer;
             saved[ATT_MULTITEXCOORD0+a].buffer = glstate->vao->vertexattrib[ATT_MULTITEXCOORD0+a].buffer;
@@ -210,7 +285,7 @@ void listInactiveVBO(renderlist_t* list, save_vbo_t* saved) {
         glstate->vao->vertexattrib[ATT_VERTEX].real_pointer = saved[ATT_VERTEX].real_pointer;
         glstate->vao->vertexattrib[ATT_VERTEX].buffer = saved[ATT_VERTEX].buffer;
     }
-    if(list->color) {
+    if(list->color || list->color_ub) {
         glstate->vao->vertexattrib[ATT_COLOR].real_buffer = saved[ATT_COLOR].real_buffer;
         glstate->vao->vertexattrib[ATT_COLOR].real_pointer = saved[ATT_COLOR].real_pointer;
         glstate->vao->vertexattrib[ATT_COLOR].buffer = saved[ATT_COLOR].buffer;
@@ -231,7 +306,7 @@ void listInactiveVBO(renderlist_t* list, save_vbo_t* saved) {
         glstate->vao->vertexattrib[ATT_NORMAL].buffer = saved[ATT_NORMAL].buffer;
     }
     for (int a=0; a<list->maxtex; ++a) {
-        if(list->tex[a]) {
+        if(list->tex[a] || list->tex_compact[a]) {
             glstate->vao->vertexattrib[ATT_MULTITEXCOORD0+a].real_buffer = saved[ATT_MULTITEXCOORD0+a].real_buffer;
             glstate->vao->vertexattrib[ATT_MULTITEXCOORD0+a].real_pointer = saved[ATT_MULTITEXCOORD0+a].real_pointer;
             glstate->vao->vertexattrib[ATT_MULTITEXCOORD0+a].buffer = saved[ATT_MULTITEXCOORD0+a].buffer;
@@ -245,8 +320,8 @@ int fill_lineIndices(modeinit_t *modes, int length, GLenum mode, GLushort* indic
     int k=0;
     int i=0;
     for (int m=0; m<length; m++) {
-        GLenum mode_init = modes[k].mode_init;
-        int len = modes[k].ilen;
+        GLenum mode_init = modes[m].mode_init;
+        int len = modes[m].ilen;
         switch (mode) {
             case GL_TRIANGLE_STRIP:
                 // first 3 points a triangle, then a 2 lines per new point
@@ -359,8 +434,40 @@ int fill_lineIndices(modeinit_t *modes, int length, GLenum mode, GLushort* indic
     return k;
 }
 
+// edges of the polygons for glPolygonMode(GL_LINE), built once, with shared edges drawn only once
+static void draw_lineIndices(renderlist_t *list, GLenum mode, GLushort *indices, int len) {
+    LOAD_GLES_FPE(glDrawElements);
+    if(!list->ind_lines) {
+        list->ind_lines = (GLushort*)malloc(sizeof(GLushort)*len*4+2);
+        modeinit_t tmp; tmp.mode_init = list->mode_init; tmp.ilen=len;
+        int k = fill_lineIndices(list->mode_inits?list->mode_inits:&tmp, list->mode_inits?list->mode_init_len:1, list->mode, indices, list->ind_lines);
+        list->ind_line = wireframe_unique(list->ind_lines, k);
+        if(hardext.esversion>1 && globals4es.usevbo && list->name && list->ind_line) {
+            LOAD_GLES2(glGenBuffers);
+            LOAD_GLES2(glBufferData);
+            gles_glGenBuffers(1, &list->vbo_lines);
+            bindBuffer(GL_ELEMENT_ARRAY_BUFFER, list->vbo_lines);
+            gles_glBufferData(GL_ELEMENT_ARRAY_BUFFER, list->ind_line*sizeof(GLushort), list->ind_lines, GL_STATIC_DRAW);
+        }
+    }
+    bindBuffer(GL_ELEMENT_ARRAY_BUFFER, list->vbo_lines);
+    gles_glDrawElements(mode, list->ind_line, GL_UNSIGNED_SHORT, list->vbo_lines?NULL:list->ind_lines);
+}
+
+// texgen of compiled lists is done once, and then only when its state or the modelview change
+static void list_tex_coords(renderlist_t *list, int a, GLushort *indices, GLint *needclean) {
+    if(list->name && texgen_cache_get(list->texgen_cache[a], a, glstate->texgened[a], list->len)) {
+        *needclean = 0;
+        return;
+    }
+    gen_tex_coords(list->vert, list->normal, &glstate->texgened[a], list->len, needclean, a, (list->ilen<list->len)?indices:NULL, (list->ilen<list->len)?list->ilen:0);
+    if(list->name && !(*needclean))
+        list->texgen_cache[a] = texgen_cache_put(list->texgen_cache[a], a, glstate->texgened[a], list->len);
+}
+
 void draw_renderlist(renderlist_t *list) {
     if (!list) return;
+    TRACE_BEGIN(draw_renderlist);
     // go to 1st...
     while (list->prev) list = list->prev;
     // ok, go on now, draw everything
@@ -383,6 +490,7 @@ void draw_renderlist(renderlist_t *list) {
     GLint needclean[MAX_TEX] = {0};
     bool stipple;
     int stipple_tmu;
+    int stipple_alloc;
     GLenum stipple_env;
     GLenum stipple_afunc;
     GLfloat stipple_aref;
@@ -402,8 +510,13 @@ void draw_renderlist(renderlist_t *list) {
             gl4es_glPopAttrib();
         call_list_t *cl = &list->calls;
         if (cl->len > 0) {
-            for (int i = 0; i < cl->len; i++) {
-                glPackedCall(cl->calls[i]);
+            // direct threaded: each record carries its own handler
+            char *p = cl->calls;
+            char *end = p + cl->size;
+            while (p < end) {
+                const call_header_t *header = (const call_header_t*)p;
+                header->exec((const packed_call_t*)(p + CALL_HEADER_SIZE));
+                p += header->size;
             }
         }
         if(list->render_op) {
@@ -414,23 +527,24 @@ void draw_renderlist(renderlist_t *list) {
                 case 4: gl4es_glLoadName(list->render_arg); break;
             }
         }
-        if (list->fog_op) {
-            gl4es_glFogfv(GL_FOG_COLOR, list->fog_val);
+        renderlist_ops_t *ops = list->ops;
+        if (ops && ops->fog_op) {
+            gl4es_glFogfv(GL_FOG_COLOR, ops->fog_val);
         }
-        if (list->pointparam_op) {
-            switch (list->pointparam_op) {
+        if (ops && ops->pointparam_op) {
+            switch (ops->pointparam_op) {
                 case 1: // GL_POINT_DISTANCE_ATTENUATION 
-                    gl4es_glPointParameterfv(GL_POINT_DISTANCE_ATTENUATION , list->pointparam_val);
+                    gl4es_glPointParameterfv(GL_POINT_DISTANCE_ATTENUATION , ops->pointparam_val);
                     break;
             }
         }
-        if (list->matrix_op) {
-            switch (list->matrix_op) {
+        if (ops && ops->matrix_op) {
+            switch (ops->matrix_op) {
                 case 1: // load
-                    gl4es_glLoadMatrixf(list->matrix_val);
+                    gl4es_glLoadMatrixf(ops->matrix_val);
                     break;
                 case 2: // mult
-                    gl4es_glMultMatrixf(list->matrix_val);
+                    gl4es_glMultMatrixf(ops->matrix_val);
                     break;
             }
         }
@@ -441,15 +555,15 @@ void draw_renderlist(renderlist_t *list) {
             gl4es_glBindTexture(list->target_texture, list->texture);
         }
         // raster
-        if (list->raster_op) {
-            if (list->raster_op==1) {
-                gl4es_glRasterPos3f(list->raster_xyz[0], list->raster_xyz[1], list->raster_xyz[2]);
-            } else if (list->raster_op==2) {
-                gl4es_glWindowPos3f(list->raster_xyz[0], list->raster_xyz[1], list->raster_xyz[2]);
-            } else if (list->raster_op==3) {
-                gl4es_glPixelZoom(list->raster_xyz[0], list->raster_xyz[1]);
-            } else if ((list->raster_op&0x10000) == 0x10000) {
-                gl4es_glPixelTransferf(list->raster_op&0xFFFF, list->raster_xyz[0]);
+        if (ops && ops->raster_op) {
+            if (ops->raster_op==1) {
+                gl4es_glRasterPos3f(ops->raster_xyz[0], ops->raster_xyz[1], ops->raster_xyz[2]);
+            } else if (ops->raster_op==2) {
+                gl4es_glWindowPos3f(ops->raster_xyz[0], ops->raster_xyz[1], ops->raster_xyz[2]);
+            } else if (ops->raster_op==3) {
+                gl4es_glPixelZoom(ops->raster_xyz[0], ops->raster_xyz[1]);
+            } else if ((ops->raster_op&0x10000) == 0x10000) {
+                gl4es_glPixelTransferf(ops->raster_op&0xFFFF, ops->raster_xyz[0]);
             }
         }
         if (list->raster) {
@@ -465,8 +579,8 @@ void draw_renderlist(renderlist_t *list) {
             }
         }
 
-        if (list->material) {
-            khash_t(material) *map = list->material;
+        if (ops && ops->material) {
+            khash_t(material) *map = ops->material;
             rendermaterial_t *m;
             kh_foreach_value(map, m,
                 switch (m->pname) {
@@ -480,8 +594,8 @@ void draw_renderlist(renderlist_t *list) {
         }
         if (list->colormat_face)
             gl4es_glColorMaterial(list->colormat_face, list->colormat_mode);
-        if (list->light) {
-            khash_t(light) *lig = list->light;
+        if (ops && ops->light) {
+            khash_t(light) *lig = ops->light;
             renderlight_t *m;
             kh_foreach_value(lig, m,
                 switch (m->pname) {
@@ -490,12 +604,12 @@ void draw_renderlist(renderlist_t *list) {
                 }
             )
         }
-        if (list->lightmodel) {
-            gl4es_glLightModelfv(list->lightmodelparam, list->lightmodel);
+        if (ops && ops->lightmodel) {
+            gl4es_glLightModelfv(ops->lightmodelparam, ops->lightmodel);
         }
 
-        if (list->linestipple_op) {
-            gl4es_glLineStipple(list->linestipple_factor, list->linestipple_pattern);
+        if (ops && ops->linestipple_op) {
+            gl4es_glLineStipple(ops->linestipple_factor, ops->linestipple_pattern);
         }
 		
         if (list->texenv) {
@@ -529,6 +643,21 @@ void draw_renderlist(renderlist_t *list) {
         if(!use_vbo_indices &&  (hardext.esversion==1 || globals4es.usevbo==0 || !list->name)) {
             use_vbo_indices = 1;
         }
+        GLfloat saved_mv[17];
+        if(list->pretransform)
+            pretransform_modelview(1, saved_mv);
+        // compiled lists use the narrowest formats on ES2+ (see compact_renderlist)
+        const int compact = (hardext.esversion>1 && list->name && !list->use_glstate);
+        if(compact && !list->compact)
+            compact_renderlist(list);
+        const unsigned int const_attribs = compact?list->const_attribs:0;
+        unsigned int hoisted = 0;
+        GLfloat saved_vavalue[MAX_VATTRIB][4];
+        // constant attribute: use the generic value instead of an array
+        #define HOIST(att, arr, n) \
+            memcpy(saved_vavalue[att], glstate->vavalue[att], 4*sizeof(GLfloat)); \
+            memcpy(glstate->vavalue[att], arr, n*sizeof(GLfloat)); \
+            hoisted |= 1u<<(att)
         if (list->vert) {
             fpe_glEnableClientState(GL_VERTEX_ARRAY);
             gles_glVertexPointer(4, GL_FLOAT, list->vert_stride, list->vert);
@@ -536,18 +665,21 @@ void draw_renderlist(renderlist_t *list) {
             fpe_glDisableClientState(GL_VERTEX_ARRAY);
         }
 
-        if (list->normal) {
+        if (list->normal && !(const_attribs & (1u<<ATT_NORMAL))) {
             fpe_glEnableClientState(GL_NORMAL_ARRAY);
             gles_glNormalPointer(GL_FLOAT, list->normal_stride, list->normal);
         } else {
             fpe_glDisableClientState(GL_NORMAL_ARRAY);
+            if (list->normal) {
+                HOIST(ATT_NORMAL, list->normal, 3);
+            }
         }
     
         indices = list->indices;
 
         if(glstate->raster.bm_drawing)
             bitmap_flush();
-        if (list->color) {
+        if ((list->color || list->color_ub) && !(const_attribs & (1u<<ATT_COLOR))) {
             fpe_glEnableClientState(GL_COLOR_ARRAY);
             if (glstate->enable.color_sum && (list->secondary) && hardext.esversion==1 && !list->use_glstate) {
                 if(!list->final_colors) {
@@ -564,40 +696,72 @@ void draw_renderlist(renderlist_t *list) {
                     }
                 }
                 gles_glColorPointer(4, GL_FLOAT, 0, list->final_colors);
+            } else if (compact && list->color_ub) {
+                gles_glColorPointer(4, GL_UNSIGNED_BYTE, 0, list->color_ub);
             } else {
 //printf("colors=%f, %f, %f, %f / %f, %f, %f, %f\n", list->color[0],list->color[1],list->color[2],list->color[3], list->color[4],list->color[5],list->color[6],list->color[7]);
                 gles_glColorPointer(4, GL_FLOAT, list->color_stride, list->color);
             }
         } else {
             fpe_glDisableClientState(GL_COLOR_ARRAY);
+            if (list->color) {
+                HOIST(ATT_COLOR, list->color, 4);
+            }
         }
         if(hardext.esversion > 1) {
             // secondary color only on ES2+
-            if (glstate->enable.color_sum && (list->secondary)) {
+            if (glstate->enable.color_sum && (list->secondary) && !(const_attribs & (1u<<ATT_SECONDARY))) {
                 fpe_glEnableClientState(GL_SECONDARY_COLOR_ARRAY);
                 fpe_glSecondaryColorPointer(4, GL_FLOAT, list->secondary_stride, list->secondary);
             } else {
                 fpe_glDisableClientState(GL_SECONDARY_COLOR_ARRAY);
+                if (glstate->enable.color_sum && (list->secondary)) {
+                    HOIST(ATT_SECONDARY, list->secondary, 4);
+                }
             }
             // fog coord only on ES2+
-            if ((glstate->fog.coord_src==GL_FOG_COORD) && (list->fogcoord)) {
+            if ((glstate->fog.coord_src==GL_FOG_COORD) && (list->fogcoord) && !(const_attribs & (1u<<ATT_FOGCOORD))) {
                 fpe_glEnableClientState(GL_FOG_COORD_ARRAY);
                 fpe_glFogCoordPointer(GL_FLOAT, list->fogcoord_stride, list->fogcoord);
             } else {
                 fpe_glDisableClientState(GL_FOG_COORD_ARRAY);
+                if ((glstate->fog.coord_src==GL_FOG_COORD) && (list->fogcoord)) {
+                    HOIST(ATT_FOGCOORD, list->fogcoord, 1);
+                }
             }
         }
         #define TEXTURE(A) if (cur_tex!=A) {gl4es_glClientActiveTexture(A+GL_TEXTURE0); cur_tex=A;}
         stipple = false;
         if ((list->mode == GL_LINES || list->mode == GL_LINE_STRIP || list->mode == GL_LINE_LOOP)
                 && glstate->enable.line_stipple) {
-            stipple = true;
-            if(get_target(glstate->enable.texture[0])!=-1)
-                stipple_tmu = 1;
-            else
-                stipple_tmu = 0;
+            // use a TMU without texture nor texcoords
+            stipple_tmu = -1;
+            for (int a=0; a<hardext.maxtex && stipple_tmu==-1; a++)
+                if(get_target(glstate->enable.texture[a])==-1 && !list->tex[a] && !list->tex_compact[a])
+                    stipple_tmu = a;
+            stipple = (stipple_tmu!=-1);
         }
-        if (stipple) {
+        stipple_alloc = stipple && !(list->use_glstate && stipple_tmu<2);
+        if (stipple && hardext.esversion>1) {
+            // the FPE shader does the pattern test, only the texcoord is needed here
+            if(!use_vbo_array) use_vbo_array = 1;
+            if(list->mode == GL_LINES && !list->indices) {
+                // anchors don't depend on the matrices, so they are kept with the list
+                glstate->fpe_state->linestipple = FPE_STIPPLE_ANCHOR;
+                if(stipple_alloc) {
+                    if(!list->stipple)
+                        list->stipple = gen_stipple_anchors(list->vert, list->len, list->vert_stride, NULL);
+                    list->tex[stipple_tmu] = list->stipple;
+                    stipple_alloc = 0;
+                } else
+                    list->tex[stipple_tmu] = gen_stipple_anchors(list->vert, list->len, list->vert_stride, list->vert+8+stipple_tmu*4);
+            } else {
+                glstate->fpe_state->linestipple = FPE_STIPPLE_DIST;
+                modeinit_t tmp; tmp.mode_init = list->mode_init; tmp.ilen=list->ilen?list->ilen:list->len;
+                list->tex[stipple_tmu] = gen_stipple_tex_coords(list->vert, list->indices, list->mode_inits?list->mode_inits:&tmp, list->vert_stride, list->mode_inits?list->mode_init_len:1, 1.f/glstate->linestipple.factor, stipple_alloc?NULL:(list->vert+8+stipple_tmu*4));
+            }
+            glstate->fpe_state->linestipple_tmu = stipple_tmu;
+        } else if (stipple) {
             if(!use_vbo_array) use_vbo_array = 1;
             stipple_old = glstate->gleshard->active;
             if(glstate->gleshard->active!=stipple_tmu) {
@@ -627,7 +791,7 @@ void draw_renderlist(renderlist_t *list) {
             gl4es_glAlphaFunc(GL_GREATER, 0.0f);
             bind_stipple_tex();
             modeinit_t tmp; tmp.mode_init = list->mode_init; tmp.ilen=list->ilen?list->ilen:list->len;
-            list->tex[stipple_tmu] = gen_stipple_tex_coords(list->vert, list->indices, list->mode_inits?list->mode_inits:&tmp, list->vert_stride, list->mode_inits?list->mode_init_len:1, (list->use_glstate)?(list->vert+8+stipple_tmu*4):NULL);
+            list->tex[stipple_tmu] = gen_stipple_tex_coords(list->vert, list->indices, list->mode_inits?list->mode_inits:&tmp, list->vert_stride, list->mode_inits?list->mode_init_len:1, 1.f/(glstate->linestipple.factor*16.f), stipple_alloc?NULL:(list->vert+8+stipple_tmu*4));
         }
         #define RS(A, len) if(glstate->texgenedsz[A]<len) {free(glstate->texgened[A]); glstate->texgened[A]=malloc(4*sizeof(GLfloat)*len); glstate->texgenedsz[A]=len; } use_texgen[A]=1
         // cannot use list->maxtex because some TMU can be using TexGen or point sprites...
@@ -640,10 +804,10 @@ void draw_renderlist(renderlist_t *list) {
                     if ((glstate->enable.texgen_s[a] || glstate->enable.texgen_t[a] || glstate->enable.texgen_r[a]  || glstate->enable.texgen_q[a])) {
                         TEXTURE(a);
                         RS(a, list->len);
-                        gen_tex_coords(list->vert, list->normal, &glstate->texgened[a], list->len, &needclean[a], a, (list->ilen<list->len)?indices:NULL, (list->ilen<list->len)?list->ilen:0);
+                        list_tex_coords(list, a, indices, &needclean[a]);
                     } else if ((list->tex[a]==NULL) && !(list->mode==GL_POINT && glstate->texture.pscoordreplace[a])) {
                         RS(a, list->len);
-                        gen_tex_coords(list->vert, list->normal, &glstate->texgened[a], list->len, &needclean[a], a, (list->ilen<list->len)?indices:NULL, (list->ilen<list->len)?list->ilen:0);
+                        list_tex_coords(list, a, indices, &needclean[a]);
                     }
                     // adjust the tex_coord now if needed, even on texgened ones
                     gltexture_t *bound = glstate->texture.bound[a][itarget];
@@ -691,13 +855,21 @@ void draw_renderlist(renderlist_t *list) {
         } else {
             // texture loop for ES2+ version
             for (int a=0; a<hardext.maxtex; a++) {
-                if(list->tex[a]) {
+                // the stipple texcoords are generated for this draw only
+                const int tex_compact = compact && !(stipple && a==stipple_tmu);
+                if((list->tex[a] || list->tex_compact[a]) && !(tex_compact && (const_attribs & (1u<<(ATT_MULTITEXCOORD0+a))))) {
                     TEXTURE(a);
                     fpe_glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-                    gles_glTexCoordPointer(4, GL_FLOAT, list->tex_stride[a], list->tex[a]);
+                    if(tex_compact && list->tex_compact[a])
+                        gles_glTexCoordPointer(list->tex_size[a], GL_FLOAT, 0, list->tex_compact[a]);
+                    else
+                        gles_glTexCoordPointer(4, GL_FLOAT, list->tex_stride[a], list->tex[a]);
                 } else {
                     TEXTURE(a);
                     fpe_glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+                    if(list->tex[a]) {
+                        HOIST(ATT_MULTITEXCOORD0+a, list->tex[a], 4);
+                    }
                 }
             }
         }
@@ -740,15 +912,7 @@ void draw_renderlist(renderlist_t *list) {
             } else {
                 GLuint old_index = wantBufferIndex(0);
                 if (glstate->polygon_mode == GL_LINE && list->mode_init>=GL_TRIANGLES) {
-                    int ilen = list->ilen;
-                    if(!list->ind_lines) {
-                        GLushort *ind_line = list->ind_lines = (GLushort*)malloc(sizeof(GLushort)*ilen*4+2);
-                        modeinit_t tmp; tmp.mode_init = list->mode_init; tmp.ilen=list->ilen;
-                        int k = fill_lineIndices(list->mode_inits?list->mode_inits:&tmp, list->mode_inits?list->mode_init_len:1, list->mode, indices, list->ind_lines);
-                        list->ind_line = k;
-                    }
-                    bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-                    gles_glDrawElements(mode, list->ind_line, GL_UNSIGNED_SHORT, list->ind_lines);
+                    draw_lineIndices(list, mode, indices, list->ilen);
                     use_vbo_indices = 1;
                 } else {
                     int vbo_indices = 0;
@@ -788,14 +952,7 @@ void draw_renderlist(renderlist_t *list) {
             } else {
                 int len = list->len;
                 if ((glstate->polygon_mode == GL_LINE) && (list->mode_init>=GL_TRIANGLES)) {
-                    if(!list->ind_lines) {
-                        GLushort *ind_line = list->ind_lines = (GLushort*)malloc(sizeof(GLushort)*len*4+2);
-                        modeinit_t tmp; tmp.mode_init = list->mode_init; tmp.ilen=len;
-                        int k = fill_lineIndices(list->mode_inits?list->mode_inits:&tmp, list->mode_inits?list->mode_init_len:1, list->mode, NULL, list->ind_lines);
-                        list->ind_line = k;
-                    }
-                    bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-					gles_glDrawElements(mode, list->ind_line, GL_UNSIGNED_SHORT, list->ind_lines);
+                    draw_lineIndices(list, mode, NULL, len);
                 } else {
                     if(list->instanceCount==1)
                         gles_glDrawArrays(mode, 0, len);
@@ -811,6 +968,14 @@ void draw_renderlist(renderlist_t *list) {
             list->use_vbo_indices = use_vbo_indices;
         if(use_vbo_array==2)
             listInactiveVBO(list, saved);
+        if(hoisted) {
+            for (int i=0; i<MAX_VATTRIB; ++i)
+                if(hoisted & (1u<<i))
+                    memcpy(glstate->vavalue[i], saved_vavalue[i], 4*sizeof(GLfloat));
+        }
+        #undef HOIST
+        if(list->pretransform)
+            pretransform_modelview(0, saved_mv);
 
         #define TEXTURE(A) if (cur_tex!=A) {gl4es_glClientActiveTexture(A+GL_TEXTURE0); cur_tex=A;}
         if(hardext.esversion==1)
@@ -829,9 +994,14 @@ void draw_renderlist(renderlist_t *list) {
         #undef TEXTURE
 
         if (stipple) {
-            if(!list->use_glstate)   //TODO: avoid that malloc/free...
+            if(stipple_alloc)
                 free(list->tex[stipple_tmu]);
             list->tex[stipple_tmu]=NULL;
+        }
+        if (stipple && hardext.esversion>1) {
+            glstate->fpe_state->linestipple = 0;
+            glstate->fpe_state->linestipple_tmu = 0;
+        } else if (stipple) {
             LOAD_GLES(glActiveTexture);
             if(glstate->gleshard->active!=stipple_tmu)
                 gl4es_glActiveTexture(GL_TEXTURE0+stipple_tmu);
@@ -861,4 +1031,5 @@ void draw_renderlist(renderlist_t *list) {
         if(list->post_normal) gl4es_glNormal3fv(list->post_normals);
     } while ((list = list->next));
     gl4es_glPopClientAttrib();
+    TRACE_END(draw_renderlist);
 }
@@ -13,7 +13,7 @@ static inline void rlVertexCommon(renderlist_t *list, int idx, int l) {
         if (list->normal)   memcpy(list->normal + idx, list->lastNormal, sizeof(GLfloat) * 3);
         if (list->fogcoord) memcpy(list->fogcoord + idx, glstate->fogcoord, sizeof(GLfloat) * 1);
     } else {
-        if (!list->vert)    list->vert = alloc_sublist(4, list->cap); 
+        if (!list->vert)    list->vert = alloc_renderlist_array(list, 4, RLARRAY_VERT); 
         else                resize_renderlist(list);
         if (list->normal)   memcpy(list->normal + (l * 3), list->lastNormal, sizeof(GLfloat) * 3);
         if (list->fogcoord) memcpy(list->fogcoord + (l * 1), glstate->fogcoord, sizeof(GLfloat) * 1);
@@ -34,6 +34,7 @@ void FASTMATH rlVertex4f(renderlist_t *list, GLfloat x, GLfloat y, GLfloat z, GL
 
     GLfloat * const vert = list->vert + idx;
     vert[0] = x; vert[1] = y; vert[2] = z; vert[3] = w;
+    if(list->pretransform) vector_matrix(vert, getMVMat(), vert);
 }
 void FASTMATH rlVertex3fv(renderlist_t *list, GLfloat* v) {
     const int idx = (list->use_glstate)?(list->len * 5*4):(list->len * 4);
@@ -43,6 +44,7 @@ void FASTMATH rlVertex3fv(renderlist_t *list, GLfloat* v) {
     ++list->len;
     memcpy(vert, v, 3*sizeof(GLfloat));
     vert[3] = 1.f;
+    if(list->pretransform) vector_matrix(vert, getMVMat(), vert);
 }
 void FASTMATH rlVertex4fv(renderlist_t *list, GLfloat* v) {
     const int idx = (list->use_glstate)?(list->len * 5*4):(list->len * 4);
@@ -51,6 +53,7 @@ void FASTMATH rlVertex4fv(renderlist_t *list, GLfloat* v) {
     GLfloat * const vert = list->vert + idx;
     ++list->len;
     memcpy(vert, v, 4*sizeof(GLfloat));
+    if(list->pretransform) vector_matrix(vert, getMVMat(), vert);
 }
 
 void rlEnd(renderlist_t *list) {
@@ -149,7 +152,7 @@ static inline void rlNormalCommon(renderlist_t *list) {
         if(list->use_glstate) {
             list->normal = glstate->merger_master+4+4+2*4;
         } else {
-            list->normal = alloc_sublist(3, list->cap);
+            list->normal = alloc_renderlist_array(list, 3, RLARRAY_NORMAL);
         }
         // catch up
         for (int i = 0; i < list->len; i++) {
@@ -177,7 +180,7 @@ static inline void rlColorCommon(renderlist_t *list) {
         if(list->use_glstate) {
             list->color = glstate->merger_master+4;
         } else {
-            list->color = alloc_sublist(4, list->cap);
+            list->color = alloc_renderlist_array(list, 4, RLARRAY_COLOR);
         }
         // catch up
         for (int i = 0; i < list->len; i++) {
@@ -205,7 +208,7 @@ void FASTMATH rlSecondary3f(renderlist_t *list, GLfloat r, GLfloat g, GLfloat b)
                 glstate->merger_secondary = (GLfloat*)malloc(sizeof(GLfloat)*4*glstate->merger_cap);
             list->secondary = glstate->merger_secondary;
         } else {
-            list->secondary = alloc_sublist(4, list->cap);
+            list->secondary = alloc_renderlist_array(list, 4, RLARRAY_SECONDARY);
         }
         // catch up
         GLfloat *secondary = list->secondary;
@@ -224,13 +227,14 @@ void rlMaterialfv(renderlist_t *list, GLenum face, GLenum pname, const GLfloat *
     khash_t(material) *map;
     khint_t k;
     int ret;
-    if (! list->material) {
-        list->material = map = kh_init(material);
+    renderlist_ops_t *ops = get_renderlist_ops(list);
+    if (! ops->material) {
+        ops->material = map = kh_init(material);
         // segfaults if we don't do a single put
         kh_put(material, map, 1, &ret);
         kh_del(material, map, 1);
     } else {
-        map = list->material;
+        map = ops->material;
     }
 
     int iface = (face==GL_FRONT)?0:((face==GL_BACK)?1:2);
@@ -255,13 +259,14 @@ void rlLightfv(renderlist_t *list, GLenum which, GLenum pname, const GLfloat * p
     khash_t(light) *map;
     khint_t k;
     int ret;
-    if (! list->light) {
-        list->light = map = kh_init(light);
+    renderlist_ops_t *ops = get_renderlist_ops(list);
+    if (! ops->light) {
+        ops->light = map = kh_init(light);
         // segfaults if we don't do a single put
         kh_put(light, map, 1, &ret);
         kh_del(light, map, 1);
     } else {
-        map = list->light;
+        map = ops->light;
     }
 
 	int key = pname | ((which-GL_LIGHT0)<<16);
@@ -324,7 +329,7 @@ void rlMultiTexCoordCommon(renderlist_t* list, int tmu) {
                 list->tex[tmu] = glstate->merger_tex[tmu-2];
             }
         } else {
-            list->tex[tmu] = alloc_sublist(4, list->cap);
+            list->tex[tmu] = alloc_renderlist_array(list, 4, RLARRAY_TEX0+tmu);
         }
         // catch up
         GLfloat *tex = list->tex[tmu];
@@ -364,7 +369,7 @@ void FASTMATH rlFogCoordf(renderlist_t *list, GLfloat coord) {
         if(list->use_glstate) {
             list->fogcoord = glstate->merger_master+4+4+2*4+3;
         } else {
-            list->fogcoord = alloc_sublist(1, list->cap);
+            list->fogcoord = alloc_renderlist_array(list, 1, RLARRAY_FOGCOORD);
         }
         // catch up
         GLfloat *fog = list->fogcoord;
@@ -389,40 +394,50 @@ void rlBindTexture(renderlist_t *list, GLenum target, GLuint texture) {
 }
 
 void rlRasterOp(renderlist_t *list, int op, GLfloat x, GLfloat y, GLfloat z) {
-    list->raster_op = op;
-    list->raster_xyz[0] = x;
-    list->raster_xyz[1] = y;
-    list->raster_xyz[2] = z;
+    renderlist_ops_t *ops = get_renderlist_ops(list);
+    ops->raster_op = op;
+    ops->raster_xyz[0] = x;
+    ops->raster_xyz[1] = y;
+    ops->raster_xyz[2] = z;
 }
 
 void rlFogOp(renderlist_t *list, int op, const GLfloat* v) {
     int n = 1;
     if (op==GL_FOG_COLOR) n = 4;
-    list->fog_op = op;
-    list->fog_val[0] = v[0];
-    if (n>1) list->fog_val[1] = v[1];
-    if (n>2) list->fog_val[2] = v[2];
-    if (n>3) list->fog_val[3] = v[3];
+    renderlist_ops_t *ops = get_renderlist_ops(list);
+    ops->fog_op = op;
+    ops->fog_val[0] = v[0];
+    if (n>1) ops->fog_val[1] = v[1];
+    if (n>2) ops->fog_val[2] = v[2];
+    if (n>3) ops->fog_val[3] = v[3];
 }
 
 void rlPointParamOp(renderlist_t *list, int op, const GLfloat* v) {
-    list->pointparam_op = op;
-    list->pointparam_val[0] = v[0];
-    list->pointparam_val[1] = v[1];
-    list->pointparam_val[2] = v[2];
-    list->pointparam_val[3] = v[3];
+    renderlist_ops_t *ops = get_renderlist_ops(list);
+    ops->pointparam_op = op;
+    ops->pointparam_val[0] = v[0];
+    ops->pointparam_val[1] = v[1];
+    ops->pointparam_val[2] = v[2];
+    ops->pointparam_val[3] = v[3];
 }
 
-void rlPushCall(renderlist_t *list, packed_call_t *data) {
+void* rlAllocCall(renderlist_t *list, int format, int size) {
+    // bump allocate the packed call in the list command buffer
     call_list_t *cl = &list->calls;
-    if (!cl->calls) {
-        cl->cap = DEFAULT_CALL_LIST_CAPACITY;
-        cl->calls = malloc(DEFAULT_CALL_LIST_CAPACITY * sizeof(void*));
-    } else if (list->calls.len == list->calls.cap) {
-        cl->cap += DEFAULT_CALL_LIST_CAPACITY;
-        cl->calls = realloc(cl->calls, cl->cap * sizeof(void*));
+    unsigned int rec = CALL_HEADER_SIZE + CALL_ALIGN(size);
+    if (cl->size + rec > cl->cap) {
+        if (!cl->cap)
+            cl->cap = DEFAULT_CALL_LIST_CAPACITY;
+        while (cl->size + rec > cl->cap)
+            cl->cap <<= 1;
+        cl->calls = realloc(cl->calls, cl->cap);
     }
-    cl->calls[cl->len++] = data;
+    call_header_t *header = (call_header_t*)(cl->calls + cl->size);
+    header->exec = glPackedCallFunc(format);
+    header->size = rec;
+    cl->size += rec;
+    cl->len++;
+    return (char*)header + CALL_HEADER_SIZE;
 }
 
 renderlist_t* GetFirst(renderlist_t* list) {
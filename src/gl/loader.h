@@ -43,6 +43,8 @@ typedef EGLBoolean (*eglReleaseThread_PTR)();
 typedef EGLBoolean (*eglSurfaceAttrib_PTR)(EGLDisplay dpy, EGLSurface surface, EGLint attribute, EGLint value);
 typedef EGLBoolean (*eglSwapBuffers_PTR)(EGLDisplay dpy, EGLSurface surface);
 typedef EGLBoolean (*eglSwapBuffersWithDamageEXT_PTR)(EGLDisplay dpy, EGLSurface surface, EGLint * rects, EGLint n_rects);
+typedef EGLBoolean (*eglSwapBuffersWithDamageKHR_PTR)(EGLDisplay dpy, EGLSurface surface, EGLint * rects, EGLint n_rects);
+typedef EGLBoolean (*eglSetDamageRegionKHR_PTR)(EGLDisplay dpy, EGLSurface surface, EGLint * rects, EGLint n_rects);
 typedef EGLBoolean (*eglSwapInterval_PTR)(EGLDisplay dpy, EGLint interval);
 typedef EGLBoolean (*eglTerminate_PTR)(EGLDisplay dpy);
 typedef EGLBoolean (*eglUnlockSurfaceKHR_PTR)(EGLDisplay display, EGLSurface surface);
@@ -78,6 +80,27 @@ typedef EGLSurface (*eglCreateStreamProducerSurfaceKHR_PTR)(EGLDisplay dpy, EGLC
 #endif // TEXSTREAM
 #endif // NOEGL
 
+// GLES3 functions that are not part of the wrapped GLES spec, to use LOAD_GLES2 on them
+typedef GLvoid* (APIENTRY_GLES * glMapBufferRange_PTR)(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+typedef GLboolean (APIENTRY_GLES * glUnmapBuffer_PTR)(GLenum target);
+typedef void (APIENTRY_GLES * glFlushMappedBufferRange_PTR)(GLenum target, GLintptr offset, GLsizeiptr length);
+typedef GLsync (APIENTRY_GLES * glFenceSync_PTR)(GLenum condition, GLbitfield flags);
+typedef GLenum (APIENTRY_GLES * glClientWaitSync_PTR)(GLsync sync, GLbitfield flags, GLuint64 timeout);
+typedef void (APIENTRY_GLES * glDeleteSync_PTR)(GLsync sync);
+typedef void (APIENTRY_GLES * glGenVertexArrays_PTR)(GLsizei n, GLuint *arrays);
+typedef void (APIENTRY_GLES * glBindVertexArray_PTR)(GLuint array);
+typedef void (APIENTRY_GLES * glDeleteVertexArrays_PTR)(GLsizei n, const GLuint *arrays);
+typedef void (APIENTRY_GLES * glBlitFramebuffer_PTR)(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter);
+// queries, from ES3 or GL_EXT_occlusion_query_boolean / GL_EXT_disjoint_timer_query
+typedef void (APIENTRY_GLES * glGenQueries_PTR)(GLsizei n, GLuint *ids);
+typedef void (APIENTRY_GLES * glDeleteQueries_PTR)(GLsizei n, const GLuint *ids);
+typedef void (APIENTRY_GLES * glBeginQuery_PTR)(GLenum target, GLuint id);
+typedef void (APIENTRY_GLES * glEndQuery_PTR)(GLenum target);
+typedef void (APIENTRY_GLES * glGetQueryiv_PTR)(GLenum target, GLenum pname, GLint *params);
+typedef void (APIENTRY_GLES * glGetQueryObjectuiv_PTR)(GLuint id, GLenum pname, GLuint *params);
+typedef void (APIENTRY_GLES * glGetQueryObjectui64v_PTR)(GLuint id, GLenum pname, GLuint64 *params);
+typedef void (APIENTRY_GLES * glQueryCounter_PTR)(GLuint id, GLenum target);
+
 #ifdef AMIGAOS4
 #include "../agl/amigaos.h"
 #elif !defined(_WIN32)
@@ -233,12 +256,24 @@ EXPORT extern void *egl;
         LOAD_RAW_SILENT(gles, name, proc_address(gles, #name)); \
     }
 
+#define LOAD_GLES2_OR_EXT(name) \
+    DEFINE_RAW(gles, name); \
+    LOAD_RAW_3(gles, name, proc_address(gles, #name), proc_address(gles, #name "EXT"), )
+
 #else // defined(AMIGAOS4) || defined(NOEGL)
 
 #define LOAD_EGL_EXT(name) \
     DEFINE_RAW(egl, name); \
     LOAD_RAW_3(egl, name, proc_address(egl, #name), proc_address(egl, #name "EXT"), LOAD_EGL(eglGetProcAddress); LOAD_RAW(egl, name, egl_eglGetProcAddress(#name "EXT")); )
 
+// EGL extension function, only available thru eglGetProcAddress (NULL if not there)
+#define LOAD_EGL_PROC(name) \
+    DEFINE_RAW(egl, name); \
+    { \
+        LOAD_EGL(eglGetProcAddress); \
+        LOAD_RAW_SILENT(egl, name, egl_eglGetProcAddress(#name)); \
+    }
+
 #define LOAD_GLES_OES(name) \
     DEFINE_RAW(gles, name); \
     { \
@@ -259,6 +294,10 @@ EXPORT extern void *egl;
         LOAD_EGL(eglGetProcAddress); \
         LOAD_RAW_SILENT(gles, name, ((hardext.esversion==1)?((void*)egl_eglGetProcAddress(#name"OES")):((void*)dlsym(gles, #name)))); \
     }
+
+#define LOAD_GLES2_OR_EXT(name) \
+    DEFINE_RAW(gles, name); \
+    LOAD_RAW_3(gles, name, proc_address(gles, #name), proc_address(gles, #name "EXT"), LOAD_EGL(eglGetProcAddress); LOAD_RAW_SILENT(gles, name, egl_eglGetProcAddress(#name "EXT")); )
 #endif // defined(AMIGAOS4) || defined(NOEGL)
 
 #endif // _GL4ES_LOADER_H_
@@ -19,41 +19,28 @@ void alloc_matrix(matrixstack_t **matrixstack, int depth) {
 	*matrixstack = (matrixstack_t*)malloc(sizeof(matrixstack_t));
 	(*matrixstack)->top = 0;
 	(*matrixstack)->identity = 0;
+	(*matrixstack)->affine = 0;
 	(*matrixstack)->stack = (GLfloat*)malloc(sizeof(GLfloat)*depth*16);
 }
 
 #define TOP(A) (glstate->A->stack+(glstate->A->top*16))
+#define TOPOF(A) ((A)->stack+((A)->top*16))
 
-static GLfloat* update_current_mat() {
+static matrixstack_t* current_stack() {
 	switch(glstate->matrix_mode) {
 		case GL_MODELVIEW:
-			return TOP(modelview_matrix);
+			return glstate->modelview_matrix;
 		case GL_PROJECTION:
-			return TOP(projection_matrix);
+			return glstate->projection_matrix;
 		case GL_TEXTURE:
-			return TOP(texture_matrix[glstate->texture.active]);
+			return glstate->texture_matrix[glstate->texture.active];
 		default:
 			if(glstate->matrix_mode>=GL_MATRIX0_ARB && glstate->matrix_mode<GL_MATRIX0_ARB+MAX_ARB_MATRIX)
-				return TOP(arb_matrix[glstate->matrix_mode-GL_MATRIX0_ARB]);
+				return glstate->arb_matrix[glstate->matrix_mode-GL_MATRIX0_ARB];
 			return NULL;
 	}
 }
 
-static int update_current_identity(int I) {
-	switch(glstate->matrix_mode) {
-		case GL_MODELVIEW:
-			return glstate->modelview_matrix->identity = (I)?1:is_identity(TOP(modelview_matrix));
-		case GL_PROJECTION:
-			return glstate->projection_matrix->identity = (I)?1:is_identity(TOP(projection_matrix));
-		case GL_TEXTURE:
-			return glstate->texture_matrix[glstate->texture.active]->identity = (I)?1:is_identity(TOP(texture_matrix[glstate->texture.active]));
-		default:
-			if(glstate->matrix_mode>=GL_MATRIX0_ARB && glstate->matrix_mode<GL_MATRIX0_ARB+MAX_ARB_MATRIX)
-				return glstate->arb_matrix[glstate->matrix_mode-GL_MATRIX0_ARB]->identity = (I)?1:is_identity(TOP(arb_matrix[glstate->matrix_mode-GL_MATRIX0_ARB]));
-		return 0;
-	}
-}
-
 static int send_to_hardware() {
 	if(hardext.esversion>1)
 		return 0;
@@ -71,14 +58,37 @@ static int send_to_hardware() {
 	return 0;
 }
 
+void set_fpe_textureidentity() {
+	if(glstate->texture_matrix[glstate->texture.active]->identity)	// inverted in fpe flags
+		glstate->fpe_state->texture[glstate->texture.active].texmat = 0;
+	else
+		glstate->fpe_state->texture[glstate->texture.active].texmat = 1;
+}
+
+static void current_mat_changed(matrixstack_t *ms) {
+	// dirty flags and hardware update after the top of the current stack changed
+	if(glstate->matrix_mode==GL_MODELVIEW)
+		glstate->normal_matrix_dirty = glstate->inv_mv_matrix_dirty = 1;
+	if(glstate->matrix_mode==GL_MODELVIEW || glstate->matrix_mode==GL_PROJECTION)
+		glstate->mvp_matrix_dirty = 1;
+	else if((glstate->matrix_mode==GL_TEXTURE) && glstate->fpe_state)
+		set_fpe_textureidentity();
+	if(send_to_hardware()) {
+		LOAD_GLES(glLoadMatrixf);
+		LOAD_GLES(glLoadIdentity);
+		if(ms->identity) gles_glLoadIdentity();	// in case the driver as some special optimisations
+		else gles_glLoadMatrixf(TOPOF(ms));
+	}
+}
+
 void init_matrix(glstate_t* glstate) {
 DBG(printf("init_matrix(%p)\n", glstate);)
     alloc_matrix(&glstate->projection_matrix, MAX_STACK_PROJECTION);
     set_identity(TOP(projection_matrix));
-	glstate->projection_matrix->identity = 1;
+	glstate->projection_matrix->identity = glstate->projection_matrix->affine = 1;
     alloc_matrix(&glstate->modelview_matrix, MAX_STACK_MODELVIEW);
     set_identity(TOP(modelview_matrix));
-	glstate->modelview_matrix->identity = 1;
+	glstate->modelview_matrix->identity = glstate->modelview_matrix->affine = 1;
 	glstate->texture_matrix = (matrixstack_t**)malloc(sizeof(matrixstack_t*)*MAX_TEX);
 	glstate->arb_matrix = (matrixstack_t**)malloc(sizeof(matrixstack_t*)*MAX_ARB_MATRIX);
 	set_identity(glstate->mvp_matrix);
@@ -92,20 +102,56 @@ DBG(printf("init_matrix(%p)\n", glstate);)
     for (int i=0; i<MAX_TEX; i++) {
         alloc_matrix(&glstate->texture_matrix[i], MAX_STACK_TEXTURE);
         set_identity(TOP(texture_matrix[i]));
-		glstate->texture_matrix[i]->identity = 1;
+		glstate->texture_matrix[i]->identity = glstate->texture_matrix[i]->affine = 1;
     }
     for (int i=0; i<MAX_ARB_MATRIX; i++) {
         alloc_matrix(&glstate->arb_matrix[i], MAX_STACK_ARB_MATRIX);
         set_identity(TOP(arb_matrix[i]));
-		glstate->arb_matrix[i]->identity = 1;
+		glstate->arb_matrix[i]->identity = glstate->arb_matrix[i]->affine = 1;
     }
 }
 
-void set_fpe_textureidentity() {
-	if(glstate->texture_matrix[glstate->texture.active]->identity)	// inverted in fpe flags
-		glstate->fpe_state->texture[glstate->texture.active].texmat = 0;
-	else
-		glstate->fpe_state->texture[glstate->texture.active].texmat = 1;
+// LIBGL_BEGINEND=2: a modelview change doesn't break the glBegin/glEnd merger.
+// The pending batch is moved to eye space on the CPU, the next vertices are
+// transformed as they come (see rlVertex4f), and the batch is drawn with an
+// identity modelview. Not used if something needs object space coordinates.
+#define PRETRANSFORM_MAX	4096	// don't transform big batches
+
+static int pretransform_batch() {
+	if(globals4es.beginend!=2 || hardext.esversion==1 || glstate->matrix_mode!=GL_MODELVIEW)
+		return 0;
+	renderlist_t *list = glstate->list.active;
+	if(list->prev || list->stage!=STAGE_POSTDRAW)
+		return 0;
+	if(glstate->enable.lighting || glstate->enable.vertex_arb || glstate->glsl->program)
+		return 0;
+	for (int a=0; a<hardext.maxtex; a++)
+		if(glstate->enable.texgen_s[a] || glstate->enable.texgen_t[a] || glstate->enable.texgen_r[a] || glstate->enable.texgen_q[a])
+			return 0;
+	if(!list->pretransform) {
+		if(list->len>PRETRANSFORM_MAX)
+			return 0;
+		if(list->vert)
+			vector_matrix_batch(list->vert, list->len, list->vert_stride?list->vert_stride/sizeof(GLfloat):4, getMVMat());
+		list->pretransform = 1;
+	}
+	return 1;
+}
+
+void pretransform_modelview(int enable, GLfloat *saved) {
+	// swap the modelview with identity (and back) to draw a pretransformed batch
+	matrixstack_t *mv = glstate->modelview_matrix;
+	if(enable) {
+		memcpy(saved, getMVMat(), 16*sizeof(GLfloat));
+		saved[16] = mv->identity | (mv->affine<<1);
+		set_identity(getMVMat());
+		mv->identity = mv->affine = 1;
+	} else {
+		memcpy(getMVMat(), saved, 16*sizeof(GLfloat));
+		mv->identity = ((int)saved[16])&1;
+		mv->affine = ((int)saved[16])>>1;
+	}
+	glstate->mvp_matrix_dirty = glstate->inv_mv_matrix_dirty = glstate->normal_matrix_dirty = 1;
 }
 
 void APIENTRY_GL4ES gl4es_glMatrixMode(GLenum mode) {
@@ -165,6 +211,7 @@ DBG(printf("glPushMatrix(), list=%p\n", glstate->list.active);)
 
 void APIENTRY_GL4ES gl4es_glPopMatrix(void) {
 DBG(printf("glPopMatrix(), list=%p\n", glstate->list.active);)
+	int pretransformed = 0;
 	if (glstate->list.active 
 	 && !(glstate->list.compiling)
 	 && (globals4es.beginend) 
@@ -176,8 +223,11 @@ DBG(printf("glPopMatrix(), list=%p\n", glstate->list.active);)
 			--glstate->modelview_matrix->top;
 			return;
 		}
+		pretransformed = pretransform_batch();
+	}
+	if(!pretransformed) {
+		PUSH_IF_COMPILING(glPopMatrix);
 	}
-	PUSH_IF_COMPILING(glPopMatrix);
 	// get matrix mode
 	GLint matrix_mode = glstate->matrix_mode;
 	// go...
@@ -185,8 +235,9 @@ DBG(printf("glPopMatrix(), list=%p\n", glstate->list.active);)
 	switch(matrix_mode) {
 		#define P(A) if(glstate->A->top) { \
 			--glstate->A->top; \
-			glstate->A->identity = is_identity(update_current_mat()); \
-			if (send_to_hardware()) {LOAD_GLES(glLoadMatrixf); gles_glLoadMatrixf(update_current_mat()); } \
+			glstate->A->identity = is_identity(TOP(A)); \
+			glstate->A->affine = is_affine(TOP(A)); \
+			if (send_to_hardware()) {LOAD_GLES(glLoadMatrixf); gles_glLoadMatrixf(TOP(A)); } \
 		} else errorShim(GL_STACK_UNDERFLOW)
 		case GL_PROJECTION:
 			P(projection_matrix);
@@ -219,110 +270,119 @@ DBG(printf("glPopMatrix(), list=%p\n", glstate->list.active);)
 void APIENTRY_GL4ES gl4es_glLoadMatrixf(const GLfloat * m) {
 DBG(printf("glLoadMatrix(%f, %f, %f, %f, %f, %f, %f...), list=%p\n", m[0], m[1], m[2], m[3], m[4], m[5], m[6], glstate->list.active);)
 	if (glstate->list.active) {
-		if(glstate->list.pending) gl4es_flush();
-		else {
+		if(glstate->list.pending) {
+			if(!pretransform_batch()) gl4es_flush();
+		} else {
 			NewStage(glstate->list.active, STAGE_MATRIX);
-			glstate->list.active->matrix_op = 1;
-			memcpy(glstate->list.active->matrix_val, m, 16*sizeof(GLfloat));
+			renderlist_ops_t *ops = get_renderlist_ops(glstate->list.active);
+			ops->matrix_op = 1;
+			memcpy(ops->matrix_val, m, 16*sizeof(GLfloat));
 			return;
 		}
 	}
-	memcpy(update_current_mat(), m, 16*sizeof(GLfloat));
-	const int id = update_current_identity(0);
-	if(glstate->matrix_mode==GL_MODELVIEW)
-		glstate->normal_matrix_dirty = glstate->inv_mv_matrix_dirty = 1;
-	if(glstate->matrix_mode==GL_MODELVIEW || glstate->matrix_mode==GL_PROJECTION)
-		glstate->mvp_matrix_dirty = 1;
-	else if((glstate->matrix_mode==GL_TEXTURE) && glstate->fpe_state)
-		set_fpe_textureidentity();
-    if(send_to_hardware()) {
-		LOAD_GLES(glLoadMatrixf);
-		LOAD_GLES(glLoadIdentity);
-		if(id) gles_glLoadIdentity();	// in case the driver as some special optimisations
-		else gles_glLoadMatrixf(m);
-	}
+	matrixstack_t *ms = current_stack();
+	memcpy(TOPOF(ms), m, 16*sizeof(GLfloat));
+	ms->identity = is_identity(m);
+	ms->affine = ms->identity || is_affine(m);
+	current_mat_changed(ms);
 }
 
 void APIENTRY_GL4ES gl4es_glMultMatrixf(const GLfloat * m) {
 DBG(printf("glMultMatrix(%f, %f, %f, %f, %f, %f, %f...), list=%p\n", m[0], m[1], m[2], m[3], m[4], m[5], m[6], glstate->list.active);)
 	if (glstate->list.active) {
-		if(glstate->list.pending) gl4es_flush();
-		else {
+		if(glstate->list.pending) {
+			if(!pretransform_batch()) gl4es_flush();
+		} else {
 			if(glstate->list.active->stage == STAGE_MATRIX) {
 				// multiply the matrix mith the current one....
-				matrix_mul(glstate->list.active->matrix_val, m, glstate->list.active->matrix_val);
+				renderlist_ops_t *ops = get_renderlist_ops(glstate->list.active);
+				matrix_mul(ops->matrix_val, m, ops->matrix_val);
 				return;
 			}
 			NewStage(glstate->list.active, STAGE_MATRIX);
-			glstate->list.active->matrix_op = 2;
-			memcpy(glstate->list.active->matrix_val, m, 16*sizeof(GLfloat));
+			renderlist_ops_t *ops = get_renderlist_ops(glstate->list.active);
+			ops->matrix_op = 2;
+			memcpy(ops->matrix_val, m, 16*sizeof(GLfloat));
 			return;
 		}
 	}
-	GLfloat *current_mat = update_current_mat();
-	matrix_mul(current_mat, m, current_mat);
-	const int id = update_current_identity(0);
-	if(glstate->matrix_mode==GL_MODELVIEW)
-		glstate->normal_matrix_dirty = glstate->inv_mv_matrix_dirty = 1;
-	if(glstate->matrix_mode==GL_MODELVIEW || glstate->matrix_mode==GL_PROJECTION)
-		glstate->mvp_matrix_dirty = 1;
-	else if((glstate->matrix_mode==GL_TEXTURE) && glstate->fpe_state)
-		set_fpe_textureidentity();
+	matrixstack_t *ms = current_stack();
+	GLfloat *current_mat = TOPOF(ms);
+	if(ms->identity)
+		memcpy(current_mat, m, 16*sizeof(GLfloat));
+	else
+		matrix_mul(current_mat, m, current_mat);
+	ms->affine = ms->affine && is_affine(m);
+	ms->identity = is_identity(current_mat);
 	DBG(printf(" => (%f, %f, %f, %f, %f, %f, %f...)\n", current_mat[0], current_mat[1], current_mat[2], current_mat[3], current_mat[4], current_mat[5], current_mat[6]);)
-	if(send_to_hardware()) {
-		LOAD_GLES(glLoadMatrixf);
-		LOAD_GLES(glLoadIdentity);
-		if(id) gles_glLoadIdentity();	// in case the driver as some special optimisations
-		else gles_glLoadMatrixf(current_mat);
-	}
+	current_mat_changed(ms);
 }
 
 void APIENTRY_GL4ES gl4es_glLoadIdentity(void) {
 DBG(printf("glLoadIdentity(), list=%p\n", glstate->list.active);)
 	if (glstate->list.active) {
-		if(glstate->list.pending) gl4es_flush();
-		else {
+		if(glstate->list.pending) {
+			if(!pretransform_batch()) gl4es_flush();
+		} else {
 			NewStage(glstate->list.active, STAGE_MATRIX);
-			glstate->list.active->matrix_op = 1;
-			set_identity(glstate->list.active->matrix_val);
+			renderlist_ops_t *ops = get_renderlist_ops(glstate->list.active);
+			ops->matrix_op = 1;
+			set_identity(ops->matrix_val);
 			return;
 		}
 	}
-	set_identity(update_current_mat());
-	update_current_identity(1);
-	if(glstate->matrix_mode==GL_MODELVIEW)
-		glstate->normal_matrix_dirty = glstate->inv_mv_matrix_dirty = 1;
-	if(glstate->matrix_mode==GL_MODELVIEW || glstate->matrix_mode==GL_PROJECTION)
-		glstate->mvp_matrix_dirty = 1;
-	else if((glstate->matrix_mode==GL_TEXTURE) && glstate->fpe_state)
-		set_fpe_textureidentity();
-	if(send_to_hardware()) {
-		LOAD_GLES(glLoadIdentity);
-		gles_glLoadIdentity();
-	}
+	matrixstack_t *ms = current_stack();
+	set_identity(TOPOF(ms));
+	ms->identity = ms->affine = 1;
+	current_mat_changed(ms);
+}
+
+// glTranslatef/glScalef/glRotatef update the current matrix in place when not compiling
+static matrixstack_t* begin_affine_mult() {
+	if (glstate->list.active && !pretransform_batch())
+		gl4es_flush();
+	return current_stack();
 }
 
 void APIENTRY_GL4ES gl4es_glTranslatef(GLfloat x, GLfloat y, GLfloat z) {
 DBG(printf("glTranslatef(%f, %f, %f), list=%p\n", x, y, z, glstate->list.active);)
-	// create a translation matrix than multiply it...
-	GLfloat tmp[16];
-	set_identity(tmp);
-	tmp[12+0] = x;
-	tmp[12+1] = y;
-	tmp[12+2] = z;
-	gl4es_glMultMatrixf(tmp);
+	if (glstate->list.active && !glstate->list.pending) {
+		// create a translation matrix for the display list...
+		GLfloat tmp[16];
+		set_identity(tmp);
+		tmp[12+0] = x;
+		tmp[12+1] = y;
+		tmp[12+2] = z;
+		gl4es_glMultMatrixf(tmp);
+		return;
+	}
+	matrixstack_t *ms = begin_affine_mult();
+	if(ms->identity && x==0.0f && y==0.0f && z==0.0f)
+		return;
+	matrix_translate(TOPOF(ms), x, y, z);
+	ms->identity = (ms->identity)?0:is_identity(TOPOF(ms));
+	current_mat_changed(ms);
 }
 
 void APIENTRY_GL4ES gl4es_glScalef(GLfloat x, GLfloat y, GLfloat z) {
 DBG(printf("glScalef(%f, %f, %f), list=%p\n", x, y, z, glstate->list.active);)
-	// create a scale matrix than multiply it...
-	GLfloat tmp[16];
-	memset(tmp, 0, 16*sizeof(GLfloat));
-	tmp[0+0] = x;
-	tmp[1+4] = y;
-	tmp[2+8] = z;
-	tmp[3+12] = 1.0f;
-	gl4es_glMultMatrixf(tmp);
+	if (glstate->list.active && !glstate->list.pending) {
+		// create a scale matrix for the display list...
+		GLfloat tmp[16];
+		memset(tmp, 0, 16*sizeof(GLfloat));
+		tmp[0+0] = x;
+		tmp[1+4] = y;
+		tmp[2+8] = z;
+		tmp[3+12] = 1.0f;
+		gl4es_glMultMatrixf(tmp);
+		return;
+	}
+	matrixstack_t *ms = begin_affine_mult();
+	if(ms->identity && x==1.0f && y==1.0f && z==1.0f)
+		return;
+	matrix_scale(TOPOF(ms), x, y, z);
+	ms->identity = (ms->identity)?0:is_identity(TOPOF(ms));
+	current_mat_changed(ms);
 }
 
 void APIENTRY_GL4ES gl4es_glRotatef(GLfloat angle, GLfloat x, GLfloat y, GLfloat z) {
@@ -347,7 +407,15 @@ DBG(printf("glRotatef(%f, %f, %f, %f), list=%p\n", angle, x, y, z, glstate->list
 
 	tmp[3+12] = 1.0f;
 	// done...
-	gl4es_glMultMatrixf(tmp);
+	if (glstate->list.active && !glstate->list.pending) {
+		gl4es_glMultMatrixf(tmp);
+		return;
+	}
+	// only the 3x3 part is used here
+	matrixstack_t *ms = begin_affine_mult();
+	matrix_mul_linear(TOPOF(ms), tmp);
+	ms->identity = is_identity(TOPOF(ms));
+	current_mat_changed(ms);
 }
 
 void APIENTRY_GL4ES gl4es_glOrthof(GLfloat left, GLfloat right, GLfloat bottom, GLfloat top, GLfloat nearVal, GLfloat farVal) {
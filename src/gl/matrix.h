@@ -17,6 +17,8 @@ void APIENTRY_GL4ES gl4es_glTranslatef(GLfloat x, GLfloat y, GLfloat z);
 void APIENTRY_GL4ES gl4es_glScalef(GLfloat x, GLfloat y, GLfloat z);
 void APIENTRY_GL4ES gl4es_glRotatef(GLfloat angle, GLfloat x, GLfloat y, GLfloat z);
 void APIENTRY_GL4ES gl4es_glOrthof(GLfloat left, GLfloat right, GLfloat bottom, GLfloat top, GLfloat nearVal, GLfloat farVal);
+void pretransform_modelview(int enable, GLfloat *saved);
+
 void APIENTRY_GL4ES gl4es_glFrustumf(GLfloat left,	GLfloat right, GLfloat bottom, GLfloat top,	GLfloat nearVal, GLfloat farVal);
 
 static inline GLfloat* getTexMat(int tmu) {
@@ -29,14 +31,24 @@ static inline GLfloat* getMVMat() {
 
 static inline GLfloat* getInvMVMat() {
 	if(glstate->inv_mv_matrix_dirty) {
-		matrix_inverse(glstate->modelview_matrix->stack+glstate->modelview_matrix->top*16, glstate->inv_mv_matrix);
+		matrixstack_t *mv = glstate->modelview_matrix;
+		if(mv->identity)
+			set_identity(glstate->inv_mv_matrix);
+		else if(mv->affine)
+			matrix_inverse_affine(mv->stack+mv->top*16, glstate->inv_mv_matrix);
+		else
+			matrix_inverse(mv->stack+mv->top*16, glstate->inv_mv_matrix);
 		glstate->inv_mv_matrix_dirty = 0;
 	}
 	return glstate->inv_mv_matrix;
 }
 static inline GLfloat* getNormalMat() {
 	if(glstate->normal_matrix_dirty) {
-		matrix_inverse3_transpose(glstate->modelview_matrix->stack+glstate->modelview_matrix->top*16, glstate->normal_matrix);
+		if(glstate->modelview_matrix->identity) {
+			memset(glstate->normal_matrix, 0, 9*sizeof(GLfloat));
+			glstate->normal_matrix[0] = glstate->normal_matrix[4] = glstate->normal_matrix[8] = 1.0f;
+		} else
+			matrix_inverse3_transpose(glstate->modelview_matrix->stack+glstate->modelview_matrix->top*16, glstate->normal_matrix);
 		glstate->normal_matrix_dirty = 0;
 	}
 	return glstate->normal_matrix;
@@ -49,7 +61,12 @@ static inline GLfloat* getPMat() {
 static inline GLfloat* getMVPMat()
 {
 	if(glstate->mvp_matrix_dirty) {
-		matrix_mul(getPMat(), getMVMat(), glstate->mvp_matrix);
+		if(glstate->modelview_matrix->identity)
+			memcpy(glstate->mvp_matrix, getPMat(), 16*sizeof(GLfloat));
+		else if(glstate->projection_matrix->identity)
+			memcpy(glstate->mvp_matrix, getMVMat(), 16*sizeof(GLfloat));
+		else
+			matrix_mul(getPMat(), getMVMat(), glstate->mvp_matrix);
 		glstate->mvp_matrix_dirty = 0;
 	}
 	return glstate->mvp_matrix;
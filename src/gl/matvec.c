@@ -83,6 +83,42 @@ void vector_matrix(const float *a, const float *b, float *c) {
 #endif
 }
 
+void FASTMATH vector_matrix_batch(float *a, int count, int stride, const float *b) {
+    // same as vector_matrix, in place, on count vectors that are stride floats apart
+#if defined(__ARM_NEON__) && !defined(__APPLE__)
+    const float* b2 = b+8;
+    const int step = stride*sizeof(float);
+    if (count) asm volatile (
+    "vld1.32  {d16-d19}, [%2]       \n" // q8,q9 = b(0..7)
+    "vld1.32  {d20-d23}, [%3]       \n" // q10,q11 = b(8..15)
+    "1:                             \n"
+    "vld1.32  {d0-d1}, [%0]         \n" // q0 = a
+    "vmul.f32 q1, q8, d0[0]         \n" // q1 = b(0..3)*a[0]
+    "vmla.f32 q1, q9, d0[1]         \n" // q1 = q1 + b(4..7)*a[1]
+    "vmla.f32 q1, q10, d1[0]        \n" // q1 = q1 + b(8..11)*a[2]
+    "vmla.f32 q1, q11, d1[1]        \n" // q1 = q1 + b(12..15)*a[3]
+    "vst1.32  {d2-d3}, [%0], %4     \n" // store, next
+    "subs     %1, %1, #1            \n"
+    "bne      1b                    \n"
+    :"+r"(a), "+r"(count) : "r"(b), "r"(b2), "r"(step)
+    : "q0", "q1", "q8", "q9", "q10", "q11", "cc", "memory"
+        );
+#else
+    // matrix in locals and no aliasing, so compilers can vectorize this one
+    const float b0=b[0], b1=b[1], b2=b[2], b3=b[3],
+        b4=b[4], b5=b[5], b6=b[6], b7=b[7],
+        b8=b[8], b9=b[9], b10=b[10], b11=b[11],
+        b12=b[12], b13=b[13], b14=b[14], b15=b[15];
+    for (int i=0; i<count; i++, a+=stride) {
+        const float x=a[0], y=a[1], z=a[2], w=a[3];
+        a[0] = x*b0 + y*b4 + z*b8 + w*b12;
+        a[1] = x*b1 + y*b5 + z*b9 + w*b13;
+        a[2] = x*b2 + y*b6 + z*b10 + w*b14;
+        a[3] = x*b3 + y*b7 + z*b11 + w*b15;
+    }
+#endif
+}
+
 void vector3_matrix(const float *a, const float *b, float *c) {
 #if defined(__ARM_NEON__) && !defined(__APPLE__)
     const float* b2=b+4;
@@ -257,6 +293,33 @@ void matrix_inverse3_transpose(const float *m, float *r) {
     float det = 1.0f/(m[0]*r[0] + m[4+0]*r[3] + m[8+0]*r[6]);
     for (int i = 0; i < 9; i++) r[i] *= det;
 }
+
+void matrix_inverse_affine(const float *m, float *r) {
+    // rows of the inverted upper 3x3 are the cross products of its columns
+    const float k00 = m[4+1]*m[8+2] - m[4+2]*m[8+1];
+    const float k01 = m[4+2]*m[8+0] - m[4+0]*m[8+2];
+    const float k02 = m[4+0]*m[8+1] - m[4+1]*m[8+0];
+
+    const float k10 = m[8+1]*m[0+2] - m[8+2]*m[0+1];
+    const float k11 = m[8+2]*m[0+0] - m[8+0]*m[0+2];
+    const float k12 = m[8+0]*m[0+1] - m[8+1]*m[0+0];
+
+    const float k20 = m[0+1]*m[4+2] - m[0+2]*m[4+1];
+    const float k21 = m[0+2]*m[4+0] - m[0+0]*m[4+2];
+    const float k22 = m[0+0]*m[4+1] - m[0+1]*m[4+0];
+
+    const float det = 1.0f/(m[0]*k00 + m[1]*k01 + m[2]*k02);
+    r[0] = k00*det; r[4] = k01*det; r[8] = k02*det;
+    r[1] = k10*det; r[5] = k11*det; r[9] = k12*det;
+    r[2] = k20*det; r[6] = k21*det; r[10]= k22*det;
+    r[3] = r[7] = r[11] = 0.0f;
+    // translation is -inv3x3*t
+    const float t0 = m[12], t1 = m[13], t2 = m[14];
+    r[12] = -(r[0]*t0 + r[4]*t1 + r[8]*t2);
+    r[13] = -(r[1]*t0 + r[5]*t1 + r[9]*t2);
+    r[14] = -(r[2]*t0 + r[6]*t1 + r[10]*t2);
+    r[15] = 1.0f;
+}
     
 void matrix_mul(const float *a, const float *b, float *c) {
 #if defined(__ARM_NEON__) && !defined(__APPLE__)
@@ -322,6 +385,88 @@ void matrix_mul(const float *a, const float *b, float *c) {
 #endif
 }
 
+void matrix_translate(float *m, float x, float y, float z) {
+    // only the last column changes: c3 = c0*x + c1*y + c2*z + c3
+#if defined(__ARM_NEON__) && !defined(__APPLE__)
+    const float t[4] = {x, y, z, 0.0f};
+    float* m1 = m+8;
+    float* m3 = m+12;
+    asm volatile (
+    "vld1.32  {d16-d19}, [%1]       \n" // q8,q9 = c0,c1
+    "vld1.32  {d20-d23}, [%2]       \n" // q10,q11 = c2,c3
+    "vld1.32  {d0-d1}, [%3]         \n" // q0 = x,y,z
+    "vmla.f32 q11, q8, d0[0]        \n"
+    "vmla.f32 q11, q9, d0[1]        \n"
+    "vmla.f32 q11, q10, d1[0]       \n"
+    "vst1.32  {d22-d23}, [%0]       \n"
+    ::"r"(m3), "r"(m), "r"(m1), "r"(t)
+    : "q0", "q8", "q9", "q10", "q11", "memory"
+        );
+#else
+    for (int i=0; i<4; i++)
+        m[12+i] += m[i]*x + m[4+i]*y + m[8+i]*z;
+#endif
+}
+
+void matrix_scale(float *m, float x, float y, float z) {
+    // each of the first 3 columns is scaled
+#if defined(__ARM_NEON__) && !defined(__APPLE__)
+    const float s[4] = {x, y, z, 0.0f};
+    float* m1 = m+8;
+    asm volatile (
+    "vld1.32  {d16-d19}, [%0]       \n" // q8,q9 = c0,c1
+    "vld1.32  {d20-d21}, [%1]       \n" // q10 = c2
+    "vld1.32  {d0-d1}, [%2]         \n" // q0 = x,y,z
+    "vmul.f32 q8, q8, d0[0]         \n"
+    "vmul.f32 q9, q9, d0[1]         \n"
+    "vmul.f32 q10, q10, d1[0]       \n"
+    "vst1.32  {d16-d19}, [%0]       \n"
+    "vst1.32  {d20-d21}, [%1]       \n"
+    ::"r"(m), "r"(m1), "r"(s)
+    : "q0", "q8", "q9", "q10", "memory"
+        );
+#else
+    for (int i=0; i<4; i++) {
+        m[i] *= x;
+        m[4+i] *= y;
+        m[8+i] *= z;
+    }
+#endif
+}
+
+void matrix_mul_linear(float *m, const float *r) {
+    // the last column of m is unchanged, r columns are 4 floats apart
+#if defined(__ARM_NEON__) && !defined(__APPLE__)
+    float* m1 = m+8;
+    asm volatile (
+    "vld1.32  {d16-d19}, [%0]       \n" // q8,q9 = c0,c1
+    "vld1.32  {d20-d21}, [%1]       \n" // q10 = c2
+    "vld1.32  {d0-d3}, [%2]!        \n" // q0,q1 = r0,r1
+    "vld1.32  {d4-d5}, [%2]         \n" // q2 = r2
+    "vmul.f32 q12, q8, d0[0]        \n"
+    "vmul.f32 q13, q8, d2[0]        \n"
+    "vmul.f32 q14, q8, d4[0]        \n"
+    "vmla.f32 q12, q9, d0[1]        \n"
+    "vmla.f32 q13, q9, d2[1]        \n"
+    "vmla.f32 q14, q9, d4[1]        \n"
+    "vmla.f32 q12, q10, d1[0]       \n"
+    "vmla.f32 q13, q10, d3[0]       \n"
+    "vmla.f32 q14, q10, d5[0]       \n"
+    "vst1.32  {d24-d27}, [%0]       \n"
+    "vst1.32  {d28-d29}, [%1]       \n"
+    :"+r"(m), "+r"(m1), "+r"(r)
+    :: "q0", "q1", "q2", "q8", "q9", "q10", "q12", "q13", "q14", "memory"
+        );
+#else
+    for (int i=0; i<4; i++) {
+        const float a0 = m[i], a1 = m[4+i], a2 = m[8+i];
+        m[i]   = a0*r[0] + a1*r[1] + a2*r[2];
+        m[4+i] = a0*r[4] + a1*r[5] + a2*r[6];
+        m[8+i] = a0*r[8] + a1*r[9] + a2*r[10];
+    }
+#endif
+}
+
 void vector4_mult(const float *a, const float *b, float *c) {
 //TODO: NEON version of this
     for (int i=0; i<4; i++)
@@ -351,3 +496,7 @@ int is_identity(const float* mat) {
     if(!set) {set_identity(i1); set=1;}
     return memcmp(mat, i1, 16*sizeof(float))==0?1:0;
 }
+
+int is_affine(const float* mat) {
+    return (mat[3]==0.0f && mat[7]==0.0f && mat[11]==0.0f && mat[15]==1.0f)?1:0;
+}
@@ -9,6 +9,7 @@ float dot4(const float *a, const float *b) FASTMATH;
 void cross3(const float *a, const float *b, float* c) FASTMATH;
 void matrix_vector(const float *a, const float *b, float *c);
 void vector_matrix(const float *a, const float *b, float *c);
+void vector_matrix_batch(float *a, int count, int stride, const float *b) FASTMATH;
 void vector3_matrix(const float *a, const float *b, float *c);
 void vector3_matrix3(const float *a, const float *b, float *c);
 void vector3_matrix4(const float *a, const float *b, float *c);
@@ -19,8 +20,13 @@ void vector4_add(const float *a, const float *b, float *c);
 void matrix_transpose(const float *a, float *b);
 void matrix_inverse(const float *m, float *r);
 void matrix_inverse3_transpose(const float *m, float *r); // upper3x3 of matrix4 -> inverse -> transposed mat3
+void matrix_inverse_affine(const float *m, float *r);   // m must have a (0,0,0,1) last row
 void matrix_mul(const float *a, const float *b, float *c);
+void matrix_translate(float *m, float x, float y, float z); // m = m * translate(x,y,z)
+void matrix_scale(float *m, float x, float y, float z);     // m = m * scale(x,y,z)
+void matrix_mul_linear(float *m, const float *r);           // m = m * r, r is a 3x3 stored as 3 padded columns
 void set_identity(float* mat);
 int is_identity(const float* mat);
+int is_affine(const float* mat);
 
 #endif // _GL4ES_MATVEC_H_
@@ -6,6 +6,7 @@
 #include "gl4es.h"
 #include "glstate.h"
 #include "debug.h"
+#include "trace.h"
 
 #ifdef __BIG_ENDIAN__
 #define GL_INT8_REV     GL_UNSIGNED_INT_8_8_8_8
@@ -764,7 +765,7 @@ bool quarter_pixel(const GLvoid *src[16],
     #undef write_each
 }
 
-bool pixel_convert(const GLvoid *src, GLvoid **dst,
+static bool do_pixel_convert(const GLvoid *src, GLvoid **dst,
                    GLuint width, GLuint height,
                    GLenum src_format, GLenum src_type,
                    GLenum dst_format, GLenum dst_type, GLuint stride, GLuint align) {
@@ -1196,6 +1197,16 @@ bool pixel_convert(const GLvoid *src, GLvoid **dst,
 	return true;
 }
 
+bool pixel_convert(const GLvoid *src, GLvoid **dst,
+                   GLuint width, GLuint height,
+                   GLenum src_format, GLenum src_type,
+                   GLenum dst_format, GLenum dst_type, GLuint stride, GLuint align) {
+    TRACE_BEGIN(pixel_convert);
+    bool ret = do_pixel_convert(src, dst, width, height, src_format, src_type, dst_format, dst_type, stride, align);
+    TRACE_END(pixel_convert);
+    return ret;
+}
+
 bool pixel_transform(const GLvoid *src, GLvoid **dst,
                    GLuint width, GLuint height,
                    GLenum src_format, GLenum src_type,
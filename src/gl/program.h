@@ -247,6 +247,7 @@ typedef struct {
     GLint                           builtin_instanceID;
     // fpe uniform
     GLint                           fpe_alpharef;
+    GLint                           fpe_linestipple;
     int                             has_fpe;
     GLint                           builtin_texsampler[MAX_TEX];
     int                             has_builtin_texsampler;
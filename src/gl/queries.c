@@ -9,6 +9,7 @@
 #include "queries.h"
 
 #include "khash.h"
+#include "../glx/hardext.h"
 #include "gl4es.h"
 #include "glstate.h"
 #include "loader.h"
@@ -24,6 +25,53 @@ void __stdcall GetSystemTimeAsFileTime(unsigned __int64*);
 
 KHASH_MAP_IMPL_INT(queries, glquery_t *);
 
+#define GL_GPU_DISJOINT_EXT 0x8FBB
+
+// GLES target used for a query target, or 0 if it has to be emulated
+static GLenum hardware_target(GLenum target) {
+	switch(target) {
+		case GL_SAMPLES_PASSED:	// only a boolean on GLES, so the count will be 0 or 1
+		case GL_ANY_SAMPLES_PASSED:
+			return (hardext.occlusion)?GL_ANY_SAMPLES_PASSED:0;
+		case GL_ANY_SAMPLES_PASSED_CONSERVATIVE:
+			return (hardext.occlusion)?GL_ANY_SAMPLES_PASSED_CONSERVATIVE:0;
+		case GL_TIME_ELAPSED:
+		case GL_TIMESTAMP:
+			return (hardext.timerquery)?target:0;
+	}
+	return 0;
+}
+
+// get the result of the GLES query, return 0 if not available yet and wait is 0
+static int fetch_result(glquery_t *q, int wait) {
+	if(!q->pending)
+		return 1;
+	if(q->active)
+		return 0;
+	LOAD_GLES2_OR_EXT(glGetQueryObjectuiv);
+	GLuint avail = GL_FALSE;
+	if(!wait) {
+		gles_glGetQueryObjectuiv(q->real, GL_QUERY_RESULT_AVAILABLE, &avail);
+		if(!avail)
+			return 0;
+	}
+	if(q->target==GL_TIME_ELAPSED || q->target==GL_TIMESTAMP) {
+		LOAD_GLES_EXT(glGetQueryObjectui64v);
+		LOAD_GLES(glGetIntegerv);
+		GLint disjoint = 0;
+		gles_glGetQueryObjectui64v(q->real, GL_QUERY_RESULT, &q->result);
+		gles_glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+		if(disjoint)
+			q->result = 0;	// the timer is not reliable for this one
+	} else {
+		GLuint res = 0;
+		gles_glGetQueryObjectuiv(q->real, GL_QUERY_RESULT, &res);
+		q->result = res?1:0;
+	}
+	q->pending = 0;
+	return 1;
+}
+
 static GLuint new_query(GLuint base) {
     khint_t k;
     khash_t(queries) *list = glstate->queries.querylist;
@@ -56,6 +104,18 @@ static glquery_t* find_query_target(GLenum target) {
     return NULL;
 }
 
+// GLES allows only one occlusion query active at a time, whatever the target
+static int hardware_busy(GLenum hw) {
+    khash_t(queries) *list = glstate->queries.querylist;
+	glquery_t *q;
+	int occlusion = (hw!=GL_TIME_ELAPSED);
+    kh_foreach_value(list, q,
+		if(q->active && q->pending && (hardware_target(q->target)!=GL_TIME_ELAPSED)==occlusion)
+			return 1;
+	);
+    return 0;
+}
+
 
 void del_querie(GLuint querie) {
     khint_t k;
@@ -66,8 +126,17 @@ void del_querie(GLuint querie) {
         s = kh_value(list, k);
         kh_del(queries, list, k);
     }
-    if(s)
+    if(s) {
+        if(s->real) {
+            LOAD_GLES2_OR_EXT(glDeleteQueries);
+            if(s->active) {
+                LOAD_GLES2_OR_EXT(glEndQuery);
+                gles_glEndQuery(hardware_target(s->target));
+            }
+            gles_glDeleteQueries(1, &s->real);
+        }
         free(s);
+    }
 }
 
 unsigned long long get_clock() {
@@ -146,10 +215,26 @@ void APIENTRY_GL4ES gl4es_glBeginQuery(GLenum target, GLuint id) {
 			errorShim(GL_INVALID_ENUM);
 			return;
 	}
+    query->id = id;
     query->target = target;
     query->num = 0;
 	query->active = 1;
 	query->start = get_clock() - glstate->queries.start;
+	query->pending = 0;
+	GLenum hw = hardware_target(target);
+	if(hw && !hardware_busy(hw)) {
+		LOAD_GLES2_OR_EXT(glGenQueries);
+		LOAD_GLES2_OR_EXT(glBeginQuery);
+		if(!query->real)
+			gles_glGenQueries(1, &query->real);
+		gles_glBeginQuery(hw, query->real);
+		query->pending = 1;
+	} else if(query->real) {
+		// emulated this time
+		LOAD_GLES2_OR_EXT(glDeleteQueries);
+		gles_glDeleteQueries(1, &query->real);
+		query->real = 0;
+	}
     noerrorShim();
 }
 
@@ -174,6 +259,10 @@ void APIENTRY_GL4ES gl4es_glEndQuery(GLenum target) {
 	}
     query->active = 0;
 	query->start = (get_clock() - glstate->queries.start) - query->start;
+	if(query->pending) {
+		LOAD_GLES2_OR_EXT(glEndQuery);
+		gles_glEndQuery(hardware_target(target));
+	}
 	noerrorShim();
 }
 
@@ -181,45 +270,59 @@ void APIENTRY_GL4ES gl4es_glGetQueryiv(GLenum target, GLenum pname, GLint* param
     FLUSH_BEGINEND;
 
 	glquery_t *q = find_query_target(target);
-	if(!q) {
-		errorShim(GL_INVALID_OPERATION);
-		return;
-	}
 
 	noerrorShim();
 	switch (pname) {
 		case GL_CURRENT_QUERY:
-			*params = (q->target==GL_TIME_ELAPSED)?q->start:q->num;
+			*params = (q)?q->id:0;
 			break;
 		case GL_QUERY_COUNTER_BITS:
-			*params = (q->target==GL_TIME_ELAPSED)?32:0;	//no counter...
+			if(target==GL_TIME_ELAPSED || target==GL_TIMESTAMP)
+				*params = (hardext.timerquery)?64:32;
+			else
+				*params = (target==GL_SAMPLES_PASSED && hardext.occlusion)?1:0;
 			break;
 		default:
 			errorShim(GL_INVALID_ENUM);
 	}
 }
 
-void APIENTRY_GL4ES gl4es_glGetQueryObjectiv(GLuint id, GLenum pname, GLint* params) {
-    FLUSH_BEGINEND;
-
-	glquery_t *query = find_query(id);
-	if(!query) {
-		errorShim(GL_INVALID_OPERATION);
-		return;
-	}
+// common part of glGetQueryObject*, return 0 if params should not be changed
+static int get_query_object(glquery_t *query, GLenum pname, GLuint64 *res) {
+    noerrorShim();
     switch (pname) {
     	case GL_QUERY_RESULT_AVAILABLE:
-    		*params = GL_TRUE;//GL_FALSE;
-    		break;
+    		*res = (query->pending)?fetch_result(query, 0):GL_TRUE;
+    		return 1;
 		case GL_QUERY_RESULT_NO_WAIT:
+			if(query->pending && !fetch_result(query, 0))
+				return 0;
+			break;
     	case GL_QUERY_RESULT:
-    		*params = (query->target==GL_TIME_ELAPSED)?query->start:query->num;
+			fetch_result(query, 1);
     		break;
     	default:
     		errorShim(GL_INVALID_ENUM);
-			return;
+			return 0;
     }
-    noerrorShim();
+	if(query->real)
+		*res = query->result;
+	else
+		*res = (query->target==GL_TIME_ELAPSED)?query->start:query->num;
+	return 1;
+}
+
+void APIENTRY_GL4ES gl4es_glGetQueryObjectiv(GLuint id, GLenum pname, GLint* params) {
+    FLUSH_BEGINEND;
+
+	glquery_t *query = find_query(id);
+	if(!query) {
+		errorShim(GL_INVALID_OPERATION);
+		return;
+	}
+    GLuint64 res;
+    if(get_query_object(query, pname, &res))
+    	*params = res;
 }
 
 void APIENTRY_GL4ES gl4es_glGetQueryObjectuiv(GLuint id, GLenum pname, GLuint* params) {
@@ -231,19 +334,9 @@ void APIENTRY_GL4ES gl4es_glGetQueryObjectuiv(GLuint id, GLenum pname, GLuint* p
 		return;
 	}
 
-    switch (pname) {
-    	case GL_QUERY_RESULT_AVAILABLE:
-    		*params = GL_TRUE;//GL_FALSE;
-    		break;
-		case GL_QUERY_RESULT_NO_WAIT:
-    	case GL_QUERY_RESULT:
-    		*params = (query->target==GL_TIME_ELAPSED)?query->start:query->num;
-    		break;
-    	default:
-    		errorShim(GL_INVALID_ENUM);
-			return;
-    }
-    noerrorShim();
+    GLuint64 res;
+    if(get_query_object(query, pname, &res))
+    	*params = res;
 }
 
 void APIENTRY_GL4ES gl4es_glQueryCounter(GLuint id, GLenum target)
@@ -263,9 +356,20 @@ void APIENTRY_GL4ES gl4es_glQueryCounter(GLuint id, GLenum target)
 		errorShim(GL_INVALID_ENUM);
 		return;
 	}
+	query->id = id;
 	query->target = target;
 	// should finish first?
 	query->start = get_clock() - glstate->queries.start;
+	query->pending = 0;
+	if(hardware_target(target)) {
+		LOAD_GLES2_OR_EXT(glGenQueries);
+		LOAD_GLES_EXT(glQueryCounter);
+		if(!query->real)
+			gles_glGenQueries(1, &query->real);
+		gles_glQueryCounter(query->real, GL_TIMESTAMP);
+		query->pending = 1;
+	}
+	noerrorShim();
 }
 
 
@@ -279,19 +383,9 @@ void APIENTRY_GL4ES gl4es_glGetQueryObjecti64v(GLuint id, GLenum pname, GLint64
 		return;
 	}
 
-    switch (pname) {
-    	case GL_QUERY_RESULT_AVAILABLE:
-    		*params = GL_TRUE;//GL_FALSE;
-    		break;
-		case GL_QUERY_RESULT_NO_WAIT:
-    	case GL_QUERY_RESULT:
-    		*params = (query->target==GL_TIME_ELAPSED)?query->start:query->num;
-    		break;
-    	default:
-    		errorShim(GL_INVALID_ENUM);
-			return;
-    }
-    noerrorShim();
+    GLuint64 res;
+    if(get_query_object(query, pname, &res))
+    	*params = res;
 }
 	
 void APIENTRY_GL4ES gl4es_glGetQueryObjectui64v(GLuint id, GLenum pname, GLuint64 * params)
@@ -304,19 +398,9 @@ void APIENTRY_GL4ES gl4es_glGetQueryObjectui64v(GLuint id, GLenum pname, GLuint6
 		return;
 	}
 
-    switch (pname) {
-    	case GL_QUERY_RESULT_AVAILABLE:
-    		*params = GL_TRUE;//GL_FALSE;
-    		break;
-		case GL_QUERY_RESULT_NO_WAIT:
-    	case GL_QUERY_RESULT:
-    		*params = (query->target==GL_TIME_ELAPSED)?query->start:query->num;
-    		break;
-    	default:
-    		errorShim(GL_INVALID_ENUM);
-			return;
-    }
-    noerrorShim();
+    GLuint64 res;
+    if(get_query_object(query, pname, &res))
+    	*params = res;
 }
  
 
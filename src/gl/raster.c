@@ -10,6 +10,7 @@
 #include "loader.h"
 #include "matvec.h"
 #include "pixel.h"
+#include "trace.h"
 
 #undef min
 #undef max
@@ -298,6 +299,7 @@ void raster_to_texture(rasterlist_t *r)
 void bitmap_flush() {
 	if(!glstate->raster.bm_drawing)
 		return;
+	TRACE_BEGIN(bitmap_flush);
 	// draw actual bitmap
 	int old_tex_unit = glstate->texture.active;
 	if(old_tex_unit)
@@ -368,6 +370,7 @@ void bitmap_flush() {
 
 	if(old_tex_unit)
 		gl4es_glActiveTexture(GL_TEXTURE0 + old_tex_unit);
+	TRACE_END(bitmap_flush);
 }
 
 
@@ -150,17 +150,6 @@ void APIENTRY_GL4ES gl4es_glSelectBuffer(GLsizei size, GLuint *buffer) {
 	glstate->selectbuf.size = size;
 }
 
-void select_transform(GLfloat *a) {
-	/*
-	 Transform a[3] using projection and modelview matrix
-	*/
-	vector_matrix(a, getMVPMat(), a);
-	// take "w" into account...
-	a[0]/=a[3];
-	a[1]/=a[3];
-	a[2]/=a[3];
-}
-
 GLboolean select_point_in_viewscreen(const GLfloat *a) {
 	/* 
 	 Return True is point is inside the Viewport
@@ -240,263 +229,203 @@ GLboolean select_triangle_in_viewscreen(const GLfloat *a, const GLfloat *b, cons
 	 return false;
 }
 
-static void FASTMATH ZMinMax(GLfloat *zmin, GLfloat *zmax, GLfloat *vtx) {
+static void FASTMATH ZMinMax(GLfloat *zmin, GLfloat *zmax, const GLfloat *vtx) {
 	if (vtx[2]<*zmin) *zmin=vtx[2];
 	if (vtx[2]>*zmax) *zmax=vtx[2];
 }
 
-
-void select_glDrawArrays(const vertexattrib_t* vtx, GLenum mode, GLuint first, GLuint count) {
-	if (count == 0) return;
-	if (vtx->pointer == NULL) return;
-	if (glstate->selectbuf.buffer == NULL) return;
-	GLfloat *vert = copy_gl_array(vtx->pointer, vtx->type, 
-			vtx->size, vtx->stride,
-			GL_FLOAT, 4, 0, count+first, NULL);
-	GLfloat zmin=1e10f, zmax=-1e10f;
-	int found = 0;
-
-	#define FOUND()	{ 				\
-		found = 1;					\
-		glstate->selectbuf.hit = 1; \
+static GLfloat *select_fetch(const vertexattrib_t* vtx, GLuint first, GLuint last) {
+	/*
+	 Copy vertices [first, last[ as float4 in the select arena (grown if needed, never shrinked)
+	*/
+	int count = last - first;
+	if (glstate->selectbuf.arena_size < count) {
+		free(glstate->selectbuf.arena);
+		glstate->selectbuf.arena_size = (count+255)&~255;
+		glstate->selectbuf.arena = (GLfloat*)malloc(glstate->selectbuf.arena_size*4*sizeof(GLfloat));
 	}
+	GLfloat *vert = glstate->selectbuf.arena;
+	copy_gl_array(vtx->pointer, vtx->type, vtx->size, vtx->stride,
+			GL_FLOAT, 4, first, last, vert);
+	if (vtx->size<4)
+		for (int i=0; i<count; i++)
+			vert[i*4+3] = 1.0f;
+	return vert;
+}
 
-    // transform the points
-	for (int i=first; i<count+first; i++) {
-		select_transform(vert+i*4);
-		ZMinMax(&glstate->selectbuf.zminoverall, &glstate->selectbuf.zmaxoverall, vert+i*4);
-    }
-    // intersect with screen now
-    GLfloat *vert2 = vert + first*4;
-	for (int i=0; i<count; i++) {
-		switch (mode) {
-			case GL_POINTS:
-				if (select_point_in_viewscreen(vert2+i*4)) {
-					ZMinMax(&zmin, &zmax, vert+i*4);
-					FOUND();
-				}
-				break;
-			case GL_LINES:
-				if (i%2==1) {
-					if (select_segment_in_viewscreen(vert2+(i-1)*4, vert2+i*4)) {
-						ZMinMax(&zmin, &zmax, vert+(i-1)*4);
-						ZMinMax(&zmin, &zmax, vert+i*4);
-						FOUND();
-					}
-				}
-				break;
-			case GL_LINE_STRIP:
-			case GL_LINE_LOOP:		//FIXME: the last "loop" segment is missing here
-				if (i>0) {
-					if (select_segment_in_viewscreen(vert2+(i-1)*4, vert2+i*4)) {
-						ZMinMax(&zmin, &zmax, vert+(i-1)*4);
-						ZMinMax(&zmin, &zmax, vert+i*4);
-						FOUND();
-					}
-				}
-				break;
-			case GL_TRIANGLES:
-				if (i%3==2) {
-					if (select_triangle_in_viewscreen(vert2+(i-2)*4, vert2+(i-1)*4, vert2+i*4)) {
-						ZMinMax(&zmin, &zmax, vert+(i-2)*4);
-						ZMinMax(&zmin, &zmax, vert+(i-1)*4);
-						ZMinMax(&zmin, &zmax, vert+i*4);
-						FOUND();
-					}
-				}
-				break;
-			case GL_TRIANGLE_STRIP:
-				if (i>1) {
-					if (select_triangle_in_viewscreen(vert2+(i-2)*4, vert2+(i-1)*4, vert2+i*4)) {
-						ZMinMax(&zmin, &zmax, vert+(i-2)*4);
-						ZMinMax(&zmin, &zmax, vert+(i-1)*4);
-						ZMinMax(&zmin, &zmax, vert+i*4);
-						FOUND();
-					}
-				}
-				break;
-			case GL_TRIANGLE_FAN:
-				if (i>1) {
-					if (select_triangle_in_viewscreen(vert2, vert2+(i-1)*4, vert2+i*4)) {
-						ZMinMax(&zmin, &zmax, vert);
-						ZMinMax(&zmin, &zmax, vert+(i-1)*4);
-						ZMinMax(&zmin, &zmax, vert+i*4);
-						FOUND();
-					}
-				}
-				break;
-			default:
-				return;		// Should never go there!
-		}
-	}
-	free(vert);
-	if(found) {
-		if (zmin<glstate->selectbuf.zmin) 	glstate->selectbuf.zmin=zmin;
-		if (zmax>glstate->selectbuf.zmax) 	glstate->selectbuf.zmax=zmax;
+static void FASTMATH select_transform_batch(const GLfloat *mvp, GLfloat *vert, int count, GLfloat *bbox) {
+	/*
+	 Transform count float4 vertices in place using projection and modelview matrix,
+	 divide by "w" and compute the bounding box (xmin, ymin, zmin, xmax, ymax, zmax)
+	*/
+	vector_matrix_batch(vert, count, 4, mvp);
+	// take "w" into account, and get the bounding box...
+	GLfloat xmin=1e10f, ymin=1e10f, zmin=1e10f, xmax=-1e10f, ymax=-1e10f, zmax=-1e10f;
+	GLfloat *v = vert;
+	for (int i=0; i<count; i++, v+=4) {
+		const GLfloat w = 1.0f/v[3];
+		const GLfloat x=v[0]*w, y=v[1]*w, z=v[2]*w;
+		v[0]=x; v[1]=y; v[2]=z;
+		if (x<xmin) xmin=x;
+		if (x>xmax) xmax=x;
+		if (y<ymin) ymin=y;
+		if (y>ymax) ymax=y;
+		if (z<zmin) zmin=z;
+		if (z>zmax) zmax=z;
 	}
-	#undef FOUND
+	bbox[0]=xmin; bbox[1]=ymin; bbox[2]=zmin;
+	bbox[3]=xmax; bbox[4]=ymax; bbox[5]=zmax;
 }
 
-void select_glDrawElements(const vertexattrib_t* vtx, GLenum mode, GLuint count, GLenum type, GLvoid * indices) {
-	if (count == 0) return;
-	if (vtx->pointer == NULL) return;
+static inline GLuint select_index(const GLvoid *indices, GLenum type, GLuint i) {
+	switch (type) {
+		case GL_UNSIGNED_BYTE: return ((const GLubyte*)indices)[i];
+		case GL_UNSIGNED_SHORT: return ((const GLushort*)indices)[i];
+		case GL_UNSIGNED_INT: return ((const GLuint*)indices)[i];
+	}
+	return i;	// no indices
+}
 
-	GLushort *sind = (GLushort*)((type==GL_UNSIGNED_SHORT)?indices:NULL);
-	GLuint *iind = (GLuint*)((type==GL_UNSIGNED_INT)?indices:NULL);
+static void select_draw(GLfloat *vert, int nvert, GLenum mode, GLuint count, GLenum type, const GLvoid *indices, GLuint base) {
+	/*
+	 vert are nvert untransformed vertices, indices (or primitive order if NULL) are relative to base
+	*/
+	GLfloat bbox[6];
+	select_transform_batch(getMVPMat(), vert, nvert, bbox);
+	if (bbox[2]<glstate->selectbuf.zminoverall) glstate->selectbuf.zminoverall=bbox[2];
+	if (bbox[5]>glstate->selectbuf.zmaxoverall) glstate->selectbuf.zmaxoverall=bbox[5];
+	// whole draw outside the viewscreen, nothing to test
+	if (bbox[3]<=-1.0f || bbox[0]>=1.0f || bbox[4]<=-1.0f || bbox[1]>=1.0f)
+		return;
+	// whole draw inside the viewscreen, every primitive is a hit
+	const int inside = (bbox[0]>-1.0f && bbox[3]<1.0f && bbox[1]>-1.0f && bbox[4]<1.0f);
 
-	GLsizei min, max;
-	if(sind)
-		getminmax_indices_us(sind, &max, &min, count);
-	else
-		getminmax_indices_ui(iind, &max, &min, count);
-    max++;
-	GLfloat *vert = copy_gl_array(vtx->pointer, vtx->type, 
-			vtx->size, vtx->stride,
-			GL_FLOAT, 4, 0, max, NULL);
-	GLfloat zmin=1e10f, zmax=-10e6f;
+	GLfloat zmin=1e10f, zmax=-1e10f;
 	int found = 0;
-	for (int i=min; i<max; i++) {
-		select_transform(vert+i*4);
-		ZMinMax(&glstate->selectbuf.zminoverall, &glstate->selectbuf.zmaxoverall, vert+i*4);
-	}
 
-	#define FOUND()	{ 				\
-		found = 1;					\
-		glstate->selectbuf.hit = 1; \
+	#define V(i) (vert+(select_index(indices, type, (i))-base)*4)
+	#define HIT1(a) 											\
+		if (inside || select_point_in_viewscreen(a)) {			\
+			ZMinMax(&zmin, &zmax, a);							\
+			found = 1;											\
+		}
+	#define HIT2(a, b) 											\
+		if (inside || select_segment_in_viewscreen(a, b)) {		\
+			ZMinMax(&zmin, &zmax, a);							\
+			ZMinMax(&zmin, &zmax, b);							\
+			found = 1;											\
+		}
+	#define HIT3(a, b, c) 										\
+		if (inside || select_triangle_in_viewscreen(a, b, c)) {	\
+			ZMinMax(&zmin, &zmax, a);							\
+			ZMinMax(&zmin, &zmax, b);							\
+			ZMinMax(&zmin, &zmax, c);							\
+			found = 1;											\
+		}
+	#define HIT4(a, b, c, d) 									\
+		if (inside || select_triangle_in_viewscreen(a, b, c)	\
+				|| select_triangle_in_viewscreen(a, c, d)) {	\
+			ZMinMax(&zmin, &zmax, a);							\
+			ZMinMax(&zmin, &zmax, b);							\
+			ZMinMax(&zmin, &zmax, c);							\
+			ZMinMax(&zmin, &zmax, d);							\
+			found = 1;											\
 		}
 
-	if(sind) {
-		for (int i=0; i<count; i++) {
-			switch (mode) {
-				case GL_POINTS:
-					if (select_point_in_viewscreen(vert+sind[i]*4)) {
-						ZMinMax(&zmin, &zmax, vert+sind[i]*4);
-						FOUND();
-					}
-					break;
-				case GL_LINES:
-					if (i%2==1) {
-						if (select_segment_in_viewscreen(vert+sind[(i-1)]*4, vert+sind[i]*4)) {
-							ZMinMax(&zmin, &zmax, vert+sind[i-1]*4);
-							ZMinMax(&zmin, &zmax, vert+sind[i]*4);
-							FOUND();
-						}
-					}
-					break;
-				case GL_LINE_STRIP:
-				case GL_LINE_LOOP:		//FIXME: the last "loop" segment is missing here
-					if (i>0) {
-						if (select_segment_in_viewscreen(vert+sind[(i-1)]*4, vert+sind[i]*4)) {
-							ZMinMax(&zmin, &zmax, vert+sind[i-1]*4);
-							ZMinMax(&zmin, &zmax, vert+sind[i]*4);
-							FOUND();
-						}
-					}
-					break;
-				case GL_TRIANGLES:
-					if (i%3==2) {
-						if (select_triangle_in_viewscreen(vert+sind[(i-2)]*4, vert+sind[(i-1)]*4, vert+sind[i]*4)) {
-							ZMinMax(&zmin, &zmax, vert+sind[i-2]*4);
-							ZMinMax(&zmin, &zmax, vert+sind[i-1]*4);
-							ZMinMax(&zmin, &zmax, vert+sind[i]*4);
-							FOUND();
-						}
-					}
-					break;
-				case GL_TRIANGLE_STRIP:
-					if (i>1) {
-						if (select_triangle_in_viewscreen(vert+sind[(i-2)]*4, vert+sind[(i-1)]*4, vert+sind[i]*4)) {
-							ZMinMax(&zmin, &zmax, vert+sind[i-2]*4);
-							ZMinMax(&zmin, &zmax, vert+sind[i-1]*4);
-							ZMinMax(&zmin, &zmax, vert+sind[i]*4);
-							FOUND();
-						}
-					}
-					break;
-				case GL_TRIANGLE_FAN:
-					if (i>1) {
-						if (select_triangle_in_viewscreen(vert+sind[0]*4, vert+sind[(i-1)]*4, vert+sind[i]*4)) {
-							ZMinMax(&zmin, &zmax, vert+sind[0]*4);
-							ZMinMax(&zmin, &zmax, vert+sind[i-1]*4);
-							ZMinMax(&zmin, &zmax, vert+sind[i]*4);
-							FOUND();
-						}	
-					}
-					break;
-				default:
-					return;		// Should never go there!
+	switch (mode) {
+		case GL_POINTS:
+			for (int i=0; i<count; i++) {
+				const GLfloat *a = V(i);
+				HIT1(a);
 			}
-		} 
-	} else {
-		for (int i=0; i<count; i++) {
-			switch (mode) {
-				case GL_POINTS:
-					if (select_point_in_viewscreen(vert+iind[i]*4)) {
-						ZMinMax(&zmin, &zmax, vert+iind[i]*4);
-						FOUND();
-					}
-					break;
-				case GL_LINES:
-					if (i%2==1) {
-						if (select_segment_in_viewscreen(vert+iind[(i-1)]*4, vert+iind[i]*4)) {
-							ZMinMax(&zmin, &zmax, vert+iind[i-1]*4);
-							ZMinMax(&zmin, &zmax, vert+iind[i]*4);
-							FOUND();
-						}
-					}
-					break;
-				case GL_LINE_STRIP:
-				case GL_LINE_LOOP:		//FIXME: the last "loop" segment is missing here
-					if (i>0) {
-						if (select_segment_in_viewscreen(vert+iind[(i-1)]*4, vert+iind[i]*4)) {
-							ZMinMax(&zmin, &zmax, vert+iind[i-1]*4);
-							ZMinMax(&zmin, &zmax, vert+iind[i]*4);
-							FOUND();
-						}
-					}
-					break;
-				case GL_TRIANGLES:
-					if (i%3==2) {
-						if (select_triangle_in_viewscreen(vert+iind[(i-2)]*4, vert+iind[(i-1)]*4, vert+iind[i]*4)) {
-							ZMinMax(&zmin, &zmax, vert+iind[i-2]*4);
-							ZMinMax(&zmin, &zmax, vert+iind[i-1]*4);
-							ZMinMax(&zmin, &zmax, vert+iind[i]*4);
-							FOUND();
-						}
-					}
-					break;
-				case GL_TRIANGLE_STRIP:
-					if (i>1) {
-						if (select_triangle_in_viewscreen(vert+iind[(i-2)]*4, vert+iind[(i-1)]*4, vert+iind[i]*4)) {
-							ZMinMax(&zmin, &zmax, vert+iind[i-2]*4);
-							ZMinMax(&zmin, &zmax, vert+iind[i-1]*4);
-							ZMinMax(&zmin, &zmax, vert+iind[i]*4);
-							FOUND();
-						}
-					}
-					break;
-				case GL_TRIANGLE_FAN:
-					if (i>1) {
-						if (select_triangle_in_viewscreen(vert+iind[0]*4, vert+iind[(i-1)]*4, vert+iind[i]*4)) {
-							ZMinMax(&zmin, &zmax, vert+iind[0]*4);
-							ZMinMax(&zmin, &zmax, vert+iind[i-1]*4);
-							ZMinMax(&zmin, &zmax, vert+iind[i]*4);
-							FOUND();
-						}
-					}
-					break;
-				default:
-					return;		// Should never go there!
+			break;
+		case GL_LINES:
+			for (int i=1; i<count; i+=2) {
+				const GLfloat *a = V(i-1), *b = V(i);
+				HIT2(a, b);
 			}
-		}
+			break;
+		case GL_LINE_STRIP:
+		case GL_LINE_LOOP:
+			for (int i=1; i<count; i++) {
+				const GLfloat *a = V(i-1), *b = V(i);
+				HIT2(a, b);
+			}
+			if (mode==GL_LINE_LOOP && count>2) {
+				const GLfloat *a = V(count-1), *b = V(0);
+				HIT2(a, b);
+			}
+			break;
+		case GL_TRIANGLES:
+			for (int i=2; i<count; i+=3) {
+				const GLfloat *a = V(i-2), *b = V(i-1), *c = V(i);
+				HIT3(a, b, c);
+			}
+			break;
+		case GL_TRIANGLE_STRIP:
+			for (int i=2; i<count; i++) {
+				const GLfloat *a = V(i-2), *b = V(i-1), *c = V(i);
+				HIT3(a, b, c);
+			}
+			break;
+		case GL_TRIANGLE_FAN:
+		case GL_POLYGON:
+			for (int i=2; i<count; i++) {
+				const GLfloat *a = V(0), *b = V(i-1), *c = V(i);
+				HIT3(a, b, c);
+			}
+			break;
+		case GL_QUADS:
+			for (int i=3; i<count; i+=4) {
+				const GLfloat *a = V(i-3), *b = V(i-2), *c = V(i-1), *d = V(i);
+				HIT4(a, b, c, d);
+			}
+			break;
+		case GL_QUAD_STRIP:
+			for (int i=3; i<count; i+=2) {
+				const GLfloat *a = V(i-3), *b = V(i-2), *c = V(i), *d = V(i-1);
+				HIT4(a, b, c, d);
+			}
+			break;
+		default:
+			return;		// Should never go there!
 	}
-	free(vert);
+	#undef HIT4
+	#undef HIT3
+	#undef HIT2
+	#undef HIT1
+	#undef V
+
 	if(found) {
+		glstate->selectbuf.hit = 1;
 		if (zmin<glstate->selectbuf.zmin) 	glstate->selectbuf.zmin=zmin;
 		if (zmax>glstate->selectbuf.zmax) 	glstate->selectbuf.zmax=zmax;
 	}
+}
+
+void select_glDrawArrays(const vertexattrib_t* vtx, GLenum mode, GLuint first, GLuint count) {
+	if (count == 0) return;
+	if (vtx->pointer == NULL) return;
+	if (glstate->selectbuf.buffer == NULL) return;
+	GLfloat *vert = select_fetch(vtx, first, first+count);
+	select_draw(vert, count, mode, count, 0, NULL, 0);
+}
 
-	#undef FOUND
+void select_glDrawElements(const vertexattrib_t* vtx, GLenum mode, GLuint count, GLenum type, GLvoid * indices) {
+	if (count == 0) return;
+	if (vtx->pointer == NULL) return;
+	if (glstate->selectbuf.buffer == NULL) return;
+	if (type!=GL_UNSIGNED_BYTE && type!=GL_UNSIGNED_SHORT && type!=GL_UNSIGNED_INT) return;
+
+	GLuint min, max;
+	min = max = select_index(indices, type, 0);
+	for (int i=1; i<count; i++) {
+		GLuint n = select_index(indices, type, i);
+		if (n<min) min=n;
+		if (n>max) max=n;
+	}
+	GLfloat *vert = select_fetch(vtx, min, max+1);
+	select_draw(vert, max+1-min, mode, count, type, indices, min);
 }
 
 //Direct wrapper
@@ -9,6 +9,7 @@
 #include "string_utils.h"
 #include "shader_hacks.h"
 #include "logs.h"
+#include "trace.h"
 
 typedef struct {
     const char* glname;
@@ -440,6 +441,7 @@ char gl4es_VA[MAX_VATTRIB][32] = {0};
 char* ConvertShader(const char* pEntry, int isVertex, shaderconv_need_t *need)
 {
   #define ShadAppend(S) Tmp = gl4es_append(Tmp, &tmpsize, S)
+  TRACE_BEGIN(ConvertShader);
 
   if(gl_VA[0][0]=='\0') {
     for (int i=0; i<MAX_VATTRIB; ++i) {
@@ -1268,6 +1270,7 @@ char* ConvertShader(const char* pEntry, int isVertex, shaderconv_need_t *need)
     free(versionString);
   if(pEntry!=pBuffer)
     free(pBuffer);
+  TRACE_END(ConvertShader);
   return Tmp;
 }
 
@@ -4,6 +4,7 @@
 
 #include "../glx/hardext.h"
 #include "wrap/gl4es.h"
+#include "blend.h"
 #include "matrix.h"
 #include "debug.h"
 
@@ -36,108 +37,48 @@ void APIENTRY_GL4ES gl4es_glPushAttrib(GLbitfield mask) {
 
     glstack_t *cur = glstate->stack + glstate->stack->len;
     cur->mask = mask;
-    cur->clip_planes_enabled = NULL;
-    cur->clip_planes = NULL;
-    cur->lights_enabled = NULL;
-    cur->lights = NULL;
-    cur->materials = NULL;
+
+    // almost everything is shadowed in glstate, so copy it from there.
+    // Only the few values gl4es doesn't track go through glGet
+    cur->enable = glstate->enable;
+    if (mask & (GL_COLOR_BUFFER_BIT | GL_ENABLE_BIT))
+        cur->dither = gl4es_glIsEnabled(GL_DITHER);
+    if (mask & (GL_ENABLE_BIT | GL_SCISSOR_BIT))
+        cur->scissor_test = gl4es_glIsEnabled(GL_SCISSOR_TEST);
 
     // TODO: GL_ACCUM_BUFFER_BIT
 
-    // TODO: will tracking these myself be much faster than glGet?
     if (mask & GL_COLOR_BUFFER_BIT) {
-        cur->alpha_test = gl4es_glIsEnabled(GL_ALPHA_TEST);
-        gl4es_glGetIntegerv(GL_ALPHA_TEST_FUNC, &cur->alpha_test_func);
-        gl4es_glGetFloatv(GL_ALPHA_TEST_REF, &cur->alpha_test_ref);
+        cur->alpha_test_func = glstate->alphafunc;
+        cur->alpha_test_ref = glstate->alpharef;
 
-        cur->blend = gl4es_glIsEnabled(GL_BLEND);
-        gl4es_glGetIntegerv(GL_BLEND_SRC, &cur->blend_src_func);
-        gl4es_glGetIntegerv(GL_BLEND_DST, &cur->blend_dst_func);
+        cur->blend_func[0] = glstate->blendsfactorrgb;
+        cur->blend_func[1] = glstate->blenddfactorrgb;
+        cur->blend_func[2] = glstate->blendsfactoralpha;
+        cur->blend_func[3] = glstate->blenddfactoralpha;
 
-        cur->dither = gl4es_glIsEnabled(GL_DITHER);
-        cur->color_logic_op = gl4es_glIsEnabled(GL_COLOR_LOGIC_OP);
-        gl4es_glGetIntegerv(GL_LOGIC_OP_MODE, &cur->logic_op);
+        cur->logic_op = glstate->logicop;
 
         gl4es_glGetFloatv(GL_COLOR_CLEAR_VALUE, cur->clear_color);
-        gl4es_glGetFloatv(GL_COLOR_WRITEMASK, cur->color_mask);
+        memcpy(cur->color_mask, glstate->colormask, sizeof(cur->color_mask));
     }
 
     if (mask & GL_CURRENT_BIT) {
-        gl4es_glGetFloatv(GL_CURRENT_COLOR, cur->color);
-        gl4es_glGetFloatv(GL_CURRENT_NORMAL, cur->normal);
-        gl4es_glGetFloatv(GL_CURRENT_TEXTURE_COORDS, cur->tex);
+        memcpy(cur->color, glstate->color, 4*sizeof(GLfloat));
+        memcpy(cur->normal, glstate->normal, 3*sizeof(GLfloat));
+        for (int a=0; a<hardext.maxtex; a++)
+            memcpy(cur->tex[a], glstate->texcoord[a], 4*sizeof(GLfloat));
     }
 
-    if (mask & GL_DEPTH_BUFFER_BIT) {
-        cur->depth_test = gl4es_glIsEnabled(GL_DEPTH_TEST);
-        gl4es_glGetIntegerv(GL_DEPTH_FUNC, &cur->depth_func);
-        gl4es_glGetFloatv(GL_DEPTH_CLEAR_VALUE, &cur->clear_depth);
-        gl4es_glGetIntegerv(GL_DEPTH_WRITEMASK, &cur->depth_mask);
-    }
-
-    if (mask & GL_ENABLE_BIT) {
-        int i;
-
-        cur->alpha_test = gl4es_glIsEnabled(GL_ALPHA_TEST);
-        cur->autonormal = gl4es_glIsEnabled(GL_AUTO_NORMAL);
-        cur->blend = gl4es_glIsEnabled(GL_BLEND);
-        
-        cur->clip_planes_enabled = (GLboolean *)malloc(hardext.maxplanes * sizeof(GLboolean));
-        for (i = 0; i < hardext.maxplanes; i++) {
-            *(cur->clip_planes_enabled + i) = gl4es_glIsEnabled(GL_CLIP_PLANE0 + i);
-        }
-
-        cur->colormaterial = gl4es_glIsEnabled(GL_COLOR_MATERIAL);
-        cur->cull_face = gl4es_glIsEnabled(GL_CULL_FACE);
-        cur->depth_test = gl4es_glIsEnabled(GL_DEPTH_TEST);
-        cur->dither = gl4es_glIsEnabled(GL_DITHER);
-        cur->fog = gl4es_glIsEnabled(GL_FOG);
-
-        cur->lights_enabled = (GLboolean *)malloc(hardext.maxlights * sizeof(GLboolean));
-        for (i = 0; i < hardext.maxlights; i++) {
-            *(cur->lights_enabled + i) = gl4es_glIsEnabled(GL_LIGHT0 + i);
-        }
-
-        cur->lighting = gl4es_glIsEnabled(GL_LIGHTING);
-        cur->line_smooth = gl4es_glIsEnabled(GL_LINE_SMOOTH);
-        cur->line_stipple = gl4es_glIsEnabled(GL_LINE_STIPPLE);
-        cur->color_logic_op = gl4es_glIsEnabled(GL_COLOR_LOGIC_OP);
-        //TODO: GL_INDEX_LOGIC_OP
-        //TODO: GL_MAP1_x
-        //TODO: GL_MAP2_x
-        cur->multisample = gl4es_glIsEnabled(GL_MULTISAMPLE);
-        cur->normalize = gl4es_glIsEnabled(GL_NORMALIZE);
-        cur->point_smooth = gl4es_glIsEnabled(GL_POINT_SMOOTH);
-        //TODO: GL_POLYGON_OFFSET_LINE
-        cur->polygon_offset_fill = gl4es_glIsEnabled(GL_POLYGON_OFFSET_FILL);
-        //TODO: GL_POLYGON_OFFSET_POINT
-        //TODO: GL_POLYGON_SMOOTH
-        //TODO: GL_POLYGON_STIPPLE
-        cur->sample_alpha_to_coverage = gl4es_glIsEnabled(GL_SAMPLE_ALPHA_TO_COVERAGE);
-        cur->sample_alpha_to_one = gl4es_glIsEnabled(GL_SAMPLE_ALPHA_TO_ONE);
-        cur->sample_coverage = gl4es_glIsEnabled(GL_SAMPLE_COVERAGE);
-        cur->scissor_test = gl4es_glIsEnabled(GL_SCISSOR_TEST);
-        cur->stencil_test = gl4es_glIsEnabled(GL_STENCIL_TEST);
-        int a;
-        for (a=0; a<hardext.maxtex; a++) {
-            cur->tex_enabled[a] = glstate->enable.texture[a];
-            cur->texgen_s[a] = glstate->enable.texgen_s[a];
-            cur->texgen_r[a] = glstate->enable.texgen_r[a];
-            cur->texgen_t[a] = glstate->enable.texgen_t[a];
-            cur->texgen_q[a] = glstate->enable.texgen_q[a];
-        }
-        cur->pointsprite = gl4es_glIsEnabled(GL_POINT_SPRITE);
+    if (mask & (GL_DEPTH_BUFFER_BIT | GL_VIEWPORT_BIT)) {
+        cur->depth = glstate->depth;
     }
 
+    //TODO: GL_MAP1_x, GL_MAP2_x
     // TODO: GL_EVAL_BIT
 
     if (mask & GL_FOG_BIT) {
-        cur->fog = gl4es_glIsEnabled(GL_FOG);
-        gl4es_glGetFloatv(GL_FOG_COLOR, cur->fog_color);
-        gl4es_glGetFloatv(GL_FOG_DENSITY, &cur->fog_density);
-        gl4es_glGetFloatv(GL_FOG_START, &cur->fog_start);
-        gl4es_glGetFloatv(GL_FOG_END, &cur->fog_end);
-        gl4es_glGetIntegerv(GL_FOG_MODE, &cur->fog_mode);
+        cur->fog = glstate->fog;
     }
 
     if (mask & GL_HINT_BIT) {
@@ -151,41 +92,13 @@ void APIENTRY_GL4ES gl4es_glPushAttrib(GLbitfield mask) {
     }
 
     if (mask & GL_LIGHTING_BIT) {
-        cur->lighting = gl4es_glIsEnabled(GL_LIGHTING);
-        gl4es_glGetFloatv(GL_LIGHT_MODEL_AMBIENT, cur->light_model_ambient);
-        gl4es_glGetIntegerv(GL_LIGHT_MODEL_TWO_SIDE, &cur->light_model_two_side);
-
-        int i;
-        int j=0;
-        cur->lights_enabled = (GLboolean *)malloc(hardext.maxlights * sizeof(GLboolean));
-        cur->lights = (GLfloat *)malloc(hardext.maxlights * sizeof(GLfloat)*(10*4));
-        for (i = 0; i < hardext.maxlights; i++) {
-            *(cur->lights_enabled + i) = gl4es_glIsEnabled(GL_LIGHT0 + i);
-            #define L(A) gl4es_glGetLightfv(GL_LIGHT0 + i, A, cur->lights+j); j+=4
-            L(GL_AMBIENT);
-            L(GL_DIFFUSE);
-            L(GL_SPECULAR);
-            L(GL_POSITION); 
-            L(GL_SPOT_CUTOFF);
-            L(GL_SPOT_DIRECTION);
-            L(GL_SPOT_EXPONENT);
-            L(GL_CONSTANT_ATTENUATION);
-            L(GL_LINEAR_ATTENUATION);
-            L(GL_QUADRATIC_ATTENUATION);
-            #undef L
-        }
-        j=0;
-        cur->materials = (GLfloat *)malloc(2 * sizeof(GLfloat)*(5*4));
-        memset(cur->materials, 0, 2 * sizeof(GLfloat)*(5*4));
-        #define M(A) gl4es_glGetMaterialfv(GL_BACK, A, cur->materials+j); j+=4; gl4es_glGetMaterialfv(GL_FRONT, A, cur->materials+j); j+=4
-        M(GL_AMBIENT); M(GL_DIFFUSE); M(GL_SPECULAR); M(GL_EMISSION); M(GL_SHININESS);  // handle both face at some point?
-        #undef M
-        gl4es_glGetIntegerv(GL_SHADE_MODEL, &cur->shade_model);
+        cur->light = glstate->light;
+        cur->material = glstate->material;
+        cur->shade_model = glstate->shademodel;
     }
 
     if (mask & GL_LINE_BIT) {
-        cur->line_smooth = gl4es_glIsEnabled(GL_LINE_SMOOTH);
-        // TODO: stipple stuff here
+        // TODO: stipple pattern here
         gl4es_glGetFloatv(GL_LINE_WIDTH, &cur->line_width);
     }
 
@@ -194,96 +107,52 @@ void APIENTRY_GL4ES gl4es_glPushAttrib(GLbitfield mask) {
         cur->list_base = glstate->list.base;
     }
 
-    if (mask & GL_MULTISAMPLE_BIT) {
-        cur->multisample = gl4es_glIsEnabled(GL_MULTISAMPLE);
-        cur->sample_alpha_to_coverage = gl4es_glIsEnabled(GL_SAMPLE_ALPHA_TO_COVERAGE);
-        cur->sample_alpha_to_one = gl4es_glIsEnabled(GL_SAMPLE_ALPHA_TO_ONE);
-        cur->sample_coverage = gl4es_glIsEnabled(GL_SAMPLE_COVERAGE);
-    }
-
     // GL_PIXEL_MODE_BIT
 	if (mask & GL_PIXEL_MODE_BIT) {
-		GLenum pixel_name[] = {GL_RED_BIAS, GL_RED_SCALE, GL_GREEN_BIAS, GL_GREEN_SCALE, GL_BLUE_BIAS, GL_BLUE_SCALE, GL_ALPHA_BIAS, GL_ALPHA_SCALE};
-		int i;
-		for (i=0; i<8; i++) 
-			gl4es_glGetFloatv(pixel_name[i], &cur->pixel_scale_bias[i]);
+		memcpy(cur->pixel_scale, glstate->raster.raster_scale, 4*sizeof(GLfloat));
+		memcpy(cur->pixel_bias, glstate->raster.raster_bias, 4*sizeof(GLfloat));
         //TODO: GL_DEPTH_BIAS & GL_DEPTH_SCALE (probably difficult)
         //TODO: GL_INDEX_OFFEST & GL_INDEX_SHIFT
         //TODO: GL_MAP_COLOR & GL_MAP_STENCIL (probably difficult too)
-		gl4es_glGetFloatv(GL_ZOOM_X, &cur->pixel_zoomx);
-		gl4es_glGetFloatv(GL_ZOOM_Y, &cur->pixel_zoomy);
+		cur->pixel_zoomx = glstate->raster.raster_zoomx;
+		cur->pixel_zoomy = glstate->raster.raster_zoomy;
 	}
 	
     if (mask & GL_POINT_BIT) {
-        cur->point_smooth = gl4es_glIsEnabled(GL_POINT_SMOOTH);
-        gl4es_glGetFloatv(GL_POINT_SIZE, &cur->point_size);
-        if(hardext.pointsprite) {
-            cur->pointsprite = gl4es_glIsEnabled(GL_POINT_SPRITE);
-            int a;
-            for (a=0; a<hardext.maxtex; a++) {
-                cur->pscoordreplace[a] = glstate->texture.pscoordreplace[a];
-            }
-        }
+        cur->point_size = glstate->pointsprite.size;
+        memcpy(cur->pscoordreplace, glstate->texture.pscoordreplace, sizeof(cur->pscoordreplace));
     }
 
     // TODO: GL_POLYGON_BIT
     // TODO: GL_POLYGON_STIPPLE_BIT
 
     if (mask & GL_SCISSOR_BIT) {
-        cur->scissor_test = gl4es_glIsEnabled(GL_SCISSOR_TEST);
-        gl4es_glGetFloatv(GL_SCISSOR_BOX, cur->scissor_box);
+        cur->scissor_box = glstate->raster.scissor;
     }
 
     // TODO: GL_STENCIL_BUFFER_BIT on both faces
     if (mask & GL_STENCIL_BUFFER_BIT) {
-        cur->stencil_test = gl4es_glIsEnabled(GL_STENCIL_TEST);
-        gl4es_glGetIntegerv(GL_STENCIL_FUNC, (GLint *) &cur->stencil_func);
-        gl4es_glGetIntegerv(GL_STENCIL_VALUE_MASK, (GLint *) &cur->stencil_mask);
-        gl4es_glGetIntegerv(GL_STENCIL_REF, (GLint *) &cur->stencil_ref);
-        //TODO: glStencilFuncSeperate
-        
-        //TODO: Stencil value mask
-        gl4es_glGetIntegerv(GL_STENCIL_FAIL, (GLint *) &cur->stencil_sfail);
-        gl4es_glGetIntegerv(GL_STENCIL_PASS_DEPTH_FAIL, (GLint *) &cur->stencil_dpfail);
-        gl4es_glGetIntegerv(GL_STENCIL_PASS_DEPTH_PASS, (GLint *) &cur->stencil_dppass);
-        //TODO: glStencilOpSeparate
-
-        gl4es_glGetIntegerv(GL_STENCIL_CLEAR_VALUE, &cur->stencil_clearvalue);
-        //TODO: Stencil buffer writemask
+        cur->stencil = glstate->stencil;
     }
+
     // GL_TEXTURE_BIT - TODO: incomplete
     if (mask & GL_TEXTURE_BIT) {
         cur->active=glstate->texture.active;
+        memcpy(cur->texgen, glstate->texgen, sizeof(cur->texgen));   // all mode and planes per texture
         int a;
         for (a=0; a<hardext.maxtex; a++) {
-            cur->texgen_r[a] = glstate->enable.texgen_r[a];
-            cur->texgen_s[a] = glstate->enable.texgen_s[a];
-            cur->texgen_t[a] = glstate->enable.texgen_t[a];
-            cur->texgen_q[a] = glstate->enable.texgen_q[a];
-            cur->texgen[a] = glstate->texgen[a];   // all mode and planes per texture in 1 line
             for (int j=0; j<ENABLED_TEXTURE_LAST; j++)
 	            cur->texture[a][j] = glstate->texture.bound[a][j]->texture;
         }
-        //glActiveTexture(GL_TEXTURE0+cur->active);
     }
 
     // GL_TRANSFORM_BIT
     if (mask & GL_TRANSFORM_BIT) {
-		if (!(mask & GL_ENABLE_BIT)) {
-			int i;
-			cur->clip_planes_enabled = (GLboolean *)malloc(hardext.maxplanes * sizeof(GLboolean));
-			for (i = 0; i < hardext.maxplanes; i++) {
-				*(cur->clip_planes_enabled + i) = gl4es_glIsEnabled(GL_CLIP_PLANE0 + i);
-			}
-		}
-		gl4es_glGetIntegerv(GL_MATRIX_MODE, (GLint *) &cur->matrix_mode);
-		cur->rescale_normal_flag = gl4es_glIsEnabled(GL_RESCALE_NORMAL);
-		cur->normalize_flag = gl4es_glIsEnabled(GL_NORMALIZE);
+		cur->matrix_mode = glstate->matrix_mode;
 	}
     // GL_VIEWPORT_BIT
     if (mask & GL_VIEWPORT_BIT) {
-		gl4es_glGetIntegerv(GL_VIEWPORT, cur->viewport_size);
-		gl4es_glGetFloatv(GL_DEPTH_RANGE, cur->depth_range);
+		cur->viewport = glstate->raster.viewport;
 	}
 		
     glstate->stack->len++;
@@ -323,17 +192,29 @@ void APIENTRY_GL4ES gl4es_glPushClientAttrib(GLbitfield mask) {
     glstate->clientStack->len++;
 }
 
-#define maybe_free(x) \
-    if (x) free(x)
-
 #define enable_disable(pname, enabled) \
     if (enabled) gl4es_glEnable(pname);      \
     else gl4es_glDisable(pname)
 
+// only touch the flags that changed since the push
+#define restore_enable(pname, flag) \
+    if (glstate->enable.flag != cur->enable.flag) { enable_disable(pname, cur->enable.flag); }
+
 #define v2(c) c[0], c[1]
 #define v3(c) v2(c), c[2]
 #define v4(c) v3(c), c[3]
 
+static void restore_material(GLenum pname, const GLfloat *front, const GLfloat *back, const GLfloat *now_front, const GLfloat *now_back, int n) {
+    const int df = memcmp(front, now_front, n*sizeof(GLfloat));
+    const int db = memcmp(back, now_back, n*sizeof(GLfloat));
+    if (df && db && memcmp(front, back, n*sizeof(GLfloat))==0) {
+        gl4es_glMaterialfv(GL_FRONT_AND_BACK, pname, front);
+        return;
+    }
+    if (df) gl4es_glMaterialfv(GL_FRONT, pname, front);
+    if (db) gl4es_glMaterialfv(GL_BACK, pname, back);
+}
+
 void APIENTRY_GL4ES gl4es_glPopAttrib(void) {
 DBG(printf("glPopAttrib()\n");)
     noerrorShim();
@@ -352,81 +233,98 @@ DBG(printf("glPopAttrib()\n");)
     glstack_t *cur = glstate->stack + glstate->stack->len-1;
 
     if (cur->mask & GL_COLOR_BUFFER_BIT) {
-        enable_disable(GL_ALPHA_TEST, cur->alpha_test);
-        gl4es_glAlphaFunc(cur->alpha_test_func, cur->alpha_test_ref);
-
-        enable_disable(GL_BLEND, cur->blend);
-        gl4es_glBlendFunc(cur->blend_src_func, cur->blend_dst_func);
+        restore_enable(GL_ALPHA_TEST, alpha_test);
+        if (glstate->alphafunc != cur->alpha_test_func || glstate->alpharef != cur->alpha_test_ref)
+            gl4es_glAlphaFunc(cur->alpha_test_func, cur->alpha_test_ref);
+
+        restore_enable(GL_BLEND, blend);
+        if (glstate->blendsfactorrgb != cur->blend_func[0] || glstate->blenddfactorrgb != cur->blend_func[1]
+         || glstate->blendsfactoralpha != cur->blend_func[2] || glstate->blenddfactoralpha != cur->blend_func[3]) {
+            if (cur->blend_func[0] == cur->blend_func[2] && cur->blend_func[1] == cur->blend_func[3])
+                gl4es_glBlendFunc(cur->blend_func[0], cur->blend_func[1]);
+            else
+                gl4es_glBlendFuncSeparate(v4(cur->blend_func));
+        }
 
         enable_disable(GL_DITHER, cur->dither);
-        enable_disable(GL_COLOR_LOGIC_OP, cur->color_logic_op);
-        gl4es_glLogicOp(cur->logic_op);
+        restore_enable(GL_COLOR_LOGIC_OP, color_logic_op);
+        if (glstate->logicop != cur->logic_op)
+            gl4es_glLogicOp(cur->logic_op);
 
         gl4es_glClearColor(v4(cur->clear_color));
-        gl4es_glColorMask(v4(cur->color_mask));
+        if (memcmp(glstate->colormask, cur->color_mask, sizeof(cur->color_mask)))
+            gl4es_glColorMask(v4(cur->color_mask));
     }
 
     if (cur->mask & GL_CURRENT_BIT) {
-        gl4es_glColor4f(v4(cur->color));
-        gl4es_glNormal3f(v3(cur->normal));
-        gl4es_glTexCoord4f(v4(cur->tex));
+        if (memcmp(glstate->color, cur->color, 4*sizeof(GLfloat)))
+            gl4es_glColor4f(v4(cur->color));
+        if (memcmp(glstate->normal, cur->normal, 3*sizeof(GLfloat)))
+            gl4es_glNormal3f(v3(cur->normal));
+        for (int a=0; a<hardext.maxtex; a++)
+            if (memcmp(glstate->texcoord[a], cur->tex[a], 4*sizeof(GLfloat)))
+                gl4es_glMultiTexCoord4f(GL_TEXTURE0+a, v4(cur->tex[a]));
     }
 
     if (cur->mask & GL_DEPTH_BUFFER_BIT) {
-        enable_disable(GL_DEPTH_TEST, cur->depth_test);
-        gl4es_glDepthFunc(cur->depth_func);
-        gl4es_glClearDepth(cur->clear_depth);
-        gl4es_glDepthMask(cur->depth_mask);
+        restore_enable(GL_DEPTH_TEST, depth_test);
+        if (glstate->depth.func != cur->depth.func)
+            gl4es_glDepthFunc(cur->depth.func);
+        if (glstate->depth.clear != cur->depth.clear)
+            gl4es_glClearDepthf(cur->depth.clear);
+        if (glstate->depth.mask != cur->depth.mask)
+            gl4es_glDepthMask(cur->depth.mask);
     }
 
     if (cur->mask & GL_ENABLE_BIT) {
         int i;
 
-        enable_disable(GL_ALPHA_TEST, cur->alpha_test);
-        enable_disable(GL_AUTO_NORMAL, cur->autonormal);
-        enable_disable(GL_BLEND, cur->blend);
+        restore_enable(GL_ALPHA_TEST, alpha_test);
+        restore_enable(GL_AUTO_NORMAL, auto_normal);
+        restore_enable(GL_BLEND, blend);
 
         for (i = 0; i < hardext.maxplanes; i++) {
-            enable_disable(GL_CLIP_PLANE0 + i, *(cur->clip_planes_enabled + i));
+            restore_enable(GL_CLIP_PLANE0 + i, plane[i]);
         }
 
-        enable_disable(GL_COLOR_MATERIAL, cur->colormaterial);
-        enable_disable(GL_CULL_FACE, cur->cull_face);
-        enable_disable(GL_DEPTH_TEST, cur->depth_test);
+        restore_enable(GL_COLOR_MATERIAL, color_material);
+        restore_enable(GL_CULL_FACE, cull_face);
+        restore_enable(GL_DEPTH_TEST, depth_test);
         enable_disable(GL_DITHER, cur->dither);
-        enable_disable(GL_FOG, cur->fog);
+        restore_enable(GL_FOG, fog);
 
         for (i = 0; i < hardext.maxlights; i++) {
-            enable_disable(GL_LIGHT0 + i, *(cur->lights_enabled + i));
+            restore_enable(GL_LIGHT0 + i, light[i]);
         }
 
-        enable_disable(GL_LIGHTING, cur->lighting);
-        enable_disable(GL_LINE_SMOOTH, cur->line_smooth);
-        enable_disable(GL_LINE_STIPPLE, cur->line_stipple);
-        enable_disable(GL_COLOR_LOGIC_OP, cur->color_logic_op);
+        restore_enable(GL_LIGHTING, lighting);
+        restore_enable(GL_LINE_SMOOTH, line_smooth);
+        restore_enable(GL_LINE_STIPPLE, line_stipple);
+        restore_enable(GL_COLOR_LOGIC_OP, color_logic_op);
         //TODO: GL_INDEX_LOGIC_OP
         //TODO: GL_MAP1_x
         //TODO: GL_MAP2_x
-        enable_disable(GL_MULTISAMPLE, cur->multisample);
-        enable_disable(GL_NORMALIZE, cur->normalize);
-        enable_disable(GL_POINT_SMOOTH, cur->point_smooth);
+        restore_enable(GL_MULTISAMPLE, multisample);
+        restore_enable(GL_NORMALIZE, normalize);
+        restore_enable(GL_RESCALE_NORMAL, normal_rescale);
+        restore_enable(GL_POINT_SMOOTH, point_smooth);
         //TODO: GL_POLYGON_OFFSET_LINE
-        enable_disable(GL_POLYGON_OFFSET_FILL, cur->polygon_offset_fill);
+        restore_enable(GL_POLYGON_OFFSET_FILL, polyfill_offset);
         //TODO: GL_POLYGON_OFFSET_POINT
         //TODO: GL_POLYGON_SMOOTH
         //TODO: GL_POLYGON_STIPPLE
-        enable_disable(GL_SAMPLE_ALPHA_TO_COVERAGE, cur->sample_alpha_to_coverage);
-        enable_disable(GL_SAMPLE_ALPHA_TO_ONE, cur->sample_alpha_to_one);
-        enable_disable(GL_SAMPLE_COVERAGE, cur->sample_coverage);
+        restore_enable(GL_SAMPLE_ALPHA_TO_COVERAGE, sample_alpha_to_coverage);
+        restore_enable(GL_SAMPLE_ALPHA_TO_ONE, sample_alpha_to_one);
+        restore_enable(GL_SAMPLE_COVERAGE, sample_coverage);
         enable_disable(GL_SCISSOR_TEST, cur->scissor_test);
-        enable_disable(GL_STENCIL_TEST, cur->stencil_test);
-        enable_disable(GL_POINT_SPRITE, cur->pointsprite);
+        restore_enable(GL_STENCIL_TEST, stencil_test);
+        restore_enable(GL_POINT_SPRITE, pointsprite);
         int a;
         int old_tex = glstate->texture.active;
         for (a=0; a<hardext.maxtex; a++) {
-            if(glstate->enable.texture[a] != cur->tex_enabled[a]) {
+            if(glstate->enable.texture[a] != cur->enable.texture[a]) {
                 for (int j=0; j<ENABLED_TEXTURE_LAST; j++) {
-                    const GLuint t = cur->tex_enabled[a] & (1<<j);
+                    const GLuint t = cur->enable.texture[a] & (1<<j);
                     if ((glstate->enable.texture[a] & (1<<j)) != t) {
                         if(glstate->texture.active!=a)
                             gl4es_glActiveTexture(GL_TEXTURE0+a);
@@ -434,21 +332,27 @@ DBG(printf("glPopAttrib()\n");)
                     }
                 }
             }
-            glstate->enable.texgen_r[a] = cur->texgen_r[a];
-            glstate->enable.texgen_s[a] = cur->texgen_s[a];
-            glstate->enable.texgen_t[a] = cur->texgen_t[a];
-            glstate->enable.texgen_q[a] = cur->texgen_q[a];
+            glstate->enable.texgen_r[a] = cur->enable.texgen_r[a];
+            glstate->enable.texgen_s[a] = cur->enable.texgen_s[a];
+            glstate->enable.texgen_t[a] = cur->enable.texgen_t[a];
+            glstate->enable.texgen_q[a] = cur->enable.texgen_q[a];
         }
         if (glstate->texture.active != old_tex) gl4es_glActiveTexture(GL_TEXTURE0+old_tex);
     }
 
     if (cur->mask & GL_FOG_BIT) {
-        enable_disable(GL_FOG, cur->fog);
-        gl4es_glFogfv(GL_FOG_COLOR, cur->fog_color);
-        gl4es_glFogf(GL_FOG_DENSITY, cur->fog_density);
-        gl4es_glFogf(GL_FOG_START, cur->fog_start);
-        gl4es_glFogf(GL_FOG_END, cur->fog_end);
-        gl4es_glFogf(GL_FOG_MODE, cur->fog_mode);
+        restore_enable(GL_FOG, fog);
+        if (memcmp(glstate->fog.color, cur->fog.color, 4*sizeof(GLfloat)))
+            gl4es_glFogfv(GL_FOG_COLOR, cur->fog.color);
+        #define F(A, f) if (glstate->fog.f != cur->fog.f) gl4es_glFogf(A, cur->fog.f)
+        F(GL_FOG_MODE, mode);
+        F(GL_FOG_DENSITY, density);
+        F(GL_FOG_START, start);
+        F(GL_FOG_END, end);
+        F(GL_FOG_INDEX, index);
+        F(GL_FOG_COORD_SRC, coord_src);
+        F(GL_FOG_DISTANCE_MODE_NV, distance);
+        #undef F
     }
 
     if (cur->mask & GL_HINT_BIT) {
@@ -462,73 +366,88 @@ DBG(printf("glPopAttrib()\n");)
     }
 
     if (cur->mask & GL_LIGHTING_BIT) {
-        enable_disable(GL_LIGHTING, cur->lighting);
-        gl4es_glLightModelfv(GL_LIGHT_MODEL_AMBIENT, cur->light_model_ambient);
-        gl4es_glLightModeli(GL_LIGHT_MODEL_TWO_SIDE, cur->light_model_two_side);
+        restore_enable(GL_LIGHTING, lighting);
+        if (memcmp(glstate->light.ambient, cur->light.ambient, 4*sizeof(GLfloat)))
+            gl4es_glLightModelfv(GL_LIGHT_MODEL_AMBIENT, cur->light.ambient);
+        if (glstate->light.two_side != cur->light.two_side)
+            gl4es_glLightModeli(GL_LIGHT_MODEL_TWO_SIDE, cur->light.two_side);
+        if (glstate->light.separate_specular != cur->light.separate_specular)
+            gl4es_glLightModeli(GL_LIGHT_MODEL_COLOR_CONTROL, cur->light.separate_specular?GL_SEPARATE_SPECULAR_COLOR:GL_SINGLE_COLOR);
+        if (glstate->light.local_viewer != cur->light.local_viewer)
+            gl4es_glLightModeli(GL_LIGHT_MODEL_LOCAL_VIEWER, cur->light.local_viewer);
 
         int i;
-        int j=0;
         int old_matrixmode = glstate->matrix_mode;
-        // Light position / direction is transformed. So load identity in modelview to restore correct stuff
-        int identity = is_identity(getMVMat());
-        if(!identity) {
-            if(old_matrixmode != GL_MODELVIEW) gl4es_glMatrixMode(GL_MODELVIEW);
-            gl4es_glPushMatrix();
-            gl4es_glLoadIdentity();
-        }
+        int pushed = 0;
         for (i = 0; i < hardext.maxlights; i++) {
-            enable_disable(GL_LIGHT0 + i, *(cur->lights_enabled + i));
-            #define L(A) gl4es_glLightfv(GL_LIGHT0 + i, A, cur->lights+j); j+=4
-            L(GL_AMBIENT);
-            L(GL_DIFFUSE);
-            L(GL_SPECULAR);
-            L(GL_POSITION); 
-            L(GL_SPOT_CUTOFF);
-            L(GL_SPOT_DIRECTION);
-            L(GL_SPOT_EXPONENT);
-            L(GL_CONSTANT_ATTENUATION);
-            L(GL_LINEAR_ATTENUATION);
-            L(GL_QUADRATIC_ATTENUATION);
+            restore_enable(GL_LIGHT0 + i, light[i]);
+            const light_t *l = &cur->light.lights[i];
+            const light_t *now = &glstate->light.lights[i];
+            if (memcmp(l, now, sizeof(light_t))==0)
+                continue;
+            #define L(A, f) if (memcmp(now->f, l->f, sizeof(l->f))) gl4es_glLightfv(GL_LIGHT0 + i, A, l->f)
+            #define Lf(A, f) if (now->f != l->f) gl4es_glLightf(GL_LIGHT0 + i, A, l->f)
+            L(GL_AMBIENT, ambient);
+            L(GL_DIFFUSE, diffuse);
+            L(GL_SPECULAR, specular);
+            Lf(GL_SPOT_CUTOFF, spotCutoff);
+            Lf(GL_SPOT_EXPONENT, spotExponent);
+            Lf(GL_CONSTANT_ATTENUATION, constantAttenuation);
+            Lf(GL_LINEAR_ATTENUATION, linearAttenuation);
+            Lf(GL_QUADRATIC_ATTENUATION, quadraticAttenuation);
+            if (memcmp(now->position, l->position, sizeof(l->position)) || memcmp(now->spotDirection, l->spotDirection, sizeof(l->spotDirection))) {
+                // Light position / direction are stored transformed. So load identity in modelview to restore them as is
+                if (!pushed && !glstate->modelview_matrix->identity) {
+                    if(old_matrixmode != GL_MODELVIEW) gl4es_glMatrixMode(GL_MODELVIEW);
+                    gl4es_glPushMatrix();
+                    gl4es_glLoadIdentity();
+                    pushed = 1;
+                }
+                L(GL_POSITION, position);
+                L(GL_SPOT_DIRECTION, spotDirection);
+            }
+            #undef Lf
             #undef L
         }
-        if(!identity) {
+        if (pushed) {
             gl4es_glPopMatrix();
             if(old_matrixmode != GL_MODELVIEW) gl4es_glMatrixMode(old_matrixmode);
         }
-        j=0;
-        #define M(A) if(memcmp(cur->materials+j, cur->materials+j+4, 4*sizeof(GLfloat))==0) \
-            {gl4es_glMaterialfv(GL_FRONT_AND_BACK, A, cur->materials+j); j+=8;} \
-            else \
-            {gl4es_glMaterialfv(GL_BACK, A, cur->materials+j); j+=4; gl4es_glMaterialfv(GL_FRONT, A, cur->materials+j); j+=4;}
-        M(GL_AMBIENT); M(GL_DIFFUSE); M(GL_SPECULAR); M(GL_EMISSION); M(GL_SHININESS);  // handle both face at some point?
+        #define M(A, f, n) restore_material(A, (const GLfloat*)&cur->material.front.f, (const GLfloat*)&cur->material.back.f, \
+                            (const GLfloat*)&glstate->material.front.f, (const GLfloat*)&glstate->material.back.f, n)
+        M(GL_AMBIENT, ambient, 4); M(GL_DIFFUSE, diffuse, 4); M(GL_SPECULAR, specular, 4); M(GL_EMISSION, emission, 4); M(GL_SHININESS, shininess, 1);
         #undef M
 
-        gl4es_glShadeModel(cur->shade_model);
+        if (glstate->shademodel != cur->shade_model)
+            gl4es_glShadeModel(cur->shade_model);
     }
 
 	// GL_LIST_BIT
     if (cur->mask & GL_LIST_BIT) {
-        gl4es_glListBase(cur->list_base);
+        if (glstate->list.base != cur->list_base)
+            gl4es_glListBase(cur->list_base);
     }
 
     if (cur->mask & GL_LINE_BIT) {
-        enable_disable(GL_LINE_SMOOTH, cur->line_smooth);
-        // TODO: stipple stuff here
+        restore_enable(GL_LINE_SMOOTH, line_smooth);
+        restore_enable(GL_LINE_STIPPLE, line_stipple);
+        // TODO: stipple pattern here
         gl4es_glLineWidth(cur->line_width);
     }
 
     if (cur->mask & GL_MULTISAMPLE_BIT) {
-        enable_disable(GL_MULTISAMPLE, cur->multisample);
-        enable_disable(GL_SAMPLE_ALPHA_TO_COVERAGE, cur->sample_alpha_to_coverage);
-        enable_disable(GL_SAMPLE_ALPHA_TO_ONE, cur->sample_alpha_to_one);
-        enable_disable(GL_SAMPLE_COVERAGE, cur->sample_coverage);
+        restore_enable(GL_MULTISAMPLE, multisample);
+        restore_enable(GL_SAMPLE_ALPHA_TO_COVERAGE, sample_alpha_to_coverage);
+        restore_enable(GL_SAMPLE_ALPHA_TO_ONE, sample_alpha_to_one);
+        restore_enable(GL_SAMPLE_COVERAGE, sample_coverage);
     }
 
     if (cur->mask & GL_POINT_BIT) {
-        enable_disable(GL_POINT_SMOOTH, cur->point_smooth);
-        gl4es_glPointSize(cur->point_size);
+        restore_enable(GL_POINT_SMOOTH, point_smooth);
+        if (glstate->pointsprite.size != cur->point_size)
+            gl4es_glPointSize(cur->point_size);
         if(hardext.pointsprite) {
-            enable_disable(GL_POINT_SPRITE, cur->pointsprite);
+            restore_enable(GL_POINT_SPRITE, pointsprite);
             int old_tex = glstate->texture.active;
             int a;
             for (a=0; a<hardext.maxtex; a++) {
@@ -544,28 +463,34 @@ DBG(printf("glPopAttrib()\n");)
 
     if (cur->mask & GL_SCISSOR_BIT) {
         enable_disable(GL_SCISSOR_TEST, cur->scissor_test);
-        gl4es_glScissor(v4(cur->scissor_box));
+        if (memcmp(&glstate->raster.scissor, &cur->scissor_box, sizeof(viewport_t)))
+            gl4es_glScissor(cur->scissor_box.x, cur->scissor_box.y, cur->scissor_box.width, cur->scissor_box.height);
     }
 
     if (cur->mask & GL_STENCIL_BUFFER_BIT) {
-        enable_disable(GL_STENCIL_TEST, cur->stencil_test);
-        gl4es_glStencilFunc(cur->stencil_func, cur->stencil_ref, cur->stencil_mask);
-        //TODO: Stencil value mask
-        gl4es_glStencilOp(cur->stencil_sfail, cur->stencil_dpfail, cur->stencil_dppass);
-        gl4es_glClearStencil(cur->stencil_clearvalue);
-        //TODO: Stencil buffer writemask
+        restore_enable(GL_STENCIL_TEST, stencil_test);
+        if (glstate->stencil.func[0] != cur->stencil.func[0] || glstate->stencil.f_ref[0] != cur->stencil.f_ref[0]
+         || glstate->stencil.f_mask[0] != cur->stencil.f_mask[0])
+            gl4es_glStencilFunc(cur->stencil.func[0], cur->stencil.f_ref[0], cur->stencil.f_mask[0]);
+        if (glstate->stencil.sfail[0] != cur->stencil.sfail[0] || glstate->stencil.dpfail[0] != cur->stencil.dpfail[0]
+         || glstate->stencil.dppass[0] != cur->stencil.dppass[0])
+            gl4es_glStencilOp(cur->stencil.sfail[0], cur->stencil.dpfail[0], cur->stencil.dppass[0]);
+        if (glstate->stencil.clear != cur->stencil.clear)
+            gl4es_glClearStencil(cur->stencil.clear);
+        if (glstate->stencil.mask[0] != cur->stencil.mask[0])
+            gl4es_glStencilMask(cur->stencil.mask[0]);
     }
 
     if (cur->mask & GL_TEXTURE_BIT) {
         int old_tex = glstate->texture.active;
         int a;
         //TODO: Enable bit for the 4 texture coordinates
+        memcpy(glstate->texgen, cur->texgen, sizeof(cur->texgen));   // all mode and planes per texture
         for (a=0; a<hardext.maxtex; a++) {
-            glstate->enable.texgen_r[a] = cur->texgen_r[a];
-            glstate->enable.texgen_s[a] = cur->texgen_s[a];
-            glstate->enable.texgen_t[a] = cur->texgen_t[a];
-            glstate->enable.texgen_q[a] = cur->texgen_q[a];
-            glstate->texgen[a] = cur->texgen[a];   // all mode and planes per texture in 1 line
+            glstate->enable.texgen_r[a] = cur->enable.texgen_r[a];
+            glstate->enable.texgen_s[a] = cur->enable.texgen_s[a];
+            glstate->enable.texgen_t[a] = cur->enable.texgen_t[a];
+            glstate->enable.texgen_q[a] = cur->enable.texgen_q[a];
             for (int j=0; j<ENABLED_TEXTURE_LAST; j++)
                 if (cur->texture[a][j] != glstate->texture.bound[a][j]->texture) {
                     if(glstate->texture.active!=a)
@@ -577,41 +502,44 @@ DBG(printf("glPopAttrib()\n");)
     }
     
 	if (cur->mask & GL_PIXEL_MODE_BIT) {
-		GLenum pixel_name[] = {GL_RED_BIAS, GL_RED_SCALE, GL_GREEN_BIAS, GL_GREEN_SCALE, GL_BLUE_BIAS, GL_BLUE_SCALE, GL_ALPHA_BIAS, GL_ALPHA_SCALE};
+		GLenum scale_name[] = {GL_RED_SCALE, GL_GREEN_SCALE, GL_BLUE_SCALE, GL_ALPHA_SCALE};
+		GLenum bias_name[] = {GL_RED_BIAS, GL_GREEN_BIAS, GL_BLUE_BIAS, GL_ALPHA_BIAS};
 		int i;
-		for (i=0; i<8; i++) 
-			gl4es_glPixelTransferf(pixel_name[i], cur->pixel_scale_bias[i]);
+		for (i=0; i<4; i++) {
+			if (glstate->raster.raster_scale[i] != cur->pixel_scale[i])
+				gl4es_glPixelTransferf(scale_name[i], cur->pixel_scale[i]);
+			if (glstate->raster.raster_bias[i] != cur->pixel_bias[i])
+				gl4es_glPixelTransferf(bias_name[i], cur->pixel_bias[i]);
+		}
         //TODO: GL_DEPTH_BIAS & GL_DEPTH_SCALE (probably difficult)
         //TODO: GL_INDEX_OFFEST & GL_INDEX_SHIFT
         //TODO: GL_MAP_COLOR & GL_MAP_STENCIL (probably difficult too)
-		gl4es_glPixelZoom(cur->pixel_zoomx, cur->pixel_zoomy);
+		if (glstate->raster.raster_zoomx != cur->pixel_zoomx || glstate->raster.raster_zoomy != cur->pixel_zoomy)
+			gl4es_glPixelZoom(cur->pixel_zoomx, cur->pixel_zoomy);
 	}
 
 	if (cur->mask & GL_TRANSFORM_BIT) {
-		if (!(cur->mask & GL_ENABLE_BIT)) {
-			int i;
-			for (i = 0; i < hardext.maxplanes; i++) {
-				enable_disable(GL_CLIP_PLANE0 + i, *(cur->clip_planes_enabled + i));
-			}
+		// clip planes are also part of GL_ENABLE_BIT, restore_enable will skip them if already done
+		for (int i = 0; i < hardext.maxplanes; i++) {
+			restore_enable(GL_CLIP_PLANE0 + i, plane[i]);
 		}
-		gl4es_glMatrixMode(cur->matrix_mode);
-		enable_disable(GL_NORMALIZE, cur->normalize_flag);		
-		enable_disable(GL_RESCALE_NORMAL, cur->rescale_normal_flag);		
+		if (glstate->matrix_mode != cur->matrix_mode)
+			gl4es_glMatrixMode(cur->matrix_mode);
+		restore_enable(GL_NORMALIZE, normalize);
+		restore_enable(GL_RESCALE_NORMAL, normal_rescale);
 	}
 
     if (cur->mask & GL_VIEWPORT_BIT) {
-		gl4es_glViewport(cur->viewport_size[0], cur->viewport_size[1], cur->viewport_size[2], cur->viewport_size[3]);
-		gl4es_glDepthRangef(cur->depth_range[0], cur->depth_range[1]);
+		if (memcmp(&glstate->raster.viewport, &cur->viewport, sizeof(viewport_t)))
+			gl4es_glViewport(cur->viewport.x, cur->viewport.y, cur->viewport.width, cur->viewport.height);
+		if (glstate->depth.Near != cur->depth.Near || glstate->depth.Far != cur->depth.Far)
+			gl4es_glDepthRangef(cur->depth.Near, cur->depth.Far);
 	}
 	
-    maybe_free(cur->clip_planes_enabled);
-    maybe_free(cur->clip_planes);
-    maybe_free(cur->lights_enabled);
-    maybe_free(cur->lights);
-    maybe_free(cur->materials);
     glstate->stack->len--;
 }
 
+#undef restore_enable
 #undef enable_disable
 #define enable_disable(pname, enabled)             \
     if (enabled) gl4es_glEnableClientState(pname);       \
@@ -650,7 +578,6 @@ void APIENTRY_GL4ES gl4es_glPopClientAttrib(void) {
     glstate->clientStack->len--;
 }
 
-#undef maybe_free
 #undef enable_disable
 #undef v2
 #undef v3
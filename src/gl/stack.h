@@ -2,7 +2,10 @@
 #define _GL4ES_STACK_H_
 
 #include "gles.h"
+#include "fog.h"
+#include "light.h"
 #include "state.h"
+#include "stencil.h"
 #include "texture.h"
 #include <gl4eshint.h>
 
@@ -15,66 +18,41 @@
 typedef struct _glstack_t {
     GLbitfield mask;
 
+    // all the flags gl4es tracks, copied in one go. Each group only restores its own
+    enable_state_t enable;
+    // those are not tracked by gl4es, so they still need a glGet
+    GLboolean dither;
+    GLboolean scissor_test;
+
     // GL_COLOR_BUFFER_BIT
-    GLboolean alpha_test;
-    GLint alpha_test_func;
+    GLenum alpha_test_func;
     GLclampf alpha_test_ref;
 
-    GLboolean blend;
-    GLint blend_src_func;
-    GLint blend_dst_func;
-	
-    GLboolean dither;
+    GLenum blend_func[4];   // src rgb, dst rgb, src alpha, dst alpha
 
-    // point sprite
-    GLboolean pointsprite;
-    GLint     pscoordreplace[MAX_TEX];
-
-    GLboolean color_logic_op;
-    GLint logic_op;
+    GLenum logic_op;
 
     GLfloat clear_color[4];
-    GLfloat color_mask[4];
+    GLboolean color_mask[4];
 
     // GL_CURRENT_BIT
     GLfloat color[4];
-    GLfloat normal[4];
-    GLfloat tex[4];
-    GLfloat secondary[4];
+    GLfloat normal[3];
+    GLfloat tex[MAX_TEX][4];
 
     // TODO: can only fill this via raster.c
     GLfloat raster_pos[3];
     GLboolean raster_valid;
-	GLfloat pixel_scale_bias[4+4];
+	GLfloat pixel_scale[4];
+	GLfloat pixel_bias[4];
 	GLfloat pixel_zoomx;
 	GLfloat pixel_zoomy;
 	
-    // GL_DEPTH_BUFFER_BIT
-    GLboolean depth_test;
-    GLint depth_func;
-    GLfloat clear_depth;
-    GLint depth_mask;
-
-    // GL_ENABLE_BIT
-    GLboolean cull_face;
-    GLboolean normalize;
-    GLboolean polygon_offset_fill;
-    GLboolean stencil_test;
-    GLuint    tex_enabled[MAX_TEX];
-    GLboolean texgen_s[MAX_TEX];
-    GLboolean texgen_r[MAX_TEX];
-    GLboolean texgen_t[MAX_TEX];
-    GLboolean texgen_q[MAX_TEX];
-    GLboolean colormaterial;
-    GLboolean autonormal;
+    // GL_DEPTH_BUFFER_BIT (and depth range for GL_VIEWPORT_BIT)
+    depth_state_t depth;
 
     // GL_FOG_BIT
-    GLboolean fog;
-    GLfloat fog_color[4];
-    GLfloat fog_density;
-    GLfloat fog_start;
-    GLfloat fog_end;
-    GLint fog_mode;
+    fog_t fog;
 
     // GL_HINT_BIT
     GLint perspective_hint;
@@ -85,65 +63,39 @@ typedef struct _glstack_t {
     GLint gles4_hint[GL4ES_HINT_LAST-GL4ES_HINT_FIRST];
 
     // GL_LIGHTING_BIT
-    GLboolean lighting;
-    GLboolean *lights_enabled;
-    GLfloat *lights;
-    GLfloat light_model_ambient[4];
-    GLint light_model_two_side;
-    GLfloat *materials;
-    GLint shade_model;
+    light_state_t light;        // positions and directions are in eye space
+    material_state_t material;
+    GLenum shade_model;
 
     // GL_LINE_BIT
-    GLboolean line_smooth;
-    GLboolean line_stipple; // TODO: needs to be hooked locally?
     GLfloat line_width;
 
     // GL_LIST_BIT
-    GLint list_base;
-
-    // GL_MULTISAMPLE_BIT
-    GLboolean multisample;
-    GLboolean sample_alpha_to_coverage;
-    GLboolean sample_alpha_to_one;
-    GLboolean sample_coverage;
+    GLuint list_base;
 
     // GL_POINT_BIT
-    GLboolean point_smooth;
     GLfloat point_size;
+    GLboolean pscoordreplace[MAX_TEX];
 
     // TODO: GL_POLYGON_BIT
     // TODO: GL_POLYGON_STIPPLE_BIT
 
     // GL_SCISSOR_BIT
-    GLboolean scissor_test;
-    GLfloat scissor_box[4];
+    viewport_t scissor_box;
 
     // GL_STENCIL_BUFFER_BIT
-    GLenum stencil_func;
-    GLint  stencil_ref;
-    GLuint stencil_mask;
-    GLint  stencil_clearvalue;
-    GLenum stencil_sfail;
-    GLenum stencil_dpfail;
-    GLenum stencil_dppass;
+    stencil_t stencil;
 
     // GL_TEXTURE_BIT
-    GLint texture[MAX_TEX][ENABLED_TEXTURE_LAST];
+    GLuint texture[MAX_TEX][ENABLED_TEXTURE_LAST];
     texgen_state_t texgen[MAX_TEX];
     GLint active;
 
     // GL_TRANSFORM_BIT
 	// with Clip Planes...
 	GLenum matrix_mode;
-	GLboolean normalize_flag;
-	GLboolean rescale_normal_flag;
     // GL_VIEWPORT_BIT
-	GLint	viewport_size[4];
-	GLfloat depth_range[2];
-	
-    // dynamically-sized shenanigans
-    GLboolean *clip_planes_enabled;
-    GLfloat *clip_planes;
+	viewport_t viewport;
 
     // misc
     unsigned int len;
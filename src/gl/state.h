@@ -63,7 +63,8 @@ typedef struct {
               multisample,
               sample_coverage,
               sample_alpha_to_one,
-              sample_alpha_to_coverage;
+              sample_alpha_to_coverage,
+              scissor_test;
     GLuint    texture[MAX_TEX]; // flag
 } enable_state_t;
 
@@ -205,11 +206,14 @@ typedef struct {
     GLuint  overflow;
     GLuint  pos;
     GLboolean  hit;
+    GLfloat *arena;         // transformed vertices, reused across draws
+    int     arena_size;     // in vertices
 } selectbuf_t;
 
 typedef struct {
 	int		top;
     int     identity;
+    int     affine;     // last row of top is known to be (0,0,0,1)
 	GLfloat	*stack;
 } matrixstack_t;
 
@@ -301,6 +305,16 @@ typedef struct {
 
 KHASH_MAP_DECLARE_INT(framebufferlist_t, glframebuffer_t *);
 
+#define MAX_READBACK_TEX    4
+#define MAX_BLIT_TEX        4
+#define MAX_DAMAGE_AGE      4
+typedef struct {
+    GLuint  tex;
+    int     width;
+    int     height;
+    GLuint  age;
+} readbacktex_t;
+
 typedef struct {
     khash_t(renderbufferlist_t) *renderbufferlist;
     glrenderbuffer_t *default_rb;
@@ -314,6 +328,10 @@ typedef struct {
     int mainfbo_height;
     int mainfbo_nwidth;
     int mainfbo_nheight;
+    // LIBGL_FBODAMAGE: part of the main FBO drawn this frame ([0]) and the previous presented ones, as x0, y0, x1, y1
+    int mainfbo_damage[MAX_DAMAGE_AGE][4];
+    int mainfbo_ndamage;    // previous frames known in mainfbo_damage
+    int mainfbo_present[4]; // window position and size of the last present
     
     khash_t(framebufferlist_t) *framebufferlist;
     glframebuffer_t *fbo_0;
@@ -325,6 +343,15 @@ typedef struct {
     int    internal;
 
     oldfbos_t   *old;
+
+    // glGetTexImage readback
+    GLuint        readback_fbo;
+    readbacktex_t readback_tex[MAX_READBACK_TEX];   // RGBA temporary textures, for the blit path
+    GLuint        readback_age;
+
+    // glBlitFramebuffer intermediate textures, by power of 2 size
+    readbacktex_t blit_tex[MAX_BLIT_TEX];
+    GLuint        blit_age;
 } fbo_t;
 
 typedef struct {
@@ -357,6 +384,9 @@ typedef struct {
     int num;
     int active;
     GLuint start;
+    GLuint real;        // GLES query object, if the target is supported by the hardware
+    int pending;        // the GLES query result has not been fetched yet
+    GLuint64 result;
 } glquery_t;
 
 KHASH_MAP_DECLARE_INT(queries, glquery_t *)
@@ -1,5 +1,7 @@
 #include "texgen.h"
 
+#include <stddef.h>
+
 #include "../glx/hardext.h"
 #include "wrap/gl4es.h"
 #include "fpe.h"
@@ -172,99 +174,114 @@ void APIENTRY_GL4ES gl4es_glGetTexGenfv(GLenum coord,GLenum pname,GLfloat *param
 }
 
 
-void dot_loop(const GLfloat *verts, const GLfloat *params, GLfloat *out, GLint count, GLushort *indices) {
-    for (int i = 0; i < count; i++) {
-	GLushort k = indices?indices[i]:i;
-        out[k*4] = dot4(verts+k*4, params);// + params[3];
-    }
+// The texgen kernels keep the matrices and planes in locals and make no call in the loop, so without
+// indices the compiler can vectorize them (the ARM builds use -ftree-vectorize -ffast-math)
+#define TEXGEN_LOOP(BODY) \
+    if (indices) \
+        for (int i=0; i<count; i++) { const int k = indices[i]; BODY } \
+    else \
+        for (int k=0; k<count; k++) { BODY }
+
+static void dot_loop(const GLfloat *verts, const GLfloat *params, GLfloat *out, GLint count, GLushort *indices) {
+    const GLfloat p0=params[0], p1=params[1], p2=params[2], p3=params[3];
+    TEXGEN_LOOP(
+        const GLfloat *v = verts+k*4;
+        out[k*4] = v[0]*p0 + v[1]*p1 + v[2]*p2 + v[3]*p3;
+    )
 }
 
-void sphere_loop(const GLfloat *verts, const GLfloat *norm, GLfloat *out, GLint count, GLushort *indices) {
+// eye position (Modelview * vertex), m is column major
+#define EYE_POS \
+        const GLfloat *v = verts+k*4; \
+        const GLfloat ex = v[0]*m0 + v[1]*m4 + v[2]*m8 + v[3]*m12; \
+        const GLfloat ey = v[0]*m1 + v[1]*m5 + v[2]*m9 + v[3]*m13; \
+        const GLfloat ez = v[0]*m2 + v[1]*m6 + v[2]*m10 + v[3]*m14;
+#define EYE_POS4 \
+        EYE_POS \
+        const GLfloat ew = v[0]*m3 + v[1]*m7 + v[2]*m11 + v[3]*m15;
+// normalized eye normal (NormalMatrix * normal) and normalized eye position
+#define EYE_NORMAL \
+        EYE_POS \
+        const GLfloat *n = (norm)?(norm+k*3):cn; \
+        GLfloat nx = n[0]*n0 + n[1]*n3 + n[2]*n6; \
+        GLfloat ny = n[0]*n1 + n[1]*n4 + n[2]*n7; \
+        GLfloat nz = n[0]*n2 + n[1]*n5 + n[2]*n8; \
+        const GLfloat ln = 1.0f/sqrtf(nx*nx + ny*ny + nz*nz); \
+        nx *= ln; ny *= ln; nz *= ln; \
+        const GLfloat le = 1.0f/sqrtf(ex*ex + ey*ey + ez*ez); \
+        const GLfloat ux = ex*le, uy = ey*le, uz = ez*le; \
+        const GLfloat a = 2.0f*(ux*nx + uy*ny + uz*nz); \
+        const GLfloat rx = ux - nx*a, ry = uy - ny*a, rz = uz - nz*a;
+#define LOAD_MV \
+    const GLfloat *mv = getMVMat(); \
+    const GLfloat m0=mv[0], m1=mv[1], m2=mv[2], m3=mv[3], \
+        m4=mv[4], m5=mv[5], m6=mv[6], m7=mv[7], \
+        m8=mv[8], m9=mv[9], m10=mv[10], m11=mv[11], \
+        m12=mv[12], m13=mv[13], m14=mv[14], m15=mv[15];
+#define LOAD_NORMALMAT \
+    const GLfloat *nm = getNormalMat(); \
+    const GLfloat n0=nm[0], n1=nm[1], n2=nm[2], \
+        n3=nm[3], n4=nm[4], n5=nm[5], \
+        n6=nm[6], n7=nm[7], n8=nm[8]; \
+    const GLfloat *cn = glstate->normal;
+
+static void sphere_loop(const GLfloat *verts, const GLfloat *norm, GLfloat *out, GLint count, GLushort *indices) {
     // based on https://www.opengl.org/wiki/Mathematics_of_glTexGen
-/*    if (!norm) {
-        printf("LIBGL: GL_SPHERE_MAP without Normals\n");
-        return;
-    }*/
-    // First get the ModelviewMatrix
-    GLfloat InvModelview[16];
-    matrix_transpose(getInvMVMat(), InvModelview);
-    const GLfloat *ModelviewMatrix = getMVMat();
-    GLfloat eye[4], eye_norm[4], reflect[4];
-    GLfloat a;
-    for (int i=0; i<count; i++) {
-	GLushort k = indices?indices[i]:i;
-        vector_matrix(verts+k*4, ModelviewMatrix, eye);
-        vector4_normalize(eye);
-        vector3_matrix((norm)?(norm+k*3):glstate->normal, InvModelview, eye_norm);
-        vector_normalize(eye_norm);
-        a=dot(eye, eye_norm)*2.0f;
-        for (int j=0; j<3; j++)
-            reflect[j]=eye[j]-eye_norm[j]*a;
-        reflect[2]+=1.0f;
-        a = 0.5f / sqrtf(dot(reflect, reflect));
-        out[k*4+0] = reflect[0]*a + 0.5f;
-        out[k*4+1] = reflect[1]*a + 0.5f;
+    LOAD_MV
+    LOAD_NORMALMAT
+    (void)m3; (void)m7; (void)m11; (void)m15;
+    TEXGEN_LOOP(
+        EYE_NORMAL
+        const GLfloat rz1 = rz + 1.0f;
+        const GLfloat r = 0.5f / sqrtf(rx*rx + ry*ry + rz1*rz1);
+        out[k*4+0] = rx*r + 0.5f;
+        out[k*4+1] = ry*r + 0.5f;
         out[k*4+2] = 0.0f;
         out[k*4+3] = 1.0f;
-    }
-
+    )
 }
 
-void reflection_loop(const GLfloat *verts, const GLfloat *norm, GLfloat *out, GLint count, GLushort *indices) {
+static void reflection_loop(const GLfloat *verts, const GLfloat *norm, GLfloat *out, GLint count, GLushort *indices) {
     // based on https://www.opengl.org/wiki/Mathematics_of_glTexGen
-/*    if (!norm) {
-        printf("LIBGL: GL_REFLECTION_MAP without Normals\n");
-        return;
-    }*/
-    GLfloat InvModelview[16];
-    matrix_transpose(InvModelview, getInvMVMat());
-    const GLfloat * ModelviewMatrix = getMVMat();
-    GLfloat eye[4], eye_norm[4];
-    GLfloat a;
-    for (int i=0; i<count; i++) {
-	GLushort k = indices?indices[i]:i;
-        vector_matrix(verts+k*4, ModelviewMatrix, eye);
-        vector4_normalize(eye);
-        vector3_matrix((norm)?(norm+k*3):glstate->normal, InvModelview, eye_norm);
-        vector4_normalize(eye_norm);
-        a=dot4(eye, eye_norm)*2.0f;
-        out[k*4+0] = eye[0] - eye_norm[0]*a;
-        out[k*4+1] = eye[1] - eye_norm[1]*a;
-        out[k*4+2] = eye[2] - eye_norm[2]*a;
+    LOAD_MV
+    LOAD_NORMALMAT
+    (void)m3; (void)m7; (void)m11; (void)m15;
+    TEXGEN_LOOP(
+        EYE_NORMAL
+        out[k*4+0] = rx;
+        out[k*4+1] = ry;
+        out[k*4+2] = rz;
         out[k*4+3] = 1.0f;
-    }
-
+    )
 }
 
-void eye_loop(const GLfloat *verts, const GLfloat *param, GLfloat *out, GLint count, GLushort *indices) {
+static void eye_loop(const GLfloat *verts, const GLfloat *param, GLfloat *out, GLint count, GLushort *indices) {
     // based on https://www.opengl.org/wiki/Mathematics_of_glTexGen
-    // First get the ModelviewMatrix
-    const GLfloat *ModelviewMatrix = getMVMat();
-    GLfloat tmp[4];
-    for (int i=0; i<count; i++) {
-	GLushort k = indices?indices[i]:i;
-        matrix_vector(ModelviewMatrix, verts+k*4, tmp);
-        out[k*4]=dot4(param, tmp);
-    }
+    LOAD_MV
+    const GLfloat p0=param[0], p1=param[1], p2=param[2], p3=param[3];
+    TEXGEN_LOOP(
+        EYE_POS4
+        out[k*4] = ex*p0 + ey*p1 + ez*p2 + ew*p3;
+    )
 }
 
-void eye_loop_dual(const GLfloat *verts, const GLfloat *param1, const GLfloat* param2, GLfloat *out, GLint count, GLushort *indices) {
+static void eye_loop_dual(const GLfloat *verts, const GLfloat *param1, const GLfloat* param2, GLfloat *out, GLint count, GLushort *indices) {
     // based on https://www.opengl.org/wiki/Mathematics_of_glTexGen
-    // First get the ModelviewMatrix
-    GLfloat ModelviewMatrix[16], InvModelview[16];
-    glGetFloatv(GL_MODELVIEW_MATRIX, InvModelview);
-    // column major -> row major
-    matrix_transpose(InvModelview, ModelviewMatrix);
-    // And get the inverse
-    matrix_inverse(ModelviewMatrix, InvModelview);
-    GLfloat tmp[4];
-    for (int i=0; i<count; i++) {
-	GLushort k = indices?indices[i]:i;
-        matrix_vector(ModelviewMatrix, verts+k*4, tmp);
-        out[k*4+0]=dot4(param1, tmp);
-        out[k*4+1]=dot4(param2, tmp);
-    }
+    LOAD_MV
+    const GLfloat s0=param1[0], s1=param1[1], s2=param1[2], s3=param1[3];
+    const GLfloat t0=param2[0], t1=param2[1], t2=param2[2], t3=param2[3];
+    TEXGEN_LOOP(
+        EYE_POS4
+        out[k*4+0] = ex*s0 + ey*s1 + ez*s2 + ew*s3;
+        out[k*4+1] = ex*t0 + ey*t1 + ez*t2 + ew*t3;
+    )
 }
+#undef LOAD_NORMALMAT
+#undef LOAD_MV
+#undef EYE_NORMAL
+#undef EYE_POS4
+#undef EYE_POS
+#undef TEXGEN_LOOP
 
 static inline void tex_coord_loop(GLfloat *verts, GLfloat *norm, GLfloat *out, GLint count, GLenum type, GLfloat *param_o, GLfloat *param_e, GLushort *indices) {
     switch (type) {
@@ -405,6 +422,58 @@ void gen_tex_coords(GLfloat *verts, GLfloat *norm, GLfloat **coords, GLint count
         }
 }
 
+// the key is compared with memcmp, so it's cleared first (padding) and unused parts stay 0
+static void texgen_key(texgen_cache_t *key, int texture, GLint count) {
+    memset(key, 0, sizeof(texgen_cache_t));
+    int eye = 0;
+    if(glstate->enable.texgen_s[texture]) { key->enabled |= 1; if(glstate->texgen[texture].S!=GL_OBJECT_LINEAR) eye = 1; }
+    if(glstate->enable.texgen_t[texture]) { key->enabled |= 2; if(glstate->texgen[texture].T!=GL_OBJECT_LINEAR) eye = 1; }
+    if(glstate->enable.texgen_r[texture]) { key->enabled |= 4; if(glstate->texgen[texture].R!=GL_OBJECT_LINEAR) eye = 1; }
+    if(glstate->enable.texgen_q[texture]) { key->enabled |= 8; if(glstate->texgen[texture].Q!=GL_OBJECT_LINEAR) eye = 1; }
+    memcpy(&key->texgen, &glstate->texgen[texture], sizeof(texgen_state_t));
+    if(eye) {
+        memcpy(key->mv, getMVMat(), 16*sizeof(GLfloat));
+        memcpy(key->normal, glstate->normal, 3*sizeof(GLfloat));
+    }
+    memcpy(key->texcoord, glstate->texcoord[texture], 4*sizeof(GLfloat));
+    key->target = glstate->enable.texture[texture];
+    key->count = count;
+}
+
+int texgen_cache_get(texgen_cache_t *cache, int texture, GLfloat *coords, GLint count) {
+    if(!cache)
+        return 0;
+    texgen_cache_t key;
+    texgen_key(&key, texture, count);
+    if(memcmp(&key, cache, offsetof(texgen_cache_t, coords)))
+        return 0;
+    memcpy(coords, cache->coords, count*4*sizeof(GLfloat));
+    return 1;
+}
+
+texgen_cache_t* texgen_cache_put(texgen_cache_t *cache, int texture, const GLfloat *coords, GLint count) {
+    if(cache && cache->count!=count) {
+        texgen_cache_free(cache);
+        cache = NULL;
+    }
+    if(!cache) {
+        cache = (texgen_cache_t*)malloc(sizeof(texgen_cache_t));
+        cache->coords = (GLfloat*)malloc(count*4*sizeof(GLfloat));
+    }
+    GLfloat *keep = cache->coords;
+    texgen_key(cache, texture, count);
+    cache->coords = keep;
+    memcpy(cache->coords, coords, count*4*sizeof(GLfloat));
+    return cache;
+}
+
+void texgen_cache_free(texgen_cache_t *cache) {
+    if(!cache)
+        return;
+    free(cache->coords);
+    free(cache);
+}
+
 void gen_tex_clean(GLint cleancode, int texture) {
 	if (cleancode == 0)
 		return;
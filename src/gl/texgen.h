@@ -2,11 +2,29 @@
 #define _GL4ES_TEXGEN_H_
 
 #include "gles.h"
+#include "state.h"
+
+// generated coords of a compiled list (the vertices don't change), reused while the texgen state and
+// the modelview used for them stay the same. Texture matrix and npot adjust are applied after
+typedef struct _texgen_cache_t {
+    GLfloat         mv[16];     // only for the eye space modes
+    texgen_state_t  texgen;
+    GLfloat         normal[3];  // current normal, only for the eye space modes
+    GLfloat         texcoord[4];
+    GLuint          target;
+    GLuint          enabled;    // texgen_s/t/r/q
+    GLint           count;
+    GLfloat        *coords;
+} texgen_cache_t;
 
 void APIENTRY_GL4ES gl4es_glTexGenfv(GLenum coord, GLenum pname, const GLfloat *params);
 void APIENTRY_GL4ES gl4es_glTexGeni(GLenum coord, GLenum pname, GLint param);
 void gen_tex_coords(GLfloat *verts, GLfloat *norm, GLfloat **coords, GLint count, GLint *needclean, int texture, GLushort* indices, GLuint ilen);
 void gen_tex_clean(GLint cleancode, int texture);
+// copy the cached coords of texture unit if still valid (return 1), or 0 if they must be generated again
+int texgen_cache_get(texgen_cache_t *cache, int texture, GLfloat *coords, GLint count);
+texgen_cache_t* texgen_cache_put(texgen_cache_t *cache, int texture, const GLfloat *coords, GLint count);
+void texgen_cache_free(texgen_cache_t *cache);
 void APIENTRY_GL4ES gl4es_glGetTexGenfv(GLenum coord,GLenum pname,GLfloat *params);
 
 void APIENTRY_GL4ES gl4es_glLoadTransposeMatrixf(const GLfloat *m);
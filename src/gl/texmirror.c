@@ -0,0 +1,198 @@
+#include "texmirror.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Bands are a list of packets, each starting with a 16bits header: 2 bits of opcode and
+// the pixel count minus one. Most textures have flat areas or repeat the row above (UI, fonts,
+// lightmaps...) and shrink a lot. Bands that don't are kept raw, so it never costs more than
+// the plain copy, and decompression is just memcpy and fill.
+
+#define OP_LITERAL  0   // count pixels follow
+#define OP_RUN      1   // 1 pixel follows, repeated count times
+#define OP_ABOVE    2   // count pixels identical to the row above
+#define OP_MAX      0x4000
+#define OP_MIN      3   // shorter runs are cheaper as literal
+
+static int band_rows(const texmirror_t* mirror, int band) {
+    int rows = mirror->height - band*TEXMIRROR_BAND;
+    return (rows<TEXMIRROR_BAND)?rows:TEXMIRROR_BAND;
+}
+
+static unsigned char* put_header(unsigned char* out, int op, int count) {
+    unsigned int h = (op<<14) | (count-1);
+    out[0] = h&0xff;
+    out[1] = h>>8;
+    return out+2;
+}
+
+// return the compressed size, or 0 if it doesn't fit in limit bytes
+static unsigned int band_compress(const uint32_t* src, int width, int npix, unsigned char* out, unsigned int limit) {
+    unsigned char* p = out;
+    unsigned char* end = out+limit;
+    int i = 0, lit = 0;
+    while(i<npix) {
+        int r = 1, a = 0;
+        while(i+r<npix && r<OP_MAX && src[i+r]==src[i]) ++r;
+        if(i>=width)
+            while(i+a<npix && a<OP_MAX && src[i+a]==src[i+a-width]) ++a;
+        if(r<OP_MIN && a<OP_MIN) {
+            ++i;
+            continue;
+        }
+        while(lit<i) {
+            int n = i-lit;
+            if(n>OP_MAX) n = OP_MAX;
+            if(p+2+n*4>end) return 0;
+            p = put_header(p, OP_LITERAL, n);
+            memcpy(p, src+lit, n*4);
+            p += n*4;
+            lit += n;
+        }
+        if(a>=r) {
+            if(p+2>end) return 0;
+            p = put_header(p, OP_ABOVE, a);
+            i += a;
+        } else {
+            if(p+6>end) return 0;
+            p = put_header(p, OP_RUN, r);
+            memcpy(p, src+i, 4);
+            p += 4;
+            i += r;
+        }
+        lit = i;
+    }
+    while(lit<npix) {
+        int n = npix-lit;
+        if(n>OP_MAX) n = OP_MAX;
+        if(p+2+n*4>end) return 0;
+        p = put_header(p, OP_LITERAL, n);
+        memcpy(p, src+lit, n*4);
+        p += n*4;
+        lit += n;
+    }
+    return p-out;
+}
+
+static void band_decompress(const unsigned char* in, unsigned int size, uint32_t* dst, int width) {
+    const unsigned char* end = in+size;
+    uint32_t* p = dst;
+    while(in<end) {
+        unsigned int h = in[0] | (in[1]<<8);
+        int count = (h&(OP_MAX-1))+1;
+        in += 2;
+        switch(h>>14) {
+            case OP_LITERAL:
+                memcpy(p, in, count*4);
+                in += count*4;
+                break;
+            case OP_RUN: {
+                uint32_t v;
+                memcpy(&v, in, 4);
+                in += 4;
+                for (int i=0; i<count; ++i)
+                    p[i] = v;
+                break;
+            }
+            case OP_ABOVE:
+                for (int i=0; i<count; ++i)
+                    p[i] = p[i-width];
+                break;
+        }
+        p += count;
+    }
+}
+
+static void band_read(const texmirror_t* mirror, int band, void* pixels) {
+    texmirror_band_t* b = &mirror->bands[band];
+    unsigned int raw = mirror->width*band_rows(mirror, band)*4;
+    if(b->size==raw)
+        memcpy(pixels, b->data, raw);
+    else
+        band_decompress(b->data, b->size, (uint32_t*)pixels, mirror->width);
+}
+
+// tmp must be at least as big as the band
+static void band_write(texmirror_t* mirror, int band, const void* pixels, unsigned char* tmp) {
+    texmirror_band_t* b = &mirror->bands[band];
+    unsigned int raw = mirror->width*band_rows(mirror, band)*4;
+    unsigned int size = band_compress((const uint32_t*)pixels, mirror->width, raw/4, tmp, raw-1);
+    if(!size) {
+        size = raw;
+        tmp = (unsigned char*)pixels;
+    }
+    if(b->size!=size) {
+        free(b->data);
+        b->data = (unsigned char*)malloc(size);
+        b->size = size;
+    }
+    memcpy(b->data, tmp, size);
+}
+
+texmirror_t* texmirror_new(int width, int height, const void* pixels, int stride) {
+    texmirror_t* mirror = (texmirror_t*)calloc(1, sizeof(texmirror_t));
+    mirror->width = width;
+    mirror->height = height;
+    if(!width || !height)
+        return mirror;
+    mirror->nbands = (height+TEXMIRROR_BAND-1)/TEXMIRROR_BAND;
+    mirror->bands = (texmirror_band_t*)calloc(mirror->nbands, sizeof(texmirror_band_t));
+    unsigned int bandsize = width*TEXMIRROR_BAND*4;
+    unsigned char* tmp = (unsigned char*)malloc(bandsize*2);
+    unsigned char* band = tmp+bandsize;
+    if(!pixels)
+        memset(band, 0, bandsize);
+    for (int i=0; i<mirror->nbands; ++i) {
+        const char* src = (pixels)?(const char*)pixels+i*TEXMIRROR_BAND*stride:NULL;
+        if(pixels && stride==width*4)
+            band_write(mirror, i, src, tmp);
+        else {
+            if(pixels)
+                for (int j=0; j<band_rows(mirror, i); ++j)
+                    memcpy(band+j*width*4, src+j*stride, width*4);
+            band_write(mirror, i, band, tmp);
+        }
+    }
+    free(tmp);
+    return mirror;
+}
+
+void texmirror_free(texmirror_t* mirror) {
+    if(!mirror)
+        return;
+    for (int i=0; i<mirror->nbands; ++i)
+        free(mirror->bands[i].data);
+    free(mirror->bands);
+    free(mirror);
+}
+
+void texmirror_update(texmirror_t* mirror, int x, int y, int width, int height, const void* pixels, int stride) {
+    if(x<0) { pixels = (const char*)pixels - x*4; width += x; x = 0; }
+    if(y<0) { pixels = (const char*)pixels - y*stride; height += y; y = 0; }
+    if(x+width>mirror->width) width = mirror->width-x;
+    if(y+height>mirror->height) height = mirror->height-y;
+    if(width<=0 || height<=0)
+        return;
+    unsigned int bandsize = mirror->width*TEXMIRROR_BAND*4;
+    unsigned char* band = (unsigned char*)malloc(bandsize*2);
+    unsigned char* tmp = band+bandsize;
+    for (int i=y/TEXMIRROR_BAND; i<=(y+height-1)/TEXMIRROR_BAND; ++i) {
+        int first = i*TEXMIRROR_BAND;
+        int rows = band_rows(mirror, i);
+        int y0 = (y>first)?y:first;
+        int y1 = (y+height<first+rows)?(y+height):(first+rows);
+        // no need to unpack a band that is fully replaced
+        if(x || width!=mirror->width || y0!=first || y1!=first+rows)
+            band_read(mirror, i, band);
+        for (int yy=y0; yy<y1; ++yy)
+            memcpy(band+((yy-first)*mirror->width+x)*4, (const char*)pixels+(yy-y)*stride, width*4);
+        band_write(mirror, i, band, tmp);
+    }
+    free(band);
+}
+
+void texmirror_read(const texmirror_t* mirror, void* pixels) {
+    unsigned int bandsize = mirror->width*TEXMIRROR_BAND*4;
+    for (int i=0; i<mirror->nbands; ++i)
+        band_read(mirror, i, (char*)pixels+i*bandsize);
+}
@@ -0,0 +1,29 @@
+#ifndef _GL4ES_TEXMIRROR_H_
+#define _GL4ES_TEXMIRROR_H_
+
+#include <stdint.h>
+
+#define TEXMIRROR_BAND  16      // rows per band, each band is compressed on its own
+
+typedef struct {
+    unsigned char   *data;
+    unsigned int    size;       // compressed size, raw pixels if equal to the band size
+} texmirror_band_t;
+
+// CPU copy of an RGBA8 texture (LIBGL_TEXCOPY), kept compressed
+typedef struct {
+    int              width;
+    int              height;
+    int              nbands;
+    texmirror_band_t *bands;
+} texmirror_t;
+
+// create a mirror of a width x height RGBA8 image, pixels can be NULL for a black one. stride is in bytes
+texmirror_t* texmirror_new(int width, int height, const void* pixels, int stride);
+void texmirror_free(texmirror_t* mirror);
+// replace a sub-rectangle, only the bands touched are recompressed. stride is in bytes
+void texmirror_update(texmirror_t* mirror, int x, int y, int width, int height, const void* pixels, int stride);
+// decompress the whole image, tightly packed
+void texmirror_read(const texmirror_t* mirror, void* pixels);
+
+#endif // _GL4ES_TEXMIRROR_H_
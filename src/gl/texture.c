@@ -962,6 +962,7 @@ void APIENTRY_GL4ES gl4es_glTexImage2D(GLenum target, GLint level, GLint interna
 
     GLvoid *datab = (GLvoid*)data;
     
+    buffer_sync(glstate->vao->unpack);
     if (glstate->vao->unpack)
         datab = (char*)datab + (uintptr_t)glstate->vao->unpack->data;
         
@@ -1387,7 +1388,7 @@ void APIENTRY_GL4ES gl4es_glTexImage2D(GLenum target, GLint level, GLint interna
             bound->height = height;
             bound->nwidth = nwidth;
             bound->nheight = nheight;
-            if(target==GL_TEXTURE_RECTANGLE_ARB && hardext.esversion==2) {
+            if(target==GL_TEXTURE_RECTANGLE_ARB && hardext.esversion>1) {
                 bound->adjust = 0;  // because this test is used in a lot of places
                 bound->adjustxy[0] = 1.0f/width;
                 bound->adjustxy[1] = 1.0f/height;
@@ -1516,15 +1517,19 @@ void APIENTRY_GL4ES gl4es_glTexImage2D(GLenum target, GLint level, GLint interna
         }
     }
     if ((target==GL_TEXTURE_2D) && globals4es.texcopydata && ((globals4es.texstream && !bound->streamed) || !globals4es.texstream)) {
-        if (bound->data) 
-            bound->data=realloc(bound->data, width*height*4);
-        else 
-            bound->data = malloc(width*height*4);
-        if (datab) {
-            if (!pixel_convert(pixels, &bound->data, width, height, format, type, GL_RGBA, GL_UNSIGNED_BYTE, 0, glstate->texture.unpack_align))
-                printf("LIBGL: Error on pixel_convert when TEXCOPY in glTexImage2D\n");
-        } else {
-        //memset(bound->data, 0, width*height*4);
+        texmirror_free(bound->mirror);
+        bound->mirror = NULL;
+        // with LIBGL_TEXCOPY=2, the mirror is only built by glGetTexImage
+        if (globals4es.texcopydata==1) {
+            GLuint stride = widthalign(width*4, glstate->texture.unpack_align);
+            GLvoid *tmp = NULL;
+            if (datab) {
+                tmp = malloc(stride*height);
+                if (!pixel_convert(pixels, &tmp, width, height, format, type, GL_RGBA, GL_UNSIGNED_BYTE, 0, glstate->texture.unpack_align))
+                    printf("LIBGL: Error on pixel_convert when TEXCOPY in glTexImage2D\n");
+            }
+            bound->mirror = texmirror_new(width, height, tmp, stride);
+            free(tmp);
         }
     }
     if (pixels != datab) {
@@ -1555,6 +1560,7 @@ void APIENTRY_GL4ES gl4es_glTexSubImage2D(GLenum target, GLint level, GLint xoff
 
     
     GLvoid *datab = (GLvoid*)data;
+    buffer_sync(glstate->vao->unpack);
     if (glstate->vao->unpack)
         datab = (char*)datab + (uintptr_t)glstate->vao->unpack->data;
     GLvoid *pixels = (GLvoid*)datab;
@@ -1763,11 +1769,15 @@ void APIENTRY_GL4ES gl4es_glTexSubImage2D(GLenum target, GLint level, GLint xoff
     /*if (bound->mipmap_need && !bound->mipmap_auto && (globals4es.automipmap!=3) && (!globals4es.texstream || (globals4es.texstream && !bound->streamed)))
         gles_glTexParameteri( rtarget, GL_GENERATE_MIPMAP, GL_FALSE );*/
 
-    if ((target==GL_TEXTURE_2D) && globals4es.texcopydata && ((globals4es.texstream && !bound->streamed) || !globals4es.texstream)) {
+    if ((target==GL_TEXTURE_2D) && bound->mirror && ((globals4es.texstream && !bound->streamed) || !globals4es.texstream)) {
     //printf("*texcopy* glTexSubImage2D, xy=%i,%i, size=%i,%i=>%i,%i, format=%s, type=%s, tex=%u\n", xoffset, yoffset, width, height, bound->width, bound->height, PrintEnum(format), PrintEnum(type), bound->glname);
-        GLvoid * tmp = (char*)bound->data + (yoffset*bound->width + xoffset)*4;
-        if (!pixel_convert(pixels, &tmp, width, height, format, type, GL_RGBA, GL_UNSIGNED_BYTE, bound->width, glstate->texture.unpack_align))
+        GLuint stride = widthalign(width*4, glstate->texture.unpack_align);
+        GLvoid * tmp = malloc(stride*height);
+        if (!pixel_convert(pixels, &tmp, width, height, format, type, GL_RGBA, GL_UNSIGNED_BYTE, 0, glstate->texture.unpack_align))
             printf("LIBGL: Error on pixel_convert while TEXCOPY in glTexSubImage2D\n");
+        else
+            texmirror_update(bound->mirror, xoffset, yoffset, width, height, tmp, stride);
+        free(tmp);
     }
 
     if (pixels != datab)
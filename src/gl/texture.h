@@ -4,6 +4,7 @@
 #include "buffers.h"
 #include "const.h"
 #include "gles.h"
+#include "texmirror.h"
 
 void APIENTRY_GL4ES gl4es_glTexImage2D(GLenum target, GLint level, GLint internalFormat,
                   GLsizei width, GLsizei height, GLint border,
@@ -152,7 +153,7 @@ typedef struct {
     GLuint renderdepth; // in case renderbuffer where used instead...
     GLuint renderstencil;
     int     trace;  // internal use for debug
-    GLvoid *data;	// in case we want to keep a copy of it (it that case, always RGBA/GL_UNSIGNED_BYTE
+    texmirror_t *mirror;    // CPU copy for LIBGL_TEXCOPY (always RGBA/GL_UNSIGNED_BYTE, compressed)
     glsampler_t sampler;    // internal sampler if not superseded by glBindSampler
     glsampler_t actual;     // actual sampler
     float fbtex_ratio; // Lower rendering resolution
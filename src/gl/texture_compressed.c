@@ -199,6 +199,7 @@ void APIENTRY_GL4ES gl4es_glCompressedTexImage2D(GLenum target, GLint level, GLe
     glbuffer_t *unpack = glstate->vao->unpack;
     glstate->vao->unpack = NULL;
     GLvoid *datab = (GLvoid*)data;
+    buffer_sync(unpack);
     if (unpack)
         datab = (char*) + (uintptr_t)unpack->data;
     
@@ -358,6 +359,7 @@ void APIENTRY_GL4ES gl4es_glCompressedTexSubImage2D(GLenum target, GLint level,
     glbuffer_t *unpack = glstate->vao->unpack;
     glstate->vao->unpack = NULL;
     GLvoid *datab = (GLvoid*)data;
+    buffer_sync(unpack);
     if (unpack)
         datab = (char*)datab + (uintptr_t)unpack->data;
     LOAD_GLES(glCompressedTexSubImage2D);
@@ -434,6 +436,7 @@ void APIENTRY_GL4ES gl4es_glGetCompressedTexImage(GLenum target, GLint lod, GLvo
     glstate->vao->unpack = NULL;
     glstate->vao->pack = NULL;
     GLvoid *datab = (GLvoid*)img;
+    buffer_sync(pack);
     if (pack)
         datab = (char*)datab + (uintptr_t)pack->data;
 
@@ -115,6 +115,7 @@ void tex_setup_texcoord(GLuint len, int changes, GLuint itarget, vertexattrib_t*
             glstate->helper_tex[texunit] = malloc(4*sizeof(GLfloat)*len);
             glstate->helper_texlen[texunit] = len;
         }
+        buffer_mirror(ptr->buffer);
         copy_gl_pointer_tex_noalloc(glstate->helper_tex[texunit], ptr, 4, 0, len);
         // Normalize if needed
         if (itarget == ENABLED_TEXTURE_RECTANGLE)
@@ -412,14 +413,14 @@ void APIENTRY_GL4ES gl4es_glDeleteTextures(GLsizei n, const GLuint *textures) {
 #endif
                 #if 1
                 kh_del(tex, list, k);
-                if (tex->data) free(tex->data);
+                texmirror_free(tex->mirror);
                 free(tex);
                 #else
                 tex->glname = tex->texture;
                 tex->streamed = false;
                 tex->streamingID = -1;
-                if (tex->data) free(tex->data);
-                tex->data = NULL;
+                texmirror_free(tex->mirror);
+                tex->mirror = NULL;
                 #endif
             }
         }
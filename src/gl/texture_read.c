@@ -85,6 +85,11 @@ void APIENTRY_GL4ES gl4es_glCopyTexImage2D(GLenum target,  GLint level,  GLenum
         }
         LOAD_GLES(glCopyTexImage2D);
         gles_glCopyTexImage2D(target, level, fmt, x, y, width, height, border);
+        if(level==0 && bound->mirror) {
+            // copied by the GPU, the CPU copy is not valid anymore
+            texmirror_free(bound->mirror);
+            bound->mirror = NULL;
+        }
     } else {
         void* tmp = malloc(width*height*4);
         gl4es_glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, tmp);
@@ -151,6 +156,11 @@ void APIENTRY_GL4ES gl4es_glCopyTexSubImage2D(GLenum target, GLint level, GLint
             || (bound->format==glstate->fbo.current_fb->read_format && bound->type==glstate->fbo.current_fb->read_type));
         if (copytex || !glstate->colormask[0] || !glstate->colormask[1] || !glstate->colormask[2] || !glstate->colormask[3]) {
             gles_glCopyTexSubImage2D(target, level, xoffset, yoffset, x, y, width, height);
+            if(level==0 && bound->mirror) {
+                // copied by the GPU, the CPU copy is not valid anymore
+                texmirror_free(bound->mirror);
+                bound->mirror = NULL;
+            }
             if(((((bound->max_level == level) && (level || bound->mipmap_need)) && (globals4es.automipmap!=3) && (bound->mipmap_need!=0))) && !(bound->max_level==bound->base_level && bound->base_level==0)) {
                 LOAD_GLES2_OR_OES(glGenerateMipmap);
                 if(gles_glGenerateMipmap)
@@ -182,36 +192,123 @@ void APIENTRY_GL4ES gl4es_glReadPixels(GLint x, GLint y, GLsizei width, GLsizei
     LOAD_GLES(glReadPixels);
     errorGL();
     GLvoid* dst = data;
-    if (glstate->vao->pack)
+    if (glstate->vao->pack) {
+        // the read must fit in the pack buffer
+        if(width>0 && height>0) {
+            const GLsizeiptr pix = pixel_sizeof(format, type);
+            const GLsizeiptr needed = widthalign(width*pix, glstate->texture.pack_align)*(height-1) + width*pix;
+            if((uintptr_t)data + needed > (uintptr_t)glstate->vao->pack->size) {
+                errorShim(GL_INVALID_OPERATION);
+                return;
+            }
+        }
+        buffer_sync(glstate->vao->pack);
         dst = (char*)dst + (uintptr_t)glstate->vao->pack->data;
+    }
         
     readfboBegin();
-    if ((format == GL_RGBA && type == GL_UNSIGNED_BYTE)     // should not use default GL_RGBA on Pandora as it's very slow...
+    const int passthru = (format == GL_RGBA && type == GL_UNSIGNED_BYTE)     // should not use default GL_RGBA on Pandora as it's very slow...
        || (format == glstate->readf && type == glstate->readt)    // use the IMPLEMENTATION_READ too...
-       || (format == GL_DEPTH_COMPONENT && (type == GL_FLOAT || type==GL_HALF_FLOAT)))   // this one will probably fail, as DEPTH is not readable on most GLES hardware 
+       || (format == GL_DEPTH_COMPONENT && (type == GL_FLOAT || type==GL_HALF_FLOAT));   // this one will probably fail, as DEPTH is not readable on most GLES hardware 
+    // grab data in GL_RGBA format if not passthru
+    int use_bgra = 0;
+    if(glstate->readf==GL_BGRA && glstate->readt==GL_UNSIGNED_BYTE)
+        use_bgra = 1;   // if IMPLEMENTATION_READ is BGRA, then use it as it's probably faster then RGBA.
+    const GLenum readf = passthru?format:(use_bgra?GL_BGRA:GL_RGBA);
+    const GLenum readt = passthru?type:GL_UNSIGNED_BYTE;
+    // with a pack buffer on GLES3, the read is async and the conversion done when the buffer is used
+    if (glstate->vao->pack && buffer_readpixels(glstate->vao->pack, x, y, width, height, readf, readt, format, type, (uintptr_t)data)) {
+        readfboEnd();
+        return;
+    }
+    if (passthru)
     {
         // easy passthru
         gles_glReadPixels(x, y, width, height, format, type, dst);
         readfboEnd();
         return;
     }
-    // grab data in GL_RGBA format
-    int use_bgra = 0;
-    if(glstate->readf==GL_BGRA && glstate->readt==GL_UNSIGNED_BYTE)
-        use_bgra = 1;   // if IMPLEMENTATION_READ is BGRA, then use it as it's probably faster then RGBA.
-    GLvoid *pixels = malloc(width*height*4);
-    gles_glReadPixels(x, y, width, height, use_bgra?GL_BGRA:GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    gl4es_scratch(widthalign(width*4, glstate->texture.pack_align)*height);
+    GLvoid *pixels = glstate->scratch;
+    gles_glReadPixels(x, y, width, height, readf, readt, pixels);
     if (! pixel_convert(pixels, &dst, width, height,
-                        use_bgra?GL_BGRA:GL_RGBA, GL_UNSIGNED_BYTE, format, type, 0,glstate->texture.pack_align)) {
+                        readf, readt, format, type, 0,glstate->texture.pack_align)) {
         LOGE("ReadPixels error: (%s, UNSIGNED_BYTE -> %s, %s )\n",
-            PrintEnum(use_bgra?GL_BGRA:GL_RGBA), PrintEnum(format), PrintEnum(type));
+            PrintEnum(readf), PrintEnum(format), PrintEnum(type));
     }
-    free(pixels);
     readfboEnd();
     return;
 }
 
 
+// glGetTexImage uses one FBO per context, and a few temporary textures kept by size
+static void readback_attach(GLuint texture, GLint level) {
+    if(!glstate->fbo.readback_fbo)
+        gl4es_glGenFramebuffers(1, &glstate->fbo.readback_fbo);
+    gl4es_glBindFramebuffer(GL_FRAMEBUFFER_OES, glstate->fbo.readback_fbo);
+    gl4es_glFramebufferTexture2D(GL_FRAMEBUFFER_OES, GL_COLOR_ATTACHMENT0_OES, GL_TEXTURE_2D, texture, level);
+}
+
+static void readback_detach(GLuint old_fbo) {
+    // don't keep a reference on the texture
+    gl4es_glFramebufferTexture2D(GL_FRAMEBUFFER_OES, GL_COLOR_ATTACHMENT0_OES, GL_TEXTURE_2D, 0, 0);
+    gl4es_glBindFramebuffer(GL_FRAMEBUFFER_OES, old_fbo);
+}
+
+static GLuint readback_texture(int width, int height) {
+    // texture of that size if any, or recycle the least recently used one
+    readbacktex_t *cache = glstate->fbo.readback_tex;
+    int idx = -1, lru = 0;
+    for (int i=0; i<MAX_READBACK_TEX && idx<0; ++i) {
+        if(cache[i].tex && cache[i].width==width && cache[i].height==height)
+            idx = i;
+        else if(cache[i].age < cache[lru].age)
+            lru = i;
+    }
+    if(idx<0) {
+        idx = lru;
+        if(!cache[idx].tex)
+            gl4es_glGenTextures(1, &cache[idx].tex);
+        gl4es_glBindTexture(GL_TEXTURE_2D, cache[idx].tex);
+        gl4es_glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+        cache[idx].width = width;
+        cache[idx].height = height;
+    }
+    cache[idx].age = ++glstate->fbo.readback_age;
+    return cache[idx].tex;
+}
+
+// read level 0 of the texture with the GPU, in an FBO
+static void readback_image(gltexture_t* bound, GLenum format, GLenum type, GLvoid * img) {
+    int width = bound->width;
+    int height = bound->height;
+    int nwidth = bound->nwidth;
+    int nheight = bound->nheight;
+    int shrink = bound->shrink;
+    // if the texture is not RGBA or RGB or ALPHA, the "just attach texture to the fbo" trick will not work, and a full Blit has to be done
+    const int attachable = (bound->format==GL_RGBA || bound->format==GL_RGB || (bound->format==GL_BGRA && hardext.bgra8888) || bound->format==GL_ALPHA) && (shrink==0);
+    GLuint old_fbo = glstate->fbo.current_fb->id;
+    if(attachable) {
+        readback_attach(bound->texture, 0);
+        // Read the pixels!
+        gl4es_glReadPixels(0, nheight-height, width, height, format, type, img);	// using "full" version with conversion of format/type
+        readback_detach(old_fbo);
+        noerrorShim();
+    } else {
+        GLuint temptex = readback_texture(nwidth<<shrink, nheight<<shrink);
+        gl4es_glBindTexture(GL_TEXTURE_2D, bound->texture);
+        readback_attach(temptex, 0);
+        // blit the texture
+        gl4es_glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        gl4es_glClear(GL_COLOR_BUFFER_BIT);
+        gl4es_blitTexture(bound->glname, 0.f, 0.f, width, height, nwidth, nheight, 1.0f, 1.0f, nwidth<<shrink, nheight<<shrink, 0, 0, BLIT_OPAQUE);
+        // Read the pixels!
+        gl4es_glReadPixels(0, (nheight-height)<<shrink, width<<shrink, height<<shrink, format, type, img);	// using "full" version with conversion of format/type
+        readback_detach(old_fbo);
+        noerrorShim();
+    }
+}
+
 void APIENTRY_GL4ES gl4es_glGetTexImage(GLenum target, GLint level, GLenum format, GLenum type, GLvoid * img) {
     DBG(printf("glGetTexImage(%s, %i, %s, %s, %p)\n", PrintEnum(target), level, PrintEnum(format), PrintEnum(type), img);)
     FLUSH_BEGINEND;
@@ -225,8 +322,22 @@ void APIENTRY_GL4ES gl4es_glGetTexImage(GLenum target, GLint level, GLenum forma
     int nwidth = bound->nwidth;
     int nheight = bound->nheight;
     int shrink = bound->shrink;
+    // if the texture is not RGBA or RGB or ALPHA, the "just attach texture to the fbo" trick will not work, and a full Blit has to be done
+    const int attachable = (bound->format==GL_RGBA || bound->format==GL_RGB || (bound->format==GL_BGRA && hardext.bgra8888) || bound->format==GL_ALPHA) && (shrink==0);
     if (level != 0) {
-        //printf("STUBBED glGetTexImage with level=%i\n", level);
+        // mipmap levels can be attached to an FBO on GLES3 (or with GL_OES_fbo_render_mipmap), so read it directly then
+        if (target==GL_TEXTURE_2D && attachable && hardext.fbomipmap && !bound->mirror) {
+            GLuint old_fbo = glstate->fbo.current_fb->id;
+            readback_attach(bound->texture, level);
+            if(gl4es_glCheckFramebufferStatus(GL_FRAMEBUFFER_OES)==GL_FRAMEBUFFER_COMPLETE_OES) {
+                gl4es_glReadPixels(0, nlevel(nheight, level)-nlevel(height, level), nlevel(width, level), nlevel(height, level), format, type, img);
+                readback_detach(old_fbo);
+                noerrorShim();
+                return;
+            }
+            readback_detach(old_fbo);
+        }
+        // CPU fallback: downscale level 0
         void* tmp = malloc(width*height*pixel_sizeof(format, type)); // tmp space...
         void* tmp2;
         gl4es_glGetTexImage(map_tex_target(target), 0, format, type, tmp);
@@ -249,8 +360,10 @@ void APIENTRY_GL4ES gl4es_glGetTexImage(GLenum target, GLint level, GLenum forma
     DBG(printf("glGetTexImage(%s, %i, %s, %s, 0x%p), texture=0x%x, size=%i,%i\n", PrintEnum(target), level, PrintEnum(format), PrintEnum(type), img, bound->glname, width, height);)
     
     GLvoid *dst = img;
-    if (glstate->vao->pack)
+    if (glstate->vao->pack) {
+        buffer_sync(glstate->vao->pack);
         dst = (char*)dst + (uintptr_t)glstate->vao->pack->data;
+    }
 #ifdef TEXSTREAM
     if (globals4es.texstream && bound->streamed) {
         noerrorShim();
@@ -259,48 +372,34 @@ void APIENTRY_GL4ES gl4es_glGetTexImage(GLenum target, GLint level, GLenum forma
         return;
     }
 #endif
-    if (globals4es.texcopydata && bound->data) {
+    if (bound->mirror && bound->binded_fbo) {
+        // the GPU may have rendered in it since the mirror was made
+        texmirror_free(bound->mirror);
+        bound->mirror = NULL;
+    }
+    if (globals4es.texcopydata==2 && !bound->mirror && !shrink && !bound->binded_fbo) {
+        // lazy mirror: read the texture back once, then serve it from the CPU copy
+        glbuffer_t *pack = glstate->vao->pack;
+        GLint pack_align = glstate->texture.pack_align;
+        glstate->vao->pack = NULL;
+        glstate->texture.pack_align = 1;
+        void* tmp = malloc(width*height*4);
+        readback_image(bound, GL_RGBA, GL_UNSIGNED_BYTE, tmp);
+        bound->mirror = texmirror_new(width, height, tmp, width*4);
+        free(tmp);
+        glstate->vao->pack = pack;
+        glstate->texture.pack_align = pack_align;
+    }
+    if (globals4es.texcopydata && bound->mirror) {
         //printf("texcopydata* glGetTexImage(0x%04X, %d, 0x%04x, 0x%04X, %p)\n", target, level, format, type, img);
         noerrorShim();
-        if (!pixel_convert(bound->data, &dst, width, height, GL_RGBA, GL_UNSIGNED_BYTE, format, type, 0, glstate->texture.pack_align))
+        void* tmp = malloc(width*height*4);
+        texmirror_read(bound->mirror, tmp);
+        if (!pixel_convert(tmp, &dst, width, height, GL_RGBA, GL_UNSIGNED_BYTE, format, type, 0, glstate->texture.pack_align))
             printf("LIBGL: Error on pixel_convert while glGetTexImage\n");
-    } else {
-        // Setup an FBO the same size of the texture
-        GLuint oldBind = bound->glname;
-        GLuint old_fbo = glstate->fbo.current_fb->id;
-        GLuint fbo;
-    
-        // if the texture is not RGBA or RGB or ALPHA, the "just attach texture to the fbo" trick will not work, and a full Blit has to be done
-        if((bound->format==GL_RGBA || bound->format==GL_RGB || (bound->format==GL_BGRA && hardext.bgra8888) || bound->format==GL_ALPHA) && (shrink==0)) {
-            gl4es_glGenFramebuffers(1, &fbo);
-            gl4es_glBindFramebuffer(GL_FRAMEBUFFER_OES, fbo);
-            gl4es_glFramebufferTexture2D(GL_FRAMEBUFFER_OES, GL_COLOR_ATTACHMENT0_OES, GL_TEXTURE_2D, oldBind, 0);
-            // Read the pixels!
-            gl4es_glReadPixels(0, nheight-height, width, height, format, type, img);	// using "full" version with conversion of format/type
-            gl4es_glBindFramebuffer(GL_FRAMEBUFFER_OES, old_fbo);
-            gl4es_glDeleteFramebuffers(1, &fbo);
-            noerrorShim();
-        } else {
-            gl4es_glGenFramebuffers(1, &fbo);
-            gl4es_glBindFramebuffer(GL_FRAMEBUFFER_OES, fbo);
-            GLuint temptex;
-            gl4es_glGenTextures(1, &temptex);
-            gl4es_glBindTexture(GL_TEXTURE_2D, temptex);
-            gl4es_glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, nwidth<<shrink, nheight<<shrink, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0);
-            gl4es_glFramebufferTexture2D(GL_FRAMEBUFFER_OES, GL_COLOR_ATTACHMENT0_OES, GL_TEXTURE_2D, temptex, 0);
-            gl4es_glBindTexture(GL_TEXTURE_2D, oldBind);
-            // blit the texture
-            gl4es_glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-            gl4es_glClear(GL_COLOR_BUFFER_BIT);
-            gl4es_blitTexture(oldBind, 0.f, 0.f, width, height, nwidth, nheight, 1.0f, 1.0f, nwidth<<shrink, nheight<<shrink, 0, 0, BLIT_OPAQUE);
-            // Read the pixels!
-            gl4es_glReadPixels(0, (nheight-height)<<shrink, width<<shrink, height<<shrink, format, type, img);	// using "full" version with conversion of format/type
-            gl4es_glBindFramebuffer(GL_FRAMEBUFFER_OES, old_fbo);
-            gl4es_glDeleteFramebuffers(1, &fbo);
-            gl4es_glDeleteTextures(1, &temptex);
-            noerrorShim();
-        }
-    }
+        free(tmp);
+    } else
+        readback_image(bound, format, type, img);
 }
 
 void APIENTRY_GL4ES gl4es_glCopyTexImage1D(GLenum target, GLint level, GLenum internalformat, GLint x, GLint y,
@@ -0,0 +1,125 @@
+#include "trace.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "loader.h"
+#include "logs.h"
+#include "queries.h"
+
+// get_clock() ticks per microsecond
+#ifdef _WIN32
+#define TRACE_TICKS 10.0
+#elif defined(USE_CLOCK)
+#define TRACE_TICKS 1000.0
+#else
+#define TRACE_TICKS 1.0
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define trace_newslot() (_InterlockedIncrement(&nrings)-1)
+#else
+#define trace_newslot() __sync_fetch_and_add(&nrings, 1)
+#endif
+
+#define TRACE_FRAME ((unsigned long long)-1)   // duration of frame markers
+
+typedef struct {
+    const char*         name;
+    unsigned long long  start;
+    unsigned long long  dur;
+} trace_event_t;
+
+typedef struct {
+    trace_event_t   events[TRACE_RING];
+    unsigned int    head;
+    unsigned int    count;
+} trace_ring_t;
+
+static char trace_file[4096];
+static unsigned long long trace_start;
+static trace_ring_t* rings[TRACE_THREADS];
+static volatile long nrings = 0;
+static THREAD_LOCAL trace_ring_t* ring = NULL;
+static THREAD_LOCAL int ring_full = 0;
+
+void trace_init(const char* filename) {
+    strncpy(trace_file, filename, sizeof(trace_file)-1);
+    trace_start = get_clock();
+    globals4es.trace = 1;
+}
+
+unsigned long long trace_clock() {
+    return get_clock();
+}
+
+static trace_ring_t* trace_ring() {
+    if(ring_full)
+        return NULL;
+    long slot = trace_newslot();
+    if(slot>=TRACE_THREADS) {
+        ring_full = 1;
+        return NULL;
+    }
+    ring = (trace_ring_t*)calloc(1, sizeof(trace_ring_t));
+    rings[slot] = ring;
+    return ring;
+}
+
+static void trace_push(const char* name, unsigned long long start, unsigned long long dur) {
+    trace_ring_t* r = (ring)?ring:trace_ring();
+    if(!r)
+        return;
+    trace_event_t* e = &r->events[r->head];
+    e->name = name;
+    e->start = start;
+    e->dur = dur;
+    r->head = (r->head+1)&(TRACE_RING-1);
+    if(r->count<TRACE_RING)
+        ++r->count;
+}
+
+void trace_span(const char* name, unsigned long long start) {
+    trace_push(name, start, get_clock()-start);
+}
+
+void trace_frame() {
+    if(globals4es.trace)
+        trace_push("frame", get_clock(), TRACE_FRAME);
+}
+
+void trace_dump() {
+    if(!globals4es.trace)
+        return;
+    globals4es.trace = 0;
+    FILE* f = fopen(trace_file, "w");
+    if(!f) {
+        SHUT_LOGE("Cannot write trace to %s\n", trace_file);
+        return;
+    }
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    int first = 1;
+    unsigned int frame = 0;
+    long n = (nrings<TRACE_THREADS)?nrings:TRACE_THREADS;
+    for (long t=0; t<n; ++t) {
+        trace_ring_t* r = rings[t];
+        if(!r)
+            continue;
+        fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%ld,\"args\":{\"name\":\"gl4es thread %ld\"}}", first?"":",\n", t+1, t+1);
+        first = 0;
+        unsigned int idx = (r->count<TRACE_RING)?0:r->head;
+        for (unsigned int i=0; i<r->count; ++i, idx=(idx+1)&(TRACE_RING-1)) {
+            trace_event_t* e = &r->events[idx];
+            double ts = (double)(long long)(e->start-trace_start)/TRACE_TICKS;
+            if(e->dur==TRACE_FRAME)
+                fprintf(f, ",\n{\"name\":\"frame\",\"cat\":\"gl4es\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":1,\"tid\":%ld,\"args\":{\"frame\":%u}}", ts, t+1, ++frame);
+            else
+                fprintf(f, ",\n{\"name\":\"%s\",\"cat\":\"gl4es\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%ld}", e->name, ts, (double)e->dur/TRACE_TICKS, t+1);
+        }
+    }
+    fprintf(f, "\n]}\n");
+    fclose(f);
+    SHUT_LOGD("Trace written to %s\n", trace_file);
+}
@@ -0,0 +1,22 @@
+#ifndef _GL4ES_TRACE_H_
+#define _GL4ES_TRACE_H_
+
+#include "init.h"
+
+// Timeline of gl4es internals, enabled with LIBGL_TRACE=file. Spans are kept in a ring buffer per thread
+// and written at exit in the Chrome trace-event JSON format (chrome://tracing or ui.perfetto.dev)
+
+#define TRACE_RING      65536   // last spans kept per thread (must be a power of 2)
+#define TRACE_THREADS   32
+
+void trace_init(const char* filename);
+void trace_dump();
+unsigned long long trace_clock();
+void trace_span(const char* name, unsigned long long start);
+void trace_frame();
+
+// TRACE_BEGIN(name) ... TRACE_END(name), in the same scope
+#define TRACE_BEGIN(name) unsigned long long trace_##name = (globals4es.trace)?trace_clock():0
+#define TRACE_END(name) if(trace_##name) trace_span(#name, trace_##name)
+
+#endif // _GL4ES_TRACE_H_
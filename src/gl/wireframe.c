@@ -0,0 +1,220 @@
+#include "wireframe.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../glx/hardext.h"
+#include "gl4es.h"
+#include "glstate.h"
+#include "init.h"
+#include "loader.h"
+
+//#define DEBUG
+#ifdef DEBUG
+#define DBG(a) a
+#else
+#define DBG(a)
+#endif
+
+// Edges are kept as min<<32|max, so shared edges of adjacent triangles are the same value,
+// and sorting them keeps the lines close to the vertex order.
+
+static uint64_t wire_mix(uint64_t h, uint64_t w) {
+    h ^= w * 0x87c37b91114253d5ULL;
+    return ((h<<31) | (h>>33)) * 0x4cf5ad432745937fULL;
+}
+
+static uint64_t wire_hash(const char* p, GLsizeiptr size) {
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ size;
+    uint64_t w;
+    GLsizeiptr n = size/8;
+    for (GLsizeiptr i=0; i<n; ++i) {
+        memcpy(&w, p+i*8, 8);
+        h = wire_mix(h, w);
+    }
+    for (GLsizeiptr i=n*8; i<size; ++i)
+        h = wire_mix(h, (unsigned char)p[i]);
+    return h;
+}
+
+static int edge_cmp(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x>y)-(x<y);
+}
+
+static int edges_unique(uint64_t *edges, int n) {
+    qsort(edges, n, sizeof(uint64_t), edge_cmp);
+    int k = 0;
+    for (int i=0; i<n; ++i)
+        if((edges[i]>>32)!=(edges[i]&0xffffffffu) && (!k || edges[i]!=edges[k-1]))
+            edges[k++] = edges[i];
+    return k;
+}
+
+int wireframe_unique(GLushort *lines, int count) {
+    int n = count/2;
+    uint64_t *edges = (uint64_t*)malloc(n*sizeof(uint64_t));
+    for (int i=0; i<n; ++i) {
+        uint64_t a = lines[i*2], b = lines[i*2+1];
+        edges[i] = (a<b)?((a<<32)|b):((b<<32)|a);
+    }
+    n = edges_unique(edges, n);
+    for (int i=0; i<n; ++i) {
+        lines[i*2] = edges[i]>>32;
+        lines[i*2+1] = edges[i]&0xffff;
+    }
+    free(edges);
+    return n*2;
+}
+
+// edges of the polygons, as glPolygonMode(GL_LINE) draws them
+static int gen_edges(GLenum mode, GLint first, GLsizei count, const GLushort *sindices, const GLuint *iindices, uint64_t *edges) {
+    #define ind(a)  (sindices?(uint64_t)sindices[a]:(iindices?(uint64_t)iindices[a]:(uint64_t)(first+(a))))
+    #define edge(a, b) {uint64_t ea=ind(a), eb=ind(b); edges[k++] = (ea<eb)?((ea<<32)|eb):((eb<<32)|ea);}
+    int k = 0;
+    switch (mode) {
+        case GL_TRIANGLES:
+            for (int i=0; i+2<count; i+=3) {
+                edge(i, i+1); edge(i+1, i+2); edge(i+2, i);
+            }
+            break;
+        case GL_TRIANGLE_STRIP:
+            if(count>2) {
+                edge(0, 1);
+                for (int i=2; i<count; ++i) {
+                    edge(i-2, i); edge(i-1, i);
+                }
+            }
+            break;
+        case GL_TRIANGLE_FAN:
+            if(count>2) {
+                edge(0, 1);
+                for (int i=2; i<count; ++i) {
+                    edge(i-1, i); edge(0, i);
+                }
+            }
+            break;
+        case GL_QUADS:
+            for (int i=0; i+3<count; i+=4) {
+                edge(i, i+1); edge(i+1, i+2); edge(i+2, i+3); edge(i+3, i);
+            }
+            break;
+        case GL_QUAD_STRIP:
+            if(count>3) {
+                edge(0, 1);
+                for (int i=2; i+1<count; i+=2) {
+                    edge(i-2, i); edge(i-1, i+1); edge(i, i+1);
+                }
+            }
+            break;
+        case GL_POLYGON:
+            if(count>1) {
+                for (int i=1; i<count; ++i)
+                    edge(i-1, i);
+                edge(count-1, 0);
+            }
+            break;
+    }
+    #undef edge
+    #undef ind
+    return k;
+}
+
+static void wire_drop(wireframe_t *w) {
+    if(w->edges.real_buffer)
+        deleteSingleBuffer(w->edges.real_buffer);
+    free(w->edges.data);
+    memset(w, 0, sizeof(wireframe_t));
+}
+
+static void wire_build(wireframe_t *w, const GLushort *sindices, const GLuint *iindices) {
+    uint64_t *edges = (uint64_t*)malloc(w->count*2*sizeof(uint64_t));
+    int n = edges_unique(edges, gen_edges(w->mode, w->first, w->count, sindices, iindices, edges));
+    uint64_t imax = 0;
+    for (int i=0; i<n; ++i)
+        if((edges[i]&0xffffffffu)>imax)
+            imax = edges[i]&0xffffffffu;
+    w->itype = (imax>0xffff)?GL_UNSIGNED_INT:GL_UNSIGNED_SHORT;
+    w->ilen = n*2;
+    GLsizeiptr size = w->ilen*((w->itype==GL_UNSIGNED_INT)?sizeof(GLuint):sizeof(GLushort));
+    free(w->edges.data);
+    w->edges.data = malloc(size?size:sizeof(GLuint));
+    w->edges.size = size;
+    w->edges.type = GL_ELEMENT_ARRAY_BUFFER;
+    if(w->itype==GL_UNSIGNED_INT) {
+        GLuint *p = (GLuint*)w->edges.data;
+        for (int i=0; i<n; ++i) {
+            *(p++) = edges[i]>>32;
+            *(p++) = edges[i]&0xffffffffu;
+        }
+    } else {
+        GLushort *p = (GLushort*)w->edges.data;
+        for (int i=0; i<n; ++i) {
+            *(p++) = edges[i]>>32;
+            *(p++) = edges[i]&0xffff;
+        }
+    }
+    free(edges);
+    if(hardext.esversion>1 && size) {
+        LOAD_GLES(glGenBuffers);
+        LOAD_GLES(glBufferData);
+        if(!w->edges.real_buffer)
+            gles_glGenBuffers(1, &w->edges.real_buffer);
+        GLuint old_index = wantBufferIndex(0);
+        bindBuffer(GL_ELEMENT_ARRAY_BUFFER, w->edges.real_buffer);
+        gles_glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, w->edges.data, GL_STATIC_DRAW);
+        wantBufferIndex(old_index);
+    }
+    DBG(printf("Wireframe of %s (first=%d, count=%d) built, %d lines\n", PrintEnum(w->mode), w->first, w->count, n);)
+}
+
+wireframe_t* wireframe_get(GLenum mode, GLint first, GLsizei count, const GLushort *sindices, const GLuint *iindices) {
+    if(!sindices && !iindices && first+count>0x10000 && !hardext.elementuint)
+        return NULL;
+    if(!glstate->wireframes)
+        glstate->wireframes = (wireframes_t*)calloc(1, sizeof(wireframes_t));
+    wireframes_t *wires = glstate->wireframes;
+    ++wires->tick;
+    if(!(wires->tick & 255))
+        for (int i=0; i<WIRE_MAX; ++i)
+            if(wires->entries[i].mode && wires->tick-wires->entries[i].last>WIRE_COLD)
+                wire_drop(&wires->entries[i]);
+    GLenum type = sindices?GL_UNSIGNED_SHORT:(iindices?GL_UNSIGNED_INT:0);
+    uint64_t hash = 0;
+    if(sindices)
+        hash = wire_hash((const char*)sindices, count*sizeof(GLushort));
+    else if(iindices)
+        hash = wire_hash((const char*)iindices, count*sizeof(GLuint));
+    wireframe_t *w = NULL;
+    for (int i=0; i<WIRE_MAX && !w; ++i) {
+        wireframe_t *e = &wires->entries[i];
+        if(e->mode==mode && e->first==first && e->count==count && e->type==type && e->hash==hash)
+            w = e;
+    }
+    if(!w) {
+        // take a free slot, or the least recently used one
+        w = &wires->entries[0];
+        for (int i=0; i<WIRE_MAX && w->mode; ++i)
+            if(!wires->entries[i].mode || wires->entries[i].last<w->last)
+                w = &wires->entries[i];
+        if(w->mode)
+            wire_drop(w);
+        w->mode = mode;
+        w->first = first;
+        w->count = count;
+        w->type = type;
+        w->hash = hash;
+        wire_build(w, sindices, iindices);
+    }
+    w->last = wires->tick;
+    return w;
+}
+
+void wireframes_free(wireframes_t *wires) {
+    if(!wires)
+        return;
+    for (int i=0; i<WIRE_MAX; ++i)
+        wire_drop(&wires->entries[i]);
+    free(wires);
+}
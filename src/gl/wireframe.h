@@ -0,0 +1,34 @@
+#ifndef _GL4ES_WIREFRAME_H_
+#define _GL4ES_WIREFRAME_H_
+
+#include "buffers.h"
+
+#define WIRE_MAX    32      // edge lists kept for array draws
+#define WIRE_COLD   4096    // draws without use before an edge list is dropped
+
+typedef struct {
+    GLenum      mode;       // source primitive (0 if slot is free)
+    GLint       first;
+    GLsizei     count;
+    GLenum      type;       // type of the source indices, 0 for glDrawArrays
+    uint64_t    hash;       // checksum of the source indices
+    unsigned    last;       // tick of the last use
+    GLsizei     ilen;       // number of GL_LINES indices
+    GLenum      itype;      // GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+    glbuffer_t  edges;      // the indices, with a real element buffer on ES2
+} wireframe_t;
+
+typedef struct {
+    wireframe_t entries[WIRE_MAX];
+    unsigned    tick;
+} wireframes_t;
+
+// glPolygonMode(GL_LINE) for array draws: the GL_LINES indices of a draw (no indices for glDrawArrays), built
+// the 1st time and then found by the draw parameters and a checksum of the indices. Return NULL if the
+// edges cannot be drawn (more than 65536 vertices without uint indices support)
+wireframe_t* wireframe_get(GLenum mode, GLint first, GLsizei count, const GLushort *sindices, const GLuint *iindices);
+// sort the edges of a GL_LINES indices list, dropping the duplicated and the degenerated ones. Return the new count
+int wireframe_unique(GLushort *lines, int count);
+void wireframes_free(wireframes_t *wires);
+
+#endif // _GL4ES_WIREFRAME_H_
@@ -2456,732 +2456,858 @@ void APIENTRY_GL4ES gl4es_glViewport(GLint x, GLint y, GLsizei width, GLsizei he
 }
 AliasExport(void,glViewport,,(GLint x, GLint y, GLsizei width, GLsizei height));
 #endif
+static void APIENTRY_GL4ES packed_call_void_GLenum(const packed_call_t *packed) {
+    PACKED_void_GLenum *unpacked = (PACKED_void_GLenum *)packed;
+    ARGS_void_GLenum args = unpacked->args;
+    unpacked->func(args.a1);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLclampf(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLclampf *unpacked = (PACKED_void_GLenum_GLclampf *)packed;
+    ARGS_void_GLenum_GLclampf args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLclampx(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLclampx *unpacked = (PACKED_void_GLenum_GLclampx *)packed;
+    ARGS_void_GLenum_GLclampx args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLuint_GLuint(const packed_call_t *packed) {
+    PACKED_void_GLuint_GLuint *unpacked = (PACKED_void_GLuint_GLuint *)packed;
+    ARGS_void_GLuint_GLuint args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLuint_GLuint_const_GLchar___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLuint_GLuint_const_GLchar___GENPT__ *unpacked = (PACKED_void_GLuint_GLuint_const_GLchar___GENPT__ *)packed;
+    ARGS_void_GLuint_GLuint_const_GLchar___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLuint(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLuint *unpacked = (PACKED_void_GLenum_GLuint *)packed;
+    ARGS_void_GLenum_GLuint args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLclampf_GLclampf_GLclampf_GLclampf(const packed_call_t *packed) {
+    PACKED_void_GLclampf_GLclampf_GLclampf_GLclampf *unpacked = (PACKED_void_GLclampf_GLclampf_GLclampf_GLclampf *)packed;
+    ARGS_void_GLclampf_GLclampf_GLclampf_GLclampf args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLenum(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLenum *unpacked = (PACKED_void_GLenum_GLenum *)packed;
+    ARGS_void_GLenum_GLenum args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLenum_GLenum_GLenum(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLenum_GLenum_GLenum *unpacked = (PACKED_void_GLenum_GLenum_GLenum_GLenum *)packed;
+    ARGS_void_GLenum_GLenum_GLenum_GLenum args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLsizeiptr_const_GLvoid___GENPT___GLenum(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLsizeiptr_const_GLvoid___GENPT___GLenum *unpacked = (PACKED_void_GLenum_GLsizeiptr_const_GLvoid___GENPT___GLenum *)packed;
+    ARGS_void_GLenum_GLsizeiptr_const_GLvoid___GENPT___GLenum args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLintptr_GLsizeiptr_const_GLvoid___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLintptr_GLsizeiptr_const_GLvoid___GENPT__ *unpacked = (PACKED_void_GLenum_GLintptr_GLsizeiptr_const_GLvoid___GENPT__ *)packed;
+    ARGS_void_GLenum_GLintptr_GLsizeiptr_const_GLvoid___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_GLenum_GLenum(const packed_call_t *packed) {
+    PACKED_GLenum_GLenum *unpacked = (PACKED_GLenum_GLenum *)packed;
+    ARGS_GLenum_GLenum args = unpacked->args;
+    unpacked->func(args.a1);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLbitfield(const packed_call_t *packed) {
+    PACKED_void_GLbitfield *unpacked = (PACKED_void_GLbitfield *)packed;
+    ARGS_void_GLbitfield args = unpacked->args;
+    unpacked->func(args.a1);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLclampx_GLclampx_GLclampx_GLclampx(const packed_call_t *packed) {
+    PACKED_void_GLclampx_GLclampx_GLclampx_GLclampx *unpacked = (PACKED_void_GLclampx_GLclampx_GLclampx_GLclampx *)packed;
+    ARGS_void_GLclampx_GLclampx_GLclampx_GLclampx args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLclampf(const packed_call_t *packed) {
+    PACKED_void_GLclampf *unpacked = (PACKED_void_GLclampf *)packed;
+    ARGS_void_GLclampf args = unpacked->args;
+    unpacked->func(args.a1);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLclampx(const packed_call_t *packed) {
+    PACKED_void_GLclampx *unpacked = (PACKED_void_GLclampx *)packed;
+    ARGS_void_GLclampx args = unpacked->args;
+    unpacked->func(args.a1);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLint(const packed_call_t *packed) {
+    PACKED_void_GLint *unpacked = (PACKED_void_GLint *)packed;
+    ARGS_void_GLint args = unpacked->args;
+    unpacked->func(args.a1);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_const_GLfloat___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLenum_const_GLfloat___GENPT__ *unpacked = (PACKED_void_GLenum_const_GLfloat___GENPT__ *)packed;
+    ARGS_void_GLenum_const_GLfloat___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_const_GLfixed___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLenum_const_GLfixed___GENPT__ *unpacked = (PACKED_void_GLenum_const_GLfixed___GENPT__ *)packed;
+    ARGS_void_GLenum_const_GLfixed___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLfloat_GLfloat_GLfloat_GLfloat(const packed_call_t *packed) {
+    PACKED_void_GLfloat_GLfloat_GLfloat_GLfloat *unpacked = (PACKED_void_GLfloat_GLfloat_GLfloat_GLfloat *)packed;
+    ARGS_void_GLfloat_GLfloat_GLfloat_GLfloat args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLubyte_GLubyte_GLubyte_GLubyte(const packed_call_t *packed) {
+    PACKED_void_GLubyte_GLubyte_GLubyte_GLubyte *unpacked = (PACKED_void_GLubyte_GLubyte_GLubyte_GLubyte *)packed;
+    ARGS_void_GLubyte_GLubyte_GLubyte_GLubyte args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLfixed_GLfixed_GLfixed_GLfixed(const packed_call_t *packed) {
+    PACKED_void_GLfixed_GLfixed_GLfixed_GLfixed *unpacked = (PACKED_void_GLfixed_GLfixed_GLfixed_GLfixed *)packed;
+    ARGS_void_GLfixed_GLfixed_GLfixed_GLfixed args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLboolean_GLboolean_GLboolean_GLboolean(const packed_call_t *packed) {
+    PACKED_void_GLboolean_GLboolean_GLboolean_GLboolean *unpacked = (PACKED_void_GLboolean_GLboolean_GLboolean_GLboolean *)packed;
+    ARGS_void_GLboolean_GLboolean_GLboolean_GLboolean args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLint_GLenum_GLsizei_const_GLvoid___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLint_GLenum_GLsizei_const_GLvoid___GENPT__ *unpacked = (PACKED_void_GLint_GLenum_GLsizei_const_GLvoid___GENPT__ *)packed;
+    ARGS_void_GLint_GLenum_GLsizei_const_GLvoid___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLuint(const packed_call_t *packed) {
+    PACKED_void_GLuint *unpacked = (PACKED_void_GLuint *)packed;
+    ARGS_void_GLuint args = unpacked->args;
+    unpacked->func(args.a1);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLint_GLenum_GLsizei_GLsizei_GLint_GLsizei_const_GLvoid___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLint_GLenum_GLsizei_GLsizei_GLint_GLsizei_const_GLvoid___GENPT__ *unpacked = (PACKED_void_GLenum_GLint_GLenum_GLsizei_GLsizei_GLint_GLsizei_const_GLvoid___GENPT__ *)packed;
+    ARGS_void_GLenum_GLint_GLenum_GLsizei_GLsizei_GLint_GLsizei_const_GLvoid___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5, args.a6, args.a7, args.a8);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLint_GLint_GLint_GLsizei_GLsizei_GLenum_GLsizei_const_GLvoid___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLint_GLint_GLint_GLsizei_GLsizei_GLenum_GLsizei_const_GLvoid___GENPT__ *unpacked = (PACKED_void_GLenum_GLint_GLint_GLint_GLsizei_GLsizei_GLenum_GLsizei_const_GLvoid___GENPT__ *)packed;
+    ARGS_void_GLenum_GLint_GLint_GLint_GLsizei_GLsizei_GLenum_GLsizei_const_GLvoid___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5, args.a6, args.a7, args.a8, args.a9);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLint_GLenum_GLint_GLint_GLsizei_GLsizei_GLint(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLint_GLenum_GLint_GLint_GLsizei_GLsizei_GLint *unpacked = (PACKED_void_GLenum_GLint_GLenum_GLint_GLint_GLsizei_GLsizei_GLint *)packed;
+    ARGS_void_GLenum_GLint_GLenum_GLint_GLint_GLsizei_GLsizei_GLint args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5, args.a6, args.a7, args.a8);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLint_GLint_GLint_GLint_GLint_GLsizei_GLsizei(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLint_GLint_GLint_GLint_GLint_GLsizei_GLsizei *unpacked = (PACKED_void_GLenum_GLint_GLint_GLint_GLint_GLint_GLsizei_GLsizei *)packed;
+    ARGS_void_GLenum_GLint_GLint_GLint_GLint_GLint_GLsizei_GLsizei args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5, args.a6, args.a7, args.a8);
+}
+
+static void APIENTRY_GL4ES packed_call_GLuint(const packed_call_t *packed) {
+    PACKED_GLuint *unpacked = (PACKED_GLuint *)packed;
+    unpacked->func();
+}
+
+static void APIENTRY_GL4ES packed_call_GLuint_GLenum(const packed_call_t *packed) {
+    PACKED_GLuint_GLenum *unpacked = (PACKED_GLuint_GLenum *)packed;
+    ARGS_GLuint_GLenum args = unpacked->args;
+    unpacked->func(args.a1);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLsizei_const_GLuint___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLsizei_const_GLuint___GENPT__ *unpacked = (PACKED_void_GLsizei_const_GLuint___GENPT__ *)packed;
+    ARGS_void_GLsizei_const_GLuint___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLsizei_GLuint___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLsizei_GLuint___GENPT__ *unpacked = (PACKED_void_GLsizei_GLuint___GENPT__ *)packed;
+    ARGS_void_GLsizei_GLuint___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLboolean(const packed_call_t *packed) {
+    PACKED_void_GLboolean *unpacked = (PACKED_void_GLboolean *)packed;
+    ARGS_void_GLboolean args = unpacked->args;
+    unpacked->func(args.a1);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLclampf_GLclampf(const packed_call_t *packed) {
+    PACKED_void_GLclampf_GLclampf *unpacked = (PACKED_void_GLclampf_GLclampf *)packed;
+    ARGS_void_GLclampf_GLclampf args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLclampx_GLclampx(const packed_call_t *packed) {
+    PACKED_void_GLclampx_GLclampx *unpacked = (PACKED_void_GLclampx_GLclampx *)packed;
+    ARGS_void_GLclampx_GLclampx args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLint_GLsizei(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLint_GLsizei *unpacked = (PACKED_void_GLenum_GLint_GLsizei *)packed;
+    ARGS_void_GLenum_GLint_GLsizei args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLsizei_const_GLenum___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLsizei_const_GLenum___GENPT__ *unpacked = (PACKED_void_GLsizei_const_GLenum___GENPT__ *)packed;
+    ARGS_void_GLsizei_const_GLenum___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLsizei_GLenum_const_GLvoid___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLsizei_GLenum_const_GLvoid___GENPT__ *unpacked = (PACKED_void_GLenum_GLsizei_GLenum_const_GLvoid___GENPT__ *)packed;
+    ARGS_void_GLenum_GLsizei_GLenum_const_GLvoid___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat(const packed_call_t *packed) {
+    PACKED_void_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat *unpacked = (PACKED_void_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat *)packed;
+    ARGS_void_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLint_GLint_GLint_GLint_GLint(const packed_call_t *packed) {
+    PACKED_void_GLint_GLint_GLint_GLint_GLint *unpacked = (PACKED_void_GLint_GLint_GLint_GLint_GLint *)packed;
+    ARGS_void_GLint_GLint_GLint_GLint_GLint args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5);
+}
+
+static void APIENTRY_GL4ES packed_call_void(const packed_call_t *packed) {
+    PACKED_void *unpacked = (PACKED_void *)packed;
+    unpacked->func();
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLsizei_const_GLvoid___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLsizei_const_GLvoid___GENPT__ *unpacked = (PACKED_void_GLenum_GLsizei_const_GLvoid___GENPT__ *)packed;
+    ARGS_void_GLenum_GLsizei_const_GLvoid___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLfloat(const packed_call_t *packed) {
+    PACKED_void_GLfloat *unpacked = (PACKED_void_GLfloat *)packed;
+    ARGS_void_GLfloat args = unpacked->args;
+    unpacked->func(args.a1);
+}
+
+static void APIENTRY_GL4ES packed_call_void_const_GLfloat___GENPT__(const packed_call_t *packed) {
+    PACKED_void_const_GLfloat___GENPT__ *unpacked = (PACKED_void_const_GLfloat___GENPT__ *)packed;
+    ARGS_void_const_GLfloat___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLfloat(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLfloat *unpacked = (PACKED_void_GLenum_GLfloat *)packed;
+    ARGS_void_GLenum_GLfloat args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLfixed(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLfixed *unpacked = (PACKED_void_GLenum_GLfixed *)packed;
+    ARGS_void_GLenum_GLfixed args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLenum_GLenum_GLuint(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLenum_GLenum_GLuint *unpacked = (PACKED_void_GLenum_GLenum_GLenum_GLuint *)packed;
+    ARGS_void_GLenum_GLenum_GLenum_GLuint args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLenum_GLenum_GLuint_GLint(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLenum_GLenum_GLuint_GLint *unpacked = (PACKED_void_GLenum_GLenum_GLenum_GLuint_GLint *)packed;
+    ARGS_void_GLenum_GLenum_GLenum_GLuint_GLint args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat(const packed_call_t *packed) {
+    PACKED_void_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat *unpacked = (PACKED_void_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat *)packed;
+    ARGS_void_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5, args.a6);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLfixed_GLfixed_GLfixed_GLfixed_GLfixed_GLfixed(const packed_call_t *packed) {
+    PACKED_void_GLfixed_GLfixed_GLfixed_GLfixed_GLfixed_GLfixed *unpacked = (PACKED_void_GLfixed_GLfixed_GLfixed_GLfixed_GLfixed_GLfixed *)packed;
+    ARGS_void_GLfixed_GLfixed_GLfixed_GLfixed_GLfixed_GLfixed args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5, args.a6);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLuint_GLuint_GLsizei_GLsizei___GENPT___GLint___GENPT___GLenum___GENPT___GLchar___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLuint_GLuint_GLsizei_GLsizei___GENPT___GLint___GENPT___GLenum___GENPT___GLchar___GENPT__ *unpacked = (PACKED_void_GLuint_GLuint_GLsizei_GLsizei___GENPT___GLint___GENPT___GLenum___GENPT___GLchar___GENPT__ *)packed;
+    ARGS_void_GLuint_GLuint_GLsizei_GLsizei___GENPT___GLint___GENPT___GLenum___GENPT___GLchar___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5, args.a6, args.a7);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLuint_GLsizei_GLsizei___GENPT___GLuint___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLuint_GLsizei_GLsizei___GENPT___GLuint___GENPT__ *unpacked = (PACKED_void_GLuint_GLsizei_GLsizei___GENPT___GLuint___GENPT__ *)packed;
+    ARGS_void_GLuint_GLsizei_GLsizei___GENPT___GLuint___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_GLint_GLuint_const_GLchar___GENPT__(const packed_call_t *packed) {
+    PACKED_GLint_GLuint_const_GLchar___GENPT__ *unpacked = (PACKED_GLint_GLuint_const_GLchar___GENPT__ *)packed;
+    ARGS_GLint_GLuint_const_GLchar___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLboolean___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLboolean___GENPT__ *unpacked = (PACKED_void_GLenum_GLboolean___GENPT__ *)packed;
+    ARGS_void_GLenum_GLboolean___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLenum_GLint___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLenum_GLint___GENPT__ *unpacked = (PACKED_void_GLenum_GLenum_GLint___GENPT__ *)packed;
+    ARGS_void_GLenum_GLenum_GLint___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLfloat___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLfloat___GENPT__ *unpacked = (PACKED_void_GLenum_GLfloat___GENPT__ *)packed;
+    ARGS_void_GLenum_GLfloat___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLfixed___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLfixed___GENPT__ *unpacked = (PACKED_void_GLenum_GLfixed___GENPT__ *)packed;
+    ARGS_void_GLenum_GLfixed___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_GLenum(const packed_call_t *packed) {
+    PACKED_GLenum *unpacked = (PACKED_GLenum *)packed;
+    unpacked->func();
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLenum_GLenum_GLint___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLenum_GLenum_GLint___GENPT__ *unpacked = (PACKED_void_GLenum_GLenum_GLenum_GLint___GENPT__ *)packed;
+    ARGS_void_GLenum_GLenum_GLenum_GLint___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLint___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLint___GENPT__ *unpacked = (PACKED_void_GLenum_GLint___GENPT__ *)packed;
+    ARGS_void_GLenum_GLint___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLenum_GLfloat___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLenum_GLfloat___GENPT__ *unpacked = (PACKED_void_GLenum_GLenum_GLfloat___GENPT__ *)packed;
+    ARGS_void_GLenum_GLenum_GLfloat___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLenum_GLfixed___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLenum_GLfixed___GENPT__ *unpacked = (PACKED_void_GLenum_GLenum_GLfixed___GENPT__ *)packed;
+    ARGS_void_GLenum_GLenum_GLfixed___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLvoid___GENPT____GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLvoid___GENPT____GENPT__ *unpacked = (PACKED_void_GLenum_GLvoid___GENPT____GENPT__ *)packed;
+    ARGS_void_GLenum_GLvoid___GENPT____GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLuint_GLsizei_GLsizei___GENPT___GLenum___GENPT___GLvoid___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLuint_GLsizei_GLsizei___GENPT___GLenum___GENPT___GLvoid___GENPT__ *unpacked = (PACKED_void_GLuint_GLsizei_GLsizei___GENPT___GLenum___GENPT___GLvoid___GENPT__ *)packed;
+    ARGS_void_GLuint_GLsizei_GLsizei___GENPT___GLenum___GENPT___GLvoid___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLuint_GLsizei_GLsizei___GENPT___GLchar___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLuint_GLsizei_GLsizei___GENPT___GLchar___GENPT__ *unpacked = (PACKED_void_GLuint_GLsizei_GLsizei___GENPT___GLchar___GENPT__ *)packed;
+    ARGS_void_GLuint_GLsizei_GLsizei___GENPT___GLchar___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLuint_GLenum_GLint___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLuint_GLenum_GLint___GENPT__ *unpacked = (PACKED_void_GLuint_GLenum_GLint___GENPT__ *)packed;
+    ARGS_void_GLuint_GLenum_GLint___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLenum_GLint___GENPT___GLint___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLenum_GLint___GENPT___GLint___GENPT__ *unpacked = (PACKED_void_GLenum_GLenum_GLint___GENPT___GLint___GENPT__ *)packed;
+    ARGS_void_GLenum_GLenum_GLint___GENPT___GLint___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_const_GLubyte___GENPT___GLenum(const packed_call_t *packed) {
+    PACKED_const_GLubyte___GENPT___GLenum *unpacked = (PACKED_const_GLubyte___GENPT___GLenum *)packed;
+    ARGS_const_GLubyte___GENPT___GLenum args = unpacked->args;
+    unpacked->func(args.a1);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLuint_GLint_GLfloat___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLuint_GLint_GLfloat___GENPT__ *unpacked = (PACKED_void_GLuint_GLint_GLfloat___GENPT__ *)packed;
+    ARGS_void_GLuint_GLint_GLfloat___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLuint_GLint_GLint___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLuint_GLint_GLint___GENPT__ *unpacked = (PACKED_void_GLuint_GLint_GLint___GENPT__ *)packed;
+    ARGS_void_GLuint_GLint_GLint___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLuint_GLenum_GLvoid___GENPT____GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLuint_GLenum_GLvoid___GENPT____GENPT__ *unpacked = (PACKED_void_GLuint_GLenum_GLvoid___GENPT____GENPT__ *)packed;
+    ARGS_void_GLuint_GLenum_GLvoid___GENPT____GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLuint_GLenum_GLfloat___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLuint_GLenum_GLfloat___GENPT__ *unpacked = (PACKED_void_GLuint_GLenum_GLfloat___GENPT__ *)packed;
+    ARGS_void_GLuint_GLenum_GLfloat___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_GLboolean_GLuint(const packed_call_t *packed) {
+    PACKED_GLboolean_GLuint *unpacked = (PACKED_GLboolean_GLuint *)packed;
+    ARGS_GLboolean_GLuint args = unpacked->args;
+    unpacked->func(args.a1);
+}
+
+static void APIENTRY_GL4ES packed_call_GLboolean_GLenum(const packed_call_t *packed) {
+    PACKED_GLboolean_GLenum *unpacked = (PACKED_GLboolean_GLenum *)packed;
+    ARGS_GLboolean_GLenum args = unpacked->args;
+    unpacked->func(args.a1);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLenum_GLfloat(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLenum_GLfloat *unpacked = (PACKED_void_GLenum_GLenum_GLfloat *)packed;
+    ARGS_void_GLenum_GLenum_GLfloat args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLenum_const_GLfloat___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLenum_const_GLfloat___GENPT__ *unpacked = (PACKED_void_GLenum_GLenum_const_GLfloat___GENPT__ *)packed;
+    ARGS_void_GLenum_GLenum_const_GLfloat___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLenum_GLfixed(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLenum_GLfixed *unpacked = (PACKED_void_GLenum_GLenum_GLfixed *)packed;
+    ARGS_void_GLenum_GLenum_GLfixed args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLenum_const_GLfixed___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLenum_const_GLfixed___GENPT__ *unpacked = (PACKED_void_GLenum_GLenum_const_GLfixed___GENPT__ *)packed;
+    ARGS_void_GLenum_GLenum_const_GLfixed___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLfixed(const packed_call_t *packed) {
+    PACKED_void_GLfixed *unpacked = (PACKED_void_GLfixed *)packed;
+    ARGS_void_GLfixed args = unpacked->args;
+    unpacked->func(args.a1);
+}
+
+static void APIENTRY_GL4ES packed_call_void_const_GLfixed___GENPT__(const packed_call_t *packed) {
+    PACKED_void_const_GLfixed___GENPT__ *unpacked = (PACKED_void_const_GLfixed___GENPT__ *)packed;
+    ARGS_void_const_GLfixed___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_const_GLint___GENPT___const_GLsizei___GENPT___GLsizei(const packed_call_t *packed) {
+    PACKED_void_GLenum_const_GLint___GENPT___const_GLsizei___GENPT___GLsizei *unpacked = (PACKED_void_GLenum_const_GLint___GENPT___const_GLsizei___GENPT___GLsizei *)packed;
+    ARGS_void_GLenum_const_GLint___GENPT___const_GLsizei___GENPT___GLsizei args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLsizei___GENPT___GLenum_const_void___GENPT___const___GENPT___GLsizei(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLsizei___GENPT___GLenum_const_void___GENPT___const___GENPT___GLsizei *unpacked = (PACKED_void_GLenum_GLsizei___GENPT___GLenum_const_void___GENPT___const___GENPT___GLsizei *)packed;
+    ARGS_void_GLenum_GLsizei___GENPT___GLenum_const_void___GENPT___const___GENPT___GLsizei args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLfloat_GLfloat_GLfloat_GLfloat(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLfloat_GLfloat_GLfloat_GLfloat *unpacked = (PACKED_void_GLenum_GLfloat_GLfloat_GLfloat_GLfloat *)packed;
+    ARGS_void_GLenum_GLfloat_GLfloat_GLfloat_GLfloat args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLfixed_GLfixed_GLfixed_GLfixed(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLfixed_GLfixed_GLfixed_GLfixed *unpacked = (PACKED_void_GLenum_GLfixed_GLfixed_GLfixed_GLfixed *)packed;
+    ARGS_void_GLenum_GLfixed_GLfixed_GLfixed_GLfixed args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLfloat_GLfloat_GLfloat(const packed_call_t *packed) {
+    PACKED_void_GLfloat_GLfloat_GLfloat *unpacked = (PACKED_void_GLfloat_GLfloat_GLfloat *)packed;
+    ARGS_void_GLfloat_GLfloat_GLfloat args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLfixed_GLfixed_GLfixed(const packed_call_t *packed) {
+    PACKED_void_GLfixed_GLfixed_GLfixed *unpacked = (PACKED_void_GLfixed_GLfixed_GLfixed *)packed;
+    ARGS_void_GLfixed_GLfixed_GLfixed args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLint(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLint *unpacked = (PACKED_void_GLenum_GLint *)packed;
+    ARGS_void_GLenum_GLint args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLfloat_GLfloat(const packed_call_t *packed) {
+    PACKED_void_GLfloat_GLfloat *unpacked = (PACKED_void_GLfloat_GLfloat *)packed;
+    ARGS_void_GLfloat_GLfloat args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLfixed_GLfixed(const packed_call_t *packed) {
+    PACKED_void_GLfixed_GLfixed *unpacked = (PACKED_void_GLfixed_GLfixed *)packed;
+    ARGS_void_GLfixed_GLfixed args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLuint_GLenum_const_GLvoid___GENPT___GLint(const packed_call_t *packed) {
+    PACKED_void_GLuint_GLenum_const_GLvoid___GENPT___GLint *unpacked = (PACKED_void_GLuint_GLenum_const_GLvoid___GENPT___GLint *)packed;
+    ARGS_void_GLuint_GLenum_const_GLvoid___GENPT___GLint args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum_GLvoid___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum_GLvoid___GENPT__ *unpacked = (PACKED_void_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum_GLvoid___GENPT__ *)packed;
+    ARGS_void_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum_GLvoid___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5, args.a6, args.a7);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLenum_GLsizei_GLsizei(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLenum_GLsizei_GLsizei *unpacked = (PACKED_void_GLenum_GLenum_GLsizei_GLsizei *)packed;
+    ARGS_void_GLenum_GLenum_GLsizei_GLsizei args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLclampf_GLboolean(const packed_call_t *packed) {
+    PACKED_void_GLclampf_GLboolean *unpacked = (PACKED_void_GLclampf_GLboolean *)packed;
+    ARGS_void_GLclampf_GLboolean args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLclampx_GLboolean(const packed_call_t *packed) {
+    PACKED_void_GLclampx_GLboolean *unpacked = (PACKED_void_GLclampx_GLboolean *)packed;
+    ARGS_void_GLclampx_GLboolean args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLint_GLint_GLsizei_GLsizei(const packed_call_t *packed) {
+    PACKED_void_GLint_GLint_GLsizei_GLsizei *unpacked = (PACKED_void_GLint_GLint_GLsizei_GLsizei *)packed;
+    ARGS_void_GLint_GLint_GLsizei_GLsizei args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLsizei_const_GLuint___GENPT___GLenum_const_GLvoid___GENPT___GLsizei(const packed_call_t *packed) {
+    PACKED_void_GLsizei_const_GLuint___GENPT___GLenum_const_GLvoid___GENPT___GLsizei *unpacked = (PACKED_void_GLsizei_const_GLuint___GENPT___GLenum_const_GLvoid___GENPT___GLsizei *)packed;
+    ARGS_void_GLsizei_const_GLuint___GENPT___GLenum_const_GLvoid___GENPT___GLsizei args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLuint_GLsizei_const_GLchar___GENPT___const___GENPT___const_GLint___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLuint_GLsizei_const_GLchar___GENPT___const___GENPT___const_GLint___GENPT__ *unpacked = (PACKED_void_GLuint_GLsizei_const_GLchar___GENPT___const___GENPT___const_GLint___GENPT__ *)packed;
+    ARGS_void_GLuint_GLsizei_const_GLchar___GENPT___const___GENPT___const_GLint___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLint_GLuint(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLint_GLuint *unpacked = (PACKED_void_GLenum_GLint_GLuint *)packed;
+    ARGS_void_GLenum_GLint_GLuint args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLenum_GLint_GLuint(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLenum_GLint_GLuint *unpacked = (PACKED_void_GLenum_GLenum_GLint_GLuint *)packed;
+    ARGS_void_GLenum_GLenum_GLint_GLuint args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLenum_GLenum(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLenum_GLenum *unpacked = (PACKED_void_GLenum_GLenum_GLenum *)packed;
+    ARGS_void_GLenum_GLenum_GLenum args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLenum_GLint(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLenum_GLint *unpacked = (PACKED_void_GLenum_GLenum_GLint *)packed;
+    ARGS_void_GLenum_GLenum_GLint args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLenum_const_GLint___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLenum_const_GLint___GENPT__ *unpacked = (PACKED_void_GLenum_GLenum_const_GLint___GENPT__ *)packed;
+    ARGS_void_GLenum_GLenum_const_GLint___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLint_GLint_GLsizei_GLsizei_GLint_GLenum_GLenum_const_GLvoid___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLint_GLint_GLsizei_GLsizei_GLint_GLenum_GLenum_const_GLvoid___GENPT__ *unpacked = (PACKED_void_GLenum_GLint_GLint_GLsizei_GLsizei_GLint_GLenum_GLenum_const_GLvoid___GENPT__ *)packed;
+    ARGS_void_GLenum_GLint_GLint_GLsizei_GLsizei_GLint_GLenum_GLenum_const_GLvoid___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5, args.a6, args.a7, args.a8, args.a9);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLenum_GLint_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum_const_GLvoid___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLenum_GLint_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum_const_GLvoid___GENPT__ *unpacked = (PACKED_void_GLenum_GLint_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum_const_GLvoid___GENPT__ *)packed;
+    ARGS_void_GLenum_GLint_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum_const_GLvoid___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5, args.a6, args.a7, args.a8, args.a9);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLint_GLfloat(const packed_call_t *packed) {
+    PACKED_void_GLint_GLfloat *unpacked = (PACKED_void_GLint_GLfloat *)packed;
+    ARGS_void_GLint_GLfloat args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLint_GLsizei_const_GLfloat___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLint_GLsizei_const_GLfloat___GENPT__ *unpacked = (PACKED_void_GLint_GLsizei_const_GLfloat___GENPT__ *)packed;
+    ARGS_void_GLint_GLsizei_const_GLfloat___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLint_GLint(const packed_call_t *packed) {
+    PACKED_void_GLint_GLint *unpacked = (PACKED_void_GLint_GLint *)packed;
+    ARGS_void_GLint_GLint args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLint_GLsizei_const_GLint___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLint_GLsizei_const_GLint___GENPT__ *unpacked = (PACKED_void_GLint_GLsizei_const_GLint___GENPT__ *)packed;
+    ARGS_void_GLint_GLsizei_const_GLint___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLint_GLfloat_GLfloat(const packed_call_t *packed) {
+    PACKED_void_GLint_GLfloat_GLfloat *unpacked = (PACKED_void_GLint_GLfloat_GLfloat *)packed;
+    ARGS_void_GLint_GLfloat_GLfloat args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLint_GLint_GLint(const packed_call_t *packed) {
+    PACKED_void_GLint_GLint_GLint *unpacked = (PACKED_void_GLint_GLint_GLint *)packed;
+    ARGS_void_GLint_GLint_GLint args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLint_GLfloat_GLfloat_GLfloat(const packed_call_t *packed) {
+    PACKED_void_GLint_GLfloat_GLfloat_GLfloat *unpacked = (PACKED_void_GLint_GLfloat_GLfloat_GLfloat *)packed;
+    ARGS_void_GLint_GLfloat_GLfloat_GLfloat args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLint_GLint_GLint_GLint(const packed_call_t *packed) {
+    PACKED_void_GLint_GLint_GLint_GLint *unpacked = (PACKED_void_GLint_GLint_GLint_GLint *)packed;
+    ARGS_void_GLint_GLint_GLint_GLint args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLint_GLfloat_GLfloat_GLfloat_GLfloat(const packed_call_t *packed) {
+    PACKED_void_GLint_GLfloat_GLfloat_GLfloat_GLfloat *unpacked = (PACKED_void_GLint_GLfloat_GLfloat_GLfloat_GLfloat *)packed;
+    ARGS_void_GLint_GLfloat_GLfloat_GLfloat_GLfloat args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLint_GLsizei_GLboolean_const_GLfloat___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLint_GLsizei_GLboolean_const_GLfloat___GENPT__ *unpacked = (PACKED_void_GLint_GLsizei_GLboolean_const_GLfloat___GENPT__ *)packed;
+    ARGS_void_GLint_GLsizei_GLboolean_const_GLfloat___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLuint_GLfloat(const packed_call_t *packed) {
+    PACKED_void_GLuint_GLfloat *unpacked = (PACKED_void_GLuint_GLfloat *)packed;
+    ARGS_void_GLuint_GLfloat args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLuint_const_GLfloat___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLuint_const_GLfloat___GENPT__ *unpacked = (PACKED_void_GLuint_const_GLfloat___GENPT__ *)packed;
+    ARGS_void_GLuint_const_GLfloat___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLuint_GLfloat_GLfloat(const packed_call_t *packed) {
+    PACKED_void_GLuint_GLfloat_GLfloat *unpacked = (PACKED_void_GLuint_GLfloat_GLfloat *)packed;
+    ARGS_void_GLuint_GLfloat_GLfloat args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLuint_GLfloat_GLfloat_GLfloat(const packed_call_t *packed) {
+    PACKED_void_GLuint_GLfloat_GLfloat_GLfloat *unpacked = (PACKED_void_GLuint_GLfloat_GLfloat_GLfloat *)packed;
+    ARGS_void_GLuint_GLfloat_GLfloat_GLfloat args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLuint_GLfloat_GLfloat_GLfloat_GLfloat(const packed_call_t *packed) {
+    PACKED_void_GLuint_GLfloat_GLfloat_GLfloat_GLfloat *unpacked = (PACKED_void_GLuint_GLfloat_GLfloat_GLfloat_GLfloat *)packed;
+    ARGS_void_GLuint_GLfloat_GLfloat_GLfloat_GLfloat args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5);
+}
+
+static void APIENTRY_GL4ES packed_call_void_GLuint_GLint_GLenum_GLboolean_GLsizei_const_GLvoid___GENPT__(const packed_call_t *packed) {
+    PACKED_void_GLuint_GLint_GLenum_GLboolean_GLsizei_const_GLvoid___GENPT__ *unpacked = (PACKED_void_GLuint_GLint_GLenum_GLboolean_GLsizei_const_GLvoid___GENPT__ *)packed;
+    ARGS_void_GLuint_GLint_GLenum_GLboolean_GLsizei_const_GLvoid___GENPT__ args = unpacked->args;
+    unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5, args.a6);
+}
+
+static const packed_call_func_t packed_call_table[] = {
+    [FORMAT_void_GLenum] = packed_call_void_GLenum,
+    [FORMAT_void_GLenum_GLclampf] = packed_call_void_GLenum_GLclampf,
+    [FORMAT_void_GLenum_GLclampx] = packed_call_void_GLenum_GLclampx,
+    [FORMAT_void_GLuint_GLuint] = packed_call_void_GLuint_GLuint,
+    [FORMAT_void_GLuint_GLuint_const_GLchar___GENPT__] = packed_call_void_GLuint_GLuint_const_GLchar___GENPT__,
+    [FORMAT_void_GLenum_GLuint] = packed_call_void_GLenum_GLuint,
+    [FORMAT_void_GLclampf_GLclampf_GLclampf_GLclampf] = packed_call_void_GLclampf_GLclampf_GLclampf_GLclampf,
+    [FORMAT_void_GLenum_GLenum] = packed_call_void_GLenum_GLenum,
+    [FORMAT_void_GLenum_GLenum_GLenum_GLenum] = packed_call_void_GLenum_GLenum_GLenum_GLenum,
+    [FORMAT_void_GLenum_GLsizeiptr_const_GLvoid___GENPT___GLenum] = packed_call_void_GLenum_GLsizeiptr_const_GLvoid___GENPT___GLenum,
+    [FORMAT_void_GLenum_GLintptr_GLsizeiptr_const_GLvoid___GENPT__] = packed_call_void_GLenum_GLintptr_GLsizeiptr_const_GLvoid___GENPT__,
+    [FORMAT_GLenum_GLenum] = packed_call_GLenum_GLenum,
+    [FORMAT_void_GLbitfield] = packed_call_void_GLbitfield,
+    [FORMAT_void_GLclampx_GLclampx_GLclampx_GLclampx] = packed_call_void_GLclampx_GLclampx_GLclampx_GLclampx,
+    [FORMAT_void_GLclampf] = packed_call_void_GLclampf,
+    [FORMAT_void_GLclampx] = packed_call_void_GLclampx,
+    [FORMAT_void_GLint] = packed_call_void_GLint,
+    [FORMAT_void_GLenum_const_GLfloat___GENPT__] = packed_call_void_GLenum_const_GLfloat___GENPT__,
+    [FORMAT_void_GLenum_const_GLfixed___GENPT__] = packed_call_void_GLenum_const_GLfixed___GENPT__,
+    [FORMAT_void_GLfloat_GLfloat_GLfloat_GLfloat] = packed_call_void_GLfloat_GLfloat_GLfloat_GLfloat,
+    [FORMAT_void_GLubyte_GLubyte_GLubyte_GLubyte] = packed_call_void_GLubyte_GLubyte_GLubyte_GLubyte,
+    [FORMAT_void_GLfixed_GLfixed_GLfixed_GLfixed] = packed_call_void_GLfixed_GLfixed_GLfixed_GLfixed,
+    [FORMAT_void_GLboolean_GLboolean_GLboolean_GLboolean] = packed_call_void_GLboolean_GLboolean_GLboolean_GLboolean,
+    [FORMAT_void_GLint_GLenum_GLsizei_const_GLvoid___GENPT__] = packed_call_void_GLint_GLenum_GLsizei_const_GLvoid___GENPT__,
+    [FORMAT_void_GLuint] = packed_call_void_GLuint,
+    [FORMAT_void_GLenum_GLint_GLenum_GLsizei_GLsizei_GLint_GLsizei_const_GLvoid___GENPT__] = packed_call_void_GLenum_GLint_GLenum_GLsizei_GLsizei_GLint_GLsizei_const_GLvoid___GENPT__,
+    [FORMAT_void_GLenum_GLint_GLint_GLint_GLsizei_GLsizei_GLenum_GLsizei_const_GLvoid___GENPT__] = packed_call_void_GLenum_GLint_GLint_GLint_GLsizei_GLsizei_GLenum_GLsizei_const_GLvoid___GENPT__,
+    [FORMAT_void_GLenum_GLint_GLenum_GLint_GLint_GLsizei_GLsizei_GLint] = packed_call_void_GLenum_GLint_GLenum_GLint_GLint_GLsizei_GLsizei_GLint,
+    [FORMAT_void_GLenum_GLint_GLint_GLint_GLint_GLint_GLsizei_GLsizei] = packed_call_void_GLenum_GLint_GLint_GLint_GLint_GLint_GLsizei_GLsizei,
+    [FORMAT_GLuint] = packed_call_GLuint,
+    [FORMAT_GLuint_GLenum] = packed_call_GLuint_GLenum,
+    [FORMAT_void_GLsizei_const_GLuint___GENPT__] = packed_call_void_GLsizei_const_GLuint___GENPT__,
+    [FORMAT_void_GLsizei_GLuint___GENPT__] = packed_call_void_GLsizei_GLuint___GENPT__,
+    [FORMAT_void_GLboolean] = packed_call_void_GLboolean,
+    [FORMAT_void_GLclampf_GLclampf] = packed_call_void_GLclampf_GLclampf,
+    [FORMAT_void_GLclampx_GLclampx] = packed_call_void_GLclampx_GLclampx,
+    [FORMAT_void_GLenum_GLint_GLsizei] = packed_call_void_GLenum_GLint_GLsizei,
+    [FORMAT_void_GLsizei_const_GLenum___GENPT__] = packed_call_void_GLsizei_const_GLenum___GENPT__,
+    [FORMAT_void_GLenum_GLsizei_GLenum_const_GLvoid___GENPT__] = packed_call_void_GLenum_GLsizei_GLenum_const_GLvoid___GENPT__,
+    [FORMAT_void_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat] = packed_call_void_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat,
+    [FORMAT_void_GLint_GLint_GLint_GLint_GLint] = packed_call_void_GLint_GLint_GLint_GLint_GLint,
+    [FORMAT_void] = packed_call_void,
+    [FORMAT_void_GLenum_GLsizei_const_GLvoid___GENPT__] = packed_call_void_GLenum_GLsizei_const_GLvoid___GENPT__,
+    [FORMAT_void_GLfloat] = packed_call_void_GLfloat,
+    [FORMAT_void_const_GLfloat___GENPT__] = packed_call_void_const_GLfloat___GENPT__,
+    [FORMAT_void_GLenum_GLfloat] = packed_call_void_GLenum_GLfloat,
+    [FORMAT_void_GLenum_GLfixed] = packed_call_void_GLenum_GLfixed,
+    [FORMAT_void_GLenum_GLenum_GLenum_GLuint] = packed_call_void_GLenum_GLenum_GLenum_GLuint,
+    [FORMAT_void_GLenum_GLenum_GLenum_GLuint_GLint] = packed_call_void_GLenum_GLenum_GLenum_GLuint_GLint,
+    [FORMAT_void_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat] = packed_call_void_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat,
+    [FORMAT_void_GLfixed_GLfixed_GLfixed_GLfixed_GLfixed_GLfixed] = packed_call_void_GLfixed_GLfixed_GLfixed_GLfixed_GLfixed_GLfixed,
+    [FORMAT_void_GLuint_GLuint_GLsizei_GLsizei___GENPT___GLint___GENPT___GLenum___GENPT___GLchar___GENPT__] = packed_call_void_GLuint_GLuint_GLsizei_GLsizei___GENPT___GLint___GENPT___GLenum___GENPT___GLchar___GENPT__,
+    [FORMAT_void_GLuint_GLsizei_GLsizei___GENPT___GLuint___GENPT__] = packed_call_void_GLuint_GLsizei_GLsizei___GENPT___GLuint___GENPT__,
+    [FORMAT_GLint_GLuint_const_GLchar___GENPT__] = packed_call_GLint_GLuint_const_GLchar___GENPT__,
+    [FORMAT_void_GLenum_GLboolean___GENPT__] = packed_call_void_GLenum_GLboolean___GENPT__,
+    [FORMAT_void_GLenum_GLenum_GLint___GENPT__] = packed_call_void_GLenum_GLenum_GLint___GENPT__,
+    [FORMAT_void_GLenum_GLfloat___GENPT__] = packed_call_void_GLenum_GLfloat___GENPT__,
+    [FORMAT_void_GLenum_GLfixed___GENPT__] = packed_call_void_GLenum_GLfixed___GENPT__,
+    [FORMAT_GLenum] = packed_call_GLenum,
+    [FORMAT_void_GLenum_GLenum_GLenum_GLint___GENPT__] = packed_call_void_GLenum_GLenum_GLenum_GLint___GENPT__,
+    [FORMAT_void_GLenum_GLint___GENPT__] = packed_call_void_GLenum_GLint___GENPT__,
+    [FORMAT_void_GLenum_GLenum_GLfloat___GENPT__] = packed_call_void_GLenum_GLenum_GLfloat___GENPT__,
+    [FORMAT_void_GLenum_GLenum_GLfixed___GENPT__] = packed_call_void_GLenum_GLenum_GLfixed___GENPT__,
+    [FORMAT_void_GLenum_GLvoid___GENPT____GENPT__] = packed_call_void_GLenum_GLvoid___GENPT____GENPT__,
+    [FORMAT_void_GLuint_GLsizei_GLsizei___GENPT___GLenum___GENPT___GLvoid___GENPT__] = packed_call_void_GLuint_GLsizei_GLsizei___GENPT___GLenum___GENPT___GLvoid___GENPT__,
+    [FORMAT_void_GLuint_GLsizei_GLsizei___GENPT___GLchar___GENPT__] = packed_call_void_GLuint_GLsizei_GLsizei___GENPT___GLchar___GENPT__,
+    [FORMAT_void_GLuint_GLenum_GLint___GENPT__] = packed_call_void_GLuint_GLenum_GLint___GENPT__,
+    [FORMAT_void_GLenum_GLenum_GLint___GENPT___GLint___GENPT__] = packed_call_void_GLenum_GLenum_GLint___GENPT___GLint___GENPT__,
+    [FORMAT_const_GLubyte___GENPT___GLenum] = packed_call_const_GLubyte___GENPT___GLenum,
+    [FORMAT_void_GLuint_GLint_GLfloat___GENPT__] = packed_call_void_GLuint_GLint_GLfloat___GENPT__,
+    [FORMAT_void_GLuint_GLint_GLint___GENPT__] = packed_call_void_GLuint_GLint_GLint___GENPT__,
+    [FORMAT_void_GLuint_GLenum_GLvoid___GENPT____GENPT__] = packed_call_void_GLuint_GLenum_GLvoid___GENPT____GENPT__,
+    [FORMAT_void_GLuint_GLenum_GLfloat___GENPT__] = packed_call_void_GLuint_GLenum_GLfloat___GENPT__,
+    [FORMAT_GLboolean_GLuint] = packed_call_GLboolean_GLuint,
+    [FORMAT_GLboolean_GLenum] = packed_call_GLboolean_GLenum,
+    [FORMAT_void_GLenum_GLenum_GLfloat] = packed_call_void_GLenum_GLenum_GLfloat,
+    [FORMAT_void_GLenum_GLenum_const_GLfloat___GENPT__] = packed_call_void_GLenum_GLenum_const_GLfloat___GENPT__,
+    [FORMAT_void_GLenum_GLenum_GLfixed] = packed_call_void_GLenum_GLenum_GLfixed,
+    [FORMAT_void_GLenum_GLenum_const_GLfixed___GENPT__] = packed_call_void_GLenum_GLenum_const_GLfixed___GENPT__,
+    [FORMAT_void_GLfixed] = packed_call_void_GLfixed,
+    [FORMAT_void_const_GLfixed___GENPT__] = packed_call_void_const_GLfixed___GENPT__,
+    [FORMAT_void_GLenum_const_GLint___GENPT___const_GLsizei___GENPT___GLsizei] = packed_call_void_GLenum_const_GLint___GENPT___const_GLsizei___GENPT___GLsizei,
+    [FORMAT_void_GLenum_GLsizei___GENPT___GLenum_const_void___GENPT___const___GENPT___GLsizei] = packed_call_void_GLenum_GLsizei___GENPT___GLenum_const_void___GENPT___const___GENPT___GLsizei,
+    [FORMAT_void_GLenum_GLfloat_GLfloat_GLfloat_GLfloat] = packed_call_void_GLenum_GLfloat_GLfloat_GLfloat_GLfloat,
+    [FORMAT_void_GLenum_GLfixed_GLfixed_GLfixed_GLfixed] = packed_call_void_GLenum_GLfixed_GLfixed_GLfixed_GLfixed,
+    [FORMAT_void_GLfloat_GLfloat_GLfloat] = packed_call_void_GLfloat_GLfloat_GLfloat,
+    [FORMAT_void_GLfixed_GLfixed_GLfixed] = packed_call_void_GLfixed_GLfixed_GLfixed,
+    [FORMAT_void_GLenum_GLint] = packed_call_void_GLenum_GLint,
+    [FORMAT_void_GLfloat_GLfloat] = packed_call_void_GLfloat_GLfloat,
+    [FORMAT_void_GLfixed_GLfixed] = packed_call_void_GLfixed_GLfixed,
+    [FORMAT_void_GLuint_GLenum_const_GLvoid___GENPT___GLint] = packed_call_void_GLuint_GLenum_const_GLvoid___GENPT___GLint,
+    [FORMAT_void_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum_GLvoid___GENPT__] = packed_call_void_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum_GLvoid___GENPT__,
+    [FORMAT_void_GLenum_GLenum_GLsizei_GLsizei] = packed_call_void_GLenum_GLenum_GLsizei_GLsizei,
+    [FORMAT_void_GLclampf_GLboolean] = packed_call_void_GLclampf_GLboolean,
+    [FORMAT_void_GLclampx_GLboolean] = packed_call_void_GLclampx_GLboolean,
+    [FORMAT_void_GLint_GLint_GLsizei_GLsizei] = packed_call_void_GLint_GLint_GLsizei_GLsizei,
+    [FORMAT_void_GLsizei_const_GLuint___GENPT___GLenum_const_GLvoid___GENPT___GLsizei] = packed_call_void_GLsizei_const_GLuint___GENPT___GLenum_const_GLvoid___GENPT___GLsizei,
+    [FORMAT_void_GLuint_GLsizei_const_GLchar___GENPT___const___GENPT___const_GLint___GENPT__] = packed_call_void_GLuint_GLsizei_const_GLchar___GENPT___const___GENPT___const_GLint___GENPT__,
+    [FORMAT_void_GLenum_GLint_GLuint] = packed_call_void_GLenum_GLint_GLuint,
+    [FORMAT_void_GLenum_GLenum_GLint_GLuint] = packed_call_void_GLenum_GLenum_GLint_GLuint,
+    [FORMAT_void_GLenum_GLenum_GLenum] = packed_call_void_GLenum_GLenum_GLenum,
+    [FORMAT_void_GLenum_GLenum_GLint] = packed_call_void_GLenum_GLenum_GLint,
+    [FORMAT_void_GLenum_GLenum_const_GLint___GENPT__] = packed_call_void_GLenum_GLenum_const_GLint___GENPT__,
+    [FORMAT_void_GLenum_GLint_GLint_GLsizei_GLsizei_GLint_GLenum_GLenum_const_GLvoid___GENPT__] = packed_call_void_GLenum_GLint_GLint_GLsizei_GLsizei_GLint_GLenum_GLenum_const_GLvoid___GENPT__,
+    [FORMAT_void_GLenum_GLint_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum_const_GLvoid___GENPT__] = packed_call_void_GLenum_GLint_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum_const_GLvoid___GENPT__,
+    [FORMAT_void_GLint_GLfloat] = packed_call_void_GLint_GLfloat,
+    [FORMAT_void_GLint_GLsizei_const_GLfloat___GENPT__] = packed_call_void_GLint_GLsizei_const_GLfloat___GENPT__,
+    [FORMAT_void_GLint_GLint] = packed_call_void_GLint_GLint,
+    [FORMAT_void_GLint_GLsizei_const_GLint___GENPT__] = packed_call_void_GLint_GLsizei_const_GLint___GENPT__,
+    [FORMAT_void_GLint_GLfloat_GLfloat] = packed_call_void_GLint_GLfloat_GLfloat,
+    [FORMAT_void_GLint_GLint_GLint] = packed_call_void_GLint_GLint_GLint,
+    [FORMAT_void_GLint_GLfloat_GLfloat_GLfloat] = packed_call_void_GLint_GLfloat_GLfloat_GLfloat,
+    [FORMAT_void_GLint_GLint_GLint_GLint] = packed_call_void_GLint_GLint_GLint_GLint,
+    [FORMAT_void_GLint_GLfloat_GLfloat_GLfloat_GLfloat] = packed_call_void_GLint_GLfloat_GLfloat_GLfloat_GLfloat,
+    [FORMAT_void_GLint_GLsizei_GLboolean_const_GLfloat___GENPT__] = packed_call_void_GLint_GLsizei_GLboolean_const_GLfloat___GENPT__,
+    [FORMAT_void_GLuint_GLfloat] = packed_call_void_GLuint_GLfloat,
+    [FORMAT_void_GLuint_const_GLfloat___GENPT__] = packed_call_void_GLuint_const_GLfloat___GENPT__,
+    [FORMAT_void_GLuint_GLfloat_GLfloat] = packed_call_void_GLuint_GLfloat_GLfloat,
+    [FORMAT_void_GLuint_GLfloat_GLfloat_GLfloat] = packed_call_void_GLuint_GLfloat_GLfloat_GLfloat,
+    [FORMAT_void_GLuint_GLfloat_GLfloat_GLfloat_GLfloat] = packed_call_void_GLuint_GLfloat_GLfloat_GLfloat_GLfloat,
+    [FORMAT_void_GLuint_GLint_GLenum_GLboolean_GLsizei_const_GLvoid___GENPT__] = packed_call_void_GLuint_GLint_GLenum_GLboolean_GLsizei_const_GLvoid___GENPT__,
+};
+
+packed_call_func_t APIENTRY_GL4ES glPackedCallFunc(int format) {
+    return packed_call_table[format];
+}
 void APIENTRY_GL4ES glPackedCall(const packed_call_t *packed) {
-    switch (packed->format) {
-        case FORMAT_void_GLenum: {
-            PACKED_void_GLenum *unpacked = (PACKED_void_GLenum *)packed;
-            ARGS_void_GLenum args = unpacked->args;
-            unpacked->func(args.a1);
-            break;
-        }
-        case FORMAT_void_GLenum_GLclampf: {
-            PACKED_void_GLenum_GLclampf *unpacked = (PACKED_void_GLenum_GLclampf *)packed;
-            ARGS_void_GLenum_GLclampf args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLenum_GLclampx: {
-            PACKED_void_GLenum_GLclampx *unpacked = (PACKED_void_GLenum_GLclampx *)packed;
-            ARGS_void_GLenum_GLclampx args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLuint_GLuint: {
-            PACKED_void_GLuint_GLuint *unpacked = (PACKED_void_GLuint_GLuint *)packed;
-            ARGS_void_GLuint_GLuint args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLuint_GLuint_const_GLchar___GENPT__: {
-            PACKED_void_GLuint_GLuint_const_GLchar___GENPT__ *unpacked = (PACKED_void_GLuint_GLuint_const_GLchar___GENPT__ *)packed;
-            ARGS_void_GLuint_GLuint_const_GLchar___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_void_GLenum_GLuint: {
-            PACKED_void_GLenum_GLuint *unpacked = (PACKED_void_GLenum_GLuint *)packed;
-            ARGS_void_GLenum_GLuint args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLclampf_GLclampf_GLclampf_GLclampf: {
-            PACKED_void_GLclampf_GLclampf_GLclampf_GLclampf *unpacked = (PACKED_void_GLclampf_GLclampf_GLclampf_GLclampf *)packed;
-            ARGS_void_GLclampf_GLclampf_GLclampf_GLclampf args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_void_GLenum_GLenum: {
-            PACKED_void_GLenum_GLenum *unpacked = (PACKED_void_GLenum_GLenum *)packed;
-            ARGS_void_GLenum_GLenum args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLenum_GLenum_GLenum_GLenum: {
-            PACKED_void_GLenum_GLenum_GLenum_GLenum *unpacked = (PACKED_void_GLenum_GLenum_GLenum_GLenum *)packed;
-            ARGS_void_GLenum_GLenum_GLenum_GLenum args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_void_GLenum_GLsizeiptr_const_GLvoid___GENPT___GLenum: {
-            PACKED_void_GLenum_GLsizeiptr_const_GLvoid___GENPT___GLenum *unpacked = (PACKED_void_GLenum_GLsizeiptr_const_GLvoid___GENPT___GLenum *)packed;
-            ARGS_void_GLenum_GLsizeiptr_const_GLvoid___GENPT___GLenum args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_void_GLenum_GLintptr_GLsizeiptr_const_GLvoid___GENPT__: {
-            PACKED_void_GLenum_GLintptr_GLsizeiptr_const_GLvoid___GENPT__ *unpacked = (PACKED_void_GLenum_GLintptr_GLsizeiptr_const_GLvoid___GENPT__ *)packed;
-            ARGS_void_GLenum_GLintptr_GLsizeiptr_const_GLvoid___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_GLenum_GLenum: {
-            PACKED_GLenum_GLenum *unpacked = (PACKED_GLenum_GLenum *)packed;
-            ARGS_GLenum_GLenum args = unpacked->args;
-            unpacked->func(args.a1);
-            break;
-        }
-        case FORMAT_void_GLbitfield: {
-            PACKED_void_GLbitfield *unpacked = (PACKED_void_GLbitfield *)packed;
-            ARGS_void_GLbitfield args = unpacked->args;
-            unpacked->func(args.a1);
-            break;
-        }
-        case FORMAT_void_GLclampx_GLclampx_GLclampx_GLclampx: {
-            PACKED_void_GLclampx_GLclampx_GLclampx_GLclampx *unpacked = (PACKED_void_GLclampx_GLclampx_GLclampx_GLclampx *)packed;
-            ARGS_void_GLclampx_GLclampx_GLclampx_GLclampx args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_void_GLclampf: {
-            PACKED_void_GLclampf *unpacked = (PACKED_void_GLclampf *)packed;
-            ARGS_void_GLclampf args = unpacked->args;
-            unpacked->func(args.a1);
-            break;
-        }
-        case FORMAT_void_GLclampx: {
-            PACKED_void_GLclampx *unpacked = (PACKED_void_GLclampx *)packed;
-            ARGS_void_GLclampx args = unpacked->args;
-            unpacked->func(args.a1);
-            break;
-        }
-        case FORMAT_void_GLint: {
-            PACKED_void_GLint *unpacked = (PACKED_void_GLint *)packed;
-            ARGS_void_GLint args = unpacked->args;
-            unpacked->func(args.a1);
-            break;
-        }
-        case FORMAT_void_GLenum_const_GLfloat___GENPT__: {
-            PACKED_void_GLenum_const_GLfloat___GENPT__ *unpacked = (PACKED_void_GLenum_const_GLfloat___GENPT__ *)packed;
-            ARGS_void_GLenum_const_GLfloat___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLenum_const_GLfixed___GENPT__: {
-            PACKED_void_GLenum_const_GLfixed___GENPT__ *unpacked = (PACKED_void_GLenum_const_GLfixed___GENPT__ *)packed;
-            ARGS_void_GLenum_const_GLfixed___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLfloat_GLfloat_GLfloat_GLfloat: {
-            PACKED_void_GLfloat_GLfloat_GLfloat_GLfloat *unpacked = (PACKED_void_GLfloat_GLfloat_GLfloat_GLfloat *)packed;
-            ARGS_void_GLfloat_GLfloat_GLfloat_GLfloat args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_void_GLubyte_GLubyte_GLubyte_GLubyte: {
-            PACKED_void_GLubyte_GLubyte_GLubyte_GLubyte *unpacked = (PACKED_void_GLubyte_GLubyte_GLubyte_GLubyte *)packed;
-            ARGS_void_GLubyte_GLubyte_GLubyte_GLubyte args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_void_GLfixed_GLfixed_GLfixed_GLfixed: {
-            PACKED_void_GLfixed_GLfixed_GLfixed_GLfixed *unpacked = (PACKED_void_GLfixed_GLfixed_GLfixed_GLfixed *)packed;
-            ARGS_void_GLfixed_GLfixed_GLfixed_GLfixed args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_void_GLboolean_GLboolean_GLboolean_GLboolean: {
-            PACKED_void_GLboolean_GLboolean_GLboolean_GLboolean *unpacked = (PACKED_void_GLboolean_GLboolean_GLboolean_GLboolean *)packed;
-            ARGS_void_GLboolean_GLboolean_GLboolean_GLboolean args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_void_GLint_GLenum_GLsizei_const_GLvoid___GENPT__: {
-            PACKED_void_GLint_GLenum_GLsizei_const_GLvoid___GENPT__ *unpacked = (PACKED_void_GLint_GLenum_GLsizei_const_GLvoid___GENPT__ *)packed;
-            ARGS_void_GLint_GLenum_GLsizei_const_GLvoid___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_void_GLuint: {
-            PACKED_void_GLuint *unpacked = (PACKED_void_GLuint *)packed;
-            ARGS_void_GLuint args = unpacked->args;
-            unpacked->func(args.a1);
-            break;
-        }
-        case FORMAT_void_GLenum_GLint_GLenum_GLsizei_GLsizei_GLint_GLsizei_const_GLvoid___GENPT__: {
-            PACKED_void_GLenum_GLint_GLenum_GLsizei_GLsizei_GLint_GLsizei_const_GLvoid___GENPT__ *unpacked = (PACKED_void_GLenum_GLint_GLenum_GLsizei_GLsizei_GLint_GLsizei_const_GLvoid___GENPT__ *)packed;
-            ARGS_void_GLenum_GLint_GLenum_GLsizei_GLsizei_GLint_GLsizei_const_GLvoid___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5, args.a6, args.a7, args.a8);
-            break;
-        }
-        case FORMAT_void_GLenum_GLint_GLint_GLint_GLsizei_GLsizei_GLenum_GLsizei_const_GLvoid___GENPT__: {
-            PACKED_void_GLenum_GLint_GLint_GLint_GLsizei_GLsizei_GLenum_GLsizei_const_GLvoid___GENPT__ *unpacked = (PACKED_void_GLenum_GLint_GLint_GLint_GLsizei_GLsizei_GLenum_GLsizei_const_GLvoid___GENPT__ *)packed;
-            ARGS_void_GLenum_GLint_GLint_GLint_GLsizei_GLsizei_GLenum_GLsizei_const_GLvoid___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5, args.a6, args.a7, args.a8, args.a9);
-            break;
-        }
-        case FORMAT_void_GLenum_GLint_GLenum_GLint_GLint_GLsizei_GLsizei_GLint: {
-            PACKED_void_GLenum_GLint_GLenum_GLint_GLint_GLsizei_GLsizei_GLint *unpacked = (PACKED_void_GLenum_GLint_GLenum_GLint_GLint_GLsizei_GLsizei_GLint *)packed;
-            ARGS_void_GLenum_GLint_GLenum_GLint_GLint_GLsizei_GLsizei_GLint args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5, args.a6, args.a7, args.a8);
-            break;
-        }
-        case FORMAT_void_GLenum_GLint_GLint_GLint_GLint_GLint_GLsizei_GLsizei: {
-            PACKED_void_GLenum_GLint_GLint_GLint_GLint_GLint_GLsizei_GLsizei *unpacked = (PACKED_void_GLenum_GLint_GLint_GLint_GLint_GLint_GLsizei_GLsizei *)packed;
-            ARGS_void_GLenum_GLint_GLint_GLint_GLint_GLint_GLsizei_GLsizei args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5, args.a6, args.a7, args.a8);
-            break;
-        }
-        case FORMAT_GLuint: {
-            PACKED_GLuint *unpacked = (PACKED_GLuint *)packed;
-            unpacked->func();
-            break;
-        }
-        case FORMAT_GLuint_GLenum: {
-            PACKED_GLuint_GLenum *unpacked = (PACKED_GLuint_GLenum *)packed;
-            ARGS_GLuint_GLenum args = unpacked->args;
-            unpacked->func(args.a1);
-            break;
-        }
-        case FORMAT_void_GLsizei_const_GLuint___GENPT__: {
-            PACKED_void_GLsizei_const_GLuint___GENPT__ *unpacked = (PACKED_void_GLsizei_const_GLuint___GENPT__ *)packed;
-            ARGS_void_GLsizei_const_GLuint___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLsizei_GLuint___GENPT__: {
-            PACKED_void_GLsizei_GLuint___GENPT__ *unpacked = (PACKED_void_GLsizei_GLuint___GENPT__ *)packed;
-            ARGS_void_GLsizei_GLuint___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLboolean: {
-            PACKED_void_GLboolean *unpacked = (PACKED_void_GLboolean *)packed;
-            ARGS_void_GLboolean args = unpacked->args;
-            unpacked->func(args.a1);
-            break;
-        }
-        case FORMAT_void_GLclampf_GLclampf: {
-            PACKED_void_GLclampf_GLclampf *unpacked = (PACKED_void_GLclampf_GLclampf *)packed;
-            ARGS_void_GLclampf_GLclampf args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLclampx_GLclampx: {
-            PACKED_void_GLclampx_GLclampx *unpacked = (PACKED_void_GLclampx_GLclampx *)packed;
-            ARGS_void_GLclampx_GLclampx args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLenum_GLint_GLsizei: {
-            PACKED_void_GLenum_GLint_GLsizei *unpacked = (PACKED_void_GLenum_GLint_GLsizei *)packed;
-            ARGS_void_GLenum_GLint_GLsizei args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_void_GLsizei_const_GLenum___GENPT__: {
-            PACKED_void_GLsizei_const_GLenum___GENPT__ *unpacked = (PACKED_void_GLsizei_const_GLenum___GENPT__ *)packed;
-            ARGS_void_GLsizei_const_GLenum___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLenum_GLsizei_GLenum_const_GLvoid___GENPT__: {
-            PACKED_void_GLenum_GLsizei_GLenum_const_GLvoid___GENPT__ *unpacked = (PACKED_void_GLenum_GLsizei_GLenum_const_GLvoid___GENPT__ *)packed;
-            ARGS_void_GLenum_GLsizei_GLenum_const_GLvoid___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_void_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat: {
-            PACKED_void_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat *unpacked = (PACKED_void_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat *)packed;
-            ARGS_void_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5);
-            break;
-        }
-        case FORMAT_void_GLint_GLint_GLint_GLint_GLint: {
-            PACKED_void_GLint_GLint_GLint_GLint_GLint *unpacked = (PACKED_void_GLint_GLint_GLint_GLint_GLint *)packed;
-            ARGS_void_GLint_GLint_GLint_GLint_GLint args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5);
-            break;
-        }
-        case FORMAT_void: {
-            PACKED_void *unpacked = (PACKED_void *)packed;
-            unpacked->func();
-            break;
-        }
-        case FORMAT_void_GLenum_GLsizei_const_GLvoid___GENPT__: {
-            PACKED_void_GLenum_GLsizei_const_GLvoid___GENPT__ *unpacked = (PACKED_void_GLenum_GLsizei_const_GLvoid___GENPT__ *)packed;
-            ARGS_void_GLenum_GLsizei_const_GLvoid___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_void_GLfloat: {
-            PACKED_void_GLfloat *unpacked = (PACKED_void_GLfloat *)packed;
-            ARGS_void_GLfloat args = unpacked->args;
-            unpacked->func(args.a1);
-            break;
-        }
-        case FORMAT_void_const_GLfloat___GENPT__: {
-            PACKED_void_const_GLfloat___GENPT__ *unpacked = (PACKED_void_const_GLfloat___GENPT__ *)packed;
-            ARGS_void_const_GLfloat___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1);
-            break;
-        }
-        case FORMAT_void_GLenum_GLfloat: {
-            PACKED_void_GLenum_GLfloat *unpacked = (PACKED_void_GLenum_GLfloat *)packed;
-            ARGS_void_GLenum_GLfloat args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLenum_GLfixed: {
-            PACKED_void_GLenum_GLfixed *unpacked = (PACKED_void_GLenum_GLfixed *)packed;
-            ARGS_void_GLenum_GLfixed args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLenum_GLenum_GLenum_GLuint: {
-            PACKED_void_GLenum_GLenum_GLenum_GLuint *unpacked = (PACKED_void_GLenum_GLenum_GLenum_GLuint *)packed;
-            ARGS_void_GLenum_GLenum_GLenum_GLuint args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_void_GLenum_GLenum_GLenum_GLuint_GLint: {
-            PACKED_void_GLenum_GLenum_GLenum_GLuint_GLint *unpacked = (PACKED_void_GLenum_GLenum_GLenum_GLuint_GLint *)packed;
-            ARGS_void_GLenum_GLenum_GLenum_GLuint_GLint args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5);
-            break;
-        }
-        case FORMAT_void_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat: {
-            PACKED_void_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat *unpacked = (PACKED_void_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat *)packed;
-            ARGS_void_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat_GLfloat args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5, args.a6);
-            break;
-        }
-        case FORMAT_void_GLfixed_GLfixed_GLfixed_GLfixed_GLfixed_GLfixed: {
-            PACKED_void_GLfixed_GLfixed_GLfixed_GLfixed_GLfixed_GLfixed *unpacked = (PACKED_void_GLfixed_GLfixed_GLfixed_GLfixed_GLfixed_GLfixed *)packed;
-            ARGS_void_GLfixed_GLfixed_GLfixed_GLfixed_GLfixed_GLfixed args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5, args.a6);
-            break;
-        }
-        case FORMAT_void_GLuint_GLuint_GLsizei_GLsizei___GENPT___GLint___GENPT___GLenum___GENPT___GLchar___GENPT__: {
-            PACKED_void_GLuint_GLuint_GLsizei_GLsizei___GENPT___GLint___GENPT___GLenum___GENPT___GLchar___GENPT__ *unpacked = (PACKED_void_GLuint_GLuint_GLsizei_GLsizei___GENPT___GLint___GENPT___GLenum___GENPT___GLchar___GENPT__ *)packed;
-            ARGS_void_GLuint_GLuint_GLsizei_GLsizei___GENPT___GLint___GENPT___GLenum___GENPT___GLchar___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5, args.a6, args.a7);
-            break;
-        }
-        case FORMAT_void_GLuint_GLsizei_GLsizei___GENPT___GLuint___GENPT__: {
-            PACKED_void_GLuint_GLsizei_GLsizei___GENPT___GLuint___GENPT__ *unpacked = (PACKED_void_GLuint_GLsizei_GLsizei___GENPT___GLuint___GENPT__ *)packed;
-            ARGS_void_GLuint_GLsizei_GLsizei___GENPT___GLuint___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_GLint_GLuint_const_GLchar___GENPT__: {
-            PACKED_GLint_GLuint_const_GLchar___GENPT__ *unpacked = (PACKED_GLint_GLuint_const_GLchar___GENPT__ *)packed;
-            ARGS_GLint_GLuint_const_GLchar___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLenum_GLboolean___GENPT__: {
-            PACKED_void_GLenum_GLboolean___GENPT__ *unpacked = (PACKED_void_GLenum_GLboolean___GENPT__ *)packed;
-            ARGS_void_GLenum_GLboolean___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLenum_GLenum_GLint___GENPT__: {
-            PACKED_void_GLenum_GLenum_GLint___GENPT__ *unpacked = (PACKED_void_GLenum_GLenum_GLint___GENPT__ *)packed;
-            ARGS_void_GLenum_GLenum_GLint___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_void_GLenum_GLfloat___GENPT__: {
-            PACKED_void_GLenum_GLfloat___GENPT__ *unpacked = (PACKED_void_GLenum_GLfloat___GENPT__ *)packed;
-            ARGS_void_GLenum_GLfloat___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLenum_GLfixed___GENPT__: {
-            PACKED_void_GLenum_GLfixed___GENPT__ *unpacked = (PACKED_void_GLenum_GLfixed___GENPT__ *)packed;
-            ARGS_void_GLenum_GLfixed___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_GLenum: {
-            PACKED_GLenum *unpacked = (PACKED_GLenum *)packed;
-            unpacked->func();
-            break;
-        }
-        case FORMAT_void_GLenum_GLenum_GLenum_GLint___GENPT__: {
-            PACKED_void_GLenum_GLenum_GLenum_GLint___GENPT__ *unpacked = (PACKED_void_GLenum_GLenum_GLenum_GLint___GENPT__ *)packed;
-            ARGS_void_GLenum_GLenum_GLenum_GLint___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_void_GLenum_GLint___GENPT__: {
-            PACKED_void_GLenum_GLint___GENPT__ *unpacked = (PACKED_void_GLenum_GLint___GENPT__ *)packed;
-            ARGS_void_GLenum_GLint___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLenum_GLenum_GLfloat___GENPT__: {
-            PACKED_void_GLenum_GLenum_GLfloat___GENPT__ *unpacked = (PACKED_void_GLenum_GLenum_GLfloat___GENPT__ *)packed;
-            ARGS_void_GLenum_GLenum_GLfloat___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_void_GLenum_GLenum_GLfixed___GENPT__: {
-            PACKED_void_GLenum_GLenum_GLfixed___GENPT__ *unpacked = (PACKED_void_GLenum_GLenum_GLfixed___GENPT__ *)packed;
-            ARGS_void_GLenum_GLenum_GLfixed___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_void_GLenum_GLvoid___GENPT____GENPT__: {
-            PACKED_void_GLenum_GLvoid___GENPT____GENPT__ *unpacked = (PACKED_void_GLenum_GLvoid___GENPT____GENPT__ *)packed;
-            ARGS_void_GLenum_GLvoid___GENPT____GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLuint_GLsizei_GLsizei___GENPT___GLenum___GENPT___GLvoid___GENPT__: {
-            PACKED_void_GLuint_GLsizei_GLsizei___GENPT___GLenum___GENPT___GLvoid___GENPT__ *unpacked = (PACKED_void_GLuint_GLsizei_GLsizei___GENPT___GLenum___GENPT___GLvoid___GENPT__ *)packed;
-            ARGS_void_GLuint_GLsizei_GLsizei___GENPT___GLenum___GENPT___GLvoid___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5);
-            break;
-        }
-        case FORMAT_void_GLuint_GLsizei_GLsizei___GENPT___GLchar___GENPT__: {
-            PACKED_void_GLuint_GLsizei_GLsizei___GENPT___GLchar___GENPT__ *unpacked = (PACKED_void_GLuint_GLsizei_GLsizei___GENPT___GLchar___GENPT__ *)packed;
-            ARGS_void_GLuint_GLsizei_GLsizei___GENPT___GLchar___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_void_GLuint_GLenum_GLint___GENPT__: {
-            PACKED_void_GLuint_GLenum_GLint___GENPT__ *unpacked = (PACKED_void_GLuint_GLenum_GLint___GENPT__ *)packed;
-            ARGS_void_GLuint_GLenum_GLint___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_void_GLenum_GLenum_GLint___GENPT___GLint___GENPT__: {
-            PACKED_void_GLenum_GLenum_GLint___GENPT___GLint___GENPT__ *unpacked = (PACKED_void_GLenum_GLenum_GLint___GENPT___GLint___GENPT__ *)packed;
-            ARGS_void_GLenum_GLenum_GLint___GENPT___GLint___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_const_GLubyte___GENPT___GLenum: {
-            PACKED_const_GLubyte___GENPT___GLenum *unpacked = (PACKED_const_GLubyte___GENPT___GLenum *)packed;
-            ARGS_const_GLubyte___GENPT___GLenum args = unpacked->args;
-            unpacked->func(args.a1);
-            break;
-        }
-        case FORMAT_void_GLuint_GLint_GLfloat___GENPT__: {
-            PACKED_void_GLuint_GLint_GLfloat___GENPT__ *unpacked = (PACKED_void_GLuint_GLint_GLfloat___GENPT__ *)packed;
-            ARGS_void_GLuint_GLint_GLfloat___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_void_GLuint_GLint_GLint___GENPT__: {
-            PACKED_void_GLuint_GLint_GLint___GENPT__ *unpacked = (PACKED_void_GLuint_GLint_GLint___GENPT__ *)packed;
-            ARGS_void_GLuint_GLint_GLint___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_void_GLuint_GLenum_GLvoid___GENPT____GENPT__: {
-            PACKED_void_GLuint_GLenum_GLvoid___GENPT____GENPT__ *unpacked = (PACKED_void_GLuint_GLenum_GLvoid___GENPT____GENPT__ *)packed;
-            ARGS_void_GLuint_GLenum_GLvoid___GENPT____GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_void_GLuint_GLenum_GLfloat___GENPT__: {
-            PACKED_void_GLuint_GLenum_GLfloat___GENPT__ *unpacked = (PACKED_void_GLuint_GLenum_GLfloat___GENPT__ *)packed;
-            ARGS_void_GLuint_GLenum_GLfloat___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_GLboolean_GLuint: {
-            PACKED_GLboolean_GLuint *unpacked = (PACKED_GLboolean_GLuint *)packed;
-            ARGS_GLboolean_GLuint args = unpacked->args;
-            unpacked->func(args.a1);
-            break;
-        }
-        case FORMAT_GLboolean_GLenum: {
-            PACKED_GLboolean_GLenum *unpacked = (PACKED_GLboolean_GLenum *)packed;
-            ARGS_GLboolean_GLenum args = unpacked->args;
-            unpacked->func(args.a1);
-            break;
-        }
-        case FORMAT_void_GLenum_GLenum_GLfloat: {
-            PACKED_void_GLenum_GLenum_GLfloat *unpacked = (PACKED_void_GLenum_GLenum_GLfloat *)packed;
-            ARGS_void_GLenum_GLenum_GLfloat args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_void_GLenum_GLenum_const_GLfloat___GENPT__: {
-            PACKED_void_GLenum_GLenum_const_GLfloat___GENPT__ *unpacked = (PACKED_void_GLenum_GLenum_const_GLfloat___GENPT__ *)packed;
-            ARGS_void_GLenum_GLenum_const_GLfloat___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_void_GLenum_GLenum_GLfixed: {
-            PACKED_void_GLenum_GLenum_GLfixed *unpacked = (PACKED_void_GLenum_GLenum_GLfixed *)packed;
-            ARGS_void_GLenum_GLenum_GLfixed args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_void_GLenum_GLenum_const_GLfixed___GENPT__: {
-            PACKED_void_GLenum_GLenum_const_GLfixed___GENPT__ *unpacked = (PACKED_void_GLenum_GLenum_const_GLfixed___GENPT__ *)packed;
-            ARGS_void_GLenum_GLenum_const_GLfixed___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_void_GLfixed: {
-            PACKED_void_GLfixed *unpacked = (PACKED_void_GLfixed *)packed;
-            ARGS_void_GLfixed args = unpacked->args;
-            unpacked->func(args.a1);
-            break;
-        }
-        case FORMAT_void_const_GLfixed___GENPT__: {
-            PACKED_void_const_GLfixed___GENPT__ *unpacked = (PACKED_void_const_GLfixed___GENPT__ *)packed;
-            ARGS_void_const_GLfixed___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1);
-            break;
-        }
-        case FORMAT_void_GLenum_const_GLint___GENPT___const_GLsizei___GENPT___GLsizei: {
-            PACKED_void_GLenum_const_GLint___GENPT___const_GLsizei___GENPT___GLsizei *unpacked = (PACKED_void_GLenum_const_GLint___GENPT___const_GLsizei___GENPT___GLsizei *)packed;
-            ARGS_void_GLenum_const_GLint___GENPT___const_GLsizei___GENPT___GLsizei args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_void_GLenum_GLsizei___GENPT___GLenum_const_void___GENPT___const___GENPT___GLsizei: {
-            PACKED_void_GLenum_GLsizei___GENPT___GLenum_const_void___GENPT___const___GENPT___GLsizei *unpacked = (PACKED_void_GLenum_GLsizei___GENPT___GLenum_const_void___GENPT___const___GENPT___GLsizei *)packed;
-            ARGS_void_GLenum_GLsizei___GENPT___GLenum_const_void___GENPT___const___GENPT___GLsizei args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5);
-            break;
-        }
-        case FORMAT_void_GLenum_GLfloat_GLfloat_GLfloat_GLfloat: {
-            PACKED_void_GLenum_GLfloat_GLfloat_GLfloat_GLfloat *unpacked = (PACKED_void_GLenum_GLfloat_GLfloat_GLfloat_GLfloat *)packed;
-            ARGS_void_GLenum_GLfloat_GLfloat_GLfloat_GLfloat args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5);
-            break;
-        }
-        case FORMAT_void_GLenum_GLfixed_GLfixed_GLfixed_GLfixed: {
-            PACKED_void_GLenum_GLfixed_GLfixed_GLfixed_GLfixed *unpacked = (PACKED_void_GLenum_GLfixed_GLfixed_GLfixed_GLfixed *)packed;
-            ARGS_void_GLenum_GLfixed_GLfixed_GLfixed_GLfixed args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5);
-            break;
-        }
-        case FORMAT_void_GLfloat_GLfloat_GLfloat: {
-            PACKED_void_GLfloat_GLfloat_GLfloat *unpacked = (PACKED_void_GLfloat_GLfloat_GLfloat *)packed;
-            ARGS_void_GLfloat_GLfloat_GLfloat args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_void_GLfixed_GLfixed_GLfixed: {
-            PACKED_void_GLfixed_GLfixed_GLfixed *unpacked = (PACKED_void_GLfixed_GLfixed_GLfixed *)packed;
-            ARGS_void_GLfixed_GLfixed_GLfixed args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_void_GLenum_GLint: {
-            PACKED_void_GLenum_GLint *unpacked = (PACKED_void_GLenum_GLint *)packed;
-            ARGS_void_GLenum_GLint args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLfloat_GLfloat: {
-            PACKED_void_GLfloat_GLfloat *unpacked = (PACKED_void_GLfloat_GLfloat *)packed;
-            ARGS_void_GLfloat_GLfloat args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLfixed_GLfixed: {
-            PACKED_void_GLfixed_GLfixed *unpacked = (PACKED_void_GLfixed_GLfixed *)packed;
-            ARGS_void_GLfixed_GLfixed args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLuint_GLenum_const_GLvoid___GENPT___GLint: {
-            PACKED_void_GLuint_GLenum_const_GLvoid___GENPT___GLint *unpacked = (PACKED_void_GLuint_GLenum_const_GLvoid___GENPT___GLint *)packed;
-            ARGS_void_GLuint_GLenum_const_GLvoid___GENPT___GLint args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_void_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum_GLvoid___GENPT__: {
-            PACKED_void_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum_GLvoid___GENPT__ *unpacked = (PACKED_void_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum_GLvoid___GENPT__ *)packed;
-            ARGS_void_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum_GLvoid___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5, args.a6, args.a7);
-            break;
-        }
-        case FORMAT_void_GLenum_GLenum_GLsizei_GLsizei: {
-            PACKED_void_GLenum_GLenum_GLsizei_GLsizei *unpacked = (PACKED_void_GLenum_GLenum_GLsizei_GLsizei *)packed;
-            ARGS_void_GLenum_GLenum_GLsizei_GLsizei args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_void_GLclampf_GLboolean: {
-            PACKED_void_GLclampf_GLboolean *unpacked = (PACKED_void_GLclampf_GLboolean *)packed;
-            ARGS_void_GLclampf_GLboolean args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLclampx_GLboolean: {
-            PACKED_void_GLclampx_GLboolean *unpacked = (PACKED_void_GLclampx_GLboolean *)packed;
-            ARGS_void_GLclampx_GLboolean args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLint_GLint_GLsizei_GLsizei: {
-            PACKED_void_GLint_GLint_GLsizei_GLsizei *unpacked = (PACKED_void_GLint_GLint_GLsizei_GLsizei *)packed;
-            ARGS_void_GLint_GLint_GLsizei_GLsizei args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_void_GLsizei_const_GLuint___GENPT___GLenum_const_GLvoid___GENPT___GLsizei: {
-            PACKED_void_GLsizei_const_GLuint___GENPT___GLenum_const_GLvoid___GENPT___GLsizei *unpacked = (PACKED_void_GLsizei_const_GLuint___GENPT___GLenum_const_GLvoid___GENPT___GLsizei *)packed;
-            ARGS_void_GLsizei_const_GLuint___GENPT___GLenum_const_GLvoid___GENPT___GLsizei args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5);
-            break;
-        }
-        case FORMAT_void_GLuint_GLsizei_const_GLchar___GENPT___const___GENPT___const_GLint___GENPT__: {
-            PACKED_void_GLuint_GLsizei_const_GLchar___GENPT___const___GENPT___const_GLint___GENPT__ *unpacked = (PACKED_void_GLuint_GLsizei_const_GLchar___GENPT___const___GENPT___const_GLint___GENPT__ *)packed;
-            ARGS_void_GLuint_GLsizei_const_GLchar___GENPT___const___GENPT___const_GLint___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_void_GLenum_GLint_GLuint: {
-            PACKED_void_GLenum_GLint_GLuint *unpacked = (PACKED_void_GLenum_GLint_GLuint *)packed;
-            ARGS_void_GLenum_GLint_GLuint args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_void_GLenum_GLenum_GLint_GLuint: {
-            PACKED_void_GLenum_GLenum_GLint_GLuint *unpacked = (PACKED_void_GLenum_GLenum_GLint_GLuint *)packed;
-            ARGS_void_GLenum_GLenum_GLint_GLuint args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_void_GLenum_GLenum_GLenum: {
-            PACKED_void_GLenum_GLenum_GLenum *unpacked = (PACKED_void_GLenum_GLenum_GLenum *)packed;
-            ARGS_void_GLenum_GLenum_GLenum args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_void_GLenum_GLenum_GLint: {
-            PACKED_void_GLenum_GLenum_GLint *unpacked = (PACKED_void_GLenum_GLenum_GLint *)packed;
-            ARGS_void_GLenum_GLenum_GLint args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_void_GLenum_GLenum_const_GLint___GENPT__: {
-            PACKED_void_GLenum_GLenum_const_GLint___GENPT__ *unpacked = (PACKED_void_GLenum_GLenum_const_GLint___GENPT__ *)packed;
-            ARGS_void_GLenum_GLenum_const_GLint___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_void_GLenum_GLint_GLint_GLsizei_GLsizei_GLint_GLenum_GLenum_const_GLvoid___GENPT__: {
-            PACKED_void_GLenum_GLint_GLint_GLsizei_GLsizei_GLint_GLenum_GLenum_const_GLvoid___GENPT__ *unpacked = (PACKED_void_GLenum_GLint_GLint_GLsizei_GLsizei_GLint_GLenum_GLenum_const_GLvoid___GENPT__ *)packed;
-            ARGS_void_GLenum_GLint_GLint_GLsizei_GLsizei_GLint_GLenum_GLenum_const_GLvoid___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5, args.a6, args.a7, args.a8, args.a9);
-            break;
-        }
-        case FORMAT_void_GLenum_GLint_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum_const_GLvoid___GENPT__: {
-            PACKED_void_GLenum_GLint_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum_const_GLvoid___GENPT__ *unpacked = (PACKED_void_GLenum_GLint_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum_const_GLvoid___GENPT__ *)packed;
-            ARGS_void_GLenum_GLint_GLint_GLint_GLsizei_GLsizei_GLenum_GLenum_const_GLvoid___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5, args.a6, args.a7, args.a8, args.a9);
-            break;
-        }
-        case FORMAT_void_GLint_GLfloat: {
-            PACKED_void_GLint_GLfloat *unpacked = (PACKED_void_GLint_GLfloat *)packed;
-            ARGS_void_GLint_GLfloat args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLint_GLsizei_const_GLfloat___GENPT__: {
-            PACKED_void_GLint_GLsizei_const_GLfloat___GENPT__ *unpacked = (PACKED_void_GLint_GLsizei_const_GLfloat___GENPT__ *)packed;
-            ARGS_void_GLint_GLsizei_const_GLfloat___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_void_GLint_GLint: {
-            PACKED_void_GLint_GLint *unpacked = (PACKED_void_GLint_GLint *)packed;
-            ARGS_void_GLint_GLint args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLint_GLsizei_const_GLint___GENPT__: {
-            PACKED_void_GLint_GLsizei_const_GLint___GENPT__ *unpacked = (PACKED_void_GLint_GLsizei_const_GLint___GENPT__ *)packed;
-            ARGS_void_GLint_GLsizei_const_GLint___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_void_GLint_GLfloat_GLfloat: {
-            PACKED_void_GLint_GLfloat_GLfloat *unpacked = (PACKED_void_GLint_GLfloat_GLfloat *)packed;
-            ARGS_void_GLint_GLfloat_GLfloat args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_void_GLint_GLint_GLint: {
-            PACKED_void_GLint_GLint_GLint *unpacked = (PACKED_void_GLint_GLint_GLint *)packed;
-            ARGS_void_GLint_GLint_GLint args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_void_GLint_GLfloat_GLfloat_GLfloat: {
-            PACKED_void_GLint_GLfloat_GLfloat_GLfloat *unpacked = (PACKED_void_GLint_GLfloat_GLfloat_GLfloat *)packed;
-            ARGS_void_GLint_GLfloat_GLfloat_GLfloat args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_void_GLint_GLint_GLint_GLint: {
-            PACKED_void_GLint_GLint_GLint_GLint *unpacked = (PACKED_void_GLint_GLint_GLint_GLint *)packed;
-            ARGS_void_GLint_GLint_GLint_GLint args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_void_GLint_GLfloat_GLfloat_GLfloat_GLfloat: {
-            PACKED_void_GLint_GLfloat_GLfloat_GLfloat_GLfloat *unpacked = (PACKED_void_GLint_GLfloat_GLfloat_GLfloat_GLfloat *)packed;
-            ARGS_void_GLint_GLfloat_GLfloat_GLfloat_GLfloat args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5);
-            break;
-        }
-        case FORMAT_void_GLint_GLsizei_GLboolean_const_GLfloat___GENPT__: {
-            PACKED_void_GLint_GLsizei_GLboolean_const_GLfloat___GENPT__ *unpacked = (PACKED_void_GLint_GLsizei_GLboolean_const_GLfloat___GENPT__ *)packed;
-            ARGS_void_GLint_GLsizei_GLboolean_const_GLfloat___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_void_GLuint_GLfloat: {
-            PACKED_void_GLuint_GLfloat *unpacked = (PACKED_void_GLuint_GLfloat *)packed;
-            ARGS_void_GLuint_GLfloat args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLuint_const_GLfloat___GENPT__: {
-            PACKED_void_GLuint_const_GLfloat___GENPT__ *unpacked = (PACKED_void_GLuint_const_GLfloat___GENPT__ *)packed;
-            ARGS_void_GLuint_const_GLfloat___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2);
-            break;
-        }
-        case FORMAT_void_GLuint_GLfloat_GLfloat: {
-            PACKED_void_GLuint_GLfloat_GLfloat *unpacked = (PACKED_void_GLuint_GLfloat_GLfloat *)packed;
-            ARGS_void_GLuint_GLfloat_GLfloat args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3);
-            break;
-        }
-        case FORMAT_void_GLuint_GLfloat_GLfloat_GLfloat: {
-            PACKED_void_GLuint_GLfloat_GLfloat_GLfloat *unpacked = (PACKED_void_GLuint_GLfloat_GLfloat_GLfloat *)packed;
-            ARGS_void_GLuint_GLfloat_GLfloat_GLfloat args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4);
-            break;
-        }
-        case FORMAT_void_GLuint_GLfloat_GLfloat_GLfloat_GLfloat: {
-            PACKED_void_GLuint_GLfloat_GLfloat_GLfloat_GLfloat *unpacked = (PACKED_void_GLuint_GLfloat_GLfloat_GLfloat_GLfloat *)packed;
-            ARGS_void_GLuint_GLfloat_GLfloat_GLfloat_GLfloat args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5);
-            break;
-        }
-        case FORMAT_void_GLuint_GLint_GLenum_GLboolean_GLsizei_const_GLvoid___GENPT__: {
-            PACKED_void_GLuint_GLint_GLenum_GLboolean_GLsizei_const_GLvoid___GENPT__ *unpacked = (PACKED_void_GLuint_GLint_GLenum_GLboolean_GLsizei_const_GLvoid___GENPT__ *)packed;
-            ARGS_void_GLuint_GLint_GLenum_GLboolean_GLsizei_const_GLvoid___GENPT__ args = unpacked->args;
-            unpacked->func(args.a1, args.a2, args.a3, args.a4, args.a5, args.a6);
-            break;
-        }
-    }
+    packed_call_table[packed->format](packed);
 }
 /*
 packed_call_t* glCopyPackedCall(const packed_call_t *packed) {
@@ -1968,8 +1968,11 @@ typedef struct {
     ARGS_void_GLuint_GLint_GLenum_GLboolean_GLsizei_const_GLvoid___GENPT__ args;
 } INDEXED_void_GLuint_GLint_GLenum_GLboolean_GLsizei_const_GLvoid___GENPT__;
 
-extern void APIENTRY_GL4ES glPushCall(void *data);
+typedef void (APIENTRY_GL4ES *packed_call_func_t)(const packed_call_t *packed);
+
+extern void* APIENTRY_GL4ES glAllocCall(int format, int size);
 void APIENTRY_GL4ES glPackedCall(const packed_call_t *packed);
+packed_call_func_t APIENTRY_GL4ES glPackedCallFunc(int format);
 void APIENTRY_GL4ES glIndexedCall(const indexed_call_t *packed, void *ret_v);
 packed_call_t* APIENTRY_GL4ES glCopyPackedCall(const packed_call_t *packed);
 
@@ -4159,341 +4162,309 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
 
 #ifndef direct_glActiveTexture
 #define push_glActiveTexture(texture) { \
-    glActiveTexture_PACKED *packed_data = malloc(sizeof(glActiveTexture_PACKED)); \
+    glActiveTexture_PACKED *packed_data = glAllocCall(glActiveTexture_FORMAT, sizeof(glActiveTexture_PACKED)); \
     packed_data->format = glActiveTexture_FORMAT; \
     packed_data->func = gl4es_glActiveTexture; \
     packed_data->args.a1 = (GLenum)texture; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glAlphaFunc
 #define push_glAlphaFunc(func, ref) { \
-    glAlphaFunc_PACKED *packed_data = malloc(sizeof(glAlphaFunc_PACKED)); \
+    glAlphaFunc_PACKED *packed_data = glAllocCall(glAlphaFunc_FORMAT, sizeof(glAlphaFunc_PACKED)); \
     packed_data->format = glAlphaFunc_FORMAT; \
     packed_data->func = gl4es_glAlphaFunc; \
     packed_data->args.a1 = (GLenum)func; \
     packed_data->args.a2 = (GLclampf)ref; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glAlphaFuncx
 #define push_glAlphaFuncx(func, ref) { \
-    glAlphaFuncx_PACKED *packed_data = malloc(sizeof(glAlphaFuncx_PACKED)); \
+    glAlphaFuncx_PACKED *packed_data = glAllocCall(glAlphaFuncx_FORMAT, sizeof(glAlphaFuncx_PACKED)); \
     packed_data->format = glAlphaFuncx_FORMAT; \
     packed_data->func = gl4es_glAlphaFuncx; \
     packed_data->args.a1 = (GLenum)func; \
     packed_data->args.a2 = (GLclampx)ref; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glAttachShader
 #define push_glAttachShader(program, shader) { \
-    glAttachShader_PACKED *packed_data = malloc(sizeof(glAttachShader_PACKED)); \
+    glAttachShader_PACKED *packed_data = glAllocCall(glAttachShader_FORMAT, sizeof(glAttachShader_PACKED)); \
     packed_data->format = glAttachShader_FORMAT; \
     packed_data->func = gl4es_glAttachShader; \
     packed_data->args.a1 = (GLuint)program; \
     packed_data->args.a2 = (GLuint)shader; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glBindAttribLocation
 #define push_glBindAttribLocation(program, index, name) { \
-    glBindAttribLocation_PACKED *packed_data = malloc(sizeof(glBindAttribLocation_PACKED)); \
+    glBindAttribLocation_PACKED *packed_data = glAllocCall(glBindAttribLocation_FORMAT, sizeof(glBindAttribLocation_PACKED)); \
     packed_data->format = glBindAttribLocation_FORMAT; \
     packed_data->func = gl4es_glBindAttribLocation; \
     packed_data->args.a1 = (GLuint)program; \
     packed_data->args.a2 = (GLuint)index; \
     packed_data->args.a3 = (GLchar *)name; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glBindBuffer
 #define push_glBindBuffer(target, buffer) { \
-    glBindBuffer_PACKED *packed_data = malloc(sizeof(glBindBuffer_PACKED)); \
+    glBindBuffer_PACKED *packed_data = glAllocCall(glBindBuffer_FORMAT, sizeof(glBindBuffer_PACKED)); \
     packed_data->format = glBindBuffer_FORMAT; \
     packed_data->func = gl4es_glBindBuffer; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLuint)buffer; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glBindFramebuffer
 #define push_glBindFramebuffer(target, framebuffer) { \
-    glBindFramebuffer_PACKED *packed_data = malloc(sizeof(glBindFramebuffer_PACKED)); \
+    glBindFramebuffer_PACKED *packed_data = glAllocCall(glBindFramebuffer_FORMAT, sizeof(glBindFramebuffer_PACKED)); \
     packed_data->format = glBindFramebuffer_FORMAT; \
     packed_data->func = gl4es_glBindFramebuffer; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLuint)framebuffer; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glBindRenderbuffer
 #define push_glBindRenderbuffer(target, renderbuffer) { \
-    glBindRenderbuffer_PACKED *packed_data = malloc(sizeof(glBindRenderbuffer_PACKED)); \
+    glBindRenderbuffer_PACKED *packed_data = glAllocCall(glBindRenderbuffer_FORMAT, sizeof(glBindRenderbuffer_PACKED)); \
     packed_data->format = glBindRenderbuffer_FORMAT; \
     packed_data->func = gl4es_glBindRenderbuffer; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLuint)renderbuffer; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glBindTexture
 #define push_glBindTexture(target, texture) { \
-    glBindTexture_PACKED *packed_data = malloc(sizeof(glBindTexture_PACKED)); \
+    glBindTexture_PACKED *packed_data = glAllocCall(glBindTexture_FORMAT, sizeof(glBindTexture_PACKED)); \
     packed_data->format = glBindTexture_FORMAT; \
     packed_data->func = gl4es_glBindTexture; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLuint)texture; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glBlendColor
 #define push_glBlendColor(red, green, blue, alpha) { \
-    glBlendColor_PACKED *packed_data = malloc(sizeof(glBlendColor_PACKED)); \
+    glBlendColor_PACKED *packed_data = glAllocCall(glBlendColor_FORMAT, sizeof(glBlendColor_PACKED)); \
     packed_data->format = glBlendColor_FORMAT; \
     packed_data->func = gl4es_glBlendColor; \
     packed_data->args.a1 = (GLclampf)red; \
     packed_data->args.a2 = (GLclampf)green; \
     packed_data->args.a3 = (GLclampf)blue; \
     packed_data->args.a4 = (GLclampf)alpha; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glBlendEquation
 #define push_glBlendEquation(mode) { \
-    glBlendEquation_PACKED *packed_data = malloc(sizeof(glBlendEquation_PACKED)); \
+    glBlendEquation_PACKED *packed_data = glAllocCall(glBlendEquation_FORMAT, sizeof(glBlendEquation_PACKED)); \
     packed_data->format = glBlendEquation_FORMAT; \
     packed_data->func = gl4es_glBlendEquation; \
     packed_data->args.a1 = (GLenum)mode; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glBlendEquationSeparate
 #define push_glBlendEquationSeparate(modeRGB, modeA) { \
-    glBlendEquationSeparate_PACKED *packed_data = malloc(sizeof(glBlendEquationSeparate_PACKED)); \
+    glBlendEquationSeparate_PACKED *packed_data = glAllocCall(glBlendEquationSeparate_FORMAT, sizeof(glBlendEquationSeparate_PACKED)); \
     packed_data->format = glBlendEquationSeparate_FORMAT; \
     packed_data->func = gl4es_glBlendEquationSeparate; \
     packed_data->args.a1 = (GLenum)modeRGB; \
     packed_data->args.a2 = (GLenum)modeA; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glBlendFunc
 #define push_glBlendFunc(sfactor, dfactor) { \
-    glBlendFunc_PACKED *packed_data = malloc(sizeof(glBlendFunc_PACKED)); \
+    glBlendFunc_PACKED *packed_data = glAllocCall(glBlendFunc_FORMAT, sizeof(glBlendFunc_PACKED)); \
     packed_data->format = glBlendFunc_FORMAT; \
     packed_data->func = gl4es_glBlendFunc; \
     packed_data->args.a1 = (GLenum)sfactor; \
     packed_data->args.a2 = (GLenum)dfactor; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glBlendFuncSeparate
 #define push_glBlendFuncSeparate(sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha) { \
-    glBlendFuncSeparate_PACKED *packed_data = malloc(sizeof(glBlendFuncSeparate_PACKED)); \
+    glBlendFuncSeparate_PACKED *packed_data = glAllocCall(glBlendFuncSeparate_FORMAT, sizeof(glBlendFuncSeparate_PACKED)); \
     packed_data->format = glBlendFuncSeparate_FORMAT; \
     packed_data->func = gl4es_glBlendFuncSeparate; \
     packed_data->args.a1 = (GLenum)sfactorRGB; \
     packed_data->args.a2 = (GLenum)dfactorRGB; \
     packed_data->args.a3 = (GLenum)sfactorAlpha; \
     packed_data->args.a4 = (GLenum)dfactorAlpha; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glBufferData
 #define push_glBufferData(target, size, data, usage) { \
-    glBufferData_PACKED *packed_data = malloc(sizeof(glBufferData_PACKED)); \
+    glBufferData_PACKED *packed_data = glAllocCall(glBufferData_FORMAT, sizeof(glBufferData_PACKED)); \
     packed_data->format = glBufferData_FORMAT; \
     packed_data->func = gl4es_glBufferData; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLsizeiptr)size; \
     packed_data->args.a3 = (GLvoid *)data; \
     packed_data->args.a4 = (GLenum)usage; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glBufferSubData
 #define push_glBufferSubData(target, offset, size, data) { \
-    glBufferSubData_PACKED *packed_data = malloc(sizeof(glBufferSubData_PACKED)); \
+    glBufferSubData_PACKED *packed_data = glAllocCall(glBufferSubData_FORMAT, sizeof(glBufferSubData_PACKED)); \
     packed_data->format = glBufferSubData_FORMAT; \
     packed_data->func = gl4es_glBufferSubData; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLintptr)offset; \
     packed_data->args.a3 = (GLsizeiptr)size; \
     packed_data->args.a4 = (GLvoid *)data; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glCheckFramebufferStatus
 #define push_glCheckFramebufferStatus(target) { \
-    glCheckFramebufferStatus_PACKED *packed_data = malloc(sizeof(glCheckFramebufferStatus_PACKED)); \
+    glCheckFramebufferStatus_PACKED *packed_data = glAllocCall(glCheckFramebufferStatus_FORMAT, sizeof(glCheckFramebufferStatus_PACKED)); \
     packed_data->format = glCheckFramebufferStatus_FORMAT; \
     packed_data->func = gl4es_glCheckFramebufferStatus; \
     packed_data->args.a1 = (GLenum)target; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glClear
 #define push_glClear(mask) { \
-    glClear_PACKED *packed_data = malloc(sizeof(glClear_PACKED)); \
+    glClear_PACKED *packed_data = glAllocCall(glClear_FORMAT, sizeof(glClear_PACKED)); \
     packed_data->format = glClear_FORMAT; \
     packed_data->func = gl4es_glClear; \
     packed_data->args.a1 = (GLbitfield)mask; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glClearColor
 #define push_glClearColor(red, green, blue, alpha) { \
-    glClearColor_PACKED *packed_data = malloc(sizeof(glClearColor_PACKED)); \
+    glClearColor_PACKED *packed_data = glAllocCall(glClearColor_FORMAT, sizeof(glClearColor_PACKED)); \
     packed_data->format = glClearColor_FORMAT; \
     packed_data->func = gl4es_glClearColor; \
     packed_data->args.a1 = (GLclampf)red; \
     packed_data->args.a2 = (GLclampf)green; \
     packed_data->args.a3 = (GLclampf)blue; \
     packed_data->args.a4 = (GLclampf)alpha; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glClearColorx
 #define push_glClearColorx(red, green, blue, alpha) { \
-    glClearColorx_PACKED *packed_data = malloc(sizeof(glClearColorx_PACKED)); \
+    glClearColorx_PACKED *packed_data = glAllocCall(glClearColorx_FORMAT, sizeof(glClearColorx_PACKED)); \
     packed_data->format = glClearColorx_FORMAT; \
     packed_data->func = gl4es_glClearColorx; \
     packed_data->args.a1 = (GLclampx)red; \
     packed_data->args.a2 = (GLclampx)green; \
     packed_data->args.a3 = (GLclampx)blue; \
     packed_data->args.a4 = (GLclampx)alpha; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glClearDepthf
 #define push_glClearDepthf(depth) { \
-    glClearDepthf_PACKED *packed_data = malloc(sizeof(glClearDepthf_PACKED)); \
+    glClearDepthf_PACKED *packed_data = glAllocCall(glClearDepthf_FORMAT, sizeof(glClearDepthf_PACKED)); \
     packed_data->format = glClearDepthf_FORMAT; \
     packed_data->func = gl4es_glClearDepthf; \
     packed_data->args.a1 = (GLclampf)depth; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glClearDepthx
 #define push_glClearDepthx(depth) { \
-    glClearDepthx_PACKED *packed_data = malloc(sizeof(glClearDepthx_PACKED)); \
+    glClearDepthx_PACKED *packed_data = glAllocCall(glClearDepthx_FORMAT, sizeof(glClearDepthx_PACKED)); \
     packed_data->format = glClearDepthx_FORMAT; \
     packed_data->func = gl4es_glClearDepthx; \
     packed_data->args.a1 = (GLclampx)depth; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glClearStencil
 #define push_glClearStencil(s) { \
-    glClearStencil_PACKED *packed_data = malloc(sizeof(glClearStencil_PACKED)); \
+    glClearStencil_PACKED *packed_data = glAllocCall(glClearStencil_FORMAT, sizeof(glClearStencil_PACKED)); \
     packed_data->format = glClearStencil_FORMAT; \
     packed_data->func = gl4es_glClearStencil; \
     packed_data->args.a1 = (GLint)s; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glClientActiveTexture
 #define push_glClientActiveTexture(texture) { \
-    glClientActiveTexture_PACKED *packed_data = malloc(sizeof(glClientActiveTexture_PACKED)); \
+    glClientActiveTexture_PACKED *packed_data = glAllocCall(glClientActiveTexture_FORMAT, sizeof(glClientActiveTexture_PACKED)); \
     packed_data->format = glClientActiveTexture_FORMAT; \
     packed_data->func = gl4es_glClientActiveTexture; \
     packed_data->args.a1 = (GLenum)texture; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glClipPlanef
 #define push_glClipPlanef(plane, equation) { \
-    glClipPlanef_PACKED *packed_data = malloc(sizeof(glClipPlanef_PACKED)); \
+    glClipPlanef_PACKED *packed_data = glAllocCall(glClipPlanef_FORMAT, sizeof(glClipPlanef_PACKED)); \
     packed_data->format = glClipPlanef_FORMAT; \
     packed_data->func = gl4es_glClipPlanef; \
     packed_data->args.a1 = (GLenum)plane; \
     packed_data->args.a2 = (GLfloat *)equation; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glClipPlanex
 #define push_glClipPlanex(plane, equation) { \
-    glClipPlanex_PACKED *packed_data = malloc(sizeof(glClipPlanex_PACKED)); \
+    glClipPlanex_PACKED *packed_data = glAllocCall(glClipPlanex_FORMAT, sizeof(glClipPlanex_PACKED)); \
     packed_data->format = glClipPlanex_FORMAT; \
     packed_data->func = gl4es_glClipPlanex; \
     packed_data->args.a1 = (GLenum)plane; \
     packed_data->args.a2 = (GLfixed *)equation; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glColor4f
 #define push_glColor4f(red, green, blue, alpha) { \
-    glColor4f_PACKED *packed_data = malloc(sizeof(glColor4f_PACKED)); \
+    glColor4f_PACKED *packed_data = glAllocCall(glColor4f_FORMAT, sizeof(glColor4f_PACKED)); \
     packed_data->format = glColor4f_FORMAT; \
     packed_data->func = gl4es_glColor4f; \
     packed_data->args.a1 = (GLfloat)red; \
     packed_data->args.a2 = (GLfloat)green; \
     packed_data->args.a3 = (GLfloat)blue; \
     packed_data->args.a4 = (GLfloat)alpha; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glColor4ub
 #define push_glColor4ub(red, green, blue, alpha) { \
-    glColor4ub_PACKED *packed_data = malloc(sizeof(glColor4ub_PACKED)); \
+    glColor4ub_PACKED *packed_data = glAllocCall(glColor4ub_FORMAT, sizeof(glColor4ub_PACKED)); \
     packed_data->format = glColor4ub_FORMAT; \
     packed_data->func = gl4es_glColor4ub; \
     packed_data->args.a1 = (GLubyte)red; \
     packed_data->args.a2 = (GLubyte)green; \
     packed_data->args.a3 = (GLubyte)blue; \
     packed_data->args.a4 = (GLubyte)alpha; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glColor4x
 #define push_glColor4x(red, green, blue, alpha) { \
-    glColor4x_PACKED *packed_data = malloc(sizeof(glColor4x_PACKED)); \
+    glColor4x_PACKED *packed_data = glAllocCall(glColor4x_FORMAT, sizeof(glColor4x_PACKED)); \
     packed_data->format = glColor4x_FORMAT; \
     packed_data->func = gl4es_glColor4x; \
     packed_data->args.a1 = (GLfixed)red; \
     packed_data->args.a2 = (GLfixed)green; \
     packed_data->args.a3 = (GLfixed)blue; \
     packed_data->args.a4 = (GLfixed)alpha; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glColorMask
 #define push_glColorMask(red, green, blue, alpha) { \
-    glColorMask_PACKED *packed_data = malloc(sizeof(glColorMask_PACKED)); \
+    glColorMask_PACKED *packed_data = glAllocCall(glColorMask_FORMAT, sizeof(glColorMask_PACKED)); \
     packed_data->format = glColorMask_FORMAT; \
     packed_data->func = gl4es_glColorMask; \
     packed_data->args.a1 = (GLboolean)red; \
     packed_data->args.a2 = (GLboolean)green; \
     packed_data->args.a3 = (GLboolean)blue; \
     packed_data->args.a4 = (GLboolean)alpha; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glColorPointer
 #define push_glColorPointer(size, type, stride, pointer) { \
-    glColorPointer_PACKED *packed_data = malloc(sizeof(glColorPointer_PACKED)); \
+    glColorPointer_PACKED *packed_data = glAllocCall(glColorPointer_FORMAT, sizeof(glColorPointer_PACKED)); \
     packed_data->format = glColorPointer_FORMAT; \
     packed_data->func = gl4es_glColorPointer; \
     packed_data->args.a1 = (GLint)size; \
     packed_data->args.a2 = (GLenum)type; \
     packed_data->args.a3 = (GLsizei)stride; \
     packed_data->args.a4 = (GLvoid *)pointer; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glCompileShader
 #define push_glCompileShader(shader) { \
-    glCompileShader_PACKED *packed_data = malloc(sizeof(glCompileShader_PACKED)); \
+    glCompileShader_PACKED *packed_data = glAllocCall(glCompileShader_FORMAT, sizeof(glCompileShader_PACKED)); \
     packed_data->format = glCompileShader_FORMAT; \
     packed_data->func = gl4es_glCompileShader; \
     packed_data->args.a1 = (GLuint)shader; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glCompressedTexImage2D
 #define push_glCompressedTexImage2D(target, level, internalformat, width, height, border, imageSize, data) { \
-    glCompressedTexImage2D_PACKED *packed_data = malloc(sizeof(glCompressedTexImage2D_PACKED)); \
+    glCompressedTexImage2D_PACKED *packed_data = glAllocCall(glCompressedTexImage2D_FORMAT, sizeof(glCompressedTexImage2D_PACKED)); \
     packed_data->format = glCompressedTexImage2D_FORMAT; \
     packed_data->func = gl4es_glCompressedTexImage2D; \
     packed_data->args.a1 = (GLenum)target; \
@@ -4504,12 +4475,11 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a6 = (GLint)border; \
     packed_data->args.a7 = (GLsizei)imageSize; \
     packed_data->args.a8 = (GLvoid *)data; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glCompressedTexSubImage2D
 #define push_glCompressedTexSubImage2D(target, level, xoffset, yoffset, width, height, format, imageSize, data) { \
-    glCompressedTexSubImage2D_PACKED *packed_data = malloc(sizeof(glCompressedTexSubImage2D_PACKED)); \
+    glCompressedTexSubImage2D_PACKED *packed_data = glAllocCall(glCompressedTexSubImage2D_FORMAT, sizeof(glCompressedTexSubImage2D_PACKED)); \
     packed_data->format = glCompressedTexSubImage2D_FORMAT; \
     packed_data->func = gl4es_glCompressedTexSubImage2D; \
     packed_data->args.a1 = (GLenum)target; \
@@ -4521,12 +4491,11 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a7 = (GLenum)format; \
     packed_data->args.a8 = (GLsizei)imageSize; \
     packed_data->args.a9 = (GLvoid *)data; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glCopyTexImage2D
 #define push_glCopyTexImage2D(target, level, internalformat, x, y, width, height, border) { \
-    glCopyTexImage2D_PACKED *packed_data = malloc(sizeof(glCopyTexImage2D_PACKED)); \
+    glCopyTexImage2D_PACKED *packed_data = glAllocCall(glCopyTexImage2D_FORMAT, sizeof(glCopyTexImage2D_PACKED)); \
     packed_data->format = glCopyTexImage2D_FORMAT; \
     packed_data->func = gl4es_glCopyTexImage2D; \
     packed_data->args.a1 = (GLenum)target; \
@@ -4537,12 +4506,11 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a6 = (GLsizei)width; \
     packed_data->args.a7 = (GLsizei)height; \
     packed_data->args.a8 = (GLint)border; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glCopyTexSubImage2D
 #define push_glCopyTexSubImage2D(target, level, xoffset, yoffset, x, y, width, height) { \
-    glCopyTexSubImage2D_PACKED *packed_data = malloc(sizeof(glCopyTexSubImage2D_PACKED)); \
+    glCopyTexSubImage2D_PACKED *packed_data = glAllocCall(glCopyTexSubImage2D_FORMAT, sizeof(glCopyTexSubImage2D_PACKED)); \
     packed_data->format = glCopyTexSubImage2D_FORMAT; \
     packed_data->func = gl4es_glCopyTexSubImage2D; \
     packed_data->args.a1 = (GLenum)target; \
@@ -4553,204 +4521,183 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a6 = (GLint)y; \
     packed_data->args.a7 = (GLsizei)width; \
     packed_data->args.a8 = (GLsizei)height; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glCreateProgram
 #define push_glCreateProgram() { \
-    glCreateProgram_PACKED *packed_data = malloc(sizeof(glCreateProgram_PACKED)); \
+    glCreateProgram_PACKED *packed_data = glAllocCall(glCreateProgram_FORMAT, sizeof(glCreateProgram_PACKED)); \
     packed_data->format = glCreateProgram_FORMAT; \
     packed_data->func = gl4es_glCreateProgram; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glCreateShader
 #define push_glCreateShader(type) { \
-    glCreateShader_PACKED *packed_data = malloc(sizeof(glCreateShader_PACKED)); \
+    glCreateShader_PACKED *packed_data = glAllocCall(glCreateShader_FORMAT, sizeof(glCreateShader_PACKED)); \
     packed_data->format = glCreateShader_FORMAT; \
     packed_data->func = gl4es_glCreateShader; \
     packed_data->args.a1 = (GLenum)type; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glCullFace
 #define push_glCullFace(mode) { \
-    glCullFace_PACKED *packed_data = malloc(sizeof(glCullFace_PACKED)); \
+    glCullFace_PACKED *packed_data = glAllocCall(glCullFace_FORMAT, sizeof(glCullFace_PACKED)); \
     packed_data->format = glCullFace_FORMAT; \
     packed_data->func = gl4es_glCullFace; \
     packed_data->args.a1 = (GLenum)mode; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glDeleteBuffers
 #define push_glDeleteBuffers(n, buffer) { \
-    glDeleteBuffers_PACKED *packed_data = malloc(sizeof(glDeleteBuffers_PACKED)); \
+    glDeleteBuffers_PACKED *packed_data = glAllocCall(glDeleteBuffers_FORMAT, sizeof(glDeleteBuffers_PACKED)); \
     packed_data->format = glDeleteBuffers_FORMAT; \
     packed_data->func = gl4es_glDeleteBuffers; \
     packed_data->args.a1 = (GLsizei)n; \
     packed_data->args.a2 = (GLuint *)buffer; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glDeleteFramebuffers
 #define push_glDeleteFramebuffers(n, framebuffers) { \
-    glDeleteFramebuffers_PACKED *packed_data = malloc(sizeof(glDeleteFramebuffers_PACKED)); \
+    glDeleteFramebuffers_PACKED *packed_data = glAllocCall(glDeleteFramebuffers_FORMAT, sizeof(glDeleteFramebuffers_PACKED)); \
     packed_data->format = glDeleteFramebuffers_FORMAT; \
     packed_data->func = gl4es_glDeleteFramebuffers; \
     packed_data->args.a1 = (GLsizei)n; \
     packed_data->args.a2 = (GLuint *)framebuffers; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glDeleteProgram
 #define push_glDeleteProgram(program) { \
-    glDeleteProgram_PACKED *packed_data = malloc(sizeof(glDeleteProgram_PACKED)); \
+    glDeleteProgram_PACKED *packed_data = glAllocCall(glDeleteProgram_FORMAT, sizeof(glDeleteProgram_PACKED)); \
     packed_data->format = glDeleteProgram_FORMAT; \
     packed_data->func = gl4es_glDeleteProgram; \
     packed_data->args.a1 = (GLuint)program; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glDeleteRenderbuffers
 #define push_glDeleteRenderbuffers(n, renderbuffers) { \
-    glDeleteRenderbuffers_PACKED *packed_data = malloc(sizeof(glDeleteRenderbuffers_PACKED)); \
+    glDeleteRenderbuffers_PACKED *packed_data = glAllocCall(glDeleteRenderbuffers_FORMAT, sizeof(glDeleteRenderbuffers_PACKED)); \
     packed_data->format = glDeleteRenderbuffers_FORMAT; \
     packed_data->func = gl4es_glDeleteRenderbuffers; \
     packed_data->args.a1 = (GLsizei)n; \
     packed_data->args.a2 = (GLuint *)renderbuffers; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glDeleteShader
 #define push_glDeleteShader(shader) { \
-    glDeleteShader_PACKED *packed_data = malloc(sizeof(glDeleteShader_PACKED)); \
+    glDeleteShader_PACKED *packed_data = glAllocCall(glDeleteShader_FORMAT, sizeof(glDeleteShader_PACKED)); \
     packed_data->format = glDeleteShader_FORMAT; \
     packed_data->func = gl4es_glDeleteShader; \
     packed_data->args.a1 = (GLuint)shader; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glDeleteTextures
 #define push_glDeleteTextures(n, textures) { \
-    glDeleteTextures_PACKED *packed_data = malloc(sizeof(glDeleteTextures_PACKED)); \
+    glDeleteTextures_PACKED *packed_data = glAllocCall(glDeleteTextures_FORMAT, sizeof(glDeleteTextures_PACKED)); \
     packed_data->format = glDeleteTextures_FORMAT; \
     packed_data->func = gl4es_glDeleteTextures; \
     packed_data->args.a1 = (GLsizei)n; \
     packed_data->args.a2 = (GLuint *)textures; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glDepthFunc
 #define push_glDepthFunc(func) { \
-    glDepthFunc_PACKED *packed_data = malloc(sizeof(glDepthFunc_PACKED)); \
+    glDepthFunc_PACKED *packed_data = glAllocCall(glDepthFunc_FORMAT, sizeof(glDepthFunc_PACKED)); \
     packed_data->format = glDepthFunc_FORMAT; \
     packed_data->func = gl4es_glDepthFunc; \
     packed_data->args.a1 = (GLenum)func; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glDepthMask
 #define push_glDepthMask(flag) { \
-    glDepthMask_PACKED *packed_data = malloc(sizeof(glDepthMask_PACKED)); \
+    glDepthMask_PACKED *packed_data = glAllocCall(glDepthMask_FORMAT, sizeof(glDepthMask_PACKED)); \
     packed_data->format = glDepthMask_FORMAT; \
     packed_data->func = gl4es_glDepthMask; \
     packed_data->args.a1 = (GLboolean)flag; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glDepthRangef
 #define push_glDepthRangef(Near, Far) { \
-    glDepthRangef_PACKED *packed_data = malloc(sizeof(glDepthRangef_PACKED)); \
+    glDepthRangef_PACKED *packed_data = glAllocCall(glDepthRangef_FORMAT, sizeof(glDepthRangef_PACKED)); \
     packed_data->format = glDepthRangef_FORMAT; \
     packed_data->func = gl4es_glDepthRangef; \
     packed_data->args.a1 = (GLclampf)Near; \
     packed_data->args.a2 = (GLclampf)Far; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glDepthRangex
 #define push_glDepthRangex(Near, Far) { \
-    glDepthRangex_PACKED *packed_data = malloc(sizeof(glDepthRangex_PACKED)); \
+    glDepthRangex_PACKED *packed_data = glAllocCall(glDepthRangex_FORMAT, sizeof(glDepthRangex_PACKED)); \
     packed_data->format = glDepthRangex_FORMAT; \
     packed_data->func = gl4es_glDepthRangex; \
     packed_data->args.a1 = (GLclampx)Near; \
     packed_data->args.a2 = (GLclampx)Far; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glDetachShader
 #define push_glDetachShader(program, shader) { \
-    glDetachShader_PACKED *packed_data = malloc(sizeof(glDetachShader_PACKED)); \
+    glDetachShader_PACKED *packed_data = glAllocCall(glDetachShader_FORMAT, sizeof(glDetachShader_PACKED)); \
     packed_data->format = glDetachShader_FORMAT; \
     packed_data->func = gl4es_glDetachShader; \
     packed_data->args.a1 = (GLuint)program; \
     packed_data->args.a2 = (GLuint)shader; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glDisable
 #define push_glDisable(cap) { \
-    glDisable_PACKED *packed_data = malloc(sizeof(glDisable_PACKED)); \
+    glDisable_PACKED *packed_data = glAllocCall(glDisable_FORMAT, sizeof(glDisable_PACKED)); \
     packed_data->format = glDisable_FORMAT; \
     packed_data->func = gl4es_glDisable; \
     packed_data->args.a1 = (GLenum)cap; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glDisableClientState
 #define push_glDisableClientState(array) { \
-    glDisableClientState_PACKED *packed_data = malloc(sizeof(glDisableClientState_PACKED)); \
+    glDisableClientState_PACKED *packed_data = glAllocCall(glDisableClientState_FORMAT, sizeof(glDisableClientState_PACKED)); \
     packed_data->format = glDisableClientState_FORMAT; \
     packed_data->func = gl4es_glDisableClientState; \
     packed_data->args.a1 = (GLenum)array; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glDisableVertexAttribArray
 #define push_glDisableVertexAttribArray(index) { \
-    glDisableVertexAttribArray_PACKED *packed_data = malloc(sizeof(glDisableVertexAttribArray_PACKED)); \
+    glDisableVertexAttribArray_PACKED *packed_data = glAllocCall(glDisableVertexAttribArray_FORMAT, sizeof(glDisableVertexAttribArray_PACKED)); \
     packed_data->format = glDisableVertexAttribArray_FORMAT; \
     packed_data->func = gl4es_glDisableVertexAttribArray; \
     packed_data->args.a1 = (GLuint)index; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glDrawArrays
 #define push_glDrawArrays(mode, first, count) { \
-    glDrawArrays_PACKED *packed_data = malloc(sizeof(glDrawArrays_PACKED)); \
+    glDrawArrays_PACKED *packed_data = glAllocCall(glDrawArrays_FORMAT, sizeof(glDrawArrays_PACKED)); \
     packed_data->format = glDrawArrays_FORMAT; \
     packed_data->func = gl4es_glDrawArrays; \
     packed_data->args.a1 = (GLenum)mode; \
     packed_data->args.a2 = (GLint)first; \
     packed_data->args.a3 = (GLsizei)count; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glDrawBuffers
 #define push_glDrawBuffers(n, bufs) { \
-    glDrawBuffers_PACKED *packed_data = malloc(sizeof(glDrawBuffers_PACKED)); \
+    glDrawBuffers_PACKED *packed_data = glAllocCall(glDrawBuffers_FORMAT, sizeof(glDrawBuffers_PACKED)); \
     packed_data->format = glDrawBuffers_FORMAT; \
     packed_data->func = gl4es_glDrawBuffers; \
     packed_data->args.a1 = (GLsizei)n; \
     packed_data->args.a2 = (GLenum *)bufs; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glDrawElements
 #define push_glDrawElements(mode, count, type, indices) { \
-    glDrawElements_PACKED *packed_data = malloc(sizeof(glDrawElements_PACKED)); \
+    glDrawElements_PACKED *packed_data = glAllocCall(glDrawElements_FORMAT, sizeof(glDrawElements_PACKED)); \
     packed_data->format = glDrawElements_FORMAT; \
     packed_data->func = gl4es_glDrawElements; \
     packed_data->args.a1 = (GLenum)mode; \
     packed_data->args.a2 = (GLsizei)count; \
     packed_data->args.a3 = (GLenum)type; \
     packed_data->args.a4 = (GLvoid *)indices; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glDrawTexf
 #define push_glDrawTexf(x, y, z, width, height) { \
-    glDrawTexf_PACKED *packed_data = malloc(sizeof(glDrawTexf_PACKED)); \
+    glDrawTexf_PACKED *packed_data = glAllocCall(glDrawTexf_FORMAT, sizeof(glDrawTexf_PACKED)); \
     packed_data->format = glDrawTexf_FORMAT; \
     packed_data->func = gl4es_glDrawTexf; \
     packed_data->args.a1 = (GLfloat)x; \
@@ -4758,12 +4705,11 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a3 = (GLfloat)z; \
     packed_data->args.a4 = (GLfloat)width; \
     packed_data->args.a5 = (GLfloat)height; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glDrawTexi
 #define push_glDrawTexi(x, y, z, width, height) { \
-    glDrawTexi_PACKED *packed_data = malloc(sizeof(glDrawTexi_PACKED)); \
+    glDrawTexi_PACKED *packed_data = glAllocCall(glDrawTexi_FORMAT, sizeof(glDrawTexi_PACKED)); \
     packed_data->format = glDrawTexi_FORMAT; \
     packed_data->func = gl4es_glDrawTexi; \
     packed_data->args.a1 = (GLint)x; \
@@ -4771,136 +4717,122 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a3 = (GLint)z; \
     packed_data->args.a4 = (GLint)width; \
     packed_data->args.a5 = (GLint)height; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glEnable
 #define push_glEnable(cap) { \
-    glEnable_PACKED *packed_data = malloc(sizeof(glEnable_PACKED)); \
+    glEnable_PACKED *packed_data = glAllocCall(glEnable_FORMAT, sizeof(glEnable_PACKED)); \
     packed_data->format = glEnable_FORMAT; \
     packed_data->func = gl4es_glEnable; \
     packed_data->args.a1 = (GLenum)cap; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glEnableClientState
 #define push_glEnableClientState(array) { \
-    glEnableClientState_PACKED *packed_data = malloc(sizeof(glEnableClientState_PACKED)); \
+    glEnableClientState_PACKED *packed_data = glAllocCall(glEnableClientState_FORMAT, sizeof(glEnableClientState_PACKED)); \
     packed_data->format = glEnableClientState_FORMAT; \
     packed_data->func = gl4es_glEnableClientState; \
     packed_data->args.a1 = (GLenum)array; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glEnableVertexAttribArray
 #define push_glEnableVertexAttribArray(index) { \
-    glEnableVertexAttribArray_PACKED *packed_data = malloc(sizeof(glEnableVertexAttribArray_PACKED)); \
+    glEnableVertexAttribArray_PACKED *packed_data = glAllocCall(glEnableVertexAttribArray_FORMAT, sizeof(glEnableVertexAttribArray_PACKED)); \
     packed_data->format = glEnableVertexAttribArray_FORMAT; \
     packed_data->func = gl4es_glEnableVertexAttribArray; \
     packed_data->args.a1 = (GLuint)index; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glFinish
 #define push_glFinish() { \
-    glFinish_PACKED *packed_data = malloc(sizeof(glFinish_PACKED)); \
+    glFinish_PACKED *packed_data = glAllocCall(glFinish_FORMAT, sizeof(glFinish_PACKED)); \
     packed_data->format = glFinish_FORMAT; \
     packed_data->func = gl4es_glFinish; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glFlush
 #define push_glFlush() { \
-    glFlush_PACKED *packed_data = malloc(sizeof(glFlush_PACKED)); \
+    glFlush_PACKED *packed_data = glAllocCall(glFlush_FORMAT, sizeof(glFlush_PACKED)); \
     packed_data->format = glFlush_FORMAT; \
     packed_data->func = gl4es_glFlush; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glFogCoordPointer
 #define push_glFogCoordPointer(type, stride, pointer) { \
-    glFogCoordPointer_PACKED *packed_data = malloc(sizeof(glFogCoordPointer_PACKED)); \
+    glFogCoordPointer_PACKED *packed_data = glAllocCall(glFogCoordPointer_FORMAT, sizeof(glFogCoordPointer_PACKED)); \
     packed_data->format = glFogCoordPointer_FORMAT; \
     packed_data->func = gl4es_glFogCoordPointer; \
     packed_data->args.a1 = (GLenum)type; \
     packed_data->args.a2 = (GLsizei)stride; \
     packed_data->args.a3 = (GLvoid *)pointer; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glFogCoordf
 #define push_glFogCoordf(coord) { \
-    glFogCoordf_PACKED *packed_data = malloc(sizeof(glFogCoordf_PACKED)); \
+    glFogCoordf_PACKED *packed_data = glAllocCall(glFogCoordf_FORMAT, sizeof(glFogCoordf_PACKED)); \
     packed_data->format = glFogCoordf_FORMAT; \
     packed_data->func = gl4es_glFogCoordf; \
     packed_data->args.a1 = (GLfloat)coord; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glFogCoordfv
 #define push_glFogCoordfv(coord) { \
-    glFogCoordfv_PACKED *packed_data = malloc(sizeof(glFogCoordfv_PACKED)); \
+    glFogCoordfv_PACKED *packed_data = glAllocCall(glFogCoordfv_FORMAT, sizeof(glFogCoordfv_PACKED)); \
     packed_data->format = glFogCoordfv_FORMAT; \
     packed_data->func = gl4es_glFogCoordfv; \
     packed_data->args.a1 = (GLfloat *)coord; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glFogf
 #define push_glFogf(pname, param) { \
-    glFogf_PACKED *packed_data = malloc(sizeof(glFogf_PACKED)); \
+    glFogf_PACKED *packed_data = glAllocCall(glFogf_FORMAT, sizeof(glFogf_PACKED)); \
     packed_data->format = glFogf_FORMAT; \
     packed_data->func = gl4es_glFogf; \
     packed_data->args.a1 = (GLenum)pname; \
     packed_data->args.a2 = (GLfloat)param; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glFogfv
 #define push_glFogfv(pname, params) { \
-    glFogfv_PACKED *packed_data = malloc(sizeof(glFogfv_PACKED)); \
+    glFogfv_PACKED *packed_data = glAllocCall(glFogfv_FORMAT, sizeof(glFogfv_PACKED)); \
     packed_data->format = glFogfv_FORMAT; \
     packed_data->func = gl4es_glFogfv; \
     packed_data->args.a1 = (GLenum)pname; \
     packed_data->args.a2 = (GLfloat *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glFogx
 #define push_glFogx(pname, param) { \
-    glFogx_PACKED *packed_data = malloc(sizeof(glFogx_PACKED)); \
+    glFogx_PACKED *packed_data = glAllocCall(glFogx_FORMAT, sizeof(glFogx_PACKED)); \
     packed_data->format = glFogx_FORMAT; \
     packed_data->func = gl4es_glFogx; \
     packed_data->args.a1 = (GLenum)pname; \
     packed_data->args.a2 = (GLfixed)param; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glFogxv
 #define push_glFogxv(pname, params) { \
-    glFogxv_PACKED *packed_data = malloc(sizeof(glFogxv_PACKED)); \
+    glFogxv_PACKED *packed_data = glAllocCall(glFogxv_FORMAT, sizeof(glFogxv_PACKED)); \
     packed_data->format = glFogxv_FORMAT; \
     packed_data->func = gl4es_glFogxv; \
     packed_data->args.a1 = (GLenum)pname; \
     packed_data->args.a2 = (GLfixed *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glFramebufferRenderbuffer
 #define push_glFramebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer) { \
-    glFramebufferRenderbuffer_PACKED *packed_data = malloc(sizeof(glFramebufferRenderbuffer_PACKED)); \
+    glFramebufferRenderbuffer_PACKED *packed_data = glAllocCall(glFramebufferRenderbuffer_FORMAT, sizeof(glFramebufferRenderbuffer_PACKED)); \
     packed_data->format = glFramebufferRenderbuffer_FORMAT; \
     packed_data->func = gl4es_glFramebufferRenderbuffer; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLenum)attachment; \
     packed_data->args.a3 = (GLenum)renderbuffertarget; \
     packed_data->args.a4 = (GLuint)renderbuffer; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glFramebufferTexture2D
 #define push_glFramebufferTexture2D(target, attachment, textarget, texture, level) { \
-    glFramebufferTexture2D_PACKED *packed_data = malloc(sizeof(glFramebufferTexture2D_PACKED)); \
+    glFramebufferTexture2D_PACKED *packed_data = glAllocCall(glFramebufferTexture2D_FORMAT, sizeof(glFramebufferTexture2D_PACKED)); \
     packed_data->format = glFramebufferTexture2D_FORMAT; \
     packed_data->func = gl4es_glFramebufferTexture2D; \
     packed_data->args.a1 = (GLenum)target; \
@@ -4908,21 +4840,19 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a3 = (GLenum)textarget; \
     packed_data->args.a4 = (GLuint)texture; \
     packed_data->args.a5 = (GLint)level; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glFrontFace
 #define push_glFrontFace(mode) { \
-    glFrontFace_PACKED *packed_data = malloc(sizeof(glFrontFace_PACKED)); \
+    glFrontFace_PACKED *packed_data = glAllocCall(glFrontFace_FORMAT, sizeof(glFrontFace_PACKED)); \
     packed_data->format = glFrontFace_FORMAT; \
     packed_data->func = gl4es_glFrontFace; \
     packed_data->args.a1 = (GLenum)mode; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glFrustumf
 #define push_glFrustumf(left, right, bottom, top, Near, Far) { \
-    glFrustumf_PACKED *packed_data = malloc(sizeof(glFrustumf_PACKED)); \
+    glFrustumf_PACKED *packed_data = glAllocCall(glFrustumf_FORMAT, sizeof(glFrustumf_PACKED)); \
     packed_data->format = glFrustumf_FORMAT; \
     packed_data->func = gl4es_glFrustumf; \
     packed_data->args.a1 = (GLfloat)left; \
@@ -4931,12 +4861,11 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a4 = (GLfloat)top; \
     packed_data->args.a5 = (GLfloat)Near; \
     packed_data->args.a6 = (GLfloat)Far; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glFrustumx
 #define push_glFrustumx(left, right, bottom, top, Near, Far) { \
-    glFrustumx_PACKED *packed_data = malloc(sizeof(glFrustumx_PACKED)); \
+    glFrustumx_PACKED *packed_data = glAllocCall(glFrustumx_FORMAT, sizeof(glFrustumx_PACKED)); \
     packed_data->format = glFrustumx_FORMAT; \
     packed_data->func = gl4es_glFrustumx; \
     packed_data->args.a1 = (GLfixed)left; \
@@ -4945,61 +4874,55 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a4 = (GLfixed)top; \
     packed_data->args.a5 = (GLfixed)Near; \
     packed_data->args.a6 = (GLfixed)Far; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGenBuffers
 #define push_glGenBuffers(n, buffer) { \
-    glGenBuffers_PACKED *packed_data = malloc(sizeof(glGenBuffers_PACKED)); \
+    glGenBuffers_PACKED *packed_data = glAllocCall(glGenBuffers_FORMAT, sizeof(glGenBuffers_PACKED)); \
     packed_data->format = glGenBuffers_FORMAT; \
     packed_data->func = gl4es_glGenBuffers; \
     packed_data->args.a1 = (GLsizei)n; \
     packed_data->args.a2 = (GLuint *)buffer; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGenFramebuffers
 #define push_glGenFramebuffers(n, ids) { \
-    glGenFramebuffers_PACKED *packed_data = malloc(sizeof(glGenFramebuffers_PACKED)); \
+    glGenFramebuffers_PACKED *packed_data = glAllocCall(glGenFramebuffers_FORMAT, sizeof(glGenFramebuffers_PACKED)); \
     packed_data->format = glGenFramebuffers_FORMAT; \
     packed_data->func = gl4es_glGenFramebuffers; \
     packed_data->args.a1 = (GLsizei)n; \
     packed_data->args.a2 = (GLuint *)ids; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGenRenderbuffers
 #define push_glGenRenderbuffers(n, renderbuffers) { \
-    glGenRenderbuffers_PACKED *packed_data = malloc(sizeof(glGenRenderbuffers_PACKED)); \
+    glGenRenderbuffers_PACKED *packed_data = glAllocCall(glGenRenderbuffers_FORMAT, sizeof(glGenRenderbuffers_PACKED)); \
     packed_data->format = glGenRenderbuffers_FORMAT; \
     packed_data->func = gl4es_glGenRenderbuffers; \
     packed_data->args.a1 = (GLsizei)n; \
     packed_data->args.a2 = (GLuint *)renderbuffers; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGenTextures
 #define push_glGenTextures(n, textures) { \
-    glGenTextures_PACKED *packed_data = malloc(sizeof(glGenTextures_PACKED)); \
+    glGenTextures_PACKED *packed_data = glAllocCall(glGenTextures_FORMAT, sizeof(glGenTextures_PACKED)); \
     packed_data->format = glGenTextures_FORMAT; \
     packed_data->func = gl4es_glGenTextures; \
     packed_data->args.a1 = (GLsizei)n; \
     packed_data->args.a2 = (GLuint *)textures; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGenerateMipmap
 #define push_glGenerateMipmap(target) { \
-    glGenerateMipmap_PACKED *packed_data = malloc(sizeof(glGenerateMipmap_PACKED)); \
+    glGenerateMipmap_PACKED *packed_data = glAllocCall(glGenerateMipmap_FORMAT, sizeof(glGenerateMipmap_PACKED)); \
     packed_data->format = glGenerateMipmap_FORMAT; \
     packed_data->func = gl4es_glGenerateMipmap; \
     packed_data->args.a1 = (GLenum)target; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetActiveAttrib
 #define push_glGetActiveAttrib(program, index, bufSize, length, size, type, name) { \
-    glGetActiveAttrib_PACKED *packed_data = malloc(sizeof(glGetActiveAttrib_PACKED)); \
+    glGetActiveAttrib_PACKED *packed_data = glAllocCall(glGetActiveAttrib_FORMAT, sizeof(glGetActiveAttrib_PACKED)); \
     packed_data->format = glGetActiveAttrib_FORMAT; \
     packed_data->func = gl4es_glGetActiveAttrib; \
     packed_data->args.a1 = (GLuint)program; \
@@ -5009,12 +4932,11 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a5 = (GLint *)size; \
     packed_data->args.a6 = (GLenum *)type; \
     packed_data->args.a7 = (GLchar *)name; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetActiveUniform
 #define push_glGetActiveUniform(program, index, bufSize, length, size, type, name) { \
-    glGetActiveUniform_PACKED *packed_data = malloc(sizeof(glGetActiveUniform_PACKED)); \
+    glGetActiveUniform_PACKED *packed_data = glAllocCall(glGetActiveUniform_FORMAT, sizeof(glGetActiveUniform_PACKED)); \
     packed_data->format = glGetActiveUniform_FORMAT; \
     packed_data->func = gl4es_glGetActiveUniform; \
     packed_data->args.a1 = (GLuint)program; \
@@ -5024,179 +4946,162 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a5 = (GLint *)size; \
     packed_data->args.a6 = (GLenum *)type; \
     packed_data->args.a7 = (GLchar *)name; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetAttachedShaders
 #define push_glGetAttachedShaders(program, maxCount, count, obj) { \
-    glGetAttachedShaders_PACKED *packed_data = malloc(sizeof(glGetAttachedShaders_PACKED)); \
+    glGetAttachedShaders_PACKED *packed_data = glAllocCall(glGetAttachedShaders_FORMAT, sizeof(glGetAttachedShaders_PACKED)); \
     packed_data->format = glGetAttachedShaders_FORMAT; \
     packed_data->func = gl4es_glGetAttachedShaders; \
     packed_data->args.a1 = (GLuint)program; \
     packed_data->args.a2 = (GLsizei)maxCount; \
     packed_data->args.a3 = (GLsizei *)count; \
     packed_data->args.a4 = (GLuint *)obj; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetAttribLocation
 #define push_glGetAttribLocation(program, name) { \
-    glGetAttribLocation_PACKED *packed_data = malloc(sizeof(glGetAttribLocation_PACKED)); \
+    glGetAttribLocation_PACKED *packed_data = glAllocCall(glGetAttribLocation_FORMAT, sizeof(glGetAttribLocation_PACKED)); \
     packed_data->format = glGetAttribLocation_FORMAT; \
     packed_data->func = gl4es_glGetAttribLocation; \
     packed_data->args.a1 = (GLuint)program; \
     packed_data->args.a2 = (GLchar *)name; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetBooleanv
 #define push_glGetBooleanv(pname, params) { \
-    glGetBooleanv_PACKED *packed_data = malloc(sizeof(glGetBooleanv_PACKED)); \
+    glGetBooleanv_PACKED *packed_data = glAllocCall(glGetBooleanv_FORMAT, sizeof(glGetBooleanv_PACKED)); \
     packed_data->format = glGetBooleanv_FORMAT; \
     packed_data->func = gl4es_glGetBooleanv; \
     packed_data->args.a1 = (GLenum)pname; \
     packed_data->args.a2 = (GLboolean *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetBufferParameteriv
 #define push_glGetBufferParameteriv(target, pname, params) { \
-    glGetBufferParameteriv_PACKED *packed_data = malloc(sizeof(glGetBufferParameteriv_PACKED)); \
+    glGetBufferParameteriv_PACKED *packed_data = glAllocCall(glGetBufferParameteriv_FORMAT, sizeof(glGetBufferParameteriv_PACKED)); \
     packed_data->format = glGetBufferParameteriv_FORMAT; \
     packed_data->func = gl4es_glGetBufferParameteriv; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLint *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetClipPlanef
 #define push_glGetClipPlanef(plane, equation) { \
-    glGetClipPlanef_PACKED *packed_data = malloc(sizeof(glGetClipPlanef_PACKED)); \
+    glGetClipPlanef_PACKED *packed_data = glAllocCall(glGetClipPlanef_FORMAT, sizeof(glGetClipPlanef_PACKED)); \
     packed_data->format = glGetClipPlanef_FORMAT; \
     packed_data->func = gl4es_glGetClipPlanef; \
     packed_data->args.a1 = (GLenum)plane; \
     packed_data->args.a2 = (GLfloat *)equation; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetClipPlanex
 #define push_glGetClipPlanex(plane, equation) { \
-    glGetClipPlanex_PACKED *packed_data = malloc(sizeof(glGetClipPlanex_PACKED)); \
+    glGetClipPlanex_PACKED *packed_data = glAllocCall(glGetClipPlanex_FORMAT, sizeof(glGetClipPlanex_PACKED)); \
     packed_data->format = glGetClipPlanex_FORMAT; \
     packed_data->func = gl4es_glGetClipPlanex; \
     packed_data->args.a1 = (GLenum)plane; \
     packed_data->args.a2 = (GLfixed *)equation; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetError
 #define push_glGetError() { \
-    glGetError_PACKED *packed_data = malloc(sizeof(glGetError_PACKED)); \
+    glGetError_PACKED *packed_data = glAllocCall(glGetError_FORMAT, sizeof(glGetError_PACKED)); \
     packed_data->format = glGetError_FORMAT; \
     packed_data->func = gl4es_glGetError; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetFixedv
 #define push_glGetFixedv(pname, params) { \
-    glGetFixedv_PACKED *packed_data = malloc(sizeof(glGetFixedv_PACKED)); \
+    glGetFixedv_PACKED *packed_data = glAllocCall(glGetFixedv_FORMAT, sizeof(glGetFixedv_PACKED)); \
     packed_data->format = glGetFixedv_FORMAT; \
     packed_data->func = gl4es_glGetFixedv; \
     packed_data->args.a1 = (GLenum)pname; \
     packed_data->args.a2 = (GLfixed *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetFloatv
 #define push_glGetFloatv(pname, params) { \
-    glGetFloatv_PACKED *packed_data = malloc(sizeof(glGetFloatv_PACKED)); \
+    glGetFloatv_PACKED *packed_data = glAllocCall(glGetFloatv_FORMAT, sizeof(glGetFloatv_PACKED)); \
     packed_data->format = glGetFloatv_FORMAT; \
     packed_data->func = gl4es_glGetFloatv; \
     packed_data->args.a1 = (GLenum)pname; \
     packed_data->args.a2 = (GLfloat *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetFramebufferAttachmentParameteriv
 #define push_glGetFramebufferAttachmentParameteriv(target, attachment, pname, params) { \
-    glGetFramebufferAttachmentParameteriv_PACKED *packed_data = malloc(sizeof(glGetFramebufferAttachmentParameteriv_PACKED)); \
+    glGetFramebufferAttachmentParameteriv_PACKED *packed_data = glAllocCall(glGetFramebufferAttachmentParameteriv_FORMAT, sizeof(glGetFramebufferAttachmentParameteriv_PACKED)); \
     packed_data->format = glGetFramebufferAttachmentParameteriv_FORMAT; \
     packed_data->func = gl4es_glGetFramebufferAttachmentParameteriv; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLenum)attachment; \
     packed_data->args.a3 = (GLenum)pname; \
     packed_data->args.a4 = (GLint *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetIntegerv
 #define push_glGetIntegerv(pname, params) { \
-    glGetIntegerv_PACKED *packed_data = malloc(sizeof(glGetIntegerv_PACKED)); \
+    glGetIntegerv_PACKED *packed_data = glAllocCall(glGetIntegerv_FORMAT, sizeof(glGetIntegerv_PACKED)); \
     packed_data->format = glGetIntegerv_FORMAT; \
     packed_data->func = gl4es_glGetIntegerv; \
     packed_data->args.a1 = (GLenum)pname; \
     packed_data->args.a2 = (GLint *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetLightfv
 #define push_glGetLightfv(light, pname, params) { \
-    glGetLightfv_PACKED *packed_data = malloc(sizeof(glGetLightfv_PACKED)); \
+    glGetLightfv_PACKED *packed_data = glAllocCall(glGetLightfv_FORMAT, sizeof(glGetLightfv_PACKED)); \
     packed_data->format = glGetLightfv_FORMAT; \
     packed_data->func = gl4es_glGetLightfv; \
     packed_data->args.a1 = (GLenum)light; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfloat *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetLightxv
 #define push_glGetLightxv(light, pname, params) { \
-    glGetLightxv_PACKED *packed_data = malloc(sizeof(glGetLightxv_PACKED)); \
+    glGetLightxv_PACKED *packed_data = glAllocCall(glGetLightxv_FORMAT, sizeof(glGetLightxv_PACKED)); \
     packed_data->format = glGetLightxv_FORMAT; \
     packed_data->func = gl4es_glGetLightxv; \
     packed_data->args.a1 = (GLenum)light; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfixed *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetMaterialfv
 #define push_glGetMaterialfv(face, pname, params) { \
-    glGetMaterialfv_PACKED *packed_data = malloc(sizeof(glGetMaterialfv_PACKED)); \
+    glGetMaterialfv_PACKED *packed_data = glAllocCall(glGetMaterialfv_FORMAT, sizeof(glGetMaterialfv_PACKED)); \
     packed_data->format = glGetMaterialfv_FORMAT; \
     packed_data->func = gl4es_glGetMaterialfv; \
     packed_data->args.a1 = (GLenum)face; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfloat *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetMaterialxv
 #define push_glGetMaterialxv(face, pname, params) { \
-    glGetMaterialxv_PACKED *packed_data = malloc(sizeof(glGetMaterialxv_PACKED)); \
+    glGetMaterialxv_PACKED *packed_data = glAllocCall(glGetMaterialxv_FORMAT, sizeof(glGetMaterialxv_PACKED)); \
     packed_data->format = glGetMaterialxv_FORMAT; \
     packed_data->func = gl4es_glGetMaterialxv; \
     packed_data->args.a1 = (GLenum)face; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfixed *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetPointerv
 #define push_glGetPointerv(pname, params) { \
-    glGetPointerv_PACKED *packed_data = malloc(sizeof(glGetPointerv_PACKED)); \
+    glGetPointerv_PACKED *packed_data = glAllocCall(glGetPointerv_FORMAT, sizeof(glGetPointerv_PACKED)); \
     packed_data->format = glGetPointerv_FORMAT; \
     packed_data->func = gl4es_glGetPointerv; \
     packed_data->args.a1 = (GLenum)pname; \
     packed_data->args.a2 = (GLvoid **)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetProgramBinary
 #define push_glGetProgramBinary(program, bufSize, length, binaryFormat, binary) { \
-    glGetProgramBinary_PACKED *packed_data = malloc(sizeof(glGetProgramBinary_PACKED)); \
+    glGetProgramBinary_PACKED *packed_data = glAllocCall(glGetProgramBinary_FORMAT, sizeof(glGetProgramBinary_PACKED)); \
     packed_data->format = glGetProgramBinary_FORMAT; \
     packed_data->func = gl4es_glGetProgramBinary; \
     packed_data->args.a1 = (GLuint)program; \
@@ -5204,535 +5109,483 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a3 = (GLsizei *)length; \
     packed_data->args.a4 = (GLenum *)binaryFormat; \
     packed_data->args.a5 = (GLvoid *)binary; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetProgramInfoLog
 #define push_glGetProgramInfoLog(program, bufSize, length, infoLog) { \
-    glGetProgramInfoLog_PACKED *packed_data = malloc(sizeof(glGetProgramInfoLog_PACKED)); \
+    glGetProgramInfoLog_PACKED *packed_data = glAllocCall(glGetProgramInfoLog_FORMAT, sizeof(glGetProgramInfoLog_PACKED)); \
     packed_data->format = glGetProgramInfoLog_FORMAT; \
     packed_data->func = gl4es_glGetProgramInfoLog; \
     packed_data->args.a1 = (GLuint)program; \
     packed_data->args.a2 = (GLsizei)bufSize; \
     packed_data->args.a3 = (GLsizei *)length; \
     packed_data->args.a4 = (GLchar *)infoLog; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetProgramiv
 #define push_glGetProgramiv(program, pname, params) { \
-    glGetProgramiv_PACKED *packed_data = malloc(sizeof(glGetProgramiv_PACKED)); \
+    glGetProgramiv_PACKED *packed_data = glAllocCall(glGetProgramiv_FORMAT, sizeof(glGetProgramiv_PACKED)); \
     packed_data->format = glGetProgramiv_FORMAT; \
     packed_data->func = gl4es_glGetProgramiv; \
     packed_data->args.a1 = (GLuint)program; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLint *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetRenderbufferParameteriv
 #define push_glGetRenderbufferParameteriv(target, pname, params) { \
-    glGetRenderbufferParameteriv_PACKED *packed_data = malloc(sizeof(glGetRenderbufferParameteriv_PACKED)); \
+    glGetRenderbufferParameteriv_PACKED *packed_data = glAllocCall(glGetRenderbufferParameteriv_FORMAT, sizeof(glGetRenderbufferParameteriv_PACKED)); \
     packed_data->format = glGetRenderbufferParameteriv_FORMAT; \
     packed_data->func = gl4es_glGetRenderbufferParameteriv; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLint *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetShaderInfoLog
 #define push_glGetShaderInfoLog(shader, bufSize, length, infoLog) { \
-    glGetShaderInfoLog_PACKED *packed_data = malloc(sizeof(glGetShaderInfoLog_PACKED)); \
+    glGetShaderInfoLog_PACKED *packed_data = glAllocCall(glGetShaderInfoLog_FORMAT, sizeof(glGetShaderInfoLog_PACKED)); \
     packed_data->format = glGetShaderInfoLog_FORMAT; \
     packed_data->func = gl4es_glGetShaderInfoLog; \
     packed_data->args.a1 = (GLuint)shader; \
     packed_data->args.a2 = (GLsizei)bufSize; \
     packed_data->args.a3 = (GLsizei *)length; \
     packed_data->args.a4 = (GLchar *)infoLog; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetShaderPrecisionFormat
 #define push_glGetShaderPrecisionFormat(shadertype, precisiontype, range, precision) { \
-    glGetShaderPrecisionFormat_PACKED *packed_data = malloc(sizeof(glGetShaderPrecisionFormat_PACKED)); \
+    glGetShaderPrecisionFormat_PACKED *packed_data = glAllocCall(glGetShaderPrecisionFormat_FORMAT, sizeof(glGetShaderPrecisionFormat_PACKED)); \
     packed_data->format = glGetShaderPrecisionFormat_FORMAT; \
     packed_data->func = gl4es_glGetShaderPrecisionFormat; \
     packed_data->args.a1 = (GLenum)shadertype; \
     packed_data->args.a2 = (GLenum)precisiontype; \
     packed_data->args.a3 = (GLint *)range; \
     packed_data->args.a4 = (GLint *)precision; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetShaderSource
 #define push_glGetShaderSource(shader, bufSize, length, source) { \
-    glGetShaderSource_PACKED *packed_data = malloc(sizeof(glGetShaderSource_PACKED)); \
+    glGetShaderSource_PACKED *packed_data = glAllocCall(glGetShaderSource_FORMAT, sizeof(glGetShaderSource_PACKED)); \
     packed_data->format = glGetShaderSource_FORMAT; \
     packed_data->func = gl4es_glGetShaderSource; \
     packed_data->args.a1 = (GLuint)shader; \
     packed_data->args.a2 = (GLsizei)bufSize; \
     packed_data->args.a3 = (GLsizei *)length; \
     packed_data->args.a4 = (GLchar *)source; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetShaderiv
 #define push_glGetShaderiv(shader, pname, params) { \
-    glGetShaderiv_PACKED *packed_data = malloc(sizeof(glGetShaderiv_PACKED)); \
+    glGetShaderiv_PACKED *packed_data = glAllocCall(glGetShaderiv_FORMAT, sizeof(glGetShaderiv_PACKED)); \
     packed_data->format = glGetShaderiv_FORMAT; \
     packed_data->func = gl4es_glGetShaderiv; \
     packed_data->args.a1 = (GLuint)shader; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLint *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetString
 #define push_glGetString(name) { \
-    glGetString_PACKED *packed_data = malloc(sizeof(glGetString_PACKED)); \
+    glGetString_PACKED *packed_data = glAllocCall(glGetString_FORMAT, sizeof(glGetString_PACKED)); \
     packed_data->format = glGetString_FORMAT; \
     packed_data->func = gl4es_glGetString; \
     packed_data->args.a1 = (GLenum)name; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetTexEnvfv
 #define push_glGetTexEnvfv(target, pname, params) { \
-    glGetTexEnvfv_PACKED *packed_data = malloc(sizeof(glGetTexEnvfv_PACKED)); \
+    glGetTexEnvfv_PACKED *packed_data = glAllocCall(glGetTexEnvfv_FORMAT, sizeof(glGetTexEnvfv_PACKED)); \
     packed_data->format = glGetTexEnvfv_FORMAT; \
     packed_data->func = gl4es_glGetTexEnvfv; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfloat *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetTexEnviv
 #define push_glGetTexEnviv(target, pname, params) { \
-    glGetTexEnviv_PACKED *packed_data = malloc(sizeof(glGetTexEnviv_PACKED)); \
+    glGetTexEnviv_PACKED *packed_data = glAllocCall(glGetTexEnviv_FORMAT, sizeof(glGetTexEnviv_PACKED)); \
     packed_data->format = glGetTexEnviv_FORMAT; \
     packed_data->func = gl4es_glGetTexEnviv; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLint *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetTexEnvxv
 #define push_glGetTexEnvxv(target, pname, params) { \
-    glGetTexEnvxv_PACKED *packed_data = malloc(sizeof(glGetTexEnvxv_PACKED)); \
+    glGetTexEnvxv_PACKED *packed_data = glAllocCall(glGetTexEnvxv_FORMAT, sizeof(glGetTexEnvxv_PACKED)); \
     packed_data->format = glGetTexEnvxv_FORMAT; \
     packed_data->func = gl4es_glGetTexEnvxv; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfixed *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetTexParameterfv
 #define push_glGetTexParameterfv(target, pname, params) { \
-    glGetTexParameterfv_PACKED *packed_data = malloc(sizeof(glGetTexParameterfv_PACKED)); \
+    glGetTexParameterfv_PACKED *packed_data = glAllocCall(glGetTexParameterfv_FORMAT, sizeof(glGetTexParameterfv_PACKED)); \
     packed_data->format = glGetTexParameterfv_FORMAT; \
     packed_data->func = gl4es_glGetTexParameterfv; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfloat *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetTexParameteriv
 #define push_glGetTexParameteriv(target, pname, params) { \
-    glGetTexParameteriv_PACKED *packed_data = malloc(sizeof(glGetTexParameteriv_PACKED)); \
+    glGetTexParameteriv_PACKED *packed_data = glAllocCall(glGetTexParameteriv_FORMAT, sizeof(glGetTexParameteriv_PACKED)); \
     packed_data->format = glGetTexParameteriv_FORMAT; \
     packed_data->func = gl4es_glGetTexParameteriv; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLint *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetTexParameterxv
 #define push_glGetTexParameterxv(target, pname, params) { \
-    glGetTexParameterxv_PACKED *packed_data = malloc(sizeof(glGetTexParameterxv_PACKED)); \
+    glGetTexParameterxv_PACKED *packed_data = glAllocCall(glGetTexParameterxv_FORMAT, sizeof(glGetTexParameterxv_PACKED)); \
     packed_data->format = glGetTexParameterxv_FORMAT; \
     packed_data->func = gl4es_glGetTexParameterxv; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfixed *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetUniformLocation
 #define push_glGetUniformLocation(program, name) { \
-    glGetUniformLocation_PACKED *packed_data = malloc(sizeof(glGetUniformLocation_PACKED)); \
+    glGetUniformLocation_PACKED *packed_data = glAllocCall(glGetUniformLocation_FORMAT, sizeof(glGetUniformLocation_PACKED)); \
     packed_data->format = glGetUniformLocation_FORMAT; \
     packed_data->func = gl4es_glGetUniformLocation; \
     packed_data->args.a1 = (GLuint)program; \
     packed_data->args.a2 = (GLchar *)name; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetUniformfv
 #define push_glGetUniformfv(program, location, params) { \
-    glGetUniformfv_PACKED *packed_data = malloc(sizeof(glGetUniformfv_PACKED)); \
+    glGetUniformfv_PACKED *packed_data = glAllocCall(glGetUniformfv_FORMAT, sizeof(glGetUniformfv_PACKED)); \
     packed_data->format = glGetUniformfv_FORMAT; \
     packed_data->func = gl4es_glGetUniformfv; \
     packed_data->args.a1 = (GLuint)program; \
     packed_data->args.a2 = (GLint)location; \
     packed_data->args.a3 = (GLfloat *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetUniformiv
 #define push_glGetUniformiv(program, location, params) { \
-    glGetUniformiv_PACKED *packed_data = malloc(sizeof(glGetUniformiv_PACKED)); \
+    glGetUniformiv_PACKED *packed_data = glAllocCall(glGetUniformiv_FORMAT, sizeof(glGetUniformiv_PACKED)); \
     packed_data->format = glGetUniformiv_FORMAT; \
     packed_data->func = gl4es_glGetUniformiv; \
     packed_data->args.a1 = (GLuint)program; \
     packed_data->args.a2 = (GLint)location; \
     packed_data->args.a3 = (GLint *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetVertexAttribPointerv
 #define push_glGetVertexAttribPointerv(index, pname, pointer) { \
-    glGetVertexAttribPointerv_PACKED *packed_data = malloc(sizeof(glGetVertexAttribPointerv_PACKED)); \
+    glGetVertexAttribPointerv_PACKED *packed_data = glAllocCall(glGetVertexAttribPointerv_FORMAT, sizeof(glGetVertexAttribPointerv_PACKED)); \
     packed_data->format = glGetVertexAttribPointerv_FORMAT; \
     packed_data->func = gl4es_glGetVertexAttribPointerv; \
     packed_data->args.a1 = (GLuint)index; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLvoid **)pointer; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetVertexAttribfv
 #define push_glGetVertexAttribfv(index, pname, params) { \
-    glGetVertexAttribfv_PACKED *packed_data = malloc(sizeof(glGetVertexAttribfv_PACKED)); \
+    glGetVertexAttribfv_PACKED *packed_data = glAllocCall(glGetVertexAttribfv_FORMAT, sizeof(glGetVertexAttribfv_PACKED)); \
     packed_data->format = glGetVertexAttribfv_FORMAT; \
     packed_data->func = gl4es_glGetVertexAttribfv; \
     packed_data->args.a1 = (GLuint)index; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfloat *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glGetVertexAttribiv
 #define push_glGetVertexAttribiv(index, pname, params) { \
-    glGetVertexAttribiv_PACKED *packed_data = malloc(sizeof(glGetVertexAttribiv_PACKED)); \
+    glGetVertexAttribiv_PACKED *packed_data = glAllocCall(glGetVertexAttribiv_FORMAT, sizeof(glGetVertexAttribiv_PACKED)); \
     packed_data->format = glGetVertexAttribiv_FORMAT; \
     packed_data->func = gl4es_glGetVertexAttribiv; \
     packed_data->args.a1 = (GLuint)index; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLint *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glHint
 #define push_glHint(target, mode) { \
-    glHint_PACKED *packed_data = malloc(sizeof(glHint_PACKED)); \
+    glHint_PACKED *packed_data = glAllocCall(glHint_FORMAT, sizeof(glHint_PACKED)); \
     packed_data->format = glHint_FORMAT; \
     packed_data->func = gl4es_glHint; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLenum)mode; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glIsBuffer
 #define push_glIsBuffer(buffer) { \
-    glIsBuffer_PACKED *packed_data = malloc(sizeof(glIsBuffer_PACKED)); \
+    glIsBuffer_PACKED *packed_data = glAllocCall(glIsBuffer_FORMAT, sizeof(glIsBuffer_PACKED)); \
     packed_data->format = glIsBuffer_FORMAT; \
     packed_data->func = gl4es_glIsBuffer; \
     packed_data->args.a1 = (GLuint)buffer; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glIsEnabled
 #define push_glIsEnabled(cap) { \
-    glIsEnabled_PACKED *packed_data = malloc(sizeof(glIsEnabled_PACKED)); \
+    glIsEnabled_PACKED *packed_data = glAllocCall(glIsEnabled_FORMAT, sizeof(glIsEnabled_PACKED)); \
     packed_data->format = glIsEnabled_FORMAT; \
     packed_data->func = gl4es_glIsEnabled; \
     packed_data->args.a1 = (GLenum)cap; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glIsFramebuffer
 #define push_glIsFramebuffer(framebuffer) { \
-    glIsFramebuffer_PACKED *packed_data = malloc(sizeof(glIsFramebuffer_PACKED)); \
+    glIsFramebuffer_PACKED *packed_data = glAllocCall(glIsFramebuffer_FORMAT, sizeof(glIsFramebuffer_PACKED)); \
     packed_data->format = glIsFramebuffer_FORMAT; \
     packed_data->func = gl4es_glIsFramebuffer; \
     packed_data->args.a1 = (GLuint)framebuffer; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glIsProgram
 #define push_glIsProgram(program) { \
-    glIsProgram_PACKED *packed_data = malloc(sizeof(glIsProgram_PACKED)); \
+    glIsProgram_PACKED *packed_data = glAllocCall(glIsProgram_FORMAT, sizeof(glIsProgram_PACKED)); \
     packed_data->format = glIsProgram_FORMAT; \
     packed_data->func = gl4es_glIsProgram; \
     packed_data->args.a1 = (GLuint)program; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glIsRenderbuffer
 #define push_glIsRenderbuffer(renderbuffer) { \
-    glIsRenderbuffer_PACKED *packed_data = malloc(sizeof(glIsRenderbuffer_PACKED)); \
+    glIsRenderbuffer_PACKED *packed_data = glAllocCall(glIsRenderbuffer_FORMAT, sizeof(glIsRenderbuffer_PACKED)); \
     packed_data->format = glIsRenderbuffer_FORMAT; \
     packed_data->func = gl4es_glIsRenderbuffer; \
     packed_data->args.a1 = (GLuint)renderbuffer; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glIsShader
 #define push_glIsShader(shader) { \
-    glIsShader_PACKED *packed_data = malloc(sizeof(glIsShader_PACKED)); \
+    glIsShader_PACKED *packed_data = glAllocCall(glIsShader_FORMAT, sizeof(glIsShader_PACKED)); \
     packed_data->format = glIsShader_FORMAT; \
     packed_data->func = gl4es_glIsShader; \
     packed_data->args.a1 = (GLuint)shader; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glIsTexture
 #define push_glIsTexture(texture) { \
-    glIsTexture_PACKED *packed_data = malloc(sizeof(glIsTexture_PACKED)); \
+    glIsTexture_PACKED *packed_data = glAllocCall(glIsTexture_FORMAT, sizeof(glIsTexture_PACKED)); \
     packed_data->format = glIsTexture_FORMAT; \
     packed_data->func = gl4es_glIsTexture; \
     packed_data->args.a1 = (GLuint)texture; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glLightModelf
 #define push_glLightModelf(pname, param) { \
-    glLightModelf_PACKED *packed_data = malloc(sizeof(glLightModelf_PACKED)); \
+    glLightModelf_PACKED *packed_data = glAllocCall(glLightModelf_FORMAT, sizeof(glLightModelf_PACKED)); \
     packed_data->format = glLightModelf_FORMAT; \
     packed_data->func = gl4es_glLightModelf; \
     packed_data->args.a1 = (GLenum)pname; \
     packed_data->args.a2 = (GLfloat)param; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glLightModelfv
 #define push_glLightModelfv(pname, params) { \
-    glLightModelfv_PACKED *packed_data = malloc(sizeof(glLightModelfv_PACKED)); \
+    glLightModelfv_PACKED *packed_data = glAllocCall(glLightModelfv_FORMAT, sizeof(glLightModelfv_PACKED)); \
     packed_data->format = glLightModelfv_FORMAT; \
     packed_data->func = gl4es_glLightModelfv; \
     packed_data->args.a1 = (GLenum)pname; \
     packed_data->args.a2 = (GLfloat *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glLightModelx
 #define push_glLightModelx(pname, param) { \
-    glLightModelx_PACKED *packed_data = malloc(sizeof(glLightModelx_PACKED)); \
+    glLightModelx_PACKED *packed_data = glAllocCall(glLightModelx_FORMAT, sizeof(glLightModelx_PACKED)); \
     packed_data->format = glLightModelx_FORMAT; \
     packed_data->func = gl4es_glLightModelx; \
     packed_data->args.a1 = (GLenum)pname; \
     packed_data->args.a2 = (GLfixed)param; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glLightModelxv
 #define push_glLightModelxv(pname, params) { \
-    glLightModelxv_PACKED *packed_data = malloc(sizeof(glLightModelxv_PACKED)); \
+    glLightModelxv_PACKED *packed_data = glAllocCall(glLightModelxv_FORMAT, sizeof(glLightModelxv_PACKED)); \
     packed_data->format = glLightModelxv_FORMAT; \
     packed_data->func = gl4es_glLightModelxv; \
     packed_data->args.a1 = (GLenum)pname; \
     packed_data->args.a2 = (GLfixed *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glLightf
 #define push_glLightf(light, pname, param) { \
-    glLightf_PACKED *packed_data = malloc(sizeof(glLightf_PACKED)); \
+    glLightf_PACKED *packed_data = glAllocCall(glLightf_FORMAT, sizeof(glLightf_PACKED)); \
     packed_data->format = glLightf_FORMAT; \
     packed_data->func = gl4es_glLightf; \
     packed_data->args.a1 = (GLenum)light; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfloat)param; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glLightfv
 #define push_glLightfv(light, pname, params) { \
-    glLightfv_PACKED *packed_data = malloc(sizeof(glLightfv_PACKED)); \
+    glLightfv_PACKED *packed_data = glAllocCall(glLightfv_FORMAT, sizeof(glLightfv_PACKED)); \
     packed_data->format = glLightfv_FORMAT; \
     packed_data->func = gl4es_glLightfv; \
     packed_data->args.a1 = (GLenum)light; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfloat *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glLightx
 #define push_glLightx(light, pname, param) { \
-    glLightx_PACKED *packed_data = malloc(sizeof(glLightx_PACKED)); \
+    glLightx_PACKED *packed_data = glAllocCall(glLightx_FORMAT, sizeof(glLightx_PACKED)); \
     packed_data->format = glLightx_FORMAT; \
     packed_data->func = gl4es_glLightx; \
     packed_data->args.a1 = (GLenum)light; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfixed)param; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glLightxv
 #define push_glLightxv(light, pname, params) { \
-    glLightxv_PACKED *packed_data = malloc(sizeof(glLightxv_PACKED)); \
+    glLightxv_PACKED *packed_data = glAllocCall(glLightxv_FORMAT, sizeof(glLightxv_PACKED)); \
     packed_data->format = glLightxv_FORMAT; \
     packed_data->func = gl4es_glLightxv; \
     packed_data->args.a1 = (GLenum)light; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfixed *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glLineWidth
 #define push_glLineWidth(width) { \
-    glLineWidth_PACKED *packed_data = malloc(sizeof(glLineWidth_PACKED)); \
+    glLineWidth_PACKED *packed_data = glAllocCall(glLineWidth_FORMAT, sizeof(glLineWidth_PACKED)); \
     packed_data->format = glLineWidth_FORMAT; \
     packed_data->func = gl4es_glLineWidth; \
     packed_data->args.a1 = (GLfloat)width; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glLineWidthx
 #define push_glLineWidthx(width) { \
-    glLineWidthx_PACKED *packed_data = malloc(sizeof(glLineWidthx_PACKED)); \
+    glLineWidthx_PACKED *packed_data = glAllocCall(glLineWidthx_FORMAT, sizeof(glLineWidthx_PACKED)); \
     packed_data->format = glLineWidthx_FORMAT; \
     packed_data->func = gl4es_glLineWidthx; \
     packed_data->args.a1 = (GLfixed)width; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glLinkProgram
 #define push_glLinkProgram(program) { \
-    glLinkProgram_PACKED *packed_data = malloc(sizeof(glLinkProgram_PACKED)); \
+    glLinkProgram_PACKED *packed_data = glAllocCall(glLinkProgram_FORMAT, sizeof(glLinkProgram_PACKED)); \
     packed_data->format = glLinkProgram_FORMAT; \
     packed_data->func = gl4es_glLinkProgram; \
     packed_data->args.a1 = (GLuint)program; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glLoadIdentity
 #define push_glLoadIdentity() { \
-    glLoadIdentity_PACKED *packed_data = malloc(sizeof(glLoadIdentity_PACKED)); \
+    glLoadIdentity_PACKED *packed_data = glAllocCall(glLoadIdentity_FORMAT, sizeof(glLoadIdentity_PACKED)); \
     packed_data->format = glLoadIdentity_FORMAT; \
     packed_data->func = gl4es_glLoadIdentity; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glLoadMatrixf
 #define push_glLoadMatrixf(m) { \
-    glLoadMatrixf_PACKED *packed_data = malloc(sizeof(glLoadMatrixf_PACKED)); \
+    glLoadMatrixf_PACKED *packed_data = glAllocCall(glLoadMatrixf_FORMAT, sizeof(glLoadMatrixf_PACKED)); \
     packed_data->format = glLoadMatrixf_FORMAT; \
     packed_data->func = gl4es_glLoadMatrixf; \
     packed_data->args.a1 = (GLfloat *)m; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glLoadMatrixx
 #define push_glLoadMatrixx(m) { \
-    glLoadMatrixx_PACKED *packed_data = malloc(sizeof(glLoadMatrixx_PACKED)); \
+    glLoadMatrixx_PACKED *packed_data = glAllocCall(glLoadMatrixx_FORMAT, sizeof(glLoadMatrixx_PACKED)); \
     packed_data->format = glLoadMatrixx_FORMAT; \
     packed_data->func = gl4es_glLoadMatrixx; \
     packed_data->args.a1 = (GLfixed *)m; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glLogicOp
 #define push_glLogicOp(opcode) { \
-    glLogicOp_PACKED *packed_data = malloc(sizeof(glLogicOp_PACKED)); \
+    glLogicOp_PACKED *packed_data = glAllocCall(glLogicOp_FORMAT, sizeof(glLogicOp_PACKED)); \
     packed_data->format = glLogicOp_FORMAT; \
     packed_data->func = gl4es_glLogicOp; \
     packed_data->args.a1 = (GLenum)opcode; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glMaterialf
 #define push_glMaterialf(face, pname, param) { \
-    glMaterialf_PACKED *packed_data = malloc(sizeof(glMaterialf_PACKED)); \
+    glMaterialf_PACKED *packed_data = glAllocCall(glMaterialf_FORMAT, sizeof(glMaterialf_PACKED)); \
     packed_data->format = glMaterialf_FORMAT; \
     packed_data->func = gl4es_glMaterialf; \
     packed_data->args.a1 = (GLenum)face; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfloat)param; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glMaterialfv
 #define push_glMaterialfv(face, pname, params) { \
-    glMaterialfv_PACKED *packed_data = malloc(sizeof(glMaterialfv_PACKED)); \
+    glMaterialfv_PACKED *packed_data = glAllocCall(glMaterialfv_FORMAT, sizeof(glMaterialfv_PACKED)); \
     packed_data->format = glMaterialfv_FORMAT; \
     packed_data->func = gl4es_glMaterialfv; \
     packed_data->args.a1 = (GLenum)face; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfloat *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glMaterialx
 #define push_glMaterialx(face, pname, param) { \
-    glMaterialx_PACKED *packed_data = malloc(sizeof(glMaterialx_PACKED)); \
+    glMaterialx_PACKED *packed_data = glAllocCall(glMaterialx_FORMAT, sizeof(glMaterialx_PACKED)); \
     packed_data->format = glMaterialx_FORMAT; \
     packed_data->func = gl4es_glMaterialx; \
     packed_data->args.a1 = (GLenum)face; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfixed)param; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glMaterialxv
 #define push_glMaterialxv(face, pname, params) { \
-    glMaterialxv_PACKED *packed_data = malloc(sizeof(glMaterialxv_PACKED)); \
+    glMaterialxv_PACKED *packed_data = glAllocCall(glMaterialxv_FORMAT, sizeof(glMaterialxv_PACKED)); \
     packed_data->format = glMaterialxv_FORMAT; \
     packed_data->func = gl4es_glMaterialxv; \
     packed_data->args.a1 = (GLenum)face; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfixed *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glMatrixMode
 #define push_glMatrixMode(mode) { \
-    glMatrixMode_PACKED *packed_data = malloc(sizeof(glMatrixMode_PACKED)); \
+    glMatrixMode_PACKED *packed_data = glAllocCall(glMatrixMode_FORMAT, sizeof(glMatrixMode_PACKED)); \
     packed_data->format = glMatrixMode_FORMAT; \
     packed_data->func = gl4es_glMatrixMode; \
     packed_data->args.a1 = (GLenum)mode; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glMultMatrixf
 #define push_glMultMatrixf(m) { \
-    glMultMatrixf_PACKED *packed_data = malloc(sizeof(glMultMatrixf_PACKED)); \
+    glMultMatrixf_PACKED *packed_data = glAllocCall(glMultMatrixf_FORMAT, sizeof(glMultMatrixf_PACKED)); \
     packed_data->format = glMultMatrixf_FORMAT; \
     packed_data->func = gl4es_glMultMatrixf; \
     packed_data->args.a1 = (GLfloat *)m; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glMultMatrixx
 #define push_glMultMatrixx(m) { \
-    glMultMatrixx_PACKED *packed_data = malloc(sizeof(glMultMatrixx_PACKED)); \
+    glMultMatrixx_PACKED *packed_data = glAllocCall(glMultMatrixx_FORMAT, sizeof(glMultMatrixx_PACKED)); \
     packed_data->format = glMultMatrixx_FORMAT; \
     packed_data->func = gl4es_glMultMatrixx; \
     packed_data->args.a1 = (GLfixed *)m; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glMultiDrawArrays
 #define push_glMultiDrawArrays(mode, first, count, primcount) { \
-    glMultiDrawArrays_PACKED *packed_data = malloc(sizeof(glMultiDrawArrays_PACKED)); \
+    glMultiDrawArrays_PACKED *packed_data = glAllocCall(glMultiDrawArrays_FORMAT, sizeof(glMultiDrawArrays_PACKED)); \
     packed_data->format = glMultiDrawArrays_FORMAT; \
     packed_data->func = gl4es_glMultiDrawArrays; \
     packed_data->args.a1 = (GLenum)mode; \
     packed_data->args.a2 = (GLint *)first; \
     packed_data->args.a3 = (GLsizei *)count; \
     packed_data->args.a4 = (GLsizei)primcount; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glMultiDrawElements
 #define push_glMultiDrawElements(mode, count, type, indices, primcount) { \
-    glMultiDrawElements_PACKED *packed_data = malloc(sizeof(glMultiDrawElements_PACKED)); \
+    glMultiDrawElements_PACKED *packed_data = glAllocCall(glMultiDrawElements_FORMAT, sizeof(glMultiDrawElements_PACKED)); \
     packed_data->format = glMultiDrawElements_FORMAT; \
     packed_data->func = gl4es_glMultiDrawElements; \
     packed_data->args.a1 = (GLenum)mode; \
@@ -5740,12 +5593,11 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a3 = (GLenum)type; \
     packed_data->args.a4 = (void * *)indices; \
     packed_data->args.a5 = (GLsizei)primcount; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glMultiTexCoord4f
 #define push_glMultiTexCoord4f(target, s, t, r, q) { \
-    glMultiTexCoord4f_PACKED *packed_data = malloc(sizeof(glMultiTexCoord4f_PACKED)); \
+    glMultiTexCoord4f_PACKED *packed_data = glAllocCall(glMultiTexCoord4f_FORMAT, sizeof(glMultiTexCoord4f_PACKED)); \
     packed_data->format = glMultiTexCoord4f_FORMAT; \
     packed_data->func = gl4es_glMultiTexCoord4f; \
     packed_data->args.a1 = (GLenum)target; \
@@ -5753,12 +5605,11 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a3 = (GLfloat)t; \
     packed_data->args.a4 = (GLfloat)r; \
     packed_data->args.a5 = (GLfloat)q; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glMultiTexCoord4x
 #define push_glMultiTexCoord4x(target, s, t, r, q) { \
-    glMultiTexCoord4x_PACKED *packed_data = malloc(sizeof(glMultiTexCoord4x_PACKED)); \
+    glMultiTexCoord4x_PACKED *packed_data = glAllocCall(glMultiTexCoord4x_FORMAT, sizeof(glMultiTexCoord4x_PACKED)); \
     packed_data->format = glMultiTexCoord4x_FORMAT; \
     packed_data->func = gl4es_glMultiTexCoord4x; \
     packed_data->args.a1 = (GLenum)target; \
@@ -5766,45 +5617,41 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a3 = (GLfixed)t; \
     packed_data->args.a4 = (GLfixed)r; \
     packed_data->args.a5 = (GLfixed)q; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glNormal3f
 #define push_glNormal3f(nx, ny, nz) { \
-    glNormal3f_PACKED *packed_data = malloc(sizeof(glNormal3f_PACKED)); \
+    glNormal3f_PACKED *packed_data = glAllocCall(glNormal3f_FORMAT, sizeof(glNormal3f_PACKED)); \
     packed_data->format = glNormal3f_FORMAT; \
     packed_data->func = gl4es_glNormal3f; \
     packed_data->args.a1 = (GLfloat)nx; \
     packed_data->args.a2 = (GLfloat)ny; \
     packed_data->args.a3 = (GLfloat)nz; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glNormal3x
 #define push_glNormal3x(nx, ny, nz) { \
-    glNormal3x_PACKED *packed_data = malloc(sizeof(glNormal3x_PACKED)); \
+    glNormal3x_PACKED *packed_data = glAllocCall(glNormal3x_FORMAT, sizeof(glNormal3x_PACKED)); \
     packed_data->format = glNormal3x_FORMAT; \
     packed_data->func = gl4es_glNormal3x; \
     packed_data->args.a1 = (GLfixed)nx; \
     packed_data->args.a2 = (GLfixed)ny; \
     packed_data->args.a3 = (GLfixed)nz; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glNormalPointer
 #define push_glNormalPointer(type, stride, pointer) { \
-    glNormalPointer_PACKED *packed_data = malloc(sizeof(glNormalPointer_PACKED)); \
+    glNormalPointer_PACKED *packed_data = glAllocCall(glNormalPointer_FORMAT, sizeof(glNormalPointer_PACKED)); \
     packed_data->format = glNormalPointer_FORMAT; \
     packed_data->func = gl4es_glNormalPointer; \
     packed_data->args.a1 = (GLenum)type; \
     packed_data->args.a2 = (GLsizei)stride; \
     packed_data->args.a3 = (GLvoid *)pointer; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glOrthof
 #define push_glOrthof(left, right, bottom, top, Near, Far) { \
-    glOrthof_PACKED *packed_data = malloc(sizeof(glOrthof_PACKED)); \
+    glOrthof_PACKED *packed_data = glAllocCall(glOrthof_FORMAT, sizeof(glOrthof_PACKED)); \
     packed_data->format = glOrthof_FORMAT; \
     packed_data->func = gl4es_glOrthof; \
     packed_data->args.a1 = (GLfloat)left; \
@@ -5813,12 +5660,11 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a4 = (GLfloat)top; \
     packed_data->args.a5 = (GLfloat)Near; \
     packed_data->args.a6 = (GLfloat)Far; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glOrthox
 #define push_glOrthox(left, right, bottom, top, Near, Far) { \
-    glOrthox_PACKED *packed_data = malloc(sizeof(glOrthox_PACKED)); \
+    glOrthox_PACKED *packed_data = glAllocCall(glOrthox_FORMAT, sizeof(glOrthox_PACKED)); \
     packed_data->format = glOrthox_FORMAT; \
     packed_data->func = gl4es_glOrthox; \
     packed_data->args.a1 = (GLfixed)left; \
@@ -5827,139 +5673,125 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a4 = (GLfixed)top; \
     packed_data->args.a5 = (GLfixed)Near; \
     packed_data->args.a6 = (GLfixed)Far; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glPixelStorei
 #define push_glPixelStorei(pname, param) { \
-    glPixelStorei_PACKED *packed_data = malloc(sizeof(glPixelStorei_PACKED)); \
+    glPixelStorei_PACKED *packed_data = glAllocCall(glPixelStorei_FORMAT, sizeof(glPixelStorei_PACKED)); \
     packed_data->format = glPixelStorei_FORMAT; \
     packed_data->func = gl4es_glPixelStorei; \
     packed_data->args.a1 = (GLenum)pname; \
     packed_data->args.a2 = (GLint)param; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glPointParameterf
 #define push_glPointParameterf(pname, param) { \
-    glPointParameterf_PACKED *packed_data = malloc(sizeof(glPointParameterf_PACKED)); \
+    glPointParameterf_PACKED *packed_data = glAllocCall(glPointParameterf_FORMAT, sizeof(glPointParameterf_PACKED)); \
     packed_data->format = glPointParameterf_FORMAT; \
     packed_data->func = gl4es_glPointParameterf; \
     packed_data->args.a1 = (GLenum)pname; \
     packed_data->args.a2 = (GLfloat)param; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glPointParameterfv
 #define push_glPointParameterfv(pname, params) { \
-    glPointParameterfv_PACKED *packed_data = malloc(sizeof(glPointParameterfv_PACKED)); \
+    glPointParameterfv_PACKED *packed_data = glAllocCall(glPointParameterfv_FORMAT, sizeof(glPointParameterfv_PACKED)); \
     packed_data->format = glPointParameterfv_FORMAT; \
     packed_data->func = gl4es_glPointParameterfv; \
     packed_data->args.a1 = (GLenum)pname; \
     packed_data->args.a2 = (GLfloat *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glPointParameterx
 #define push_glPointParameterx(pname, param) { \
-    glPointParameterx_PACKED *packed_data = malloc(sizeof(glPointParameterx_PACKED)); \
+    glPointParameterx_PACKED *packed_data = glAllocCall(glPointParameterx_FORMAT, sizeof(glPointParameterx_PACKED)); \
     packed_data->format = glPointParameterx_FORMAT; \
     packed_data->func = gl4es_glPointParameterx; \
     packed_data->args.a1 = (GLenum)pname; \
     packed_data->args.a2 = (GLfixed)param; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glPointParameterxv
 #define push_glPointParameterxv(pname, params) { \
-    glPointParameterxv_PACKED *packed_data = malloc(sizeof(glPointParameterxv_PACKED)); \
+    glPointParameterxv_PACKED *packed_data = glAllocCall(glPointParameterxv_FORMAT, sizeof(glPointParameterxv_PACKED)); \
     packed_data->format = glPointParameterxv_FORMAT; \
     packed_data->func = gl4es_glPointParameterxv; \
     packed_data->args.a1 = (GLenum)pname; \
     packed_data->args.a2 = (GLfixed *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glPointSize
 #define push_glPointSize(size) { \
-    glPointSize_PACKED *packed_data = malloc(sizeof(glPointSize_PACKED)); \
+    glPointSize_PACKED *packed_data = glAllocCall(glPointSize_FORMAT, sizeof(glPointSize_PACKED)); \
     packed_data->format = glPointSize_FORMAT; \
     packed_data->func = gl4es_glPointSize; \
     packed_data->args.a1 = (GLfloat)size; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glPointSizePointerOES
 #define push_glPointSizePointerOES(type, stride, pointer) { \
-    glPointSizePointerOES_PACKED *packed_data = malloc(sizeof(glPointSizePointerOES_PACKED)); \
+    glPointSizePointerOES_PACKED *packed_data = glAllocCall(glPointSizePointerOES_FORMAT, sizeof(glPointSizePointerOES_PACKED)); \
     packed_data->format = glPointSizePointerOES_FORMAT; \
     packed_data->func = gl4es_glPointSizePointerOES; \
     packed_data->args.a1 = (GLenum)type; \
     packed_data->args.a2 = (GLsizei)stride; \
     packed_data->args.a3 = (GLvoid *)pointer; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glPointSizex
 #define push_glPointSizex(size) { \
-    glPointSizex_PACKED *packed_data = malloc(sizeof(glPointSizex_PACKED)); \
+    glPointSizex_PACKED *packed_data = glAllocCall(glPointSizex_FORMAT, sizeof(glPointSizex_PACKED)); \
     packed_data->format = glPointSizex_FORMAT; \
     packed_data->func = gl4es_glPointSizex; \
     packed_data->args.a1 = (GLfixed)size; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glPolygonOffset
 #define push_glPolygonOffset(factor, units) { \
-    glPolygonOffset_PACKED *packed_data = malloc(sizeof(glPolygonOffset_PACKED)); \
+    glPolygonOffset_PACKED *packed_data = glAllocCall(glPolygonOffset_FORMAT, sizeof(glPolygonOffset_PACKED)); \
     packed_data->format = glPolygonOffset_FORMAT; \
     packed_data->func = gl4es_glPolygonOffset; \
     packed_data->args.a1 = (GLfloat)factor; \
     packed_data->args.a2 = (GLfloat)units; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glPolygonOffsetx
 #define push_glPolygonOffsetx(factor, units) { \
-    glPolygonOffsetx_PACKED *packed_data = malloc(sizeof(glPolygonOffsetx_PACKED)); \
+    glPolygonOffsetx_PACKED *packed_data = glAllocCall(glPolygonOffsetx_FORMAT, sizeof(glPolygonOffsetx_PACKED)); \
     packed_data->format = glPolygonOffsetx_FORMAT; \
     packed_data->func = gl4es_glPolygonOffsetx; \
     packed_data->args.a1 = (GLfixed)factor; \
     packed_data->args.a2 = (GLfixed)units; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glPopMatrix
 #define push_glPopMatrix() { \
-    glPopMatrix_PACKED *packed_data = malloc(sizeof(glPopMatrix_PACKED)); \
+    glPopMatrix_PACKED *packed_data = glAllocCall(glPopMatrix_FORMAT, sizeof(glPopMatrix_PACKED)); \
     packed_data->format = glPopMatrix_FORMAT; \
     packed_data->func = gl4es_glPopMatrix; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glProgramBinary
 #define push_glProgramBinary(program, binaryFormat, binary, length) { \
-    glProgramBinary_PACKED *packed_data = malloc(sizeof(glProgramBinary_PACKED)); \
+    glProgramBinary_PACKED *packed_data = glAllocCall(glProgramBinary_FORMAT, sizeof(glProgramBinary_PACKED)); \
     packed_data->format = glProgramBinary_FORMAT; \
     packed_data->func = gl4es_glProgramBinary; \
     packed_data->args.a1 = (GLuint)program; \
     packed_data->args.a2 = (GLenum)binaryFormat; \
     packed_data->args.a3 = (GLvoid *)binary; \
     packed_data->args.a4 = (GLint)length; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glPushMatrix
 #define push_glPushMatrix() { \
-    glPushMatrix_PACKED *packed_data = malloc(sizeof(glPushMatrix_PACKED)); \
+    glPushMatrix_PACKED *packed_data = glAllocCall(glPushMatrix_FORMAT, sizeof(glPushMatrix_PACKED)); \
     packed_data->format = glPushMatrix_FORMAT; \
     packed_data->func = gl4es_glPushMatrix; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glReadPixels
 #define push_glReadPixels(x, y, width, height, format, type, pixels) { \
-    glReadPixels_PACKED *packed_data = malloc(sizeof(glReadPixels_PACKED)); \
+    glReadPixels_PACKED *packed_data = glAllocCall(glReadPixels_FORMAT, sizeof(glReadPixels_PACKED)); \
     packed_data->format = glReadPixels_FORMAT; \
     packed_data->func = gl4es_glReadPixels; \
     packed_data->args.a1 = (GLint)x; \
@@ -5969,119 +5801,108 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a5 = (GLenum)format; \
     packed_data->args.a6 = (GLenum)type; \
     packed_data->args.a7 = (GLvoid *)pixels; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glReleaseShaderCompiler
 #define push_glReleaseShaderCompiler() { \
-    glReleaseShaderCompiler_PACKED *packed_data = malloc(sizeof(glReleaseShaderCompiler_PACKED)); \
+    glReleaseShaderCompiler_PACKED *packed_data = glAllocCall(glReleaseShaderCompiler_FORMAT, sizeof(glReleaseShaderCompiler_PACKED)); \
     packed_data->format = glReleaseShaderCompiler_FORMAT; \
     packed_data->func = gl4es_glReleaseShaderCompiler; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glRenderbufferStorage
 #define push_glRenderbufferStorage(target, internalformat, width, height) { \
-    glRenderbufferStorage_PACKED *packed_data = malloc(sizeof(glRenderbufferStorage_PACKED)); \
+    glRenderbufferStorage_PACKED *packed_data = glAllocCall(glRenderbufferStorage_FORMAT, sizeof(glRenderbufferStorage_PACKED)); \
     packed_data->format = glRenderbufferStorage_FORMAT; \
     packed_data->func = gl4es_glRenderbufferStorage; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLenum)internalformat; \
     packed_data->args.a3 = (GLsizei)width; \
     packed_data->args.a4 = (GLsizei)height; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glRotatef
 #define push_glRotatef(angle, x, y, z) { \
-    glRotatef_PACKED *packed_data = malloc(sizeof(glRotatef_PACKED)); \
+    glRotatef_PACKED *packed_data = glAllocCall(glRotatef_FORMAT, sizeof(glRotatef_PACKED)); \
     packed_data->format = glRotatef_FORMAT; \
     packed_data->func = gl4es_glRotatef; \
     packed_data->args.a1 = (GLfloat)angle; \
     packed_data->args.a2 = (GLfloat)x; \
     packed_data->args.a3 = (GLfloat)y; \
     packed_data->args.a4 = (GLfloat)z; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glRotatex
 #define push_glRotatex(angle, x, y, z) { \
-    glRotatex_PACKED *packed_data = malloc(sizeof(glRotatex_PACKED)); \
+    glRotatex_PACKED *packed_data = glAllocCall(glRotatex_FORMAT, sizeof(glRotatex_PACKED)); \
     packed_data->format = glRotatex_FORMAT; \
     packed_data->func = gl4es_glRotatex; \
     packed_data->args.a1 = (GLfixed)angle; \
     packed_data->args.a2 = (GLfixed)x; \
     packed_data->args.a3 = (GLfixed)y; \
     packed_data->args.a4 = (GLfixed)z; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glSampleCoverage
 #define push_glSampleCoverage(value, invert) { \
-    glSampleCoverage_PACKED *packed_data = malloc(sizeof(glSampleCoverage_PACKED)); \
+    glSampleCoverage_PACKED *packed_data = glAllocCall(glSampleCoverage_FORMAT, sizeof(glSampleCoverage_PACKED)); \
     packed_data->format = glSampleCoverage_FORMAT; \
     packed_data->func = gl4es_glSampleCoverage; \
     packed_data->args.a1 = (GLclampf)value; \
     packed_data->args.a2 = (GLboolean)invert; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glSampleCoveragex
 #define push_glSampleCoveragex(value, invert) { \
-    glSampleCoveragex_PACKED *packed_data = malloc(sizeof(glSampleCoveragex_PACKED)); \
+    glSampleCoveragex_PACKED *packed_data = glAllocCall(glSampleCoveragex_FORMAT, sizeof(glSampleCoveragex_PACKED)); \
     packed_data->format = glSampleCoveragex_FORMAT; \
     packed_data->func = gl4es_glSampleCoveragex; \
     packed_data->args.a1 = (GLclampx)value; \
     packed_data->args.a2 = (GLboolean)invert; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glScalef
 #define push_glScalef(x, y, z) { \
-    glScalef_PACKED *packed_data = malloc(sizeof(glScalef_PACKED)); \
+    glScalef_PACKED *packed_data = glAllocCall(glScalef_FORMAT, sizeof(glScalef_PACKED)); \
     packed_data->format = glScalef_FORMAT; \
     packed_data->func = gl4es_glScalef; \
     packed_data->args.a1 = (GLfloat)x; \
     packed_data->args.a2 = (GLfloat)y; \
     packed_data->args.a3 = (GLfloat)z; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glScalex
 #define push_glScalex(x, y, z) { \
-    glScalex_PACKED *packed_data = malloc(sizeof(glScalex_PACKED)); \
+    glScalex_PACKED *packed_data = glAllocCall(glScalex_FORMAT, sizeof(glScalex_PACKED)); \
     packed_data->format = glScalex_FORMAT; \
     packed_data->func = gl4es_glScalex; \
     packed_data->args.a1 = (GLfixed)x; \
     packed_data->args.a2 = (GLfixed)y; \
     packed_data->args.a3 = (GLfixed)z; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glScissor
 #define push_glScissor(x, y, width, height) { \
-    glScissor_PACKED *packed_data = malloc(sizeof(glScissor_PACKED)); \
+    glScissor_PACKED *packed_data = glAllocCall(glScissor_FORMAT, sizeof(glScissor_PACKED)); \
     packed_data->format = glScissor_FORMAT; \
     packed_data->func = gl4es_glScissor; \
     packed_data->args.a1 = (GLint)x; \
     packed_data->args.a2 = (GLint)y; \
     packed_data->args.a3 = (GLsizei)width; \
     packed_data->args.a4 = (GLsizei)height; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glShadeModel
 #define push_glShadeModel(mode) { \
-    glShadeModel_PACKED *packed_data = malloc(sizeof(glShadeModel_PACKED)); \
+    glShadeModel_PACKED *packed_data = glAllocCall(glShadeModel_FORMAT, sizeof(glShadeModel_PACKED)); \
     packed_data->format = glShadeModel_FORMAT; \
     packed_data->func = gl4es_glShadeModel; \
     packed_data->args.a1 = (GLenum)mode; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glShaderBinary
 #define push_glShaderBinary(n, shaders, binaryformat, binary, length) { \
-    glShaderBinary_PACKED *packed_data = malloc(sizeof(glShaderBinary_PACKED)); \
+    glShaderBinary_PACKED *packed_data = glAllocCall(glShaderBinary_FORMAT, sizeof(glShaderBinary_PACKED)); \
     packed_data->format = glShaderBinary_FORMAT; \
     packed_data->func = gl4es_glShaderBinary; \
     packed_data->args.a1 = (GLsizei)n; \
@@ -6089,189 +5910,172 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a3 = (GLenum)binaryformat; \
     packed_data->args.a4 = (GLvoid *)binary; \
     packed_data->args.a5 = (GLsizei)length; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glShaderSource
 #define push_glShaderSource(shader, count, string, length) { \
-    glShaderSource_PACKED *packed_data = malloc(sizeof(glShaderSource_PACKED)); \
+    glShaderSource_PACKED *packed_data = glAllocCall(glShaderSource_FORMAT, sizeof(glShaderSource_PACKED)); \
     packed_data->format = glShaderSource_FORMAT; \
     packed_data->func = gl4es_glShaderSource; \
     packed_data->args.a1 = (GLuint)shader; \
     packed_data->args.a2 = (GLsizei)count; \
     packed_data->args.a3 = (GLchar * *)string; \
     packed_data->args.a4 = (GLint *)length; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glStencilFunc
 #define push_glStencilFunc(func, ref, mask) { \
-    glStencilFunc_PACKED *packed_data = malloc(sizeof(glStencilFunc_PACKED)); \
+    glStencilFunc_PACKED *packed_data = glAllocCall(glStencilFunc_FORMAT, sizeof(glStencilFunc_PACKED)); \
     packed_data->format = glStencilFunc_FORMAT; \
     packed_data->func = gl4es_glStencilFunc; \
     packed_data->args.a1 = (GLenum)func; \
     packed_data->args.a2 = (GLint)ref; \
     packed_data->args.a3 = (GLuint)mask; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glStencilFuncSeparate
 #define push_glStencilFuncSeparate(face, func, ref, mask) { \
-    glStencilFuncSeparate_PACKED *packed_data = malloc(sizeof(glStencilFuncSeparate_PACKED)); \
+    glStencilFuncSeparate_PACKED *packed_data = glAllocCall(glStencilFuncSeparate_FORMAT, sizeof(glStencilFuncSeparate_PACKED)); \
     packed_data->format = glStencilFuncSeparate_FORMAT; \
     packed_data->func = gl4es_glStencilFuncSeparate; \
     packed_data->args.a1 = (GLenum)face; \
     packed_data->args.a2 = (GLenum)func; \
     packed_data->args.a3 = (GLint)ref; \
     packed_data->args.a4 = (GLuint)mask; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glStencilMask
 #define push_glStencilMask(mask) { \
-    glStencilMask_PACKED *packed_data = malloc(sizeof(glStencilMask_PACKED)); \
+    glStencilMask_PACKED *packed_data = glAllocCall(glStencilMask_FORMAT, sizeof(glStencilMask_PACKED)); \
     packed_data->format = glStencilMask_FORMAT; \
     packed_data->func = gl4es_glStencilMask; \
     packed_data->args.a1 = (GLuint)mask; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glStencilMaskSeparate
 #define push_glStencilMaskSeparate(face, mask) { \
-    glStencilMaskSeparate_PACKED *packed_data = malloc(sizeof(glStencilMaskSeparate_PACKED)); \
+    glStencilMaskSeparate_PACKED *packed_data = glAllocCall(glStencilMaskSeparate_FORMAT, sizeof(glStencilMaskSeparate_PACKED)); \
     packed_data->format = glStencilMaskSeparate_FORMAT; \
     packed_data->func = gl4es_glStencilMaskSeparate; \
     packed_data->args.a1 = (GLenum)face; \
     packed_data->args.a2 = (GLuint)mask; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glStencilOp
 #define push_glStencilOp(fail, zfail, zpass) { \
-    glStencilOp_PACKED *packed_data = malloc(sizeof(glStencilOp_PACKED)); \
+    glStencilOp_PACKED *packed_data = glAllocCall(glStencilOp_FORMAT, sizeof(glStencilOp_PACKED)); \
     packed_data->format = glStencilOp_FORMAT; \
     packed_data->func = gl4es_glStencilOp; \
     packed_data->args.a1 = (GLenum)fail; \
     packed_data->args.a2 = (GLenum)zfail; \
     packed_data->args.a3 = (GLenum)zpass; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glStencilOpSeparate
 #define push_glStencilOpSeparate(face, sfail, zfail, zpass) { \
-    glStencilOpSeparate_PACKED *packed_data = malloc(sizeof(glStencilOpSeparate_PACKED)); \
+    glStencilOpSeparate_PACKED *packed_data = glAllocCall(glStencilOpSeparate_FORMAT, sizeof(glStencilOpSeparate_PACKED)); \
     packed_data->format = glStencilOpSeparate_FORMAT; \
     packed_data->func = gl4es_glStencilOpSeparate; \
     packed_data->args.a1 = (GLenum)face; \
     packed_data->args.a2 = (GLenum)sfail; \
     packed_data->args.a3 = (GLenum)zfail; \
     packed_data->args.a4 = (GLenum)zpass; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glTexCoordPointer
 #define push_glTexCoordPointer(size, type, stride, pointer) { \
-    glTexCoordPointer_PACKED *packed_data = malloc(sizeof(glTexCoordPointer_PACKED)); \
+    glTexCoordPointer_PACKED *packed_data = glAllocCall(glTexCoordPointer_FORMAT, sizeof(glTexCoordPointer_PACKED)); \
     packed_data->format = glTexCoordPointer_FORMAT; \
     packed_data->func = gl4es_glTexCoordPointer; \
     packed_data->args.a1 = (GLint)size; \
     packed_data->args.a2 = (GLenum)type; \
     packed_data->args.a3 = (GLsizei)stride; \
     packed_data->args.a4 = (GLvoid *)pointer; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glTexEnvf
 #define push_glTexEnvf(target, pname, param) { \
-    glTexEnvf_PACKED *packed_data = malloc(sizeof(glTexEnvf_PACKED)); \
+    glTexEnvf_PACKED *packed_data = glAllocCall(glTexEnvf_FORMAT, sizeof(glTexEnvf_PACKED)); \
     packed_data->format = glTexEnvf_FORMAT; \
     packed_data->func = gl4es_glTexEnvf; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfloat)param; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glTexEnvfv
 #define push_glTexEnvfv(target, pname, params) { \
-    glTexEnvfv_PACKED *packed_data = malloc(sizeof(glTexEnvfv_PACKED)); \
+    glTexEnvfv_PACKED *packed_data = glAllocCall(glTexEnvfv_FORMAT, sizeof(glTexEnvfv_PACKED)); \
     packed_data->format = glTexEnvfv_FORMAT; \
     packed_data->func = gl4es_glTexEnvfv; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfloat *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glTexEnvi
 #define push_glTexEnvi(target, pname, param) { \
-    glTexEnvi_PACKED *packed_data = malloc(sizeof(glTexEnvi_PACKED)); \
+    glTexEnvi_PACKED *packed_data = glAllocCall(glTexEnvi_FORMAT, sizeof(glTexEnvi_PACKED)); \
     packed_data->format = glTexEnvi_FORMAT; \
     packed_data->func = gl4es_glTexEnvi; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLint)param; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glTexEnviv
 #define push_glTexEnviv(target, pname, params) { \
-    glTexEnviv_PACKED *packed_data = malloc(sizeof(glTexEnviv_PACKED)); \
+    glTexEnviv_PACKED *packed_data = glAllocCall(glTexEnviv_FORMAT, sizeof(glTexEnviv_PACKED)); \
     packed_data->format = glTexEnviv_FORMAT; \
     packed_data->func = gl4es_glTexEnviv; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLint *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glTexEnvx
 #define push_glTexEnvx(target, pname, param) { \
-    glTexEnvx_PACKED *packed_data = malloc(sizeof(glTexEnvx_PACKED)); \
+    glTexEnvx_PACKED *packed_data = glAllocCall(glTexEnvx_FORMAT, sizeof(glTexEnvx_PACKED)); \
     packed_data->format = glTexEnvx_FORMAT; \
     packed_data->func = gl4es_glTexEnvx; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfixed)param; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glTexEnvxv
 #define push_glTexEnvxv(target, pname, params) { \
-    glTexEnvxv_PACKED *packed_data = malloc(sizeof(glTexEnvxv_PACKED)); \
+    glTexEnvxv_PACKED *packed_data = glAllocCall(glTexEnvxv_FORMAT, sizeof(glTexEnvxv_PACKED)); \
     packed_data->format = glTexEnvxv_FORMAT; \
     packed_data->func = gl4es_glTexEnvxv; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfixed *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glTexGenfv
 #define push_glTexGenfv(coord, pname, params) { \
-    glTexGenfv_PACKED *packed_data = malloc(sizeof(glTexGenfv_PACKED)); \
+    glTexGenfv_PACKED *packed_data = glAllocCall(glTexGenfv_FORMAT, sizeof(glTexGenfv_PACKED)); \
     packed_data->format = glTexGenfv_FORMAT; \
     packed_data->func = gl4es_glTexGenfv; \
     packed_data->args.a1 = (GLenum)coord; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfloat *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glTexGeni
 #define push_glTexGeni(coord, pname, param) { \
-    glTexGeni_PACKED *packed_data = malloc(sizeof(glTexGeni_PACKED)); \
+    glTexGeni_PACKED *packed_data = glAllocCall(glTexGeni_FORMAT, sizeof(glTexGeni_PACKED)); \
     packed_data->format = glTexGeni_FORMAT; \
     packed_data->func = gl4es_glTexGeni; \
     packed_data->args.a1 = (GLenum)coord; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLint)param; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glTexImage2D
 #define push_glTexImage2D(target, level, internalformat, width, height, border, format, type, data) { \
-    glTexImage2D_PACKED *packed_data = malloc(sizeof(glTexImage2D_PACKED)); \
+    glTexImage2D_PACKED *packed_data = glAllocCall(glTexImage2D_FORMAT, sizeof(glTexImage2D_PACKED)); \
     packed_data->format = glTexImage2D_FORMAT; \
     packed_data->func = gl4es_glTexImage2D; \
     packed_data->args.a1 = (GLenum)target; \
@@ -6283,78 +6087,71 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a7 = (GLenum)format; \
     packed_data->args.a8 = (GLenum)type; \
     packed_data->args.a9 = (GLvoid *)data; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glTexParameterf
 #define push_glTexParameterf(target, pname, param) { \
-    glTexParameterf_PACKED *packed_data = malloc(sizeof(glTexParameterf_PACKED)); \
+    glTexParameterf_PACKED *packed_data = glAllocCall(glTexParameterf_FORMAT, sizeof(glTexParameterf_PACKED)); \
     packed_data->format = glTexParameterf_FORMAT; \
     packed_data->func = gl4es_glTexParameterf; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfloat)param; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glTexParameterfv
 #define push_glTexParameterfv(target, pname, params) { \
-    glTexParameterfv_PACKED *packed_data = malloc(sizeof(glTexParameterfv_PACKED)); \
+    glTexParameterfv_PACKED *packed_data = glAllocCall(glTexParameterfv_FORMAT, sizeof(glTexParameterfv_PACKED)); \
     packed_data->format = glTexParameterfv_FORMAT; \
     packed_data->func = gl4es_glTexParameterfv; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfloat *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glTexParameteri
 #define push_glTexParameteri(target, pname, param) { \
-    glTexParameteri_PACKED *packed_data = malloc(sizeof(glTexParameteri_PACKED)); \
+    glTexParameteri_PACKED *packed_data = glAllocCall(glTexParameteri_FORMAT, sizeof(glTexParameteri_PACKED)); \
     packed_data->format = glTexParameteri_FORMAT; \
     packed_data->func = gl4es_glTexParameteri; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLint)param; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glTexParameteriv
 #define push_glTexParameteriv(target, pname, params) { \
-    glTexParameteriv_PACKED *packed_data = malloc(sizeof(glTexParameteriv_PACKED)); \
+    glTexParameteriv_PACKED *packed_data = glAllocCall(glTexParameteriv_FORMAT, sizeof(glTexParameteriv_PACKED)); \
     packed_data->format = glTexParameteriv_FORMAT; \
     packed_data->func = gl4es_glTexParameteriv; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLint *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glTexParameterx
 #define push_glTexParameterx(target, pname, param) { \
-    glTexParameterx_PACKED *packed_data = malloc(sizeof(glTexParameterx_PACKED)); \
+    glTexParameterx_PACKED *packed_data = glAllocCall(glTexParameterx_FORMAT, sizeof(glTexParameterx_PACKED)); \
     packed_data->format = glTexParameterx_FORMAT; \
     packed_data->func = gl4es_glTexParameterx; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfixed)param; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glTexParameterxv
 #define push_glTexParameterxv(target, pname, params) { \
-    glTexParameterxv_PACKED *packed_data = malloc(sizeof(glTexParameterxv_PACKED)); \
+    glTexParameterxv_PACKED *packed_data = glAllocCall(glTexParameterxv_FORMAT, sizeof(glTexParameterxv_PACKED)); \
     packed_data->format = glTexParameterxv_FORMAT; \
     packed_data->func = gl4es_glTexParameterxv; \
     packed_data->args.a1 = (GLenum)target; \
     packed_data->args.a2 = (GLenum)pname; \
     packed_data->args.a3 = (GLfixed *)params; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glTexSubImage2D
 #define push_glTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, data) { \
-    glTexSubImage2D_PACKED *packed_data = malloc(sizeof(glTexSubImage2D_PACKED)); \
+    glTexSubImage2D_PACKED *packed_data = glAllocCall(glTexSubImage2D_FORMAT, sizeof(glTexSubImage2D_PACKED)); \
     packed_data->format = glTexSubImage2D_FORMAT; \
     packed_data->func = gl4es_glTexSubImage2D; \
     packed_data->args.a1 = (GLenum)target; \
@@ -6366,166 +6163,151 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a7 = (GLenum)format; \
     packed_data->args.a8 = (GLenum)type; \
     packed_data->args.a9 = (GLvoid *)data; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glTranslatef
 #define push_glTranslatef(x, y, z) { \
-    glTranslatef_PACKED *packed_data = malloc(sizeof(glTranslatef_PACKED)); \
+    glTranslatef_PACKED *packed_data = glAllocCall(glTranslatef_FORMAT, sizeof(glTranslatef_PACKED)); \
     packed_data->format = glTranslatef_FORMAT; \
     packed_data->func = gl4es_glTranslatef; \
     packed_data->args.a1 = (GLfloat)x; \
     packed_data->args.a2 = (GLfloat)y; \
     packed_data->args.a3 = (GLfloat)z; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glTranslatex
 #define push_glTranslatex(x, y, z) { \
-    glTranslatex_PACKED *packed_data = malloc(sizeof(glTranslatex_PACKED)); \
+    glTranslatex_PACKED *packed_data = glAllocCall(glTranslatex_FORMAT, sizeof(glTranslatex_PACKED)); \
     packed_data->format = glTranslatex_FORMAT; \
     packed_data->func = gl4es_glTranslatex; \
     packed_data->args.a1 = (GLfixed)x; \
     packed_data->args.a2 = (GLfixed)y; \
     packed_data->args.a3 = (GLfixed)z; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glUniform1f
 #define push_glUniform1f(location, v0) { \
-    glUniform1f_PACKED *packed_data = malloc(sizeof(glUniform1f_PACKED)); \
+    glUniform1f_PACKED *packed_data = glAllocCall(glUniform1f_FORMAT, sizeof(glUniform1f_PACKED)); \
     packed_data->format = glUniform1f_FORMAT; \
     packed_data->func = gl4es_glUniform1f; \
     packed_data->args.a1 = (GLint)location; \
     packed_data->args.a2 = (GLfloat)v0; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glUniform1fv
 #define push_glUniform1fv(location, count, value) { \
-    glUniform1fv_PACKED *packed_data = malloc(sizeof(glUniform1fv_PACKED)); \
+    glUniform1fv_PACKED *packed_data = glAllocCall(glUniform1fv_FORMAT, sizeof(glUniform1fv_PACKED)); \
     packed_data->format = glUniform1fv_FORMAT; \
     packed_data->func = gl4es_glUniform1fv; \
     packed_data->args.a1 = (GLint)location; \
     packed_data->args.a2 = (GLsizei)count; \
     packed_data->args.a3 = (GLfloat *)value; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glUniform1i
 #define push_glUniform1i(location, v0) { \
-    glUniform1i_PACKED *packed_data = malloc(sizeof(glUniform1i_PACKED)); \
+    glUniform1i_PACKED *packed_data = glAllocCall(glUniform1i_FORMAT, sizeof(glUniform1i_PACKED)); \
     packed_data->format = glUniform1i_FORMAT; \
     packed_data->func = gl4es_glUniform1i; \
     packed_data->args.a1 = (GLint)location; \
     packed_data->args.a2 = (GLint)v0; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glUniform1iv
 #define push_glUniform1iv(location, count, value) { \
-    glUniform1iv_PACKED *packed_data = malloc(sizeof(glUniform1iv_PACKED)); \
+    glUniform1iv_PACKED *packed_data = glAllocCall(glUniform1iv_FORMAT, sizeof(glUniform1iv_PACKED)); \
     packed_data->format = glUniform1iv_FORMAT; \
     packed_data->func = gl4es_glUniform1iv; \
     packed_data->args.a1 = (GLint)location; \
     packed_data->args.a2 = (GLsizei)count; \
     packed_data->args.a3 = (GLint *)value; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glUniform2f
 #define push_glUniform2f(location, v0, v1) { \
-    glUniform2f_PACKED *packed_data = malloc(sizeof(glUniform2f_PACKED)); \
+    glUniform2f_PACKED *packed_data = glAllocCall(glUniform2f_FORMAT, sizeof(glUniform2f_PACKED)); \
     packed_data->format = glUniform2f_FORMAT; \
     packed_data->func = gl4es_glUniform2f; \
     packed_data->args.a1 = (GLint)location; \
     packed_data->args.a2 = (GLfloat)v0; \
     packed_data->args.a3 = (GLfloat)v1; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glUniform2fv
 #define push_glUniform2fv(location, count, value) { \
-    glUniform2fv_PACKED *packed_data = malloc(sizeof(glUniform2fv_PACKED)); \
+    glUniform2fv_PACKED *packed_data = glAllocCall(glUniform2fv_FORMAT, sizeof(glUniform2fv_PACKED)); \
     packed_data->format = glUniform2fv_FORMAT; \
     packed_data->func = gl4es_glUniform2fv; \
     packed_data->args.a1 = (GLint)location; \
     packed_data->args.a2 = (GLsizei)count; \
     packed_data->args.a3 = (GLfloat *)value; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glUniform2i
 #define push_glUniform2i(location, v0, v1) { \
-    glUniform2i_PACKED *packed_data = malloc(sizeof(glUniform2i_PACKED)); \
+    glUniform2i_PACKED *packed_data = glAllocCall(glUniform2i_FORMAT, sizeof(glUniform2i_PACKED)); \
     packed_data->format = glUniform2i_FORMAT; \
     packed_data->func = gl4es_glUniform2i; \
     packed_data->args.a1 = (GLint)location; \
     packed_data->args.a2 = (GLint)v0; \
     packed_data->args.a3 = (GLint)v1; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glUniform2iv
 #define push_glUniform2iv(location, count, value) { \
-    glUniform2iv_PACKED *packed_data = malloc(sizeof(glUniform2iv_PACKED)); \
+    glUniform2iv_PACKED *packed_data = glAllocCall(glUniform2iv_FORMAT, sizeof(glUniform2iv_PACKED)); \
     packed_data->format = glUniform2iv_FORMAT; \
     packed_data->func = gl4es_glUniform2iv; \
     packed_data->args.a1 = (GLint)location; \
     packed_data->args.a2 = (GLsizei)count; \
     packed_data->args.a3 = (GLint *)value; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glUniform3f
 #define push_glUniform3f(location, v0, v1, v2) { \
-    glUniform3f_PACKED *packed_data = malloc(sizeof(glUniform3f_PACKED)); \
+    glUniform3f_PACKED *packed_data = glAllocCall(glUniform3f_FORMAT, sizeof(glUniform3f_PACKED)); \
     packed_data->format = glUniform3f_FORMAT; \
     packed_data->func = gl4es_glUniform3f; \
     packed_data->args.a1 = (GLint)location; \
     packed_data->args.a2 = (GLfloat)v0; \
     packed_data->args.a3 = (GLfloat)v1; \
     packed_data->args.a4 = (GLfloat)v2; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glUniform3fv
 #define push_glUniform3fv(location, count, value) { \
-    glUniform3fv_PACKED *packed_data = malloc(sizeof(glUniform3fv_PACKED)); \
+    glUniform3fv_PACKED *packed_data = glAllocCall(glUniform3fv_FORMAT, sizeof(glUniform3fv_PACKED)); \
     packed_data->format = glUniform3fv_FORMAT; \
     packed_data->func = gl4es_glUniform3fv; \
     packed_data->args.a1 = (GLint)location; \
     packed_data->args.a2 = (GLsizei)count; \
     packed_data->args.a3 = (GLfloat *)value; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glUniform3i
 #define push_glUniform3i(location, v0, v1, v2) { \
-    glUniform3i_PACKED *packed_data = malloc(sizeof(glUniform3i_PACKED)); \
+    glUniform3i_PACKED *packed_data = glAllocCall(glUniform3i_FORMAT, sizeof(glUniform3i_PACKED)); \
     packed_data->format = glUniform3i_FORMAT; \
     packed_data->func = gl4es_glUniform3i; \
     packed_data->args.a1 = (GLint)location; \
     packed_data->args.a2 = (GLint)v0; \
     packed_data->args.a3 = (GLint)v1; \
     packed_data->args.a4 = (GLint)v2; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glUniform3iv
 #define push_glUniform3iv(location, count, value) { \
-    glUniform3iv_PACKED *packed_data = malloc(sizeof(glUniform3iv_PACKED)); \
+    glUniform3iv_PACKED *packed_data = glAllocCall(glUniform3iv_FORMAT, sizeof(glUniform3iv_PACKED)); \
     packed_data->format = glUniform3iv_FORMAT; \
     packed_data->func = gl4es_glUniform3iv; \
     packed_data->args.a1 = (GLint)location; \
     packed_data->args.a2 = (GLsizei)count; \
     packed_data->args.a3 = (GLint *)value; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glUniform4f
 #define push_glUniform4f(location, v0, v1, v2, v3) { \
-    glUniform4f_PACKED *packed_data = malloc(sizeof(glUniform4f_PACKED)); \
+    glUniform4f_PACKED *packed_data = glAllocCall(glUniform4f_FORMAT, sizeof(glUniform4f_PACKED)); \
     packed_data->format = glUniform4f_FORMAT; \
     packed_data->func = gl4es_glUniform4f; \
     packed_data->args.a1 = (GLint)location; \
@@ -6533,23 +6315,21 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a3 = (GLfloat)v1; \
     packed_data->args.a4 = (GLfloat)v2; \
     packed_data->args.a5 = (GLfloat)v3; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glUniform4fv
 #define push_glUniform4fv(location, count, value) { \
-    glUniform4fv_PACKED *packed_data = malloc(sizeof(glUniform4fv_PACKED)); \
+    glUniform4fv_PACKED *packed_data = glAllocCall(glUniform4fv_FORMAT, sizeof(glUniform4fv_PACKED)); \
     packed_data->format = glUniform4fv_FORMAT; \
     packed_data->func = gl4es_glUniform4fv; \
     packed_data->args.a1 = (GLint)location; \
     packed_data->args.a2 = (GLsizei)count; \
     packed_data->args.a3 = (GLfloat *)value; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glUniform4i
 #define push_glUniform4i(location, v0, v1, v2, v3) { \
-    glUniform4i_PACKED *packed_data = malloc(sizeof(glUniform4i_PACKED)); \
+    glUniform4i_PACKED *packed_data = glAllocCall(glUniform4i_FORMAT, sizeof(glUniform4i_PACKED)); \
     packed_data->format = glUniform4i_FORMAT; \
     packed_data->func = gl4es_glUniform4i; \
     packed_data->args.a1 = (GLint)location; \
@@ -6557,140 +6337,127 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a3 = (GLint)v1; \
     packed_data->args.a4 = (GLint)v2; \
     packed_data->args.a5 = (GLint)v3; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glUniform4iv
 #define push_glUniform4iv(location, count, value) { \
-    glUniform4iv_PACKED *packed_data = malloc(sizeof(glUniform4iv_PACKED)); \
+    glUniform4iv_PACKED *packed_data = glAllocCall(glUniform4iv_FORMAT, sizeof(glUniform4iv_PACKED)); \
     packed_data->format = glUniform4iv_FORMAT; \
     packed_data->func = gl4es_glUniform4iv; \
     packed_data->args.a1 = (GLint)location; \
     packed_data->args.a2 = (GLsizei)count; \
     packed_data->args.a3 = (GLint *)value; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glUniformMatrix2fv
 #define push_glUniformMatrix2fv(location, count, transpose, value) { \
-    glUniformMatrix2fv_PACKED *packed_data = malloc(sizeof(glUniformMatrix2fv_PACKED)); \
+    glUniformMatrix2fv_PACKED *packed_data = glAllocCall(glUniformMatrix2fv_FORMAT, sizeof(glUniformMatrix2fv_PACKED)); \
     packed_data->format = glUniformMatrix2fv_FORMAT; \
     packed_data->func = gl4es_glUniformMatrix2fv; \
     packed_data->args.a1 = (GLint)location; \
     packed_data->args.a2 = (GLsizei)count; \
     packed_data->args.a3 = (GLboolean)transpose; \
     packed_data->args.a4 = (GLfloat *)value; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glUniformMatrix3fv
 #define push_glUniformMatrix3fv(location, count, transpose, value) { \
-    glUniformMatrix3fv_PACKED *packed_data = malloc(sizeof(glUniformMatrix3fv_PACKED)); \
+    glUniformMatrix3fv_PACKED *packed_data = glAllocCall(glUniformMatrix3fv_FORMAT, sizeof(glUniformMatrix3fv_PACKED)); \
     packed_data->format = glUniformMatrix3fv_FORMAT; \
     packed_data->func = gl4es_glUniformMatrix3fv; \
     packed_data->args.a1 = (GLint)location; \
     packed_data->args.a2 = (GLsizei)count; \
     packed_data->args.a3 = (GLboolean)transpose; \
     packed_data->args.a4 = (GLfloat *)value; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glUniformMatrix4fv
 #define push_glUniformMatrix4fv(location, count, transpose, value) { \
-    glUniformMatrix4fv_PACKED *packed_data = malloc(sizeof(glUniformMatrix4fv_PACKED)); \
+    glUniformMatrix4fv_PACKED *packed_data = glAllocCall(glUniformMatrix4fv_FORMAT, sizeof(glUniformMatrix4fv_PACKED)); \
     packed_data->format = glUniformMatrix4fv_FORMAT; \
     packed_data->func = gl4es_glUniformMatrix4fv; \
     packed_data->args.a1 = (GLint)location; \
     packed_data->args.a2 = (GLsizei)count; \
     packed_data->args.a3 = (GLboolean)transpose; \
     packed_data->args.a4 = (GLfloat *)value; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glUseProgram
 #define push_glUseProgram(program) { \
-    glUseProgram_PACKED *packed_data = malloc(sizeof(glUseProgram_PACKED)); \
+    glUseProgram_PACKED *packed_data = glAllocCall(glUseProgram_FORMAT, sizeof(glUseProgram_PACKED)); \
     packed_data->format = glUseProgram_FORMAT; \
     packed_data->func = gl4es_glUseProgram; \
     packed_data->args.a1 = (GLuint)program; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glValidateProgram
 #define push_glValidateProgram(program) { \
-    glValidateProgram_PACKED *packed_data = malloc(sizeof(glValidateProgram_PACKED)); \
+    glValidateProgram_PACKED *packed_data = glAllocCall(glValidateProgram_FORMAT, sizeof(glValidateProgram_PACKED)); \
     packed_data->format = glValidateProgram_FORMAT; \
     packed_data->func = gl4es_glValidateProgram; \
     packed_data->args.a1 = (GLuint)program; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glVertexAttrib1f
 #define push_glVertexAttrib1f(index, x) { \
-    glVertexAttrib1f_PACKED *packed_data = malloc(sizeof(glVertexAttrib1f_PACKED)); \
+    glVertexAttrib1f_PACKED *packed_data = glAllocCall(glVertexAttrib1f_FORMAT, sizeof(glVertexAttrib1f_PACKED)); \
     packed_data->format = glVertexAttrib1f_FORMAT; \
     packed_data->func = gl4es_glVertexAttrib1f; \
     packed_data->args.a1 = (GLuint)index; \
     packed_data->args.a2 = (GLfloat)x; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glVertexAttrib1fv
 #define push_glVertexAttrib1fv(index, v) { \
-    glVertexAttrib1fv_PACKED *packed_data = malloc(sizeof(glVertexAttrib1fv_PACKED)); \
+    glVertexAttrib1fv_PACKED *packed_data = glAllocCall(glVertexAttrib1fv_FORMAT, sizeof(glVertexAttrib1fv_PACKED)); \
     packed_data->format = glVertexAttrib1fv_FORMAT; \
     packed_data->func = gl4es_glVertexAttrib1fv; \
     packed_data->args.a1 = (GLuint)index; \
     packed_data->args.a2 = (GLfloat *)v; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glVertexAttrib2f
 #define push_glVertexAttrib2f(index, x, y) { \
-    glVertexAttrib2f_PACKED *packed_data = malloc(sizeof(glVertexAttrib2f_PACKED)); \
+    glVertexAttrib2f_PACKED *packed_data = glAllocCall(glVertexAttrib2f_FORMAT, sizeof(glVertexAttrib2f_PACKED)); \
     packed_data->format = glVertexAttrib2f_FORMAT; \
     packed_data->func = gl4es_glVertexAttrib2f; \
     packed_data->args.a1 = (GLuint)index; \
     packed_data->args.a2 = (GLfloat)x; \
     packed_data->args.a3 = (GLfloat)y; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glVertexAttrib2fv
 #define push_glVertexAttrib2fv(index, v) { \
-    glVertexAttrib2fv_PACKED *packed_data = malloc(sizeof(glVertexAttrib2fv_PACKED)); \
+    glVertexAttrib2fv_PACKED *packed_data = glAllocCall(glVertexAttrib2fv_FORMAT, sizeof(glVertexAttrib2fv_PACKED)); \
     packed_data->format = glVertexAttrib2fv_FORMAT; \
     packed_data->func = gl4es_glVertexAttrib2fv; \
     packed_data->args.a1 = (GLuint)index; \
     packed_data->args.a2 = (GLfloat *)v; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glVertexAttrib3f
 #define push_glVertexAttrib3f(index, x, y, z) { \
-    glVertexAttrib3f_PACKED *packed_data = malloc(sizeof(glVertexAttrib3f_PACKED)); \
+    glVertexAttrib3f_PACKED *packed_data = glAllocCall(glVertexAttrib3f_FORMAT, sizeof(glVertexAttrib3f_PACKED)); \
     packed_data->format = glVertexAttrib3f_FORMAT; \
     packed_data->func = gl4es_glVertexAttrib3f; \
     packed_data->args.a1 = (GLuint)index; \
     packed_data->args.a2 = (GLfloat)x; \
     packed_data->args.a3 = (GLfloat)y; \
     packed_data->args.a4 = (GLfloat)z; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glVertexAttrib3fv
 #define push_glVertexAttrib3fv(index, v) { \
-    glVertexAttrib3fv_PACKED *packed_data = malloc(sizeof(glVertexAttrib3fv_PACKED)); \
+    glVertexAttrib3fv_PACKED *packed_data = glAllocCall(glVertexAttrib3fv_FORMAT, sizeof(glVertexAttrib3fv_PACKED)); \
     packed_data->format = glVertexAttrib3fv_FORMAT; \
     packed_data->func = gl4es_glVertexAttrib3fv; \
     packed_data->args.a1 = (GLuint)index; \
     packed_data->args.a2 = (GLfloat *)v; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glVertexAttrib4f
 #define push_glVertexAttrib4f(index, x, y, z, w) { \
-    glVertexAttrib4f_PACKED *packed_data = malloc(sizeof(glVertexAttrib4f_PACKED)); \
+    glVertexAttrib4f_PACKED *packed_data = glAllocCall(glVertexAttrib4f_FORMAT, sizeof(glVertexAttrib4f_PACKED)); \
     packed_data->format = glVertexAttrib4f_FORMAT; \
     packed_data->func = gl4es_glVertexAttrib4f; \
     packed_data->args.a1 = (GLuint)index; \
@@ -6698,22 +6465,20 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a3 = (GLfloat)y; \
     packed_data->args.a4 = (GLfloat)z; \
     packed_data->args.a5 = (GLfloat)w; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glVertexAttrib4fv
 #define push_glVertexAttrib4fv(index, v) { \
-    glVertexAttrib4fv_PACKED *packed_data = malloc(sizeof(glVertexAttrib4fv_PACKED)); \
+    glVertexAttrib4fv_PACKED *packed_data = glAllocCall(glVertexAttrib4fv_FORMAT, sizeof(glVertexAttrib4fv_PACKED)); \
     packed_data->format = glVertexAttrib4fv_FORMAT; \
     packed_data->func = gl4es_glVertexAttrib4fv; \
     packed_data->args.a1 = (GLuint)index; \
     packed_data->args.a2 = (GLfloat *)v; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glVertexAttribPointer
 #define push_glVertexAttribPointer(index, size, type, normalized, stride, pointer) { \
-    glVertexAttribPointer_PACKED *packed_data = malloc(sizeof(glVertexAttribPointer_PACKED)); \
+    glVertexAttribPointer_PACKED *packed_data = glAllocCall(glVertexAttribPointer_FORMAT, sizeof(glVertexAttribPointer_PACKED)); \
     packed_data->format = glVertexAttribPointer_FORMAT; \
     packed_data->func = gl4es_glVertexAttribPointer; \
     packed_data->args.a1 = (GLuint)index; \
@@ -6722,12 +6487,11 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a4 = (GLboolean)normalized; \
     packed_data->args.a5 = (GLsizei)stride; \
     packed_data->args.a6 = (GLvoid *)pointer; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glVertexAttribIPointer
 #define push_glVertexAttribIPointer(index, size, type, stride, pointer) { \
-    glVertexAttribIPointer_PACKED *packed_data = malloc(sizeof(glVertexAttribIPointer_PACKED)); \
+    glVertexAttribIPointer_PACKED *packed_data = glAllocCall(glVertexAttribIPointer_FORMAT, sizeof(glVertexAttribIPointer_PACKED)); \
     packed_data->format = glVertexAttribIPointer_FORMAT; \
     packed_data->func = gl4es_glVertexAttribIPointer; \
     packed_data->args.a1 = (GLuint)index; \
@@ -6735,31 +6499,28 @@ typedef void (APIENTRY_GLES * glVertexAttribIPointer_PTR)(glVertexAttribIPointer
     packed_data->args.a3 = (GLenum)type; \
     packed_data->args.a4 = (GLsizei)stride; \
     packed_data->args.a5 = (GLvoid *)pointer; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glVertexPointer
 #define push_glVertexPointer(size, type, stride, pointer) { \
-    glVertexPointer_PACKED *packed_data = malloc(sizeof(glVertexPointer_PACKED)); \
+    glVertexPointer_PACKED *packed_data = glAllocCall(glVertexPointer_FORMAT, sizeof(glVertexPointer_PACKED)); \
     packed_data->format = glVertexPointer_FORMAT; \
     packed_data->func = gl4es_glVertexPointer; \
     packed_data->args.a1 = (GLint)size; \
     packed_data->args.a2 = (GLenum)type; \
     packed_data->args.a3 = (GLsizei)stride; \
     packed_data->args.a4 = (GLvoid *)pointer; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #ifndef direct_glViewport
 #define push_glViewport(x, y, width, height) { \
-    glViewport_PACKED *packed_data = malloc(sizeof(glViewport_PACKED)); \
+    glViewport_PACKED *packed_data = glAllocCall(glViewport_FORMAT, sizeof(glViewport_PACKED)); \
     packed_data->format = glViewport_FORMAT; \
     packed_data->func = gl4es_glViewport; \
     packed_data->args.a1 = (GLint)x; \
     packed_data->args.a2 = (GLint)y; \
     packed_data->args.a3 = (GLsizei)width; \
     packed_data->args.a4 = (GLsizei)height; \
-    glPushCall((void *)packed_data); \
 }
 #endif
 #endif
@@ -29,14 +29,13 @@
 #include "../gl/framebuffers.h"
 #include "../gl/init.h"
 #include "../gl/loader.h"
-#ifdef PANDORA
 #include "../gl/pixel.h"
-#endif
 #include "glx_gbm.h"
 #include "hardext.h"
 #include "streaming.h"
 #include "utils.h"
 #include "../gl/envvars.h"
+#include "../gl/trace.h"
 
 //#define DEBUG
 #ifdef DEBUG
@@ -89,7 +88,8 @@ typedef struct {
     Display *dpy;
     int Type;
     GC gc; 
-    XImage* frame;
+    shmimage_t frame[2];    // emulated pixmap are double buffered, so one can be read while X sends the other
+    int cur;
 } glx_buffSize;
 
 //PBuffer should work under ANDROID / NOX11
@@ -704,10 +704,10 @@ GLXContext gl4es_glXCreateContext(Display *display,
         glxfbconfig->stencilBits = EGL_DONT_CARE;
 #ifdef PANDORA
     if(depthBits==32)
-        depthBits = (glxfbconfig->stencilBits==8 && hardext.esversion==2)?24:16;
-    if(depthBits==24 && glxfbconfig->stencilBits==8 && !(globals4es.usefbo || globals4es.usepbuffer || hardext.esversion==2))
+        depthBits = (glxfbconfig->stencilBits==8 && hardext.esversion>1)?24:16;
+    if(depthBits==24 && glxfbconfig->stencilBits==8 && !(globals4es.usefbo || globals4es.usepbuffer || hardext.esversion>1))
         depthBits = 16;
-    else if(depthBits==16 && glxfbconfig->stencilBits==8 && hardext.esversion==2)
+    else if(depthBits==16 && glxfbconfig->stencilBits==8 && hardext.esversion>1)
         depthBits = 24;
 #endif    
 
@@ -1459,6 +1459,7 @@ Bool gl4es_glXMakeCurrent(Display *display,
         context->drawable = drawable;
 
         ActivateGLState(context->glstate);
+        ValidateHardwareCache();
 #ifdef PANDORA
         if(!created) pandora_set_gamma();
 #endif
@@ -1553,6 +1554,7 @@ void gl4es_glXSwapBuffers(Display *display,
       old_time = new_time;
     }
 #endif
+    EGLint damage[4] = {0};   // part of the window that changed, with LIBGL_FBODAMAGE
     if (globals4es.usefbo && PBuffer==0) {
         unbindMainFBO();
         int x = 0, y = 0;
@@ -1566,21 +1568,60 @@ void gl4es_glXSwapBuffers(Display *display,
             XTranslateCoordinates( display, drawable, root, 0, 0, &x, &y, &root ); // translate to get x,y absolute to screen
         }
 #endif
-        DBG(printf("blitMainFBO(%d, %d, %u, %u)\n", x, y, width, height);)
-        blitMainFBO(x, y, width, height);
+        if(globals4es.fbodamage && hardext.esversion>1) {
+            // only blit what the back buffer misses
+            EGLint age = 0;
+            EGLint region[4];
+            if(hardext.bufferage) {
+                LOAD_EGL(eglQuerySurface);
+                if(!egl_eglQuerySurface(eglDisplay, surface, EGL_BUFFER_AGE_EXT, &age))
+                    age = 0;
+            }
+            int present = damageMainFBORegion(x, y, width, height, age, region, damage);
+            DBG(printf("blitMainFBORegion(%d, %d, %u, %u) age=%d, present=%d\n", x, y, width, height, age, present);)
+            if(!present) {
+                // nothing drawn, but the back buffer content is unknown: present everything, the swap keeps the pacing
+                blitMainFBO(x, y, width, height);
+            } else if(region[2] && region[3]) {
+                if(age && hardext.partialupdate) {
+                    LOAD_EGL_PROC(eglSetDamageRegionKHR);
+                    if(egl_eglSetDamageRegionKHR)
+                        egl_eglSetDamageRegionKHR(eglDisplay, surface, region, 1);
+                }
+                blitMainFBORegion(x, y, width, height, region);
+            }
+        } else {
+            DBG(printf("blitMainFBO(%d, %d, %u, %u)\n", x, y, width, height);)
+            blitMainFBO(x, y, width, height);
+        }
         // blit the main_fbo before swap
         //adjust FBO size if needed
         if((width && height && (width!=glstate->fbo.mainfbo_width || height!=glstate->fbo.mainfbo_height))) {
             createMainFBO(width, height);   // adjust mainFBO
         }
     }
+    TRACE_BEGIN(swap);
     // check emulated Pixmap
     if(PBuffer && glstate->emulatedPixmap) {
         LOAD_GLES(glFinish);
         gles_glFinish();
         BlitEmulatedPixmap(drawable);
+    } else if(damage[2] && damage[3] && hardext.swapdamage==1) {
+        LOAD_EGL_PROC(eglSwapBuffersWithDamageKHR);
+        if(egl_eglSwapBuffersWithDamageKHR)
+            egl_eglSwapBuffersWithDamageKHR(eglDisplay, surface, damage, 1);
+        else
+            egl_eglSwapBuffers(eglDisplay, surface);
+    } else if(damage[2] && damage[3] && hardext.swapdamage==2) {
+        LOAD_EGL_PROC(eglSwapBuffersWithDamageEXT);
+        if(egl_eglSwapBuffersWithDamageEXT)
+            egl_eglSwapBuffersWithDamageEXT(eglDisplay, surface, damage, 1);
+        else
+            egl_eglSwapBuffers(eglDisplay, surface);
     } else
         egl_eglSwapBuffers(eglDisplay, surface);
+    TRACE_END(swap);
+    trace_frame();
     //CheckEGLErrors();     // not sure it's a good thing to call a eglGetError() after all eglSwapBuffers, performance wize (plus result is discarded anyway)
 #ifdef PANDORA
     if (globals4es.showfps || (sock>-1))
@@ -2530,7 +2571,8 @@ GLXPbuffer addPixBuffer(Display *dpy, EGLSurface surface, EGLConfig Config, int
     pbuffersize[pbufferlist_size].Depth = depth;
     pbuffersize[pbufferlist_size].dpy = dpy;
     pbuffersize[pbufferlist_size].gc = (emulated)?XCreateGC(dpy, pixmap, 0, NULL):NULL;
-    pbuffersize[pbufferlist_size].frame = NULL;
+    memset(pbuffersize[pbufferlist_size].frame, 0, sizeof(pbuffersize[pbufferlist_size].frame));
+    pbuffersize[pbufferlist_size].cur = 0;
 
     pbuffersize[pbufferlist_size].Type = 2+emulated;    //2 = pixmap, 3 = emulated pixmap, 4 = emulated win
     return pbufferlist[pbufferlist_size++];
@@ -2540,9 +2582,8 @@ void delPixBuffer(int j)
     LOAD_EGL(eglDestroyContext);
     if(pbuffersize[j].gc)
         XFree(pbuffersize[j].gc);
-    if(pbuffersize[j].frame) {
-        XDestroyImage(pbuffersize[j].frame);
-    }
+    for (int i=0; i<2; ++i)
+        shmimage_destroy(pbuffersize[j].dpy, &pbuffersize[j].frame[i]);
     pbufferlist[j] = 0;
     pbuffersize[j].Width = 0;
     pbuffersize[j].Height = 0;
@@ -2692,13 +2733,26 @@ void gl4es_glXDestroyPixmap(Display *display, void *pixmap) {
 }
 
 
+// read the current surface with the top row first, as X wants it. Rows are converted straight to their place
+static void readFlipped(int Width, int Height, int Depth, uintptr_t pix) {
+    const int stride = Width * (Depth==16?2:4);
+    gl4es_scratch(Width*Height*4);
+    const char* src = (const char*)glstate->scratch;
+    gl4es_glReadPixels(0, 0, Width, Height, GL_RGBA, GL_UNSIGNED_BYTE, (void*)src);
+    for (int i=0; i<Height; ++i) {
+        void* dst = (void*)(pix + (Height-1-i)*stride);
+        pixel_convert(src+i*Width*4, &dst, Width, 1, GL_RGBA, GL_UNSIGNED_BYTE,
+            (Depth==16)?GL_RGB:GL_BGRA, (Depth==16)?GL_UNSIGNED_SHORT_5_6_5:GL_UNSIGNED_BYTE, 0, 1);
+    }
+}
+
 void actualBlit(int reverse, int Width, int Height, int Depth, 
-                    Display *dpy, Pixmap drawable, GC gc, XImage* frame,
+                    Display *dpy, Pixmap drawable, GC gc, shmimage_t* frame,
                     uintptr_t pix, void* tmp) {
-const int sbuf = Width * Height * (Depth==16?2:4);
 #ifdef PANDORA
     if (tmp) {
         if(reverse) {
+            const int sbuf = Width * Height * 2;
             int stride = Width * 2;
             uintptr_t src_pos = (uintptr_t)tmp;
             uintptr_t dst_pos = (uintptr_t)pix+sbuf-stride;
@@ -2712,22 +2766,10 @@ const int sbuf = Width * Height * (Depth==16?2:4);
             }
         } else
             pixel_convert(tmp, (void**)&pix, Width, Height, GL_BGRA, GL_UNSIGNED_BYTE, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, 0, glstate->texture.unpack_align);
-    } else
+    }
 #endif
-        if(reverse) {
-            int stride = Width * (Depth==16?2:4);
-            uintptr_t end=(uintptr_t)pix+sbuf-stride;
-            uintptr_t beg=(uintptr_t)pix;
-            void* const tmp = (void*)(pix+sbuf);
-            for (; beg < end; beg+=stride, end-=stride) {
-                memcpy(tmp, (void*)end, stride);
-                memcpy((void*)end, (void*)beg, stride);
-                memcpy((void*)beg, tmp, stride);
-            }
-        }
-
-    // blit
-    XPutImage(dpy, drawable, gc, frame, 0, 0, 0, 0, Width, Height);
+    // blit (rows are already in X order)
+    shmimage_put(dpy, drawable, gc, frame, Width, Height);
 }
 
 void BlitEmulatedPixmap(int win) {
@@ -2745,8 +2787,7 @@ void BlitEmulatedPixmap(int win) {
     GC gc = buff->gc;
     // the reverse stuff can probably be better!
     int reverse = buff->Type==4?1:0;
-    const int sbuf = Width * Height * (Depth==16?2:4);
-    XImage* frame = buff->frame;
+    shmimage_t* frame = &buff->frame[buff->cur];
 
     // grab the size of the drawable if it has changed
     if(reverse) {
@@ -2761,9 +2802,9 @@ void BlitEmulatedPixmap(int win) {
             LOAD_EGL(eglMakeCurrent);
             LOAD_EGL(eglCreatePbufferSurface);
             // destroy old stuff
-            XSync(dpy, False);  // synch seems needed before the DestroyImage...
-            if(frame) XDestroyImage(frame);
-            buff->frame = 0;
+            for (int i=0; i<2; ++i)
+                shmimage_destroy(dpy, &buff->frame[i]);
+            buff->cur = 0;
             
 
             //let's create a PBuffer attributes
@@ -2807,51 +2848,57 @@ void BlitEmulatedPixmap(int win) {
     }
 
     // create things if needed
-    if(!buff->frame) {
-        int sz = Width*(Height+reverse)*(Depth==16?2:4);
+    if(!frame->image) {
+        int sz = Width*Height*(Depth==16?2:4);
 #ifdef PANDORA
         if(hardext.esversion==1 && Depth==16) {
             sz += Width*Height*4;
         }
 #endif
-        frame = buff->frame = XCreateImage(dpy, NULL /*visual*/, Depth, ZPixmap, 0, malloc(sz), Width, Height, (Depth==16)?16:32, 0);
+        shmimage_create(dpy, frame, Depth, Width, Height, sz);
     }
 
-    if (!frame) {
+    if (!frame->image) {
         return;
     }
     static int direct_copy = 1;
     if(direct_copy) {
         LOAD_EGL(eglCopyBuffers);
-        if(!egl_eglCopyBuffers(eglDisplay, buff->Surface, (EGLNativePixmapType)frame)) {
+        if(!egl_eglCopyBuffers(eglDisplay, buff->Surface, (EGLNativePixmapType)frame->image)) {
             LOGE("Cannot use eglCopyBuffers, disabling it's use: ");
             CheckEGLErrors();
             direct_copy = 0;
         } else
             return;
     }
-    uintptr_t pix=(uintptr_t)frame->data;
+    // the X server may still be reading this image from 2 frames ago
+    shmimage_wait(dpy, frame);
+    uintptr_t pix=(uintptr_t)frame->image->data;
 
     // grab framebuffer
     void* tmp = NULL;
 #ifdef PANDORA
     LOAD_GLES(glReadPixels);
-    if(hardext.esversion==1) {
-        if(Depth==16) {
-            tmp = (void*)(pix + Width*Height*2);
-            gles_glReadPixels(0, 0, Width, Height, GL_BGRA, GL_UNSIGNED_BYTE, tmp);
-        } else {
-            gles_glReadPixels(0, 0, Width, Height, GL_BGRA, GL_UNSIGNED_BYTE, (void*)pix);
-        }
-    } else 
-    if(Depth==16)
+    if(hardext.esversion==1 && Depth==16) {
+        tmp = (void*)(pix + Width*Height*2);
+        gles_glReadPixels(0, 0, Width, Height, GL_BGRA, GL_UNSIGNED_BYTE, tmp);
+    } else if(reverse)
+        readFlipped(Width, Height, Depth, pix);
+    else if(hardext.esversion==1)
+        gles_glReadPixels(0, 0, Width, Height, GL_BGRA, GL_UNSIGNED_BYTE, (void*)pix);
+    else if(Depth==16)
         gles_glReadPixels(0, 0, Width, Height, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, (void*)pix);
     else
+        gl4es_glReadPixels(0, 0, Width, Height, GL_BGRA, GL_UNSIGNED_BYTE, (void*)pix);
+#else
+    if(reverse)
+        readFlipped(Width, Height, Depth, pix);
+    else
+        gl4es_glReadPixels(0, 0, Width, Height, (Depth==16)?GL_RGB:GL_BGRA, (Depth==16)?GL_UNSIGNED_SHORT_5_6_5:GL_UNSIGNED_BYTE, (void*)pix);
 #endif
-    gl4es_glReadPixels(0, 0, Width, Height, (Depth==16)?GL_RGB:GL_BGRA, (Depth==16)?GL_UNSIGNED_SHORT_5_6_5:GL_UNSIGNED_BYTE, (void*)pix);
 
     actualBlit(reverse, Width, Height, Depth, dpy, drawable, gc, frame, pix, tmp);
-
+    buff->cur ^= 1;
 }
 
 GLXContext gl4es_glXCreateContextAttribs(Display *dpy, GLXFBConfig config, GLXContext share_context, Bool direct, const int *attrib_list) {
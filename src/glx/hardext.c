@@ -1,6 +1,7 @@
 #include "hardext.h"
 
 #include "../gl/debug.h"
+#include "../gl/envvars.h"
 #include "../gl/gl4es.h"
 #include "../gl/init.h"
 #include "../gl/logs.h"
@@ -85,10 +86,7 @@ static int testTextureCubeLod() {
     return compiled;
 }
 
-EXPORT
-void GetHardwareExtensions(int notest)
-{
-    if(tested) return;
+static void hardext_defaults() {
     // put some default values
     hardext.maxtex = 2;
     hardext.maxsize = 2048;
@@ -97,168 +95,31 @@ void GetHardwareExtensions(int notest)
     hardext.maxdrawbuffers = 1;
 
     hardext.esversion = globals4es.es;
-    if(notest) 
-    {
-#ifndef AMIGAOS4
-        SHUT_LOGD("Hardware test disabled, nothing activated...\n");
-#endif
-        if(hardext.esversion==2) {
-            hardext.maxteximage = 4;
-            hardext.maxvarying = 8;
-            hardext.maxtex = 8;
-            hardext.maxvattrib = 16;
-#ifdef AMIGAOS4
-            hardext.npot = 3;
-#else
-            hardext.npot = 1;
-#endif
-            hardext.fbo = 1; 
-            hardext.blendcolor = 1;
-            hardext.blendsub = 1;
-            hardext.blendfunc = 1;
-            hardext.blendeq = 1;
-            hardext.mirrored = 1;
-            hardext.pointsprite = 1;
-            hardext.pointsize = 1;
-            hardext.cubemap = 1;
-            hardext.maxdrawbuffers = 1;
-#ifdef AMIGAOS4
-            hardext.glsl300es = 1;
-#endif
-        }
-        return;
-    }
-#if defined(BCMHOST) && !defined(ANDROID)
-    rpi_init();
-#endif
-#ifdef NOEGL
-    SHUT_LOGD("Hardware test on current Context...\n");
-#else
-    // used EGL & GLES functions
-    LOAD_EGL(eglBindAPI);
-    LOAD_EGL(eglInitialize);
-    LOAD_EGL(eglGetDisplay);
-    LOAD_EGL(eglCreatePbufferSurface);
-    LOAD_EGL(eglDestroySurface);
-    LOAD_EGL(eglDestroyContext);
-    LOAD_EGL(eglMakeCurrent);
-    LOAD_EGL(eglChooseConfig);
-    LOAD_EGL(eglCreateContext);
-    LOAD_EGL(eglQueryString);
-    LOAD_EGL(eglTerminate);
-
-    EGLDisplay eglDisplay;
-    EGLSurface eglSurface;
-    EGLContext eglContext;
-
-    SHUT_LOGD("Using GLES %s backend\n", (hardext.esversion==1)?"1.1":"2.0");
-
-    // Create a PBuffer first...
-    EGLint egl_context_attrib_es2[] = {
-        EGL_CONTEXT_CLIENT_VERSION, 2,
-        EGL_NONE
-    };
-
-    EGLint egl_context_attrib[] = {
-        EGL_NONE
-    };
-
-    //let's create a PBuffer attributes
-    EGLint egl_attribs[10];	// should be enough
-    int i = 0;
-    egl_attribs[i++] = EGL_WIDTH;
-    egl_attribs[i++] = 32;
-    egl_attribs[i++] = EGL_HEIGHT;
-    egl_attribs[i++] = 32;
-    egl_attribs[i++] = EGL_NONE;
-
-    EGLint configAttribs[] = {
-#ifdef PANDORA
-    // on the Pandora, there don't seem to exist a 8888 PBuffer config for GLES2.
-        EGL_RED_SIZE, (hardext.esversion==1)?8:5,
-        EGL_GREEN_SIZE, (hardext.esversion==1)?8:6,
-        EGL_BLUE_SIZE, (hardext.esversion==1)?8:5,
-        EGL_ALPHA_SIZE, (hardext.esversion==1)?8:0,
-#else
-        EGL_RED_SIZE, 8,
-        EGL_GREEN_SIZE, 8,
-        EGL_BLUE_SIZE, 8,
-        EGL_ALPHA_SIZE, 8,
-#endif
-        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
-        EGL_RENDERABLE_TYPE, (hardext.esversion==1)?EGL_OPENGL_ES_BIT:EGL_OPENGL_ES2_BIT,
-        EGL_NONE
-    };
-
-    int configsFound;
-    static EGLConfig pbufConfigs[1];
-
-#ifndef NO_GBM
-    if (globals4es.usegbm) {
-        LoadGBMFunctions();
-        eglDisplay = OpenGBMDisplay(EGL_DEFAULT_DISPLAY);
-    }
-    else
-#endif
-        eglDisplay = egl_eglGetDisplay(EGL_DEFAULT_DISPLAY);
-
-    egl_eglBindAPI(EGL_OPENGL_ES_API);
-    if (egl_eglInitialize(eglDisplay, NULL, NULL) != EGL_TRUE) {
-        LOGE("Error while gathering supported extension (eglInitialize: %s), default to none\n", PrintEGLError(0));
-        egl_eglTerminate(eglDisplay);
-        return;
-    }
+}
 
-    egl_eglChooseConfig(eglDisplay, configAttribs, pbufConfigs, 1, &configsFound);
-#ifndef NO_GBM
-    const char* eglExts = egl_eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
-    if(eglExts && strstr(eglExts, "EGL_KHR_platform_gbm ")) {
-        SHUT_LOGD("GBM Surfaces supported%s\n", globals4es.usegbm?" and used":"");
-        hardext.gbm = 1;
-    }
-#endif
-#ifndef PANDORA
-    if(!configsFound) {
-        // try without alpha channel
-        configAttribs[4*2-1] = 0;
-        egl_eglChooseConfig(eglDisplay, configAttribs, pbufConfigs, 1, &configsFound);
-        if(configsFound) {
-            SHUT_LOGD("No alpha channel in PBuffer context, disabling EGL Alpha channel...\n");
-            hardext.eglnoalpha = 1;
-        }
-    }
-#endif
-    if(!configsFound) {
-        SHUT_LOGE("Error while gathering supported extension (eglChooseConfig: %s), default to none\n", PrintEGLError(0));
-        egl_eglTerminate(eglDisplay);
-        return;
-    }
-    eglContext = egl_eglCreateContext(eglDisplay, pbufConfigs[0], EGL_NO_CONTEXT, (hardext.esversion==1)?egl_context_attrib:egl_context_attrib_es2);
-    if(!eglContext) {
-        SHUT_LOGE("Error while gathering supported extension (eglCreateContext: %s), default to none\n", PrintEGLError(0));
-        return;
-    }
-    eglSurface = egl_eglCreatePbufferSurface(eglDisplay, pbufConfigs[0], egl_attribs);
-    if(!eglSurface) {
-        SHUT_LOGE("Error while gathering supported extension (eglCreatePBufferSurface: %s), default to none\n", PrintEGLError(0));
-        egl_eglDestroyContext(eglDisplay, eglContext);
-        egl_eglTerminate(eglDisplay);
-        return;
-    }
-    egl_eglMakeCurrent(eglDisplay, eglSurface, eglSurface, eglContext);
-#endif
-    tested = 1;
+// probe the GLES capabilities on the current context
+static void GetGLESExtensions() {
     LOAD_GLES(glGetString);
     LOAD_GLES(glGetIntegerv);
     LOAD_GLES(glGetError);
     // Now get extensions
     const char *Exts = (const char *) gles_glGetString(GL_EXTENSIONS);
+    // ES2 contexts are ES3 ones on most drivers: the ES3 functions can be used then
+    if(hardext.esversion==2) {
+        const char *version = (const char *) gles_glGetString(GL_VERSION);
+        LOAD_GLES2(glMapBufferRange);
+        if(version && strstr(version, "OpenGL ES 3") && gles_glMapBufferRange) {
+            hardext.esversion = 3;
+            SHUT_LOGD("GLES 3 driver detected, ES3 functions will be used\n");
+        }
+    }
     // Parse them!
     #define S(A, B, C) if(strstr(Exts, A)) { hardext.B = 1; SHUT_LOGD("Extension %s detected%s",A, C?" and used\n":"\n"); } 
     if(hardext.esversion>1) hardext.npot = 1;
     if(strstr(Exts, "GL_APPLE_texture_2D_limited_npot ")) hardext.npot = 1;
     if(strstr(Exts, "GL_IMG_texture_npot ")) hardext.npot = 1; // it should enable mipmap (so hardext.npot=2), but mipmap (so level > 0) needs to be POT-sized?!!
     if(strstr(Exts, "GL_ARB_texture_non_power_of_two ") || strstr(Exts, "GL_OES_texture_npot ")) hardext.npot = 3;
+    if(hardext.esversion>2) hardext.npot = 3;   // full NPOT is core in ES3
     if(hardext.npot>0) {
         SHUT_LOGD("Hardware %s NPOT detected and used\n", hardext.npot==3?"Full":(hardext.npot==2?"Limited+Mipmap":"Limited"));
     }
@@ -305,6 +166,27 @@ void GetHardwareExtensions(int notest)
         SHUT_LOGD("Texture Mirrored Repeat is in core, and so used\n");
         hardext.mirrored = 1;
     }
+    if (hardext.esversion>2) {
+        // core in ES3, if the driver really exports the functions
+        LOAD_GLES2(glGenQueries);
+        LOAD_GLES2(glBeginQuery);
+        LOAD_GLES2(glEndQuery);
+        LOAD_GLES2(glGetQueryObjectuiv);
+        if(gles_glGenQueries && gles_glBeginQuery && gles_glEndQuery && gles_glGetQueryObjectuiv) {
+            SHUT_LOGD("Occlusion queries are in core ES3, and so used\n");
+            hardext.occlusion = 1;
+        }
+    }
+    if (!hardext.occlusion) {
+        S("GL_EXT_occlusion_query_boolean ", occlusion, 1);
+    }
+    S("GL_EXT_disjoint_timer_query ", timerquery, 1);
+    if (hardext.esversion>2) {
+        SHUT_LOGD("FBO attachment of mipmap levels is in core ES3, and so used\n");
+        hardext.fbomipmap = 1;
+    } else {
+        S("GL_OES_fbo_render_mipmap ", fbomipmap, 1);
+    }
     S("GL_OES_mapbuffer ", mapbuffer, 0);
     S("GL_OES_element_index_uint ", elementuint, 1);
     S("GL_OES_packed_depth_stencil ", depthstencil, 1);
@@ -441,6 +323,406 @@ void GetHardwareExtensions(int notest)
     if(hardext.glsl310es) {
         SHUT_LOGD("GLSL 310 es supported%s\n", hardext.glsl120?"":" and used");
     }
+}
+
+// Hardware probe cache
+// The result of the probe is saved on disk, keyed by the driver libraries and the EGL and GLES driver strings,
+// so the PBuffer context and the test shaders can be skipped on the next start.
+// EGL strings are checked before using the cache, GLES ones once a real context is current.
+#define HWCACHE_SIGN    "GL4ES HardExt Cache"
+#define HWCACHE_VERSION 3
+#define HWCACHE_NOPT    7
+
+enum {
+    HWKEY_GLESLIB = 0,
+    HWKEY_EGLLIB,
+    HWKEY_EGLVENDOR,
+    HWKEY_EGLVERSION,
+    HWKEY_RENDERER,
+    HWKEY_VERSION,
+    HWKEY_EXTENSIONS,
+    HWKEY_COUNT
+};
+
+static char* hwcache_name = NULL;
+static char* hwcache_keys[HWKEY_COUNT] = {0};   // GLES keys of the loaded cache, still to be checked
+static int hwcache_pending = 0;
+
+static void hwcache_options(int* opts) {
+    // user settings that change the outcome of the probe
+    opts[0] = globals4es.es;
+    opts[1] = globals4es.nobgra;
+    opts[2] = globals4es.nodepthtex;
+    opts[3] = globals4es.floattex;
+    opts[4] = globals4es.nohighp;
+    opts[5] = globals4es.usegbm;
+    opts[6] = globals4es.noshaderlod;
+}
+
+static void hwcache_init() {
+    if(globals4es.nohwcache || hwcache_name)
+        return;
+    char path[4096];
+    path[0] = '\0';
+    const char* custom = GetEnvVar("LIBGL_PSA_FOLDER");
+#ifdef __linux__
+    const char* home = GetEnvVar("HOME");
+    if(custom)
+        strncpy(path, custom, sizeof(path)-20);
+    else if(home)
+        strncpy(path, home, sizeof(path)-20);
+    path[sizeof(path)-20] = '\0';
+    if(strlen(path) && path[strlen(path)-1]!='/')
+        strcat(path, "/");
+#elif defined AMIGAOS4
+    if(custom)
+        strncpy(path, custom, sizeof(path)-20);
+    else
+        strcpy(path, "PROGDIR:");
+    path[sizeof(path)-20] = '\0';
+#endif
+    if(!strlen(path))
+        return;
+    strcat(path, ".gl4es.hw");
+    hwcache_name = strdup(path);
+}
+
+static void hwcache_freekeys() {
+    for (int i=0; i<HWKEY_COUNT; ++i) {
+        free(hwcache_keys[i]);
+        hwcache_keys[i] = NULL;
+    }
+    hwcache_pending = 0;
+}
+
+static char* hwcache_readstr(FILE* f) {
+    int l = 0;
+    if(fread(&l, sizeof(l), 1, f)!=1 || l<0 || l>1024*1024)
+        return NULL;
+    char* s = (char*)malloc(l+1);
+    if(l && fread(s, l, 1, f)!=1) {
+        free(s);
+        return NULL;
+    }
+    s[l] = '\0';
+    return s;
+}
+
+static int hwcache_writestr(FILE* f, const char* s) {
+    if(!s) s = "";
+    int l = strlen(s);
+    if(fwrite(&l, sizeof(l), 1, f)!=1)
+        return 0;
+    if(l && fwrite(s, l, 1, f)!=1)
+        return 0;
+    return 1;
+}
+
+static int hwcache_samekey(const char* a, const char* b) {
+    return strcmp(a?a:"", b?b:"")==0;
+}
+
+// Load the cache if it matches the current settings and the "known" keys (NULL ones are not checked yet)
+static int hwcache_read(const char** keys) {
+    if(!hwcache_name)
+        return 0;
+    FILE *f = fopen(hwcache_name, "rb");
+    if(!f)
+        return 0;
+    char tmp[sizeof(HWCACHE_SIGN)];
+    int version = 0;
+    int sz = 0;
+    int opts[HWCACHE_NOPT], cur[HWCACHE_NOPT];
+    hardext_t cached;
+    if(fread(tmp, sizeof(HWCACHE_SIGN), 1, f)!=1 || memcmp(tmp, HWCACHE_SIGN, sizeof(HWCACHE_SIGN))
+     || fread(&version, sizeof(version), 1, f)!=1 || version!=HWCACHE_VERSION
+     || fread(&sz, sizeof(sz), 1, f)!=1 || sz!=sizeof(hardext_t)
+     || fread(opts, sizeof(opts), 1, f)!=1) {
+        fclose(f);
+        return 0;
+    }
+    hwcache_options(cur);
+    if(memcmp(opts, cur, sizeof(opts))) {
+        fclose(f);
+        return 0;   // different settings
+    }
+    for (int i=0; i<HWKEY_COUNT; ++i) {
+        hwcache_keys[i] = hwcache_readstr(f);
+        if(!hwcache_keys[i] || (keys[i] && !hwcache_samekey(keys[i], hwcache_keys[i]))) {
+            hwcache_freekeys();
+            fclose(f);
+            return 0;
+        }
+    }
+    if(fread(&cached, sizeof(cached), 1, f)!=1) {
+        hwcache_freekeys();
+        fclose(f);
+        return 0;
+    }
+    fclose(f);
+    memcpy(&hardext, &cached, sizeof(hardext));
+    hwcache_pending = 0;
+    for (int i=HWKEY_RENDERER; i<HWKEY_COUNT; ++i)
+        if(!keys[i])
+            hwcache_pending = 1;
+    if(!hwcache_pending)
+        hwcache_freekeys();
+    SHUT_LOGD("Hardware capabilities loaded from cache (%s)\n", hwcache_name);
+    return 1;
+}
+
+static void hwcache_write(const char** keys) {
+    if(!hwcache_name)
+        return;
+    FILE *f = fopen(hwcache_name, "wb");
+    if(!f)
+        return;
+    int version = HWCACHE_VERSION;
+    int sz = sizeof(hardext_t);
+    int opts[HWCACHE_NOPT];
+    hwcache_options(opts);
+    int ok = fwrite(HWCACHE_SIGN, sizeof(HWCACHE_SIGN), 1, f)==1
+          && fwrite(&version, sizeof(version), 1, f)==1
+          && fwrite(&sz, sizeof(sz), 1, f)==1
+          && fwrite(opts, sizeof(opts), 1, f)==1;
+    for (int i=0; ok && i<HWKEY_COUNT; ++i)
+        ok = hwcache_writestr(f, keys[i]);
+    if(ok)
+        ok = fwrite(&hardext, sizeof(hardext), 1, f)==1;
+    fclose(f);
+    if(!ok)
+        remove(hwcache_name);   // don't leave a truncated file around
+    else
+        SHUT_LOGD("Hardware capabilities saved in %s\n", hwcache_name);
+}
+
+void ValidateHardwareCache() {
+    if(!hwcache_pending)
+        return;
+    LOAD_GLES(glGetString);
+    const char* keys[HWKEY_COUNT] = {0};
+    for (int i=0; i<HWKEY_RENDERER; ++i)
+        keys[i] = hwcache_keys[i];  // already checked
+    keys[HWKEY_RENDERER] = (const char*)gles_glGetString(GL_RENDERER);
+    keys[HWKEY_VERSION] = (const char*)gles_glGetString(GL_VERSION);
+    keys[HWKEY_EXTENSIONS] = (const char*)gles_glGetString(GL_EXTENSIONS);
+    int stale = 0;
+    for (int i=HWKEY_RENDERER; i<HWKEY_COUNT; ++i)
+        if(!hwcache_samekey(keys[i], hwcache_keys[i]))
+            stale = 1;
+    if(stale) {
+        // probe the GLES capabilities again, on the current context (the EGL ones are still good)
+        SHUT_LOGD("Hardware cache doesn't match the GLES driver, probing again\n");
+        hardext_t cached;
+        memcpy(&cached, &hardext, sizeof(hardext));
+        memset(&hardext, 0, sizeof(hardext));
+        hardext_defaults();
+        #define EGLCAP(A) hardext.A = cached.A
+        EGLCAP(gbm);
+        EGLCAP(eglnoalpha);
+        EGLCAP(srgb);
+        EGLCAP(khr_pixmap);
+        EGLCAP(khr_texture_2d);
+        EGLCAP(khr_renderbuffer);
+        EGLCAP(bufferage);
+        EGLCAP(partialupdate);
+        EGLCAP(swapdamage);
+        #undef EGLCAP
+        GetGLESExtensions();
+        hwcache_write(keys);
+    }
+    hwcache_freekeys();
+}
+
+EXPORT
+void GetHardwareExtensions(int notest)
+{
+    if(tested) return;
+    hardext_defaults();
+    if(notest) 
+    {
+#ifndef AMIGAOS4
+        SHUT_LOGD("Hardware test disabled, nothing activated...\n");
+#endif
+        if(hardext.esversion==2) {
+            hardext.maxteximage = 4;
+            hardext.maxvarying = 8;
+            hardext.maxtex = 8;
+            hardext.maxvattrib = 16;
+#ifdef AMIGAOS4
+            hardext.npot = 3;
+#else
+            hardext.npot = 1;
+#endif
+            hardext.fbo = 1; 
+            hardext.blendcolor = 1;
+            hardext.blendsub = 1;
+            hardext.blendfunc = 1;
+            hardext.blendeq = 1;
+            hardext.mirrored = 1;
+            hardext.pointsprite = 1;
+            hardext.pointsize = 1;
+            hardext.cubemap = 1;
+            hardext.maxdrawbuffers = 1;
+#ifdef AMIGAOS4
+            hardext.glsl300es = 1;
+#endif
+        }
+        return;
+    }
+#if defined(BCMHOST) && !defined(ANDROID)
+    rpi_init();
+#endif
+    hwcache_init();
+    const char* keys[HWKEY_COUNT] = {0};
+    // a different driver library means different capabilities
+    keys[HWKEY_GLESLIB] = GetEnvVar("LIBGL_GLES");
+    keys[HWKEY_EGLLIB] = GetEnvVar("LIBGL_EGL");
+    if(!keys[HWKEY_GLESLIB]) keys[HWKEY_GLESLIB] = "";
+    if(!keys[HWKEY_EGLLIB]) keys[HWKEY_EGLLIB] = "";
+#ifdef NOEGL
+    SHUT_LOGD("Hardware test on current Context...\n");
+    {
+        LOAD_GLES(glGetString);
+        keys[HWKEY_EGLVENDOR] = keys[HWKEY_EGLVERSION] = "";
+        keys[HWKEY_RENDERER] = (const char*)gles_glGetString(GL_RENDERER);
+        keys[HWKEY_VERSION] = (const char*)gles_glGetString(GL_VERSION);
+        keys[HWKEY_EXTENSIONS] = (const char*)gles_glGetString(GL_EXTENSIONS);
+        if(hwcache_read(keys)) {
+            tested = 1;
+            return;
+        }
+    }
+#else
+    // used EGL & GLES functions
+    LOAD_EGL(eglBindAPI);
+    LOAD_EGL(eglInitialize);
+    LOAD_EGL(eglGetDisplay);
+    LOAD_EGL(eglCreatePbufferSurface);
+    LOAD_EGL(eglDestroySurface);
+    LOAD_EGL(eglDestroyContext);
+    LOAD_EGL(eglMakeCurrent);
+    LOAD_EGL(eglChooseConfig);
+    LOAD_EGL(eglCreateContext);
+    LOAD_EGL(eglQueryString);
+    LOAD_EGL(eglTerminate);
+
+    EGLDisplay eglDisplay;
+    EGLSurface eglSurface;
+    EGLContext eglContext;
+
+    SHUT_LOGD("Using GLES %s backend\n", (hardext.esversion==1)?"1.1":"2.0");
+
+    // Create a PBuffer first...
+    EGLint egl_context_attrib_es2[] = {
+        EGL_CONTEXT_CLIENT_VERSION, 2,
+        EGL_NONE
+    };
+
+    EGLint egl_context_attrib[] = {
+        EGL_NONE
+    };
+
+    //let's create a PBuffer attributes
+    EGLint egl_attribs[10];	// should be enough
+    int i = 0;
+    egl_attribs[i++] = EGL_WIDTH;
+    egl_attribs[i++] = 32;
+    egl_attribs[i++] = EGL_HEIGHT;
+    egl_attribs[i++] = 32;
+    egl_attribs[i++] = EGL_NONE;
+
+    EGLint configAttribs[] = {
+#ifdef PANDORA
+    // on the Pandora, there don't seem to exist a 8888 PBuffer config for GLES2.
+        EGL_RED_SIZE, (hardext.esversion==1)?8:5,
+        EGL_GREEN_SIZE, (hardext.esversion==1)?8:6,
+        EGL_BLUE_SIZE, (hardext.esversion==1)?8:5,
+        EGL_ALPHA_SIZE, (hardext.esversion==1)?8:0,
+#else
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_ALPHA_SIZE, 8,
+#endif
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, (hardext.esversion==1)?EGL_OPENGL_ES_BIT:EGL_OPENGL_ES2_BIT,
+        EGL_NONE
+    };
+
+    int configsFound;
+    static EGLConfig pbufConfigs[1];
+
+#ifndef NO_GBM
+    if (globals4es.usegbm) {
+        LoadGBMFunctions();
+        eglDisplay = OpenGBMDisplay(EGL_DEFAULT_DISPLAY);
+    }
+    else
+#endif
+        eglDisplay = egl_eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+    egl_eglBindAPI(EGL_OPENGL_ES_API);
+    if (egl_eglInitialize(eglDisplay, NULL, NULL) != EGL_TRUE) {
+        LOGE("Error while gathering supported extension (eglInitialize: %s), default to none\n", PrintEGLError(0));
+        egl_eglTerminate(eglDisplay);
+        return;
+    }
+
+    keys[HWKEY_EGLVENDOR] = egl_eglQueryString(eglDisplay, EGL_VENDOR);
+    keys[HWKEY_EGLVERSION] = egl_eglQueryString(eglDisplay, EGL_VERSION);
+    if(hwcache_read(keys)) {
+        tested = 1;
+        egl_eglTerminate(eglDisplay);
+        return;
+    }
+
+    egl_eglChooseConfig(eglDisplay, configAttribs, pbufConfigs, 1, &configsFound);
+#ifndef NO_GBM
+    const char* eglExts = egl_eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if(eglExts && strstr(eglExts, "EGL_KHR_platform_gbm ")) {
+        SHUT_LOGD("GBM Surfaces supported%s\n", globals4es.usegbm?" and used":"");
+        hardext.gbm = 1;
+    }
+#endif
+#ifndef PANDORA
+    if(!configsFound) {
+        // try without alpha channel
+        configAttribs[4*2-1] = 0;
+        egl_eglChooseConfig(eglDisplay, configAttribs, pbufConfigs, 1, &configsFound);
+        if(configsFound) {
+            SHUT_LOGD("No alpha channel in PBuffer context, disabling EGL Alpha channel...\n");
+            hardext.eglnoalpha = 1;
+        }
+    }
+#endif
+    if(!configsFound) {
+        SHUT_LOGE("Error while gathering supported extension (eglChooseConfig: %s), default to none\n", PrintEGLError(0));
+        egl_eglTerminate(eglDisplay);
+        return;
+    }
+    eglContext = egl_eglCreateContext(eglDisplay, pbufConfigs[0], EGL_NO_CONTEXT, (hardext.esversion==1)?egl_context_attrib:egl_context_attrib_es2);
+    if(!eglContext) {
+        SHUT_LOGE("Error while gathering supported extension (eglCreateContext: %s), default to none\n", PrintEGLError(0));
+        return;
+    }
+    eglSurface = egl_eglCreatePbufferSurface(eglDisplay, pbufConfigs[0], egl_attribs);
+    if(!eglSurface) {
+        SHUT_LOGE("Error while gathering supported extension (eglCreatePBufferSurface: %s), default to none\n", PrintEGLError(0));
+        egl_eglDestroyContext(eglDisplay, eglContext);
+        egl_eglTerminate(eglDisplay);
+        return;
+    }
+    egl_eglMakeCurrent(eglDisplay, eglSurface, eglSurface, eglContext);
+#endif
+    tested = 1;
+#ifndef NOEGL
+    LOAD_GLES(glGetString);
+    keys[HWKEY_RENDERER] = (const char*)gles_glGetString(GL_RENDERER);
+    keys[HWKEY_VERSION] = (const char*)gles_glGetString(GL_VERSION);
+    keys[HWKEY_EXTENSIONS] = (const char*)gles_glGetString(GL_EXTENSIONS);
+#endif
+    GetGLESExtensions();
 
 #ifndef NOEGL
     if(strstr(egl_eglQueryString(eglDisplay, EGL_EXTENSIONS), "EGL_KHR_gl_colorspace")) {
@@ -459,7 +741,24 @@ void GetHardwareExtensions(int notest)
         SHUT_LOGD("EGLImage to RenderBuffer supported\n");
         hardext.khr_renderbuffer = 1;
     }
-
+    if(strstr(egl_eglQueryString(eglDisplay, EGL_EXTENSIONS), "EGL_EXT_buffer_age")) {
+        SHUT_LOGD("EGL Buffer Age supported\n");
+        hardext.bufferage = 1;
+    }
+    if(strstr(egl_eglQueryString(eglDisplay, EGL_EXTENSIONS), "EGL_KHR_partial_update")) {
+        SHUT_LOGD("EGL Partial Update supported\n");
+        hardext.partialupdate = 1;
+    }
+    if(strstr(egl_eglQueryString(eglDisplay, EGL_EXTENSIONS), "EGL_KHR_swap_buffers_with_damage")) {
+        SHUT_LOGD("EGL SwapBuffers with damage supported\n");
+        hardext.swapdamage = 1;
+    } else if(strstr(egl_eglQueryString(eglDisplay, EGL_EXTENSIONS), "EGL_EXT_swap_buffers_with_damage")) {
+        SHUT_LOGD("EGL SwapBuffers with damage (EXT) supported\n");
+        hardext.swapdamage = 2;
+    }
+#endif
+    hwcache_write(keys);
+#ifndef NOEGL
     // End, cleanup
     egl_eglMakeCurrent(eglDisplay, 0, 0, EGL_NO_CONTEXT);
     egl_eglDestroySurface(eglDisplay, eglSurface);
@@ -47,8 +47,11 @@ typedef struct _hardext {
     int srgb;           // EGL_KHR_gl_colorspace
     int mapbuffer;      // GL_OES_mapbuffer
     int drawbuffers;    // GL_EXT_draw_buffers
+    int occlusion;      // GL_EXT_occlusion_query_boolean (core in ES3)
+    int timerquery;     // GL_EXT_disjoint_timer_query
+    int fbomipmap;      // GL_OES_fbo_render_mipmap (core in ES3)
     // es2 stuffs
-    int esversion;      // 1 is ES1.1 backend, 2 is ES2
+    int esversion;      // 1 is ES1.1 backend, 2 is ES2, 3 is ES2 backend on an ES3 driver
     int maxvattrib;     // GL_MAX_VERTEX_ATTRIBS (or 0 if not using es2)
     int maxteximage;    // GL_MAX_TEXTURE_IMAGE_UNITS for es2
     int maxvarying;     // GL_MAX_VARYING_VECTORS for es2
@@ -63,6 +66,9 @@ typedef struct _hardext {
     int khr_pixmap;     // EGL_KHR_image_pixmap
     int khr_texture_2d; // EGL_KHR_gl_texture_2D_image
     int khr_renderbuffer; // EGL_KHR_gl_renderbuffer_image
+    int bufferage;      // EGL_EXT_buffer_age
+    int partialupdate;  // EGL_KHR_partial_update
+    int swapdamage;     // EGL_KHR_swap_buffers_with_damage (1) or EGL_EXT_swap_buffers_with_damage (2)
     int vendor;         // which vendor (to apply workaround)
     int eglnoalpha;     // EGL surface doesn't seems to have any alpha channel (auto detect)
     int prgbinary;      // GL_OES_get_program extension
@@ -76,5 +82,6 @@ typedef struct _hardext {
 EXPORT extern hardext_t hardext;
 
 EXPORT void GetHardwareExtensions(int test);
+void ValidateHardwareCache();
 
 #endif
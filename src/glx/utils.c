@@ -1,4 +1,13 @@
 #include "utils.h"
+
+#ifndef NOX11
+#include <dlfcn.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <X11/extensions/XShm.h>
+#include "../gl/init.h"
+#include "../gl/logs.h"
+#endif
 /*
  * Generate OpenGL-compatible bitmap.
  * From Mesa-9.0.1
@@ -88,4 +97,135 @@ isvalid(XFontStruct * fs, int which)
    return (NULL);
 }
 
-#endif //NOX11
\ No newline at end of file
+/*
+ * MIT-SHM images. libXext is loaded at runtime, so it's not a dependency.
+ * If the extension, the library, or the attach fails (remote display...),
+ * plain XImage and XPutImage are used.
+ */
+typedef Bool (*XShmQueryExtension_PTR)(Display *dpy);
+typedef XImage* (*XShmCreateImage_PTR)(Display *dpy, Visual *visual, unsigned int depth, int format, char *data, XShmSegmentInfo *shminfo, unsigned int width, unsigned int height);
+typedef Bool (*XShmAttach_PTR)(Display *dpy, XShmSegmentInfo *shminfo);
+typedef Bool (*XShmDetach_PTR)(Display *dpy, XShmSegmentInfo *shminfo);
+typedef Bool (*XShmPutImage_PTR)(Display *dpy, Drawable d, GC gc, XImage *image, int src_x, int src_y, int dst_x, int dst_y, unsigned int width, unsigned int height, Bool send_event);
+
+static int shm_state = 0;   // 0 = not tested, 1 = usable, -1 = not usable
+static XShmCreateImage_PTR shm_XShmCreateImage = NULL;
+static XShmAttach_PTR shm_XShmAttach = NULL;
+static XShmDetach_PTR shm_XShmDetach = NULL;
+static XShmPutImage_PTR shm_XShmPutImage = NULL;
+
+static int shm_init(Display *dpy) {
+    if(shm_state)
+        return shm_state>0;
+    shm_state = -1;
+    if(globals4es.noxshm)
+        return 0;
+    void *xext = dlopen("libXext.so.6", RTLD_LAZY | RTLD_LOCAL);
+    if(!xext)
+        xext = dlopen("libXext.so", RTLD_LAZY | RTLD_LOCAL);
+    if(!xext)
+        return 0;
+    XShmQueryExtension_PTR shm_XShmQueryExtension = (XShmQueryExtension_PTR)dlsym(xext, "XShmQueryExtension");
+    shm_XShmCreateImage = (XShmCreateImage_PTR)dlsym(xext, "XShmCreateImage");
+    shm_XShmAttach = (XShmAttach_PTR)dlsym(xext, "XShmAttach");
+    shm_XShmDetach = (XShmDetach_PTR)dlsym(xext, "XShmDetach");
+    shm_XShmPutImage = (XShmPutImage_PTR)dlsym(xext, "XShmPutImage");
+    if(!shm_XShmQueryExtension || !shm_XShmCreateImage || !shm_XShmAttach || !shm_XShmDetach || !shm_XShmPutImage
+        || !shm_XShmQueryExtension(dpy))
+        return 0;
+    SHUT_LOGD("Using MIT-SHM for emulated pixmaps\n");
+    shm_state = 1;
+    return 1;
+}
+
+static int shm_error = 0;
+static int shm_error_handler(Display *dpy, XErrorEvent *ev) {
+    shm_error = 1;
+    return 0;
+}
+
+static XImage* shm_create(Display *dpy, XShmSegmentInfo *info, int depth, int width, int height, int size) {
+    XImage *image = shm_XShmCreateImage(dpy, NULL /*visual*/, depth, ZPixmap, NULL, info, width, height);
+    if(!image)
+        return NULL;
+    info->shmid = shmget(IPC_PRIVATE, size, IPC_CREAT | 0600);
+    if(info->shmid<0) {
+        XDestroyImage(image);
+        return NULL;
+    }
+    info->shmaddr = image->data = (char*)shmat(info->shmid, NULL, 0);
+    info->readOnly = False;
+    if(info->shmaddr==(char*)-1) {
+        shmctl(info->shmid, IPC_RMID, NULL);
+        image->data = NULL;
+        XDestroyImage(image);
+        return NULL;
+    }
+    // the attach fails with an X error if the server cannot see the segment
+    shm_error = 0;
+    XErrorHandler old = XSetErrorHandler(shm_error_handler);
+    shm_XShmAttach(dpy, info);
+    XSync(dpy, False);
+    XSetErrorHandler(old);
+    // segment will be freed once everyone detached it
+    shmctl(info->shmid, IPC_RMID, NULL);
+    if(shm_error) {
+        SHUT_LOGD("MIT-SHM attach failed, using plain XPutImage\n");
+        shm_state = -1;
+        shmdt(info->shmaddr);
+        image->data = NULL;
+        XDestroyImage(image);
+        return NULL;
+    }
+    return image;
+}
+
+int shmimage_create(Display *dpy, shmimage_t *img, int depth, int width, int height, int size) {
+    memset(img, 0, sizeof(shmimage_t));
+    if(shm_init(dpy)) {
+        XShmSegmentInfo *info = (XShmSegmentInfo*)calloc(1, sizeof(XShmSegmentInfo));
+        img->image = shm_create(dpy, info, depth, width, height, size);
+        if(img->image) {
+            img->shminfo = info;
+            return 1;
+        }
+        free(info);
+    }
+    img->image = XCreateImage(dpy, NULL /*visual*/, depth, ZPixmap, 0, malloc(size), width, height, (depth==16)?16:32, 0);
+    return (img->image!=NULL);
+}
+
+void shmimage_destroy(Display *dpy, shmimage_t *img) {
+    if(!img->image)
+        return;
+    if(img->shminfo) {
+        XShmSegmentInfo *info = (XShmSegmentInfo*)img->shminfo;
+        XSync(dpy, False);
+        shm_XShmDetach(dpy, info);
+        XSync(dpy, False);
+        shmdt(info->shmaddr);
+        img->image->data = NULL;
+        free(info);
+    }
+    XDestroyImage(img->image);
+    memset(img, 0, sizeof(shmimage_t));
+}
+
+// wait for the X server to be done with the image before writing in it
+void shmimage_wait(Display *dpy, shmimage_t *img) {
+    if(img->shminfo && img->serial && LastKnownRequestProcessed(dpy)<img->serial)
+        XSync(dpy, False);
+    img->serial = 0;
+}
+
+void shmimage_put(Display *dpy, Drawable drawable, GC gc, shmimage_t *img, int width, int height) {
+    if(img->shminfo) {
+        img->serial = NextRequest(dpy);
+        shm_XShmPutImage(dpy, drawable, gc, img->image, 0, 0, 0, 0, width, height, False);
+        // don't wait, the next frame is read in the other image meanwhile
+        XFlush(dpy);
+    } else
+        XPutImage(dpy, drawable, gc, img->image, 0, 0, 0, 0, width, height);
+}
+
+#endif //NOX11
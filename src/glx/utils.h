@@ -17,5 +17,17 @@ fill_bitmap(Display * dpy, Window win, GC gc,
 
 XCharStruct *
 isvalid(XFontStruct * fs, int which);
+
+// MIT-SHM XImage, so emulated pixmaps and windows are not sent thru the X socket
+typedef struct {
+    XImage         *image;
+    void           *shminfo;    // XShmSegmentInfo, NULL if the image is a plain one
+    unsigned long   serial;     // request that last put the image, it's in use by the X server until then
+} shmimage_t;
+
+int  shmimage_create(Display *dpy, shmimage_t *img, int depth, int width, int height, int size);
+void shmimage_destroy(Display *dpy, shmimage_t *img);
+void shmimage_wait(Display *dpy, shmimage_t *img);
+void shmimage_put(Display *dpy, Drawable drawable, GC gc, shmimage_t *img, int width, int height);
 #endif // NOX11
 #endif // _GLX_UTILS_H_